@@ -344,6 +344,7 @@ typedef  uint8_t              bool_t;
 #ifdef __KERNEL__
 #include <linux/types.h>   // data types uint8_t ... uint32_t, kernel space
 #else
+#include <stdbool.h>       // boolean definitions
 #include <stdint.h>        // data types uint8_t ... uint32_t, user space
 #endif
 
@@ -0,0 +1,204 @@
+//============================================================================//
+// File:          cp_fifo.c                                                   //
+// Description:   CANpie FIFO functions                                       //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "cp_fifo.h"
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// CpFifoInit()                                                               //
+// initialise FIFO                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpFifoInit(CpFifo_ts * ptsFifoV, CpCanMsg_ts * ptsCanMsgV,
+                       uint32_t ulSizeV)
+{
+   //----------------------------------------------------------------
+   // check for valid pointer
+   //
+   if((ptsFifoV == (CpFifo_ts *) 0L) || (ptsCanMsgV == (CpCanMsg_ts *) 0L))
+   {
+      return(eCP_ERR_FIFO_PARM);
+   }
+
+   CpFifoStoreRelease(&(ptsFifoV->ulIndexIn),  0);
+   CpFifoStoreRelease(&(ptsFifoV->ulIndexOut), 0);
+   ptsFifoV->ptsCanMsg = ptsCanMsgV;
+
+   //----------------------------------------------------------------
+   // the entries are addressed by masking the index, for any other
+   // size than a power of two the FIFO gets no entries
+   //
+   if((ulSizeV == 0UL) || ((ulSizeV & (ulSizeV - 1UL)) != 0UL))
+   {
+      ptsFifoV->ulIndexMax = 0UL;
+      return(eCP_ERR_FIFO_SIZE);
+   }
+   ptsFifoV->ulIndexMax = ulSizeV;
+
+   return(eCP_ERR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpFifoPop()                                                                //
+// read messages from FIFO                                                    //
+//----------------------------------------------------------------------------//
+uint32_t CpFifoPop(CpFifo_ts * ptsFifoV, CpCanMsg_ts * ptsCanMsgV,
+                   uint32_t ulCountV)
+{
+   uint32_t  ulIndexInT;
+   uint32_t  ulIndexOutT;
+   uint32_t  ulPosT;
+   uint32_t  ulChunkT;
+
+   //----------------------------------------------------------------
+   // check for valid pointer
+   //
+   if((ptsFifoV == (CpFifo_ts *) 0L) || (ptsCanMsgV == (CpCanMsg_ts *) 0L))
+   {
+      return(0UL);
+   }
+
+   //----------------------------------------------------------------
+   // The input index is read with acquire semantics, all messages
+   // up to this index have been written completely by the producer.
+   //
+   ulIndexOutT = CpFifoLoadRelaxed(&(ptsFifoV->ulIndexOut));
+   ulIndexInT  = CpFifoLoadAcquire(&(ptsFifoV->ulIndexIn));
+   if(ulCountV > (ulIndexInT - ulIndexOutT))
+   {
+      ulCountV = ulIndexInT - ulIndexOutT;
+   }
+
+   if(ulCountV > 0UL)
+   {
+      //--------------------------------------------------------
+      // copy messages in at most two blocks: up to the end of
+      // the buffer and from the start of the buffer
+      //
+      ulPosT   = ulIndexOutT & (ptsFifoV->ulIndexMax - 1UL);
+      ulChunkT = ptsFifoV->ulIndexMax - ulPosT;
+      if(ulChunkT > ulCountV)
+      {
+         ulChunkT = ulCountV;
+      }
+      memcpy(ptsCanMsgV, &(ptsFifoV->ptsCanMsg[ulPosT]),
+             ulChunkT * sizeof(CpCanMsg_ts));
+
+      if(ulChunkT < ulCountV)
+      {
+         memcpy(&ptsCanMsgV[ulChunkT], &(ptsFifoV->ptsCanMsg[0]),
+                (ulCountV - ulChunkT) * sizeof(CpCanMsg_ts));
+      }
+
+      //--------------------------------------------------------
+      // release the entries to the producer
+      //
+      CpFifoStoreRelease(&(ptsFifoV->ulIndexOut), ulIndexOutT + ulCountV);
+   }
+
+   return(ulCountV);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpFifoPush()                                                               //
+// write messages to FIFO                                                     //
+//----------------------------------------------------------------------------//
+uint32_t CpFifoPush(CpFifo_ts * ptsFifoV, const CpCanMsg_ts * ptsCanMsgV,
+                    uint32_t ulCountV)
+{
+   uint32_t  ulIndexInT;
+   uint32_t  ulIndexOutT;
+   uint32_t  ulPosT;
+   uint32_t  ulChunkT;
+   uint32_t  ulFreeT;
+
+   //----------------------------------------------------------------
+   // check for valid pointer
+   //
+   if((ptsFifoV == (CpFifo_ts *) 0L) || (ptsCanMsgV == (CpCanMsg_ts *) 0L))
+   {
+      return(0UL);
+   }
+
+   //----------------------------------------------------------------
+   // The output index is read with acquire semantics, all entries
+   // up to this index have been read completely by the consumer.
+   //
+   ulIndexInT  = CpFifoLoadRelaxed(&(ptsFifoV->ulIndexIn));
+   ulIndexOutT = CpFifoLoadAcquire(&(ptsFifoV->ulIndexOut));
+   ulFreeT     = ptsFifoV->ulIndexMax - (ulIndexInT - ulIndexOutT);
+   if(ulCountV > ulFreeT)
+   {
+      ulCountV = ulFreeT;
+   }
+
+   if(ulCountV > 0UL)
+   {
+      //--------------------------------------------------------
+      // copy messages in at most two blocks: up to the end of
+      // the buffer and from the start of the buffer
+      //
+      ulPosT   = ulIndexInT & (ptsFifoV->ulIndexMax - 1UL);
+      ulChunkT = ptsFifoV->ulIndexMax - ulPosT;
+      if(ulChunkT > ulCountV)
+      {
+         ulChunkT = ulCountV;
+      }
+      memcpy(&(ptsFifoV->ptsCanMsg[ulPosT]), ptsCanMsgV,
+             ulChunkT * sizeof(CpCanMsg_ts));
+
+      if(ulChunkT < ulCountV)
+      {
+         memcpy(&(ptsFifoV->ptsCanMsg[0]), &ptsCanMsgV[ulChunkT],
+                (ulCountV - ulChunkT) * sizeof(CpCanMsg_ts));
+      }
+
+      //--------------------------------------------------------
+      // publish the messages to the consumer
+      //
+      CpFifoStoreRelease(&(ptsFifoV->ulIndexIn), ulIndexInT + ulCountV);
+   }
+
+   return(ulCountV);
+}
+
@@ -37,6 +37,21 @@
 ** \file    cp_fifo.h
 ** \brief   Definitions and prototypes for FIFO implementation
 **
+** The FIFO is a single-producer / single-consumer ring buffer for
+** CAN messages. The producer (e.g. an interrupt service routine or
+** a driver thread) only writes the input index, the consumer only
+** writes the output index. Both indices are free-running, the
+** number of entries is the difference of both indices. Hence the
+** capacity of the FIFO must be a power of two and all entries can
+** be used.
+** <p>
+** Access to the indices uses acquire / release semantics, so the
+** producer and the consumer may run on different CPU cores without
+** a mutex. Depending on the compiler the following implementation
+** is selected:
+** \li C11 atomics (stdatomic.h)
+** \li GNU C atomic built-in functions (also for C++ and C99)
+** \li volatile access, only valid for single core systems
 */
 
 /*----------------------------------------------------------------------------*\
@@ -44,11 +59,73 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#include "canpie.h"
+
+#if   (!defined(__cplusplus)) && defined(__STDC_VERSION__)
+#if   (__STDC_VERSION__ >= 201112L) && (!defined(__STDC_NO_ATOMICS__))
+#define  CP_FIFO_C11_ATOMIC   1
+#include <stdatomic.h>
+#endif
+#endif
+
+
+//-------------------------------------------------------------------//
+// take precautions if compiled with C++ compiler                    //
+#ifdef __cplusplus                                                   //
+extern "C" {                                                         //
+#endif                                                               //
+//-------------------------------------------------------------------//
+
+
 /*----------------------------------------------------------------------------*\
 ** Definitions                                                                **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+//-------------------------------------------------------------------
+// Access to FIFO indices: a load with acquire semantics makes the
+// messages written by the other side visible, a store with release
+// semantics publishes the messages written by this side.
+//
+#if   defined(CP_FIFO_C11_ATOMIC)
+
+typedef  _Atomic uint32_t     CpFifoIndex_tv;
+
+#define  CpFifoLoadAcquire(IDX_PTR)                                  \
+            atomic_load_explicit((IDX_PTR), memory_order_acquire)
+
+#define  CpFifoLoadRelaxed(IDX_PTR)                                  \
+            atomic_load_explicit((IDX_PTR), memory_order_relaxed)
+
+#define  CpFifoStoreRelease(IDX_PTR, VAL)                            \
+            atomic_store_explicit((IDX_PTR), (VAL), memory_order_release)
+
+#elif defined(__GNUC__)
+
+typedef  uint32_t             CpFifoIndex_tv;
+
+#define  CpFifoLoadAcquire(IDX_PTR)                                  \
+            __atomic_load_n((IDX_PTR), __ATOMIC_ACQUIRE)
+
+#define  CpFifoLoadRelaxed(IDX_PTR)                                  \
+            __atomic_load_n((IDX_PTR), __ATOMIC_RELAXED)
+
+#define  CpFifoStoreRelease(IDX_PTR, VAL)                            \
+            __atomic_store_n((IDX_PTR), (VAL), __ATOMIC_RELEASE)
+
+#else
+
+typedef  volatile uint32_t    CpFifoIndex_tv;
+
+#define  CpFifoLoadAcquire(IDX_PTR)          (*(IDX_PTR))
+
+#define  CpFifoLoadRelaxed(IDX_PTR)          (*(IDX_PTR))
+
+#define  CpFifoStoreRelease(IDX_PTR, VAL)    (*(IDX_PTR) = (VAL))
+
+#endif
+
+
 /*----------------------------------------------------------------------------*\
 ** Structures                                                                 **
 **                                                                            **
@@ -63,15 +140,17 @@
 ** FIFO access.
 */
 struct CpFifo_s {
-   /*! Index where the last data has been written to
+   /*! Free-running index where the next data will be written to,
+   **  only modified by the producer
    */
-   uint32_t  ulIndexIn;
+   CpFifoIndex_tv  ulIndexIn;
 
-   /*! Index where the last data has been read from
+   /*! Free-running index where the next data will be read from,
+   **  only modified by the consumer
    */
-   uint32_t  ulIndexOut;
+   CpFifoIndex_tv  ulIndexOut;
 
-   /*! Maximum number of FIFO entries
+   /*! Maximum number of FIFO entries, must be a power of two
    */
    uint32_t  ulIndexMax;
 
@@ -87,12 +166,22 @@ typedef struct CpFifo_s CpFifo_ts;
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+/*!
+** \def     CpFifoCount(FIFO_PTR)
+** \return  Number of messages in the FIFO
+**
+** The macro can be used by the producer and by the consumer.
+*/
+#define  CpFifoCount(FIFO_PTR)                                       \
+            (CpFifoLoadAcquire(&((FIFO_PTR)->ulIndexIn)) -           \
+             CpFifoLoadAcquire(&((FIFO_PTR)->ulIndexOut)))
+
+
 /*!
 ** \def     CpFifoDataInPtr(FIFO_PTR)
 ** \return  Pointer to next empty FIFO element.
 **
-** Value ctrl have to be a (static) variable from type
-** of McFifoCtrl_ts structure. Value pdata is pointer to the FIFO array.
+** The macro must only be used by the producer.
 **
 ** \code
 **
@@ -110,62 +199,53 @@ typedef struct CpFifo_s CpFifo_ts;
 ** }
 ** \endcode
 */
-#define  CpFifoDataInPtr(FIFO_PTR)                            \
-            (((FIFO_PTR)->ptsCanMsg) + ((FIFO_PTR)->ulIndexIn))
+#define  CpFifoDataInPtr(FIFO_PTR)                                   \
+            (((FIFO_PTR)->ptsCanMsg) +                               \
+             (CpFifoLoadRelaxed(&((FIFO_PTR)->ulIndexIn)) &          \
+              ((FIFO_PTR)->ulIndexMax - 1)))
 
 
 /*!
 ** \def     CpFifoDataOutPtr(FIFO_PTR)
 ** \brief   This macro returns pointer to next FIFO out element.
 **
-** Value ctrl have to be a (static) variable from type
-** of McFifoCtrl_ts structure. Value pdata is pointer to the FIFO array.
+** The macro must only be used by the consumer.
 **
 ** \code
-** UserFifoEntry_ts * ptsFifoOutEntryT;
+** CpCanMsg_ts * ptsCanMsgT;
 **
-** if (!(MC_FIFO_EMPTY(tsFifoCntrlS)))
+** if (!(CpFifoIsEmpty(&tsCanFifoS)))
 ** {
-**    ptsFifoOutEntryT = MC_FIFO_DATA_OUT_PTR(tsFifoCntrlS,&atsFifoDataS[0]);
+**    ptsCanMsgT = CpFifoDataOutPtr(&tsCanFifoS);
 **
-**    memcpy(ptsUserDataT, ptsFifoOutEntryT, sizeof(UserFifoEntry_ts));
+**    memcpy(ptsUserDataT, ptsCanMsgT, sizeof(CpCanMsg_ts));
 **
 **    // handle ptsUserDataT data from FIFO
 **    ...
 **
-**    MC_FIFO_INC_OUT(tsFifoCntrlS);
+**    CpFifoIncOut(&tsCanFifoS);
 ** }
 ** \endcode
 */
-#define  CpFifoDataOutPtr(FIFO_PTR) \
-      (((FIFO_PTR)->ptsCanMsg) + ((FIFO_PTR)->ulIndexOut))
+#define  CpFifoDataOutPtr(FIFO_PTR)                                  \
+            (((FIFO_PTR)->ptsCanMsg) +                               \
+             (CpFifoLoadRelaxed(&((FIFO_PTR)->ulIndexOut)) &         \
+              ((FIFO_PTR)->ulIndexMax - 1)))
 
 
 /*!
-** \def     CpFifoIsEmpty(ctrl)
+** \def     CpFifoIsEmpty(FIFO_PTR)
 ** \return  1 if FIFO is empty, otherwise 0
 **
-** Value x have to be a (static) variable from type of
-** McFifoCtrl_ts structure.
-** e.g :
 ** \code
-** uint32_t * pulFifoElementT;
-** ...
-** if (MC_FIFO_EMPTY(tsMcFifoCtrlS))
+** if (CpFifoIsEmpty(&tsCanFifoS))
 ** {
 **    return CpErr_FIFO_EMPTY;
 ** }
-**
-** // access to next data of FIFO
-** pulFifoElementT = (uint32_t *) MC_FIFO_DATA_OUT_PTR(tsMcFifoCtrlS);
-**
-** Dummy = *pulFifoElementT;
-** ...
-** MC_FIFO_INC_OUT(tsMcFifoCtrlS);
 ** \endcode
 */
 #define  CpFifoIsEmpty(FIFO_PTR) \
-   (((FIFO_PTR)->ulIndexIn == (FIFO_PTR)->ulIndexOut) ? 1 : 0)
+            ((CpFifoCount(FIFO_PTR) == 0) ? 1 : 0)
 
 
 
@@ -173,104 +253,127 @@ typedef struct CpFifo_s CpFifo_ts;
 ** \def     CpFifoIsFull(FIFO_PTR)
 ** \return  1 if FIFO is full, otherwise 0
 **
-** Value ctrl have to be a (static) variable from type of
-** McFifoCtrl_ts structure.
-** e.g :
 ** \code
-** uint32_t * pulFifoElementT;
-** ...
-** if (MC_FIFO_FULL(tsMcFifoCtrlS))
+** if (CpFifoIsFull(&tsCanFifoS))
 ** {
 **    return CpErr_FIFO_FULL;
 ** }
-**
-** // access to data of FIFO
-** pulFifoElementT = (uint32_t *) MC_FIFO_DATA_IN_PTR(tsMcFifoCtrlS);
-**
-** *pulFifoElementT = Dummy;
-** ...
-** MC_FIFO_INC_IN(tsMcFifoCtrlS);
 ** \endcode
 **
 */
-#define  CpFifoIsFull(FIFO_PTR)                                            \
-            ( (((FIFO_PTR)->ulIndexIn+1 == (FIFO_PTR)->ulIndexOut) ||       \
-              (((FIFO_PTR)->ulIndexOut  == 0) &&                             \
-               ((FIFO_PTR)->ulIndexIn+1 == (FIFO_PTR)->ulIndexMax) )) ? 1 : 0)
+#define  CpFifoIsFull(FIFO_PTR) \
+            ((CpFifoCount(FIFO_PTR) >= (FIFO_PTR)->ulIndexMax) ? 1 : 0)
 
 
 
 /*!
-** \def     CpFifoIncIn(ctrl)
+** \def     CpFifoIncIn(FIFO_PTR)
 ** \brief   This macro have to be execute when data was written to the FIFO.
 **
-** Value ctrl have to be a (static) variable from type of
-** McFifoCtrl_ts structure.
+** The macro must only be used by the producer, it publishes the
+** message written to CpFifoDataInPtr().
 */
 #define  CpFifoIncIn(FIFO_PTR)                                       \
-         do {                                                        \
-            (FIFO_PTR)->ulIndexIn++;                                 \
-            if ((FIFO_PTR)->ulIndexIn >= (FIFO_PTR)->ulIndexMax)     \
-            {                                                        \
-               (FIFO_PTR)->ulIndexIn = 0;                            \
-            }                                                        \
-         } while (0)
+            CpFifoStoreRelease(&((FIFO_PTR)->ulIndexIn),             \
+                   CpFifoLoadRelaxed(&((FIFO_PTR)->ulIndexIn)) + 1)
 
 
 /*!
-** \def     CpFifoIncOut(ctrl)
+** \def     CpFifoIncOut(FIFO_PTR)
 ** \brief   This macro have to be execute when data was read from the FIFO.
 **
-** Value ctrl have to be a (static) variable from type of
-** McFifoCtrl_ts structure.
+** The macro must only be used by the consumer, it releases the
+** message read from CpFifoDataOutPtr().
 */
 #define  CpFifoIncOut(FIFO_PTR)                                      \
-         do {                                                        \
-            (FIFO_PTR)->ulIndexOut++;                                \
-            if ((FIFO_PTR)->ulIndexOut >= (FIFO_PTR)->ulIndexMax)    \
-            {                                                        \
-               (FIFO_PTR)->ulIndexOut = 0;                           \
-            }                                                        \
-         } while (0)
+            CpFifoStoreRelease(&((FIFO_PTR)->ulIndexOut),            \
+                   CpFifoLoadRelaxed(&((FIFO_PTR)->ulIndexOut)) + 1)
 
 
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
 /*!
-** \def     CpFifoInit(ctrl,size)
-** \brief   Initialise FIFO.
+** \brief   Initialise FIFO
+** \param   ptsFifoV       Pointer to FIFO
+** \param   ptsCanMsgV     Pointer to message buffer
+** \param   ulSizeV        Number of entries of message buffer
+** \return  Error code taken from the #CpErr_e enumeration
 **
-** Value ctrl have to be a (static) variable from type of a McFifoCtrl_ts.
-** Value size gives number of entries the FIFO contains.
+** The function initialises the FIFO \c ptsFifoV for the message
+** buffer \c ptsCanMsgV with \c ulSizeV entries. The entries are
+** addressed by masking the index, so \c ulSizeV must be a power of
+** two. For any other size the function returns #eCP_ERR_FIFO_SIZE
+** and the FIFO gets no entries at all. The FIFO must not be used by
+** the producer or the consumer during initialisation.
 **
 ** Here is an example for initialisation of FIFO:
 ** \code
 ** ...
 ** // define example FIFO
-** #define NUMBER_OF_FIFO_ENTRIES   20
-** static McFifoCtrl_ts tsMcFifoCtrlS;
-** static uint32_t      aulUserFifoDataS[NUMBER_OF_FIFO_ENTRIES]; // can be an array of struct
+** #define NUMBER_OF_FIFO_ENTRIES   32
+** static CpFifo_ts   tsCanFifoS;
+** static CpCanMsg_ts atsCanMsgS[NUMBER_OF_FIFO_ENTRIES];
 ** ...
 ** // initialise example FIFO
-** MC_FIFO_INIT(tsMcFifoCtrlS,NUMBER_OF_FIFO_ENTRIES);
-**
+** if (CpFifoInit(&tsCanFifoS, &atsCanMsgS[0],
+**                NUMBER_OF_FIFO_ENTRIES) != eCP_ERR_NONE)
+** {
+**    ...
+** }
 ** \endcode
 **
 ** \attention It is important that NUMBER_OF_FIFO_ENTRIES value that was
-** used for atsUserFifoDataS declaration is the same as value
-** that is used with MC_FIFO_INIT();
+** used for atsCanMsgS declaration is the same as value
+** that is used with CpFifoInit();
 */
-#define  CpFifoInit(FIFO_PTR, MSG_PTR, SIZE)                         \
-         do {                                                        \
-            (FIFO_PTR)->ulIndexIn  = 0;                              \
-            (FIFO_PTR)->ulIndexOut = 0;                              \
-            (FIFO_PTR)->ulIndexMax = (SIZE);                         \
-            (FIFO_PTR)->ptsCanMsg  = (MSG_PTR);                      \
-         } while (0)
+CpStatus_tv  CpFifoInit(CpFifo_ts * ptsFifoV, CpCanMsg_ts * ptsCanMsgV,
+                        uint32_t ulSizeV);
 
 
+//------------------------------------------------------------------------------
+/*!
+** \brief   Read messages from FIFO
+** \param   ptsFifoV       Pointer to FIFO
+** \param   ptsCanMsgV     Pointer to message buffer
+** \param   ulCountV       Maximum number of messages to read
+** \return  Number of messages read
+**
+** The function copies up to \c ulCountV messages from the FIFO to the
+** buffer \c ptsCanMsgV and releases them with a single update of the
+** output index. The function must only be used by the consumer.
+*/
+uint32_t  CpFifoPop(CpFifo_ts * ptsFifoV, CpCanMsg_ts * ptsCanMsgV,
+                    uint32_t ulCountV);
 
-/*----------------------------------------------------------------------------*\
-** Function prototypes                                                        **
-**                                                                            **
-\*----------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+/*!
+** \brief   Write messages to FIFO
+** \param   ptsFifoV       Pointer to FIFO
+** \param   ptsCanMsgV     Pointer to message buffer
+** \param   ulCountV       Number of messages to write
+** \return  Number of messages written
+**
+** The function copies up to \c ulCountV messages from the buffer
+** \c ptsCanMsgV to the FIFO and publishes them with a single update
+** of the input index. If the FIFO has not enough free entries,
+** only the first messages are written. The function must only be
+** used by the producer.
+*/
+uint32_t  CpFifoPush(CpFifo_ts * ptsFifoV, const CpCanMsg_ts * ptsCanMsgV,
+                     uint32_t ulCountV);
+
+
+//-------------------------------------------------------------------//
+#ifdef __cplusplus                                                   //
+}                                                                    //
+#endif                                                               //
+// end of C++ compiler wrapper                                       //
+//-------------------------------------------------------------------//
 
 #endif   // CP_FIFO_H_
@@ -45,6 +45,12 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+//-------------------------------------------------------------------
+// direction value of a simulated CAN message buffer which is
+// not configured
+//
+#define  SIM_BUFFER_DIR_NONE        ((uint8_t) 0xFF)
+
 
 
 /*----------------------------------------------------------------------------*\
@@ -65,8 +71,18 @@
 //
 static CpCanMsg_ts atsCanMsgS[CP_BUFFER_MAX];
 
+static uint32_t    aulAcceptMaskS[CP_BUFFER_MAX];
+
+static uint8_t     aubBufferDirS[CP_BUFFER_MAX];
+
 static CpFifo_ts * aptsFifoS[CP_BUFFER_MAX];
 
+//-------------------------------------------------------------------
+// statistic counters of simulated CAN controller
+//
+static uint32_t    ulRcvMsgCntS;
+static uint32_t    ulTrmMsgCntS;
+
 
 //-------------------------------------------------------------------
 // these pointers store the callback handlers
@@ -76,6 +92,85 @@ static CpTrmHandler_Fn  /*@null@*/  pfnTrmHandlerS = CPP_NULL;
 static CpErrHandler_Fn  /*@null@*/  pfnErrHandlerS = CPP_NULL;
 
 
+/*----------------------------------------------------------------------------*\
+** Static functions                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// SimReceive()                                                               //
+// simulated reception of a CAN message                                       //
+//----------------------------------------------------------------------------//
+static void SimReceive(const CpCanMsg_ts * ptsCanMsgV)
+{
+   uint8_t        ubBufferIdxT;
+   uint32_t       ulAcceptMaskT;
+   CpCanMsg_ts *  ptsMailboxT;
+
+   //----------------------------------------------------------------
+   // The message is stored in the first receive buffer with matching
+   // frame format and identifier. A buffer with assigned FIFO stores
+   // the message in the FIFO, otherwise the message is stored in the
+   // buffer and the receive handler is called.
+   //
+   for(ubBufferIdxT = 0; ubBufferIdxT < CP_BUFFER_MAX; ubBufferIdxT++)
+   {
+      if(aubBufferDirS[ubBufferIdxT] != eCP_BUFFER_DIR_RCV)
+      {
+         continue;
+      }
+
+      ptsMailboxT   = &atsCanMsgS[ubBufferIdxT];
+      ulAcceptMaskT = aulAcceptMaskS[ubBufferIdxT];
+      if(CpMsgIsExtended(ptsMailboxT) != CpMsgIsExtended(ptsCanMsgV))
+      {
+         continue;
+      }
+      if((CpMsgGetIdentifier(ptsMailboxT) & ulAcceptMaskT) !=
+         (CpMsgGetIdentifier(ptsCanMsgV)  & ulAcceptMaskT)    )
+      {
+         continue;
+      }
+
+      ulRcvMsgCntS++;
+      if(aptsFifoS[ubBufferIdxT] != (CpFifo_ts *) 0L)
+      {
+         (void) CpFifoPush(aptsFifoS[ubBufferIdxT], ptsCanMsgV, 1);
+      }
+      else
+      {
+         *ptsMailboxT = *ptsCanMsgV;
+         if(pfnRcvHandlerS != CPP_NULL)
+         {
+            (void) (* pfnRcvHandlerS)(ptsMailboxT, ubBufferIdxT + 1);
+         }
+      }
+      break;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// SimTransmit()                                                              //
+// simulated transmission of a CAN message buffer                             //
+//----------------------------------------------------------------------------//
+static void SimTransmit(uint8_t ubBufferIdxV)
+{
+   //----------------------------------------------------------------
+   // the simulated CAN controller is in loop-back mode, a transmitted
+   // message is received by the own receive buffers
+   //
+   ulTrmMsgCntS++;
+   SimReceive(&atsCanMsgS[ubBufferIdxV - 1]);
+
+   if(pfnTrmHandlerS != CPP_NULL)
+   {
+      (void) (* pfnTrmHandlerS)(&atsCanMsgS[ubBufferIdxV - 1], ubBufferIdxV);
+   }
+}
+
+
 /*----------------------------------------------------------------------------*\
 ** Function implementation                                                    **
 **                                                                            **
@@ -86,7 +181,7 @@ static CpErrHandler_Fn  /*@null@*/  pfnErrHandlerS = CPP_NULL;
 // CpCoreBitrate()                                                            //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBitrate( CpPort_ts * ptsPortV, int32_t slNomBitRateV,
+CpStatus_tv CpCoreBitrate( const CpPort_ts * ptsPortV, int32_t slNomBitRateV,
                            int32_t slDatBitRateV)
 {
    //----------------------------------------------------------------
@@ -119,7 +214,7 @@ CpStatus_tv CpCoreBitrate( CpPort_ts * ptsPortV, int32_t slNomBitRateV,
 // CpCoreBufferConfig()                                                       //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBufferConfig( CpPort_ts * ptsPortV,
+CpStatus_tv CpCoreBufferConfig( const CpPort_ts * ptsPortV,
                                 uint8_t   ubBufferIdxV,
                                 uint32_t  ulIdentifierV,
                                 uint32_t  ulAcceptMaskV,
@@ -150,16 +245,19 @@ CpStatus_tv CpCoreBufferConfig( CpPort_ts * ptsPortV,
    switch(ubFormatV & CP_MSG_FORMAT_MASK)
    {
       case CP_MSG_FORMAT_CBFF:
+      case CP_MSG_FORMAT_FBFF:
          ulIdentifierV = ulIdentifierV & CP_MASK_STD_FRAME;
          ulAcceptMaskV = ulAcceptMaskV & CP_MASK_STD_FRAME;
          break;
 
       case CP_MSG_FORMAT_CEFF:
+      case CP_MSG_FORMAT_FEFF:
          ulIdentifierV = ulIdentifierV & CP_MASK_EXT_FRAME;
          ulAcceptMaskV = ulAcceptMaskV & CP_MASK_EXT_FRAME;
          break;
 
-
+      default:
+         return(eCP_ERR_PARAM);
    }
 
    switch(ubDirectionV)
@@ -171,7 +269,19 @@ CpStatus_tv CpCoreBufferConfig( CpPort_ts * ptsPortV,
       case eCP_BUFFER_DIR_TRM:
 
          break;
+
+      default:
+         return(eCP_ERR_PARAM);
    }
+
+   //----------------------------------------------------------------
+   // setup simulated CAN buffer
+   //
+   CpMsgInit(&atsCanMsgS[ubBufferIdxV - 1], ubFormatV);
+   CpMsgSetIdentifier(&atsCanMsgS[ubBufferIdxV - 1], ulIdentifierV);
+   aulAcceptMaskS[ubBufferIdxV - 1] = ulAcceptMaskV;
+   aubBufferDirS[ubBufferIdxV - 1]  = ubDirectionV;
+
    return (eCP_ERR_NONE);
 }
 
@@ -179,7 +289,7 @@ CpStatus_tv CpCoreBufferConfig( CpPort_ts * ptsPortV,
 // CpCoreBufferGetData()                                                      //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBufferGetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+CpStatus_tv CpCoreBufferGetData( const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint8_t * pubDestDataV,
                                  uint8_t   ubStartPosV,
                                  uint8_t   ubSizeV)
@@ -233,7 +343,7 @@ CpStatus_tv CpCoreBufferGetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 // CpCoreBufferGetDlc()                                                       //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBufferGetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+CpStatus_tv CpCoreBufferGetDlc(  const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint8_t * pubDlcV)
 {
    //----------------------------------------------------------------
@@ -268,7 +378,7 @@ CpStatus_tv CpCoreBufferGetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 // CpCoreBufferRelease()                                                      //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
+CpStatus_tv CpCoreBufferRelease( const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 {
    //----------------------------------------------------------------
    // test CAN port
@@ -289,6 +399,8 @@ CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
       return(eCP_ERR_BUFFER);
    }
 
+   aubBufferDirS[ubBufferIdxV - 1] = SIM_BUFFER_DIR_NONE;
+   aptsFifoS[ubBufferIdxV - 1]     = (CpFifo_ts *) 0L;
 
    return (eCP_ERR_NONE);
 }
@@ -298,7 +410,7 @@ CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 // CpCoreBufferSend()                                                         //
 // send message out of the CAN controller                                     //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
+CpStatus_tv CpCoreBufferSend(const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 {
    //----------------------------------------------------------------
    // test CAN port
@@ -318,7 +430,15 @@ CpStatus_tv CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
       return(eCP_ERR_BUFFER);
    }
 
+   //----------------------------------------------------------------
+   // only a transmit buffer can be sent
+   //
+   if(aubBufferDirS[ubBufferIdxV - 1] != eCP_BUFFER_DIR_TRM)
+   {
+      return(eCP_ERR_BUFFER);
+   }
 
+   SimTransmit(ubBufferIdxV);
 
    return (eCP_ERR_NONE);
 }
@@ -328,7 +448,7 @@ CpStatus_tv CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 // CpCoreBufferSetData()                                                      //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBufferSetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+CpStatus_tv CpCoreBufferSetData( const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
       uint8_t * pubSrcDataV,
       uint8_t   ubStartPosV,
       uint8_t   ubSizeV)
@@ -371,7 +491,7 @@ CpStatus_tv CpCoreBufferSetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 // CpCoreBufferSetDlc()                                                       //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreBufferSetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+CpStatus_tv CpCoreBufferSetDlc(  const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint8_t ubDlcV)
 {
    //----------------------------------------------------------------
@@ -407,7 +527,7 @@ CpStatus_tv CpCoreBufferSetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 // CpCoreCanMode()                                                            //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreCanMode(CpPort_ts * ptsPortV, uint8_t ubModeV)
+CpStatus_tv CpCoreCanMode(const CpPort_ts * ptsPortV, uint8_t ubModeV)
 {
    uint8_t  ubStatusT;
 
@@ -466,7 +586,7 @@ CpStatus_tv CpCoreCanMode(CpPort_ts * ptsPortV, uint8_t ubModeV)
 // CpCoreCanState()                                                           //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreCanState(CpPort_ts * ptsPortV, CpState_ts * ptsStateV)
+CpStatus_tv CpCoreCanState(const CpPort_ts * ptsPortV, CpState_ts * ptsStateV)
 {
    //----------------------------------------------------------------
    // test CAN port
@@ -496,6 +616,7 @@ CpStatus_tv CpCoreCanState(CpPort_ts * ptsPortV, CpState_ts * ptsStateV)
 CpStatus_tv CpCoreDriverInit( uint8_t ubPhyIfV, CpPort_ts * ptsPortV,
                               uint8_t CPP_PARM_UNUSED(ubConfigV) )
 {
+   uint8_t  ubBufferIdxT;
 
    if(ubPhyIfV != eCP_CHANNEL_1)
    {
@@ -507,6 +628,19 @@ CpStatus_tv CpCoreDriverInit( uint8_t ubPhyIfV, CpPort_ts * ptsPortV,
 
    }
 
+   //----------------------------------------------------------------
+   // reset simulated CAN controller
+   //
+   for(ubBufferIdxT = 0; ubBufferIdxT < CP_BUFFER_MAX; ubBufferIdxT++)
+   {
+      CpMsgInit(&atsCanMsgS[ubBufferIdxT], CP_MSG_FORMAT_CBFF);
+      aulAcceptMaskS[ubBufferIdxT] = 0;
+      aubBufferDirS[ubBufferIdxT]  = SIM_BUFFER_DIR_NONE;
+      aptsFifoS[ubBufferIdxT]      = (CpFifo_ts *) 0L;
+   }
+   ulRcvMsgCntS = 0;
+   ulTrmMsgCntS = 0;
+
    return(eCP_ERR_NONE);
 }
 
@@ -530,7 +664,7 @@ CpStatus_tv CpCoreDriverRelease(CpPort_ts * ptsPortV)
 // CpCoreFifoConfig()                                                         //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreFifoConfig(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+CpStatus_tv CpCoreFifoConfig(const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                              CpFifo_ts * ptsFifoV)
 {
    //----------------------------------------------------------------
@@ -551,22 +685,74 @@ CpStatus_tv CpCoreFifoConfig(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
       return(eCP_ERR_BUFFER);
    }
 
-   if(ptsFifoV != 0)
+   //----------------------------------------------------------------
+   // the FIFO uses free-running indices, the number of entries
+   // must be a power of two
+   //
+   if(ptsFifoV == (CpFifo_ts *) 0L)
+   {
+      return(eCP_ERR_FIFO_PARM);
+   }
+   if((ptsFifoV->ulIndexMax == 0) ||
+      ((ptsFifoV->ulIndexMax & (ptsFifoV->ulIndexMax - 1)) != 0))
    {
-      aptsFifoS[ubBufferIdxV - 1] = ptsFifoV;
+      return(eCP_ERR_FIFO_SIZE);
    }
+
+   aptsFifoS[ubBufferIdxV - 1] = ptsFifoV;
+
    return(eCP_ERR_NONE);
 }
 
 
+//----------------------------------------------------------------------------//
+// CpCoreFifoEvent()                                                          //
+// simulated interrupt of a message buffer with assigned FIFO                 //
+//----------------------------------------------------------------------------//
+void CpCoreFifoEvent(const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
+{
+   CpFifo_ts *    ptsFifoT;
+
+   //----------------------------------------------------------------
+   // test CAN port
+   //
+   #if CP_SMALL_CODE == 0
+   if(ptsPortV == (CpPort_ts *) 0L)
+   {
+      return;
+   }
+   #endif
+
+   if((ubBufferIdxV < eCP_BUFFER_1  ) || (ubBufferIdxV > CP_BUFFER_MAX) )
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // a transmit buffer takes the pending messages from the FIFO
+   // and sends them one after the other
+   //
+   ptsFifoT = aptsFifoS[ubBufferIdxV - 1];
+   if((ptsFifoT != (CpFifo_ts *) 0L) &&
+      (aubBufferDirS[ubBufferIdxV - 1] == eCP_BUFFER_DIR_TRM))
+   {
+      while(CpFifoPop(ptsFifoT, &atsCanMsgS[ubBufferIdxV - 1], 1) > 0)
+      {
+         SimTransmit(ubBufferIdxV);
+      }
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // CpCoreFifoRead()                                                           //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreFifoRead(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+CpStatus_tv CpCoreFifoRead(const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                            CpCanMsg_ts * ptsCanMsgV,
                            uint32_t * pulBufferSizeV)
 {
+   CpFifo_ts *    ptsFifoT;
 
    //----------------------------------------------------------------
    // test CAN port
@@ -586,12 +772,26 @@ CpStatus_tv CpCoreFifoRead(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
       return(eCP_ERR_BUFFER);
    }
 
-   if(pulBufferSizeV != (uint32_t *) 0L)
+   if((pulBufferSizeV == (uint32_t *) 0L) || (ptsCanMsgV == (CpCanMsg_ts *) 0L))
    {
-      if(ptsCanMsgV != (CpCanMsg_ts *) 0L)
-      {
+      return(eCP_ERR_FIFO_PARM);
+   }
 
-      }
+   ptsFifoT = aptsFifoS[ubBufferIdxV - 1];
+   if(ptsFifoT == (CpFifo_ts *) 0L)
+   {
+      *pulBufferSizeV = 0;
+      return(eCP_ERR_FIFO_PARM);
+   }
+
+   //----------------------------------------------------------------
+   // copy up to *pulBufferSizeV messages in one block, the number
+   // of copied messages is returned via pulBufferSizeV
+   //
+   *pulBufferSizeV = CpFifoPop(ptsFifoT, ptsCanMsgV, *pulBufferSizeV);
+   if(*pulBufferSizeV == 0)
+   {
+      return(eCP_ERR_FIFO_EMPTY);
    }
 
    return(eCP_ERR_NONE);
@@ -602,7 +802,7 @@ CpStatus_tv CpCoreFifoRead(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 // CpCoreFifoRelease()                                                        //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreFifoRelease(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
+CpStatus_tv CpCoreFifoRelease(const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 {
    //----------------------------------------------------------------
    // test CAN port
@@ -622,6 +822,8 @@ CpStatus_tv CpCoreFifoRelease(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
       return(eCP_ERR_BUFFER);
    }
 
+   aptsFifoS[ubBufferIdxV - 1] = (CpFifo_ts *) 0L;
+
    return(eCP_ERR_NONE);
 }
 
@@ -630,10 +832,13 @@ CpStatus_tv CpCoreFifoRelease(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 // CpCoreFifoWrite()                                                          //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreFifoWrite(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+CpStatus_tv CpCoreFifoWrite(const CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                              CpCanMsg_ts * ptsCanMsgV,
                              uint32_t * pulBufferSizeV)
 {
+   CpFifo_ts *    ptsFifoT;
+   CpStatus_tv    tvStatusT = eCP_ERR_NONE;
+
    //----------------------------------------------------------------
    // test CAN port
    //
@@ -652,16 +857,38 @@ CpStatus_tv CpCoreFifoWrite(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
       return(eCP_ERR_BUFFER);
    }
 
-   if(pulBufferSizeV != (uint32_t *) 0L)
+   if((pulBufferSizeV == (uint32_t *) 0L) || (ptsCanMsgV == (CpCanMsg_ts *) 0L))
    {
-      if(ptsCanMsgV != (CpCanMsg_ts *) 0L)
-      {
+      return(eCP_ERR_FIFO_PARM);
+   }
 
-      }
+   ptsFifoT = aptsFifoS[ubBufferIdxV - 1];
+   if(ptsFifoT == (CpFifo_ts *) 0L)
+   {
+      *pulBufferSizeV = 0;
+      return(eCP_ERR_FIFO_PARM);
+   }
 
+   //----------------------------------------------------------------
+   // copy up to *pulBufferSizeV messages in one block, the number
+   // of copied messages is returned via pulBufferSizeV
+   //
+   if(*pulBufferSizeV > 0)
+   {
+      *pulBufferSizeV = CpFifoPush(ptsFifoT, ptsCanMsgV, *pulBufferSizeV);
+      if(*pulBufferSizeV == 0)
+      {
+         tvStatusT = eCP_ERR_FIFO_FULL;
+      }
    }
 
-   return(eCP_ERR_NONE);
+   //----------------------------------------------------------------
+   // start transmission, a real CAN controller would raise an
+   // interrupt for the next message
+   //
+   CpCoreFifoEvent(ptsPortV, ubBufferIdxV);
+
+   return(tvStatusT);
 }
 
 
@@ -669,7 +896,7 @@ CpStatus_tv CpCoreFifoWrite(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 // CpCoreHDI()                                                                //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreHDI(CpPort_ts * ptsPortV, CpHdi_ts * ptsHdiV)
+CpStatus_tv CpCoreHDI(const CpPort_ts * ptsPortV, CpHdi_ts * ptsHdiV)
 {
    //----------------------------------------------------------------
    // test CAN port
@@ -699,7 +926,7 @@ CpStatus_tv CpCoreHDI(CpPort_ts * ptsPortV, CpHdi_ts * ptsHdiV)
 // CpCoreIntFunctions()                                                       //
 //                                                                            //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreIntFunctions(CpPort_ts * ptsPortV,
+CpStatus_tv CpCoreIntFunctions(const CpPort_ts * ptsPortV,
                                CpRcvHandler_Fn pfnRcvHandlerV,
                                CpTrmHandler_Fn pfnTrmHandlerV,
                                CpErrHandler_Fn pfnErrHandlerV )
@@ -730,7 +957,7 @@ CpStatus_tv CpCoreIntFunctions(CpPort_ts * ptsPortV,
 // CpCoreStatistic()                                                          //
 // return statistical information                                             //
 //----------------------------------------------------------------------------//
-CpStatus_tv CpCoreStatistic(CpPort_ts * ptsPortV, CpStatistic_ts * ptsStatsV)
+CpStatus_tv CpCoreStatistic(const CpPort_ts * ptsPortV, CpStatistic_ts * ptsStatsV)
 {
    //----------------------------------------------------------------
    // test CAN port
@@ -743,8 +970,8 @@ CpStatus_tv CpCoreStatistic(CpPort_ts * ptsPortV, CpStatistic_ts * ptsStatsV)
    #endif
 
    ptsStatsV->ulErrMsgCount = 0;
-   ptsStatsV->ulRcvMsgCount = 0;
-   ptsStatsV->ulTrmMsgCount = 0;
+   ptsStatsV->ulRcvMsgCount = ulRcvMsgCntS;
+   ptsStatsV->ulTrmMsgCount = ulTrmMsgCntS;
 
    return(eCP_ERR_NONE);
 }
@@ -34,6 +34,14 @@
 #include <QtWidgets>
 #include "qcan_defs.hpp"
 #include <qcan_interface_ixxat.hpp>
+#include "qcan_trace.hpp"
+
+
+//-------------------------------------------------------------------
+// time in milliseconds the receive thread waits for the receive
+// event, before it checks if it has to terminate
+//
+#define  IXXAT_RCV_EVENT_TIMEOUT    100
 
 
 /*----------------------------------------------------------------------------*\
@@ -48,7 +56,7 @@
 //----------------------------------------------------------------------------//
 QCanInterfaceIxxat::QCanInterfaceIxxat(VCIDEVICEINFO clDevInfoV)
 {
-   qDebug() << "QCanInterfaceIxxat::QCanInterfaceIxxat()";
+   qCanTrace(qcanTracePlugin) << "QCanInterfaceIxxat::QCanInterfaceIxxat()";
 
    if (!pclIxxatVciP.isAvailable())
    {
@@ -56,6 +64,9 @@ QCanInterfaceIxxat::QCanInterfaceIxxat(VCIDEVICEINFO clDevInfoV)
    }
 
    clDevInfoP = clDevInfoV;
+
+   pclRcvThreadP = new ReceiveThread(this);
+   ulRcvRunP.storeRelease(0);
 }
 
 //----------------------------------------------------------------------------//
@@ -64,7 +75,8 @@ QCanInterfaceIxxat::QCanInterfaceIxxat(VCIDEVICEINFO clDevInfoV)
 //----------------------------------------------------------------------------//
 QCanInterfaceIxxat::~QCanInterfaceIxxat()
 {
-
+   stopReceive();
+   delete (pclRcvThreadP);
 }
 
 //----------------------------------------------------------------------------//
@@ -104,10 +116,16 @@ bool QCanInterfaceIxxat::connected()
 QCanInterface::InterfaceError_e QCanInterfaceIxxat::disconnect()
 {
    HRESULT slStatusT;
+
+   //----------------------------------------------------------------
+   // the receive thread must not access the channel any more
+   //
+   stopReceive();
+
    slStatusT = pclIxxatVciP.pfnVciDeviceCloseP(vdCanInterfaceP);
    if (slStatusT != VCI_OK)
    {
-      qDebug() << "Fail to disconnect the device";
+      qCanTrace(qcanTracePlugin) << "Fail to disconnect the device";
    }
 
    btConnectedP = false;
@@ -158,13 +176,26 @@ QString QCanInterfaceIxxat::name()
 
 //----------------------------------------------------------------------------//
 // read()                                                                     //
-//                                                                            //
+// read next frame from the receive queue                                     //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e QCanInterfaceIxxat::read(QByteArray &clDataR)
+{
+   if (clRcvQueueP.pop(clDataR) == true)
+   {
+      return eERROR_NONE;
+   }
+
+   return eERROR_FIFO_RCV_EMPTY;
+}
+
+
+//----------------------------------------------------------------------------//
+// read()                                                                     //
+// read next frame from the receive queue                                     //
 //----------------------------------------------------------------------------//
 QCanInterface::InterfaceError_e QCanInterfaceIxxat::read(QCanFrame &clFrameR)
 {
-   CANMSG  tsCanMsgT;
-   HRESULT slResultT;
-   int32_t slByteCntrT;
+   QByteArray  clDataT;
 
    //----------------------------------------------------------------
    // check lib have been loaded
@@ -174,69 +205,174 @@ QCanInterface::InterfaceError_e QCanInterfaceIxxat::read(QCanFrame &clFrameR)
       return eERROR_LIBRARY;
    }
 
-   //----------------------------------------------------------------
-   // get next message in FIFO
-   //
-   slResultT = pclIxxatVciP.pfnCanChannelPeekMessageP(vdCanChannelP,&tsCanMsgT);
-
-   if (slResultT == VCI_OK)
+   while (clRcvQueueP.pop(clDataT) == true)
    {
-      // handle data depending on type
-      switch (tsCanMsgT.uMsgInfo.Bytes.bType)
+      if (clFrameR.fromByteArray(clDataT) == true)
       {
-         case CAN_MSGTYPE_DATA :
-            qDebug() << tr("handle CAN_MSGTYPE_DATA");
-
-            // copy all needed parameters to QCanFrame structure
-            if (tsCanMsgT.uMsgInfo.Bits.ext)
-            {
-               clFrameR.setIdentifier(tsCanMsgT.dwMsgId);
-            } else
-            {
-               clFrameR.setIdentifier((uint16_t)tsCanMsgT.dwMsgId);
-            }
+         return eERROR_NONE;
+      }
+   }
 
-            clFrameR.setDlc(tsCanMsgT.uMsgInfo.Bits.dlc);
+   return eERROR_FIFO_RCV_EMPTY;
+}
 
-            for (slByteCntrT = 0; slByteCntrT < clFrameR.dlc(); slByteCntrT++)
-            {
-               clFrameR.setData(slByteCntrT, tsCanMsgT.abData[slByteCntrT]);
-            }
 
-            clStatisticP.ulRcvCount++;
+//----------------------------------------------------------------------------//
+// readBatch()                                                                //
+// read several frames from the receive queue                                 //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e QCanInterfaceIxxat::readBatch(char * pchDataV,
+                                                              uint32_t ulFrameMaxV,
+                                                              uint32_t & ulFrameCntR)
+{
+   ulFrameCntR = clRcvQueueP.popBatch(pchDataV, ulFrameMaxV);
+   if (ulFrameCntR == 0)
+   {
+      return eERROR_FIFO_RCV_EMPTY;
+   }
 
-            return eERROR_NONE;
+   return eERROR_NONE;
+}
 
-            break;
 
-         case CAN_MSGTYPE_INFO :
-            qDebug() << tr("handle CAN_MSGTYPE_INFO");
-            break;
+//----------------------------------------------------------------------------//
+// readDevice()                                                               //
+// move messages from the CAN channel to the queue, called by receive thread  //
+//----------------------------------------------------------------------------//
+uint32_t QCanInterfaceIxxat::readDevice(void)
+{
+   CANMSG         atsCanMsgT[QCAN_IF_BATCH_SIZE];
+   CANMSG *       ptsCanMsgT;
+   HRESULT        slResultT;
+   UINT32         ulNumT;
+   uint32_t       ulMsgCntT;
+   uint32_t       ulFrameCntT = 0;
+   int32_t        slByteCntrT;
+   int32_t        slSizeT;
+   QCanFrame      clCanFrameT;
+   QCanTimeStamp  clTimeStampT;
+   char           achDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   do
+   {
+      //--------------------------------------------------------
+      // get up to QCAN_IF_BATCH_SIZE messages with one call
+      //
+      ulNumT = QCAN_IF_BATCH_SIZE;
+      slResultT = pclIxxatVciP.pfnCanChannelPeekMultipleMessagesP(vdCanChannelP,
+                                                                  &ulNumT,
+                                                                  &atsCanMsgT[0]);
+      if (slResultT != VCI_OK)
+      {
+         if (slResultT != (HRESULT)VCI_E_RXQUEUE_EMPTY)
+         {
+            qWarning() << "QCanInterface::readDevice() -> CanChannelPeekMultipleMessages()" <<
+                          "fail with error:" <<
+                          pclIxxatVciP.formatedError((HRESULT)slResultT);
+         }
+         break;
+      }
 
-         case CAN_MSGTYPE_ERROR :
-            qDebug() << tr("handle CAN_MSGTYPE_ERROR");
-            break;
+      //--------------------------------------------------------
+      // the messages are stamped on arrival in the receive
+      // thread, the time base is started by startReceive()
+      //
+      clTimeStampT.fromNanoSeconds((uint64_t) clRcvTimerP.nsecsElapsed());
 
-         case CAN_MSGTYPE_STATUS :
-            qDebug() << tr("handle CAN_MSGTYPE_STATUS");
-            break;
+      for (ulMsgCntT = 0; ulMsgCntT < ulNumT; ulMsgCntT++)
+      {
+         ptsCanMsgT = &atsCanMsgT[ulMsgCntT];
 
-         default :
-            qDebug() << tr("UNKNOWN Message Type");
-            break;
+         // handle data depending on type
+         switch (ptsCanMsgT->uMsgInfo.Bytes.bType)
+         {
+            case CAN_MSGTYPE_DATA :
+               // copy all needed parameters to QCanFrame structure
+               if (ptsCanMsgT->uMsgInfo.Bits.ext)
+               {
+                  clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_EXT);
+                  clCanFrameT.setIdentifier(ptsCanMsgT->dwMsgId);
+               } else
+               {
+                  clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_STD);
+                  clCanFrameT.setIdentifier((uint16_t)ptsCanMsgT->dwMsgId);
+               }
+
+               clCanFrameT.setRemote(ptsCanMsgT->uMsgInfo.Bits.rtr != 0);
+               clCanFrameT.setDlc(ptsCanMsgT->uMsgInfo.Bits.dlc);
+
+               for (slByteCntrT = 0; slByteCntrT < clCanFrameT.dataSize(); slByteCntrT++)
+               {
+                  clCanFrameT.setData(slByteCntrT, ptsCanMsgT->abData[slByteCntrT]);
+               }
+               clCanFrameT.setTimeStamp(clTimeStampT);
+
+               clStatisticP.ulRcvCount++;
+
+               //-----------------------------------------
+               // the frame is converted on the stack
+               //
+               slSizeT = clCanFrameT.toByteArray(&achDataT[0], QCAN_FRAME_ARRAY_SIZE);
+               if (clRcvQueueP.push(&achDataT[0], slSizeT) == true)
+               {
+                  ulFrameCntT++;
+               }
+               break;
+
+            case CAN_MSGTYPE_INFO :
+               qCanTraceLimited(qcanTraceReceive) << "handle CAN_MSGTYPE_INFO";
+               break;
+
+            case CAN_MSGTYPE_ERROR :
+               qCanTraceLimited(qcanTraceReceive) << "handle CAN_MSGTYPE_ERROR";
+               break;
+
+            case CAN_MSGTYPE_STATUS :
+               qCanTraceLimited(qcanTraceReceive) << "handle CAN_MSGTYPE_STATUS";
+               break;
+
+            default :
+               qCanTraceLimited(qcanTraceReceive) << "UNKNOWN Message Type";
+               break;
+         }
       }
-   }
 
-   else if (slResultT != (HRESULT)VCI_E_RXQUEUE_EMPTY)
+   } while (ulNumT == QCAN_IF_BATCH_SIZE);
+
+   return (ulFrameCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// runReceive()                                                               //
+// receive thread: move all frames from the CAN channel to the receive queue  //
+//----------------------------------------------------------------------------//
+void QCanInterfaceIxxat::runReceive(void)
+{
+   uint32_t          ulFrameCntT;
+
+   while (ulRcvRunP.loadAcquire() != 0)
    {
-      qWarning() << "QCanInterface::read() -> CanChannelPeekMessage()" <<
-                    "fail with error:" <<
-                    pclIxxatVciP.formatedError((HRESULT)slResultT);
-      return eERROR_DEVICE;
-   }
+      //--------------------------------------------------------
+      // wait for the receive event, the timeout is used to
+      // check if the thread has to terminate
+      //
+      if (pclIxxatVciP.pfnCanChannelWaitRxEventP(vdCanChannelP,
+                                                 IXXAT_RCV_EVENT_TIMEOUT) != VCI_OK)
+      {
+         continue;
+      }
 
+      //--------------------------------------------------------
+      // drain the FIFO of the CAN channel
+      //
+      ulFrameCntT = readDevice();
 
-   return eERROR_FIFO_RCV_EMPTY;
+      if (ulFrameCntT > 0)
+      {
+         emit framesReceived(ulFrameCntT);
+      }
+   }
 }
 
 
@@ -434,9 +570,11 @@ QCanInterface::InterfaceError_e	QCanInterfaceIxxat::setMode(const CAN_Mode_e teM
             qWarning() << tr("WARNING: Fail to activate CAN channel!");
          }
 
+         startReceive();
          break;
 
       case eCAN_MODE_STOP :
+         stopReceive();
          if (pclIxxatVciP.pfnCanChannelActivateP(vdCanChannelP,false) != VCI_OK)
          {
             qWarning() << tr("WARNING: Fail to deactivate CAN channel!");
@@ -452,6 +590,22 @@ QCanInterface::InterfaceError_e	QCanInterfaceIxxat::setMode(const CAN_Mode_e teM
 }
 
 
+//----------------------------------------------------------------------------//
+// startReceive()                                                             //
+// start the receive thread                                                   //
+//----------------------------------------------------------------------------//
+void QCanInterfaceIxxat::startReceive(void)
+{
+   if (pclRcvThreadP->isRunning() == false)
+   {
+      clRcvQueueP.clear();
+      clRcvTimerP.start();
+      ulRcvRunP.storeRelease(1);
+      pclRcvThreadP->start(QThread::TimeCriticalPriority);
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // state()                                                                    //
 //                                                                            //
@@ -470,10 +624,29 @@ QCanInterface::InterfaceError_e	QCanInterfaceIxxat::statistic(QCanStatistic_ts &
 {
    clStatisticR = clStatisticP;
 
+   //----------------------------------------------------------------
+   // frames lost due to a full receive queue are counted as errors
+   //
+   clStatisticR.ulErrCount += clRcvQueueP.overruns();
+
    return(eERROR_NONE);
 }
 
 
+//----------------------------------------------------------------------------//
+// stopReceive()                                                              //
+// stop the receive thread and wait until it has finished                     //
+//----------------------------------------------------------------------------//
+void QCanInterfaceIxxat::stopReceive(void)
+{
+   ulRcvRunP.storeRelease(0);
+   if (pclRcvThreadP->isRunning() == true)
+   {
+      pclRcvThreadP->wait();
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // supportedFeatures()                                                        //
 //                                                                            //
@@ -493,6 +666,42 @@ uint32_t QCanInterfaceIxxat::supportedFeatures()
 }
 
 
+//----------------------------------------------------------------------------//
+// setupMessage()                                                             //
+// copy a CAN frame to the message structure of the driver                    //
+//----------------------------------------------------------------------------//
+void QCanInterfaceIxxat::setupMessage(const QCanFrame &clFrameR,
+                                      CANMSG &tsCanMsgR)
+{
+   int32_t slByteCntrT;
+
+   tsCanMsgR.uMsgInfo.Bytes.bAccept = 0;
+   tsCanMsgR.uMsgInfo.Bytes.bAddFlags = 0;
+   tsCanMsgR.uMsgInfo.Bytes.bFlags = 0;
+   tsCanMsgR.uMsgInfo.Bytes.bType = 0;
+
+   // copy all needed parameters to QCanFrame structure
+   if (clFrameR.isExtended())
+   {
+      tsCanMsgR.uMsgInfo.Bits.ext = 1;
+   } else
+   {
+      tsCanMsgR.uMsgInfo.Bits.ext = 0;
+   }
+
+   tsCanMsgR.dwMsgId = clFrameR.identifier();
+
+   tsCanMsgR.uMsgInfo.Bits.dlc = clFrameR.dlc();
+
+   for (slByteCntrT = 0; slByteCntrT < clFrameR.dlc(); slByteCntrT++)
+   {
+      tsCanMsgR.abData[slByteCntrT] = clFrameR.data(slByteCntrT);
+   }
+   tsCanMsgR.uMsgInfo.Bytes.bType = CAN_MSGTYPE_DATA;
+   tsCanMsgR.dwTime = 0;
+}
+
+
 //----------------------------------------------------------------------------//
 // write()                                                                    //
 //                                                                            //
@@ -501,7 +710,6 @@ QCanInterface::InterfaceError_e	QCanInterfaceIxxat::write( const QCanFrame &clFr
 {
    CANMSG  tsCanMsgT;
    HRESULT slResultT;
-   int32_t slByteCntrT;
 
    //----------------------------------------------------------------
    // check lib have been loaded
@@ -514,46 +722,90 @@ QCanInterface::InterfaceError_e	QCanInterfaceIxxat::write( const QCanFrame &clFr
    //----------------------------------------------------------------
    // prepare CAN message
    //
-   tsCanMsgT.uMsgInfo.Bytes.bAccept = 0;
-   tsCanMsgT.uMsgInfo.Bytes.bAddFlags = 0;
-   tsCanMsgT.uMsgInfo.Bytes.bFlags = 0;
-   tsCanMsgT.uMsgInfo.Bytes.bType = 0;
+   setupMessage(clFrameR, tsCanMsgT);
+   slResultT = pclIxxatVciP.pfnCanChannelPostMessageP(vdCanChannelP, &tsCanMsgT);
 
-   // copy all needed parameters to QCanFrame structure
-   if (clFrameR.isExtended())
+   if (slResultT == VCI_OK)
    {
-      tsCanMsgT.uMsgInfo.Bits.ext = 1;
-   } else
+      clStatisticP.ulTrmCount++;
+      return eERROR_NONE;
+   }
+   else if (slResultT != (HRESULT)VCI_E_TXQUEUE_FULL)
    {
-      tsCanMsgT.uMsgInfo.Bits.ext = 0;
+      qWarning() << tr("Fail to call pfnCanChannelPostMessageP(): ") + QString::number(slResultT,16);
+      return eERROR_DEVICE;
    }
 
-   tsCanMsgT.dwMsgId = clFrameR.identifier();
+   return eERROR_FIFO_TRM_FULL;
 
-   tsCanMsgT.uMsgInfo.Bits.dlc = clFrameR.dlc();
+}
 
-   for (slByteCntrT = 0; slByteCntrT < clFrameR.dlc(); slByteCntrT++)
+
+//----------------------------------------------------------------------------//
+// writeBatch()                                                               //
+// post several messages with one driver call                                 //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e	QCanInterfaceIxxat::writeBatch(const QCanFrame * pclFrameV,
+                                                               uint32_t ulFrameCntV,
+                                                               uint32_t & ulWrittenR)
+{
+   CANMSG   atsCanMsgT[QCAN_IF_BATCH_SIZE];
+   HRESULT  slResultT = VCI_OK;
+   UINT32   ulNumT;
+   uint32_t ulMsgCntT;
+
+   ulWrittenR = 0;
+
+   //----------------------------------------------------------------
+   // check lib have been loaded
+   //
+   if (!pclIxxatVciP.isAvailable())
    {
-      tsCanMsgT.abData[slByteCntrT] = clFrameR.data(slByteCntrT);
+      return eERROR_LIBRARY;
    }
-   tsCanMsgT.uMsgInfo.Bytes.bType = CAN_MSGTYPE_DATA;
-   tsCanMsgT.dwTime = 0;
-   slResultT = pclIxxatVciP.pfnCanChannelPostMessageP(vdCanChannelP, &tsCanMsgT);
 
-   if (slResultT == VCI_OK)
+   while (ulWrittenR < ulFrameCntV)
    {
-      qDebug() << tr("PosMessage() OK");
+      //--------------------------------------------------------
+      // prepare up to QCAN_IF_BATCH_SIZE messages
+      //
+      ulNumT = qMin(ulFrameCntV - ulWrittenR, (uint32_t) QCAN_IF_BATCH_SIZE);
+      for (ulMsgCntT = 0; ulMsgCntT < ulNumT; ulMsgCntT++)
+      {
+         setupMessage(pclFrameV[ulWrittenR + ulMsgCntT], atsCanMsgT[ulMsgCntT]);
+      }
 
-      clStatisticP.ulTrmCount++;
+      //--------------------------------------------------------
+      // the driver returns the number of messages which have
+      // been placed into the transmit FIFO
+      //
+      ulMsgCntT = ulNumT;
+      slResultT = pclIxxatVciP.pfnCanChannelPostMultipleMessagesP(vdCanChannelP,
+                                                                  &ulNumT,
+                                                                  &atsCanMsgT[0]);
+      if (ulNumT > ulMsgCntT)
+      {
+         ulNumT = ulMsgCntT;
+      }
+      ulWrittenR += ulNumT;
+      clStatisticP.ulTrmCount += ulNumT;
+
+      if ((slResultT != VCI_OK) || (ulNumT < ulMsgCntT))
+      {
+         break;
+      }
+   }
+
+   if (ulWrittenR == ulFrameCntV)
+   {
       return eERROR_NONE;
    }
-   else if (slResultT != (HRESULT)VCI_E_TXQUEUE_FULL)
+
+   if ((slResultT != VCI_OK) && (slResultT != (HRESULT)VCI_E_TXQUEUE_FULL))
    {
-      qWarning() << tr("Fail to call pfnCanChannelPostMessageP(): ") + QString::number(slResultT,16);
+      qWarning() << tr("Fail to call pfnCanChannelPostMultipleMessagesP(): ") + QString::number(slResultT,16);
       return eERROR_DEVICE;
    }
 
    return eERROR_FIFO_TRM_FULL;
-
 }
-
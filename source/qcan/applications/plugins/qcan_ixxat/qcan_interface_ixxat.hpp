@@ -39,7 +39,11 @@
 #include <QtPlugin>
 #include <QLibrary>
 #include <QVector>
+#include <QThread>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
 #include <QCanInterface>
+#include "qcan_frame_queue.hpp"
 #include "qcan_ixxat_vci.hpp"
 
 
@@ -54,6 +58,24 @@ class QCanInterfaceIxxat : public QCanInterface
 
 private:
 
+   //----------------------------------------------------------------
+   // The receive thread blocks on the receive event of the CAN
+   // channel and moves all frames into clRcvQueueP, which is
+   // drained by read().
+   //
+   class ReceiveThread : public QThread
+   {
+   public:
+      ReceiveThread(QCanInterfaceIxxat * pclInterfaceV) :
+         pclInterfaceP(pclInterfaceV) { };
+
+   protected:
+      void run() Q_DECL_OVERRIDE { pclInterfaceP->runReceive(); };
+
+   private:
+      QCanInterfaceIxxat * pclInterfaceP;
+   };
+
    /*!
     * \brief clCanLibP
     */
@@ -102,6 +124,22 @@ private:
     */
    QCanStatistic_ts clStatisticP;
 
+   /*!
+    * \brief clRcvQueueP
+    * Frames read by the receive thread
+    */
+   QCanFrameQueue    clRcvQueueP;
+
+   ReceiveThread *   pclRcvThreadP;
+
+   QAtomicInteger<uint32_t>   ulRcvRunP;
+
+   /*!
+    * \brief clRcvTimerP
+    * Time base for the time-stamp of received frames
+    */
+   QElapsedTimer     clRcvTimerP;
+
    uint8_t ubChannelP;
 
    bool     btConnectedP = false;
@@ -113,6 +151,23 @@ private:
    //
    QCanIxxatVci &pclIxxatVciP = QCanIxxatVci::getInstance();
 
+   /*!
+    * \brief readDevice
+    * \return
+    *
+    * Move all messages from the CAN channel into the receive queue,
+    * this function is called by the receive thread only
+    */
+   uint32_t          readDevice(void);
+
+   void              runReceive(void);
+
+   void              setupMessage(const QCanFrame &clFrameR, CANMSG &tsCanMsgR);
+
+   void              startReceive(void);
+
+   void              stopReceive(void);
+
 public:
 
    QCanInterfaceIxxat(VCIDEVICEINFO clDevInfoV);
@@ -128,8 +183,13 @@ public:
 
    QString           name(void) Q_DECL_OVERRIDE;
 
+   InterfaceError_e  read( QByteArray &clDataR) Q_DECL_OVERRIDE;
+
    InterfaceError_e  read( QCanFrame &clFrameR) Q_DECL_OVERRIDE;
 
+   InterfaceError_e  readBatch(char * pchDataV, uint32_t ulFrameMaxV,
+                               uint32_t & ulFrameCntR) Q_DECL_OVERRIDE;
+
    InterfaceError_e  setBitrate( int32_t slBitrateV,
                                  int32_t slBrsClockV) Q_DECL_OVERRIDE;
 
@@ -143,6 +203,10 @@ public:
 
    InterfaceError_e  write(const QCanFrame &clFrameR) Q_DECL_OVERRIDE;
 
+   InterfaceError_e  writeBatch(const QCanFrame * pclFrameV,
+                                uint32_t ulFrameCntV,
+                                uint32_t & ulWrittenR) Q_DECL_OVERRIDE;
+
 Q_SIGNALS:
     void errorOccurred(int32_t slCanBusErrorV);
 };
@@ -101,11 +101,13 @@ VPATH += ./../../../../canpie-fd
 HEADERS =   qcan_frame_api.hpp      \
             qcan_frame_error.hpp    \
             qcan_frame.hpp          \
+            qcan_frame_queue.hpp    \
             qcan_interface.hpp      \
             qcan_interface_ixxat.hpp\
             qcan_ixxat_vci.hpp      \
             qcan_plugin.hpp         \
-            qcan_plugin_ixxat.hpp
+            qcan_plugin_ixxat.hpp   \
+            qcan_trace.hpp
 
 
 #---------------------------------------------------------------
@@ -118,9 +120,11 @@ SOURCES =   canpie_frame_api.cpp    \
             qcan_frame_api.cpp      \
             qcan_frame_error.cpp    \
             qcan_frame.cpp          \
+            qcan_frame_queue.cpp    \
             qcan_interface_ixxat.cpp\
             qcan_ixxat_vci.cpp      \
-            qcan_plugin_ixxat.cpp
+            qcan_plugin_ixxat.cpp   \
+            qcan_trace.cpp
 
 EXAMPLE_FILES = plugin.json
 
@@ -32,6 +32,7 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 #include "qcan_ixxat_vci.hpp"
+#include "qcan_trace.hpp"
 
 
 /*----------------------------------------------------------------------------*\
@@ -191,7 +192,7 @@ QCanIxxatVci::QCanIxxatVci()
 //----------------------------------------------------------------------------//
 QCanIxxatVci::~QCanIxxatVci()
 {
-   qDebug() << "QCanIxxatVci::~QCanIxxatVci()";
+   qCanTrace(qcanTracePlugin) << "QCanIxxatVci::~QCanIxxatVci()";
 
    btLibFuncLoadP = false;
 
@@ -32,6 +32,7 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 #include "qcan_plugin_ixxat.hpp"
+#include "qcan_trace.hpp"
 
 
 /*----------------------------------------------------------------------------*\
@@ -46,7 +47,7 @@
 //----------------------------------------------------------------------------//
 QCanPluginIxxat::QCanPluginIxxat()
 {
-   qDebug() << "QCanPluginIxxat::QCanPluginIxxat()";
+   qCanTrace(qcanTracePlugin) << "QCanPluginIxxat::QCanPluginIxxat()";
 
    //----------------------------------------------------------------
    // check PCAN Basic lib is available
@@ -63,7 +64,7 @@ QCanPluginIxxat::QCanPluginIxxat()
 //----------------------------------------------------------------------------//
 QCanPluginIxxat::~QCanPluginIxxat()
 {
-   qDebug() << "QCanPluginIxxat::~QCanPluginIxxat()";
+   qCanTrace(qcanTracePlugin) << "QCanPluginIxxat::~QCanPluginIxxat()";
 }
 
 //----------------------------------------------------------------------------//
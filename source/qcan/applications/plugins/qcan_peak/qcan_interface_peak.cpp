@@ -27,6 +27,18 @@
 //============================================================================//
 
 #include "qcan_interface_peak.hpp"
+#include "qcan_trace.hpp"
+
+#ifndef  Q_OS_WIN32
+#include <sys/select.h>
+#endif
+
+
+//-------------------------------------------------------------------
+// time in milliseconds the receive thread waits for the receive
+// event, before it checks if it has to terminate
+//
+#define  PEAK_RCV_EVENT_TIMEOUT     100
 
 
 //----------------------------------------------------------------------------//
@@ -48,6 +60,9 @@ QCanInterfacePeak::QCanInterfacePeak(uint16_t uwPCanChannelV)
 
    btConnectedP = false;
    btFdUsedP = false;
+
+   pclRcvThreadP = new ReceiveThread(this);
+   ulRcvRunP.storeRelease(0);
 }
 
 //----------------------------------------------------------------------------//
@@ -56,7 +71,10 @@ QCanInterfacePeak::QCanInterfacePeak(uint16_t uwPCanChannelV)
 //----------------------------------------------------------------------------//
 QCanInterfacePeak::~QCanInterfacePeak()
 {
-   qDebug() << "QCanInterfacePeak::~QCanInterfacePeak()";
+   qCanTrace(qcanTracePlugin) << "QCanInterfacePeak::~QCanInterfacePeak()";
+
+   stopReceive();
+   delete (pclRcvThreadP);
 
    if (pclPcanBasicP.isAvailable())
    {
@@ -76,6 +94,7 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::connect(void)
       if (tsStatusT == PCAN_ERROR_OK)
       {
          btConnectedP = true;
+         startReceive();
          return eERROR_NONE;
       }
 
@@ -107,6 +126,11 @@ bool QCanInterfacePeak::connected(void)
 //----------------------------------------------------------------------------//
 QCanInterface::InterfaceError_e QCanInterfacePeak::disconnect()
 {
+   //----------------------------------------------------------------
+   // the receive thread must not access the channel any more
+   //
+   stopReceive();
+
    if (pclPcanBasicP.isAvailable())
    {
       TPCANStatus tsStatusT = pclPcanBasicP.unInitialize(uwPCanChannelP);
@@ -139,7 +163,7 @@ QIcon QCanInterfacePeak::icon(void)
          clIconNameT.replace(QString("-"),QString("_"));
          clIconNameT.replace(QString(" "),QString("_"));
 
-         qDebug() <<QString("QCanInterfacePeak::icon(0x" +QString::number(uwPCanChannelP,16)+")") << QString(":/images/"+clIconNameT+".png");
+         qCanTrace(qcanTracePlugin) <<QString("QCanInterfacePeak::icon(0x" +QString::number(uwPCanChannelP,16)+")") << QString(":/images/"+clIconNameT+".png");
 
          return QIcon(QString(":/images/"+clIconNameT+".png"));
 
@@ -181,134 +205,135 @@ QString QCanInterfacePeak::name()
 
 //----------------------------------------------------------------------------//
 // read()                                                                     //
-//                                                                            //
+// read next frame from the receive queue                                     //
 //----------------------------------------------------------------------------//
 QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QCanFrame &clFrameR)
 {
+   QByteArray  clDataT;
+
    if (!pclPcanBasicP.isAvailable())
    {
       return eERROR_LIBRARY;
    }
 
    //----------------------------------------------------------------
-   // check channel have been connected
+   // error frames are not returned by this function
    //
-   #if QCAN_SUPPORT_CAN_FD > 0
-   if (btFdUsedP == true)
+   while (clRcvQueueP.pop(clDataT) == true)
    {
-      return readFD(clFrameR);
+      if (clFrameR.fromByteArray(clDataT) == true)
+      {
+         return eERROR_NONE;
+      }
    }
-   #endif
 
-   return readCAN(clFrameR);
+   return eERROR_FIFO_RCV_EMPTY;
 }
 
 //----------------------------------------------------------------------------//
-// readCAN()                                                                  //
-//                                                                            //
+// read()                                                                     //
+// read next frame from the receive queue                                     //
 //----------------------------------------------------------------------------//
-QCanInterface::InterfaceError_e  QCanInterfacePeak::readCAN(QCanFrame &clFrameR)
+QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
 {
-   TPCANStatus    ulStatusT;
-   uint8_t        ubByteCntrT;
-   TPCANMsg       tsCanMsgT;
-   TPCANTimestamp tsTimestampBufferT;
-
-   //----------------------------------------------------------------
-   // get next message from FIFO
-   //
-   ulStatusT = pclPcanBasicP.read(uwPCanChannelP, &tsCanMsgT, 
-                                  &tsTimestampBufferT);
-
-   /*
-   if (ulStatusT == PCAN_ERROR_OK)
+   if (clRcvQueueP.pop(clDataR) == true)
    {
-      //--------------------------------------------------------
-      // handle data depending on type
-      //
-      if ((tsCanMsgT.MSGTYPE == PCAN_MESSAGE_STANDARD) ||
-          ((tsCanMsgT.MSGTYPE & (PCAN_MESSAGE_RTR | PCAN_MESSAGE_EXTENDED)) != 0))
-      {
-         //---------------------------------------------
-         // copy all values to QCanFrame structure
-         //
-         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
-         {
-            clFrameR.setFrameType(QCanFrame::eTYPE_CAN_EXT);
-         }
-         else
-         {
-            clFrameR.setFrameType(QCanFrame::eTYPE_CAN_STD);
-         }
-         clFrameR.setIdentifier(tsCanMsgT.ID);
-
-         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_RTR)
-         {
-            clFrameR.setRemote(true);
-         }
-         else
-         {
-            clFrameR.setRemote(false);
-         }
-
-         clFrameR.setDlc(tsCanMsgT.LEN);
-
-         for (ubByteCntrT = 0; ubByteCntrT < clFrameR.dataSize(); ubByteCntrT++)
-         {
-            clFrameR.setData(ubByteCntrT, tsCanMsgT.DATA[ubByteCntrT]);
-         }
-
-         clStatisticP.ulRcvCount++;
-
-      } else if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_STATUS)
-      {
-         qDebug() << "PCAN_MESSAGE_STATUS Message Type [hex]:" << QString::number(tsCanMsgT.MSGTYPE,16);
-      } else
-      {
-         qDebug() << "UNKNOWN Message Type [hex]:" << QString::number(tsCanMsgT.MSGTYPE,16);
-      }
-
       return eERROR_NONE;
    }
 
-
-   else if ((ulStatusT & (TPCANStatus)PCAN_ERROR_ANYBUSERR) != 0)
-   {
-      setupErroFrame(ulStatusT, clFrameR);
-
-      return eERROR_NONE;
-   }
+   return eERROR_FIFO_RCV_EMPTY;
+}
 
 
-   else if (ulStatusT != (TPCANStatus)PCAN_ERROR_QRCVEMPTY)
+//----------------------------------------------------------------------------//
+// readBatch()                                                                //
+// read several frames from the receive queue                                 //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e  QCanInterfacePeak::readBatch(char * pchDataV,
+                                                              uint32_t ulFrameMaxV,
+                                                              uint32_t & ulFrameCntR)
+{
+   ulFrameCntR = clRcvQueueP.popBatch(pchDataV, ulFrameMaxV);
+   if (ulFrameCntR == 0)
    {
-      qWarning() << "Fail to call CAN_Read():" + QString::number(ulStatusT,16);
-      return eERROR_DEVICE;
+      return eERROR_FIFO_RCV_EMPTY;
    }
-   */
-   
-   return eERROR_FIFO_RCV_EMPTY;
+
+   return eERROR_NONE;
 }
 
-QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
+
+//----------------------------------------------------------------------------//
+// readDevice()                                                               //
+// read next message from the driver, called by the receive thread            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e  QCanInterfacePeak::readDevice(QByteArray &clDataR,
+                                                                bool &btStatusR)
 {
    TPCANStatus       ulStatusT;
    uint8_t           ubCntT;
+   uint8_t           ubMsgTypeT;
+   uint8_t           ubDlcT;
+   uint32_t          ulIdentifierT;
+   const uint8_t *   pubDataT;
    TPCANMsg          tsCanMsgT;
    TPCANTimestamp    tsCanTimeStampT;
-   uint32_t          ulMicroSecsT;
+   #if QCAN_SUPPORT_CAN_FD > 0
+   TPCANMsgFD        tsCanMsgFdT;
+   TPCANTimestampFD  uqCanTimeStampFdT;
+   #endif
+   uint64_t          uqMicroSecsT;
    QCanFrame         clCanFrameT;
    QCanFrameError    clErrFrameT;
    QCanTimeStamp     clTimeStampT;
    InterfaceError_e  clRetValueT = eERROR_NONE;
    
    //----------------------------------------------------------------
-   // get next message from FIFO
+   // get next message from FIFO, a channel which is initialised
+   // for CAN FD only delivers messages by CAN_ReadFD()
    //
-   ulStatusT = pclPcanBasicP.read(uwPCanChannelP, &tsCanMsgT, 
-                                  &tsCanTimeStampT);
+   #if QCAN_SUPPORT_CAN_FD > 0
+   if (btFdUsedP == true)
+   {
+      ulStatusT = pclPcanBasicP.readFD(uwPCanChannelP, &tsCanMsgFdT, 
+                                       &uqCanTimeStampFdT);
+      ubMsgTypeT    = tsCanMsgFdT.MSGTYPE;
+      ulIdentifierT = tsCanMsgFdT.ID;
+      ubDlcT        = tsCanMsgFdT.DLC;
+      pubDataT      = &tsCanMsgFdT.DATA[0];
+
+      //--------------------------------------------------------
+      // the time-stamp of CAN_ReadFD() is a multiple of 1 us
+      //
+      uqMicroSecsT  = uqCanTimeStampFdT;
+   }
+   else
+   #endif
+   {
+      ulStatusT = pclPcanBasicP.read(uwPCanChannelP, &tsCanMsgT, 
+                                     &tsCanTimeStampT);
+      ubMsgTypeT    = tsCanMsgT.MSGTYPE;
+      ulIdentifierT = tsCanMsgT.ID;
+      ubDlcT        = tsCanMsgT.LEN;
+      pubDataT      = &tsCanMsgT.DATA[0];
+
+      //--------------------------------------------------------
+      // the millisecond counter of the driver is extended by
+      // its overflow counter to 48 bit, so the value does not
+      // wrap
+      //
+      uqMicroSecsT  = ((uint64_t) tsCanTimeStampT.millis_overflow) << 32;
+      uqMicroSecsT  = uqMicroSecsT + tsCanTimeStampT.millis;
+      uqMicroSecsT  = uqMicroSecsT * 1000ULL;
+      uqMicroSecsT  = uqMicroSecsT + tsCanTimeStampT.micros;
+   }
+
+   //----------------------------------------------------------------
+   // no data is returned for a status message
+   //
+   clDataR.clear();
+   btStatusR = false;
 
-   
    //----------------------------------------------------------------
    // read message structure 
    //
@@ -317,7 +342,7 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
       //--------------------------------------------------------
       // handle data depending on type
       //
-      if((tsCanMsgT.MSGTYPE & PCAN_MESSAGE_STATUS) > 0)
+      if((ubMsgTypeT & PCAN_MESSAGE_STATUS) > 0)
       {
          //------------------------------------------------
          // this is a status message
@@ -328,13 +353,13 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
          //------------------------------------------------
          // this is a CAN message
          //
-         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_FD)
+         if (ubMsgTypeT & PCAN_MESSAGE_FD)
          {
             //----------------------------------------
             // ISO CAN FD frame with standard or
             // extended identifier
             //
-            if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
+            if (ubMsgTypeT & PCAN_MESSAGE_EXTENDED)
             {
                clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_FD_EXT);
             }
@@ -342,6 +367,12 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
             {
                clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_FD_STD);
             }
+
+            #if QCAN_SUPPORT_CAN_FD > 0
+            clCanFrameT.setBitrateSwitch((ubMsgTypeT & PCAN_MESSAGE_BRS) > 0);
+            clCanFrameT.setErrorStateIndicator((ubMsgTypeT & 
+                                                PCAN_MESSAGE_ESI) > 0);
+            #endif
          }
          else
          {
@@ -349,7 +380,7 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
             // Classical CAN frame with standard or
             // extended identifier
             //
-            if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
+            if (ubMsgTypeT & PCAN_MESSAGE_EXTENDED)
             {
                clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_EXT);
             }
@@ -361,7 +392,7 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
             //----------------------------------------
             // Classical CAN remote frame 
             //
-            if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_RTR)
+            if (ubMsgTypeT & PCAN_MESSAGE_RTR)
             {
                clCanFrameT.setRemote(true);
             }
@@ -374,29 +405,26 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
          //------------------------------------------------
          // copy the identifier
          //
-         clCanFrameT.setIdentifier(tsCanMsgT.ID);
+         clCanFrameT.setIdentifier(ulIdentifierT);
 
          //------------------------------------------------
          // copy the DLC
          //
-         clCanFrameT.setDlc(tsCanMsgT.LEN);
+         clCanFrameT.setDlc(ubDlcT);
 
          //------------------------------------------------
          // copy the data
          //
          for (ubCntT = 0; ubCntT < clCanFrameT.dataSize(); ubCntT++)
          {
-            clCanFrameT.setData(ubCntT, tsCanMsgT.DATA[ubCntT]);
+            clCanFrameT.setData(ubCntT, pubDataT[ubCntT]);
          }
 
          //------------------------------------------------
-         // copy the time-stamp
-         // the value is a multiple of 1 us and has a
-         // total time span of 4294,9 secs 
+         // copy the time-stamp, the value is a multiple
+         // of 1 us
          //
-         ulMicroSecsT = tsCanTimeStampT.millis * 1000;
-         ulMicroSecsT = ulMicroSecsT + tsCanTimeStampT.micros;
-         clTimeStampT.fromMicroSeconds(ulMicroSecsT);
+         clTimeStampT.fromMicroSeconds(uqMicroSecsT);
          
          clCanFrameT.setTimeStamp(clTimeStampT);
          
@@ -423,6 +451,11 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
          // copy the error frame to a byte array 
          //
          clDataR = clErrFrameT.toByteArray();
+         btStatusR = true;
+      }
+      else if (ulStatusT == (TPCANStatus) PCAN_ERROR_QRCVEMPTY)
+      {
+         clRetValueT = eERROR_FIFO_RCV_EMPTY;
       }
       else
       {
@@ -435,99 +468,126 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
 
 
 //----------------------------------------------------------------------------//
-// readFD()                                                                   //
-//                                                                            //
+// runReceive()                                                               //
+// receive thread: move all frames from the driver to the receive queue       //
 //----------------------------------------------------------------------------//
-#if QCAN_SUPPORT_CAN_FD > 0
-QCanInterface::InterfaceError_e  QCanInterfacePeak::readFD(QCanFrame &clFrameR)
+void QCanInterfacePeak::runReceive(void)
 {
-   TPCANStatus    ulStatusT;
-   uint8_t        ubByteCntrT;
-   TPCANMsgFD     tsCanMsgFdT;
-   TPCANTimestampFD tsTimestampBufferFdT;
+   QByteArray        clDataT;
+   InterfaceError_e  teResultT;
+   uint32_t          ulFrameCntT;
+   uint32_t          ulReadCntT;
+   bool              btStatusT;
+   #ifdef   Q_OS_WIN32
+   HANDLE            hRcvEventT;
+   #else
+   int               slRcvEventT = -1;
+   fd_set            tsFdSetT;
+   struct timeval    tsTimeOutT;
+   #endif
 
    //----------------------------------------------------------------
-   // get next message from FIFO
+   // register the receive event at the driver, the event is
+   // signaled as soon as a message is placed into the FIFO
+   //
+   #ifdef   Q_OS_WIN32
+   hRcvEventT = CreateEvent(NULL, FALSE, FALSE, NULL);
+   if (pclPcanBasicP.setValue(uwPCanChannelP, PCAN_RECEIVE_EVENT,
+                              &hRcvEventT, sizeof(hRcvEventT)) != PCAN_ERROR_OK)
+   {
+      qWarning() << "QCanInterfacePeak::runReceive(): fail to set receive event";
+   }
+   #else
+   //----------------------------------------------------------------
+   // on macOS and Linux the driver provides a file descriptor,
+   // which becomes readable as soon as a message is received
    //
-   ulStatusT = pclPcanBasicP.readFD(uwPCanChannelP, &tsCanMsgFdT, &tsTimestampBufferFdT);
+   if (pclPcanBasicP.getValue(uwPCanChannelP, PCAN_RECEIVE_EVENT,
+                              &slRcvEventT, sizeof(slRcvEventT)) != PCAN_ERROR_OK)
+   {
+      qWarning() << "QCanInterfacePeak::runReceive(): fail to get receive event";
+   }
+   #endif
 
-   if (ulStatusT == PCAN_ERROR_OK)
+   ulReadCntT = 0;
+   while (ulRcvRunP.loadAcquire() != 0)
    {
       //--------------------------------------------------------
-      // handle data depending on type
+      // wait for the receive event, the timeout is used to
+      // check if the thread has to terminate. After a full
+      // batch the FIFO is read again without waiting.
       //
-      if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_FD)
+      if (ulReadCntT < QCAN_IF_BATCH_SIZE)
       {
-         //---------------------------------------------
-         // copy all values to QCanFrame structure
-         //
-         if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
+         #ifdef   Q_OS_WIN32
+         WaitForSingleObject(hRcvEventT, PEAK_RCV_EVENT_TIMEOUT);
+         #else
+         if (slRcvEventT >= 0)
          {
-            clFrameR.setFrameType(QCanFrame::eTYPE_FD_EXT);
+            FD_ZERO(&tsFdSetT);
+            FD_SET(slRcvEventT, &tsFdSetT);
+            tsTimeOutT.tv_sec  = 0;
+            tsTimeOutT.tv_usec = PEAK_RCV_EVENT_TIMEOUT * 1000;
+            select(slRcvEventT + 1, &tsFdSetT, NULL, NULL, &tsTimeOutT);
          }
          else
          {
-            clFrameR.setFrameType(QCanFrame::eTYPE_FD_STD);
+            QThread::msleep(1);
          }
-         clFrameR.setIdentifier(tsCanMsgFdT.ID);
+         #endif
+      }
 
-         if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_RTR)
-         {
-            clFrameR.setRemote(true);
-         } else
+      //--------------------------------------------------------
+      // drain the FIFO of the driver, the time-stamp of each
+      // frame has been taken by the driver on arrival. The driver
+      // reports a bus error also while its FIFO is empty, hence
+      // the pass ends with an error frame. At most one batch is
+      // read per pass, so a request to stop is not delayed.
+      //
+      ulFrameCntT = 0;
+      for (ulReadCntT = 0; ulReadCntT < QCAN_IF_BATCH_SIZE; ulReadCntT++)
+      {
+         if (ulRcvRunP.loadAcquire() == 0)
          {
-            clFrameR.setRemote(false);
+            break;
          }
 
-         if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_BRS)
+         teResultT = readDevice(clDataT, btStatusT);
+         if (teResultT != eERROR_NONE)
          {
-            //! \todo Set BRS Flag of the QCanFrame
-         } else
-         {
-            //! \todo Clear BRS Flag of the QCanFrame
+            break;
          }
 
-         clFrameR.setDlc(tsCanMsgFdT.DLC);
-
-         for (ubByteCntrT = 0; ubByteCntrT < clFrameR.dataSize(); ubByteCntrT++)
+         if (clDataT.isEmpty() == false)
          {
-            clFrameR.setData(ubByteCntrT, tsCanMsgFdT.DATA[ubByteCntrT]);
+            if (clRcvQueueP.push(clDataT) == true)
+            {
+               ulFrameCntT++;
+            }
          }
 
-         clStatisticP.ulRcvCount++;
-
-      } else if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_ESI)
-      {
-         qDebug() << "PCAN_MESSAGE_ESI Message Type [hex]:" << QString::number(tsCanMsgFdT.MSGTYPE,16);
+         if (btStatusT == true)
+         {
+            break;
+         }
+      }
 
-      } else if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_STATUS)
+      if (ulFrameCntT > 0)
       {
-         qDebug() << "PCAN_MESSAGE_STATUS Message Type [hex]:" << QString::number(tsCanMsgFdT.MSGTYPE,16);
-      } else
-      {
-         qDebug() << "UNKNOWN Message Type [hex]:" << QString::number(tsCanMsgFdT.MSGTYPE,16);
+         emit framesReceived(ulFrameCntT);
       }
-
-      return eERROR_NONE;
    }
-   
-   else if ((ulStatusT & (TPCANStatus)PCAN_ERROR_ANYBUSERR) != 0)
-   {
-      setupErroFrame(ulStatusT, clFrameR);
-
-      return eERROR_NONE;
-   }
-   
-   else if (ulStatusT != (TPCANStatus)PCAN_ERROR_QRCVEMPTY)
-   {
-      qWarning() << "Fail to call CAN_ReadFD():" << QString::number(ulStatusT,16);
-      return eERROR_DEVICE;
-   }
-
-   return eERROR_FIFO_RCV_EMPTY;
 
+   //----------------------------------------------------------------
+   // remove the receive event from the driver
+   //
+   #ifdef   Q_OS_WIN32
+   HANDLE   hNoEventT = NULL;
+   pclPcanBasicP.setValue(uwPCanChannelP, PCAN_RECEIVE_EVENT,
+                          &hNoEventT, sizeof(hNoEventT));
+   CloseHandle(hRcvEventT);
+   #endif
 }
-#endif
 
 
 //----------------------------------------------------------------------------//
@@ -696,14 +756,17 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::setBitrate( int32_t slNomBitR
    }
 
    //----------------------------------------------------------------
-   // perform initalisation CAN Interface
+   // perform initalisation CAN Interface, the receive thread must
+   // not access the channel meanwhile: it reads the FD mode and the
+   // receive event is registered again for the new channel
    //
+   stopReceive();
    pclPcanBasicP.unInitialize(uwPCanChannelP);
 
    if (slDatBitRateV != eCAN_BITRATE_NONE)
    {
 
-      qDebug() << QString("QCanInterfacePeak::setBitrate(0x" +QString::number(uwPCanChannelP,16)+")") << " : FD Mode with bitrate adapting";
+      qCanTrace(qcanTracePlugin) << QString("QCanInterfacePeak::setBitrate(0x" +QString::number(uwPCanChannelP,16)+")") << " : FD Mode with bitrate adapting";
 
       #if QCAN_SUPPORT_CAN_FD > 0
       uint8_t ubValueBufT = PCAN_PARAMETER_ON;
@@ -721,7 +784,7 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::setBitrate( int32_t slNomBitR
    }
    else
    {
-      qDebug() << QString("QCanInterfacePeak::setBitrate(0x" +QString::number(uwPCanChannelP,16)+")") << " : Standard Mode";
+      qCanTrace(qcanTracePlugin) << QString("QCanInterfacePeak::setBitrate(0x" +QString::number(uwPCanChannelP,16)+")") << " : Standard Mode";
       ulStatusT = pclPcanBasicP.initialize(uwPCanChannelP, uwBtr0Btr1T, 0, 0, 0);
       btFdUsedP = false;
    }
@@ -734,6 +797,11 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::setBitrate( int32_t slNomBitR
       return eERROR_DEVICE;
    }
 
+   if (btConnectedP == true)
+   {
+      startReceive();
+   }
+
    return eERROR_NONE;
 }
 
@@ -820,6 +888,21 @@ void QCanInterfacePeak::setupErrorFrame(TPCANStatus ulStatusV,
 }
 
 
+//----------------------------------------------------------------------------//
+// startReceive()                                                             //
+// start the receive thread                                                   //
+//----------------------------------------------------------------------------//
+void QCanInterfacePeak::startReceive(void)
+{
+   if (pclRcvThreadP->isRunning() == false)
+   {
+      clRcvQueueP.clear();
+      ulRcvRunP.storeRelease(1);
+      pclRcvThreadP->start(QThread::TimeCriticalPriority);
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // state()                                                                    //
 //                                                                            //
@@ -837,14 +920,32 @@ CAN_State_e	QCanInterfacePeak::state()
 //----------------------------------------------------------------------------//
 QCanInterface::InterfaceError_e	QCanInterfacePeak::statistic(QCanStatistic_ts &clStatisticR)
 {
-   //! \todo
+   clStatisticR.ulRcvCount = clStatisticP.ulRcvCount;
+   clStatisticR.ulTrmCount = clStatisticP.ulTrmCount;
 
-   clStatisticR.ulErrCount = 0;
+   //----------------------------------------------------------------
+   // frames lost due to a full receive queue are counted as errors
+   //
+   clStatisticR.ulErrCount = clStatisticP.ulErrCount + clRcvQueueP.overruns();
 
    return(eERROR_NONE);
 }
 
 
+//----------------------------------------------------------------------------//
+// stopReceive()                                                              //
+// stop the receive thread and wait until it has finished                     //
+//----------------------------------------------------------------------------//
+void QCanInterfacePeak::stopReceive(void)
+{
+   ulRcvRunP.storeRelease(0);
+   if (pclRcvThreadP->isRunning() == true)
+   {
+      pclRcvThreadP->wait();
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // supportedFeatures()                                                        //
 //                                                                            //
@@ -34,7 +34,10 @@
 #include <QLibrary>
 #include <QCanInterface>
 #include <QIcon>
+#include <QThread>
+#include <QAtomicInteger>
 #include "qcan_frame_error.hpp"
+#include "qcan_frame_queue.hpp"
 #include "qcan_pcan_basic.hpp"
 
 
@@ -48,30 +51,57 @@ class QCanInterfacePeak : public QCanInterface
 
 private:
 
+   //----------------------------------------------------------------
+   // The receive thread blocks on the receive event of the driver
+   // and moves all frames into clRcvQueueP, which is drained by
+   // read().
+   //
+   class ReceiveThread : public QThread
+   {
+   public:
+      ReceiveThread(QCanInterfacePeak * pclInterfaceV) :
+         pclInterfaceP(pclInterfaceV) { };
+
+   protected:
+      void run() Q_DECL_OVERRIDE { pclInterfaceP->runReceive(); };
+
+   private:
+      QCanInterfacePeak *  pclInterfaceP;
+   };
+
    /*!
     * \brief clStatisticP
     */
    QCanStatistic_ts clStatisticP;
 
    /*!
-    * \brief readCAN
-    * \param clFrameR
-    * \param ubChannelV
-    * \return
-    *
-    * Read CAN message from peak USB device
+    * \brief clRcvQueueP
+    * Frames read by the receive thread
     */
-   InterfaceError_e  readCAN(QCanFrame &clFrameR);
+   QCanFrameQueue    clRcvQueueP;
+
+   ReceiveThread *   pclRcvThreadP;
+
+   QAtomicInteger<uint32_t>   ulRcvRunP;
 
    /*!
-    * \brief readFD
-    * \param clFrameR
-    * \param ubChannelV
+    * \brief readDevice
+    * \param clDataR
+    * \param btStatusR
     * \return
     *
-    * Read CAN FD message from peak USB device
+    * Read next message from the FIFO of the driver, this function is
+    * called by the receive thread only. The value of \c btStatusR is
+    * \c true if \c clDataR holds an error frame built from the bus
+    * status instead of a received message.
     */
-   InterfaceError_e  readFD(QCanFrame &clFrameR);
+   InterfaceError_e  readDevice(QByteArray &clDataR, bool &btStatusR);
+
+   void              runReceive(void);
+
+   void              startReceive(void);
+
+   void              stopReceive(void);
 
    /*!
     * \brief ubChannelP
@@ -111,6 +141,9 @@ public:
    InterfaceError_e  read( QByteArray &clDataR) Q_DECL_OVERRIDE;
    
    InterfaceError_e  read( QCanFrame &clFrameR) Q_DECL_OVERRIDE;
+
+   InterfaceError_e  readBatch(char * pchDataV, uint32_t ulFrameMaxV,
+                               uint32_t & ulFrameCntR) Q_DECL_OVERRIDE;
    
    InterfaceError_e  setBitrate( int32_t slBitrateV,
                                  int32_t slBrsClockV) Q_DECL_OVERRIDE;
@@ -27,6 +27,7 @@
 //============================================================================//
 
 #include "qcan_pcan_basic.hpp"
+#include "qcan_trace.hpp"
 
 //----------------------------------------------------------------------------//
 // QCanPcanBasic()                                                            //
@@ -103,7 +104,7 @@ QCanPcanBasic::QCanPcanBasic()
 //----------------------------------------------------------------------------//
 QCanPcanBasic::~QCanPcanBasic()
 {
-   qDebug() << "QCanPcanBasic::~QCanPcanBasic()";
+   qCanTrace(qcanTracePlugin) << "QCanPcanBasic::~QCanPcanBasic()";
 
    btLibFuncLoadP = false;
 
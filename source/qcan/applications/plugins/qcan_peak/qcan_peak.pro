@@ -103,10 +103,12 @@ VPATH += ./../../..
 # header files of project
 #
 HEADERS =   qcan_interface.hpp      \
+            qcan_frame_queue.hpp    \
             qcan_interface_peak.hpp \
             qcan_pcan_basic.hpp     \
             qcan_plugin.hpp         \
-            qcan_plugin_peak.hpp
+            qcan_plugin_peak.hpp    \
+            qcan_trace.hpp
 
 
 #---------------------------------------------------------------
@@ -116,10 +118,12 @@ SOURCES =   qcan_data.cpp           \
             qcan_frame.cpp          \
             qcan_frame_api.cpp      \
             qcan_frame_error.cpp    \
+            qcan_frame_queue.cpp    \
             qcan_timestamp.cpp      \
             qcan_interface_peak.cpp \
             qcan_pcan_basic.cpp     \
-            qcan_plugin_peak.cpp
+            qcan_plugin_peak.cpp    \
+            qcan_trace.cpp
 
 
 EXAMPLE_FILES = plugin.json
@@ -27,6 +27,7 @@
 //============================================================================//
 
 #include "qcan_plugin_peak.hpp"
+#include "qcan_trace.hpp"
 
 //----------------------------------------------------------------------------//
 // QCanPluginPeak()                                                           //
@@ -34,7 +35,7 @@
 //----------------------------------------------------------------------------//
 QCanPluginPeak::QCanPluginPeak()
 {
-   qDebug() << "QCanPluginPeak::QCanPluginPeak()";
+   qCanTrace(qcanTracePlugin) << "QCanPluginPeak::QCanPluginPeak()";
 
    // reset number of interfaces
 //   apclQCanInterfacePeakP.clear();
@@ -84,7 +85,7 @@ QCanPluginPeak::QCanPluginPeak()
 //----------------------------------------------------------------------------//
 QCanPluginPeak::~QCanPluginPeak()
 {
-   qDebug() << "QCanPluginPeak::~QCanPluginPeak()";
+   qCanTrace(qcanTracePlugin) << "QCanPluginPeak::~QCanPluginPeak()";
 
    //----------------------------------------------------------------
    // disconnect all connected interfaces and delete objects
@@ -125,7 +126,7 @@ uint8_t QCanPluginPeak::interfaceCount()
                                          (void*)&ulParmBufferT, sizeof(ulParmBufferT));
       if (tsStatusT != PCAN_ERROR_OK)
       {
-         qDebug() << "QCanPluginPeak::QCanPluginPeak()" << pclPcanBasicP.formatedError(tsStatusT);
+         qCanTrace(qcanTracePlugin) << "QCanPluginPeak::QCanPluginPeak()" << pclPcanBasicP.formatedError(tsStatusT);
       } else if ((ulParmBufferT & PCAN_CHANNEL_AVAILABLE) == PCAN_CHANNEL_AVAILABLE)
       {
          // -----------------------------------------------
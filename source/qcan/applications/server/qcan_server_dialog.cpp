@@ -61,6 +61,15 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
    uint8_t        ubNetworkIdxT;
    QCanNetwork *  pclNetworkT;
    QString        clNetNameT;
+   QString        clRecordFileT;
+
+   //----------------------------------------------------------------
+   // load settings
+   //
+   pclSettingsP = new QSettings( QSettings::NativeFormat,
+                                 QSettings::UserScope,
+                                 "microcontrol.net",
+                                 "QCANserver");
 
    //----------------------------------------------------------------
    // create CAN networks
@@ -136,6 +145,9 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
    connect(pclNetworkT, SIGNAL(showLoad(uint8_t, uint32_t)),
             this, SLOT(onNetworkShowLoad(uint8_t, uint32_t)) );
 
+   connect(pclNetworkT, SIGNAL(showQueue(uint32_t, uint32_t)),
+            this, SLOT(onNetworkShowQueue(uint32_t, uint32_t)) );
+
    //----------------------------------------------------------------
    // Intialise interface widgets for CAN interface selection
    //
@@ -148,14 +160,6 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
    }
 
 
-   //----------------------------------------------------------------
-   // load settings
-   //
-   pclSettingsP = new QSettings( QSettings::NativeFormat,
-                                 QSettings::UserScope,
-                                 "microcontrol.net",
-                                 "QCANserver");
-
    //-----------------------------------------------------------
    // settings for network
    //
@@ -182,6 +186,31 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
       pclNetworkT->setListenOnlyEnabled(pclSettingsP->value("listenOnly",
                                  0).toBool());
 
+      pclNetworkT->setSendQueueSize(pclSettingsP->value("sendQueueSize",
+                                 QCAN_NETWORK_QUEUE_SIZE).toUInt());
+
+      pclNetworkT->setSendPolicy(pclSettingsP->value("sendPolicy",
+                                 QCAN_SEND_POLICY_DROP_OLDEST).toUInt());
+
+      pclNetworkT->setTimeStampEnabled(pclSettingsP->value("timeStamp",
+                                 0).toBool());
+
+      //--------------------------------------------------------
+      // the binary trace is started if a file name is set
+      //
+      pclNetworkT->recorder()->setSegmentSize(pclSettingsP->value(
+                                 "recordSegmentSize",
+                                 QCAN_RECORDER_SEGMENT_SIZE).toUInt());
+
+      pclNetworkT->recorder()->setSegmentCount(pclSettingsP->value(
+                                 "recordSegmentCount", 0).toUInt());
+
+      clRecordFileT = pclSettingsP->value("recordFile", "").toString();
+      if(clRecordFileT.isEmpty() == false)
+      {
+         pclNetworkT->startRecording(clRecordFileT);
+      }
+
       apclCanIfWidgetP[ubNetworkIdxT]->setInterface(pclSettingsP->value("interface"+QString::number(ubNetworkIdxT),"").toString());
 
       pclSettingsP->endGroup();
@@ -250,6 +279,15 @@ QCanServerDialog::~QCanServerDialog()
       pclSettingsP->setValue("errorFrame", pclNetworkT->isErrorFramesEnabled());
       pclSettingsP->setValue("canFD",      pclNetworkT->isFastDataEnabled());
       pclSettingsP->setValue("listenOnly", pclNetworkT->isListenOnlyEnabled());
+      pclSettingsP->setValue("sendQueueSize", pclNetworkT->sendQueueSize());
+      pclSettingsP->setValue("sendPolicy", pclNetworkT->sendPolicy());
+      pclSettingsP->setValue("timeStamp",  pclNetworkT->isTimeStampEnabled());
+      pclSettingsP->setValue("recordFile",
+                              pclNetworkT->recorder()->fileName());
+      pclSettingsP->setValue("recordSegmentSize",
+                              pclNetworkT->recorder()->segmentSize());
+      pclSettingsP->setValue("recordSegmentCount",
+                              pclNetworkT->recorder()->segmentCount());
 
       pclSettingsP->setValue("interface"+QString::number(ubNetworkIdxT), 
                               apclCanIfWidgetP[ubNetworkIdxT]->name());
@@ -265,6 +303,8 @@ QCanServerDialog::~QCanServerDialog()
 
    pclSettingsP->setValue("dispatchTime",
                            pclCanServerP->dispatcherTime());
+   pclSettingsP->setValue("dispatchThreads",
+                           pclCanServerP->isThreaded());
    pclSettingsP->endGroup();
 
    delete(pclSettingsP);
@@ -366,6 +406,9 @@ void QCanServerDialog::onNetworkChange(int slIndexV)
    disconnect(pclNetworkT, SIGNAL(showLoad(uint8_t, uint32_t)),
             this, SLOT(onNetworkShowLoad(uint8_t, uint32_t)) );
 
+   disconnect(pclNetworkT, SIGNAL(showQueue(uint32_t, uint32_t)),
+            this, SLOT(onNetworkShowQueue(uint32_t, uint32_t)) );
+
 
    pclNetworkT = pclCanServerP->network(slIndexV);
    connect(pclNetworkT, SIGNAL(showCanFrames(uint32_t)),
@@ -377,6 +420,9 @@ void QCanServerDialog::onNetworkChange(int slIndexV)
    connect(pclNetworkT, SIGNAL(showLoad(uint8_t, uint32_t)),
             this, SLOT(onNetworkShowLoad(uint8_t, uint32_t)) );
 
+   connect(pclNetworkT, SIGNAL(showQueue(uint32_t, uint32_t)),
+            this, SLOT(onNetworkShowQueue(uint32_t, uint32_t)) );
+
    //----------------------------------------------------------------
    // update user interface
    //
@@ -555,6 +601,18 @@ void QCanServerDialog::onNetworkShowLoad(uint8_t ubLoadV, uint32_t ulMsgPerSecV)
 }
 
 
+//----------------------------------------------------------------------------//
+// onNetworkShowQueue()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanServerDialog::onNetworkShowQueue(uint32_t ulDepthMaxV, 
+                                          uint32_t ulDroppedV)
+{
+   ui.pclCntStatQueueM->setText(QString("%1").arg(ulDepthMaxV));
+   ui.pclCntStatDropM->setText(QString("%1").arg(ulDroppedV));
+}
+
+
 //----------------------------------------------------------------------------//
 // onServerConfAddress()                                                      //
 //                                                                            //
@@ -592,9 +650,19 @@ void QCanServerDialog::onServerConfTime(int slValueV)
 //----------------------------------------------------------------------------//
 void QCanServerDialog::setupNetworks(void)
 {
+   bool  btThreadedT;
+
+   //----------------------------------------------------------------
+   // each CAN network runs in a dedicated thread by default
+   //
+   pclSettingsP->beginGroup("Server");
+   btThreadedT = pclSettingsP->value("dispatchThreads", true).toBool();
+   pclSettingsP->endGroup();
+
    pclCanServerP = new QCanServer(  this,
                                     QCAN_TCP_DEFAULT_PORT,
-                                    QCAN_NETWORK_MAX);
+                                    QCAN_NETWORK_MAX,
+                                    btThreadedT);
 }
 
 
@@ -37,6 +37,7 @@ public slots:
    void onNetworkShowCanFrames(uint32_t ulFrameCntV);
    void onNetworkShowErrFrames(uint32_t ulFrameCntV);
    void onNetworkShowLoad(uint8_t ubLoadV, uint32_t ulMsgPerSecV);
+   void onNetworkShowQueue(uint32_t ulDepthMaxV, uint32_t ulDroppedV);
 
 private slots:
    void onNetworkChange(int slIndexV);
@@ -90,20 +90,30 @@ VPATH += ./../../../canpie-fd
 HEADERS =   qcan_interface_widget.hpp  \
             qcan_interface.hpp         \
             qcan_network.hpp           \
+            qcan_recorder.hpp          \
+            qcan_scheduler.hpp         \
             qcan_server.hpp            \
-            qcan_server_dialog.hpp
+            qcan_server_dialog.hpp     \
+            qcan_trace.hpp
                 
             
 #---------------------------------------------------------------
 # source files of project 
 #
 SOURCES =   qcan_interface_widget.cpp  \
+            qcan_bus_load.cpp          \
             qcan_data.cpp              \
             qcan_frame.cpp             \
             qcan_frame_api.cpp         \
             qcan_frame_error.cpp       \
+            qcan_frame_queue.cpp       \
+            qcan_filter_index.cpp      \
+            qcan_shared_ring.cpp       \
             qcan_timestamp.cpp         \
+            qcan_trace.cpp             \
             qcan_network.cpp           \
+            qcan_recorder.cpp          \
+            qcan_scheduler.cpp         \
             qcan_server.cpp            \
             qcan_server_dialog.cpp     \
             server_main.cpp
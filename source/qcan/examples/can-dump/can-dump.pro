@@ -100,6 +100,8 @@ SOURCES =   qcan_data.cpp              \
             qcan_frame.cpp             \
             qcan_frame_api.cpp         \
             qcan_frame_error.cpp       \
+            qcan_filter_index.cpp      \
+            qcan_shared_ring.cpp       \
             qcan_socket.cpp            \
             qcan_timestamp.cpp         \
             qcan_dump.cpp
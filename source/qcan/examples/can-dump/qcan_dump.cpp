@@ -93,6 +93,16 @@ QCanDump::QCanDump(QObject *parent) :
 
    QObject::connect(&clCanSocketP, SIGNAL(framesReceived(uint32_t)),
                     this, SLOT(socketReceive(uint32_t)));
+
+   //----------------------------------------------------------------
+   // default output is stderr, written after each batch
+   //
+   teOutModeP  = eOUT_MODE_STDERR;
+   ptsOutFileP = stderr;
+   slOutPosP   = 0;
+
+   QObject::connect(&clFlushTimerP, SIGNAL(timeout()),
+                    this, SLOT(flushOutput()));
 }
 
 
@@ -101,9 +111,55 @@ QCanDump::QCanDump(QObject *parent) :
 // constructor and/or to stop any threads
 void QCanDump::aboutToQuitApp()
 {
-    // stop threads
-    // sleep(1);   // wait for threads to stop.
-    // delete any objects
+   clFlushTimerP.stop();
+   flushOutput();
+}
+
+
+//----------------------------------------------------------------------------//
+// appendRaw()                                                                //
+// copy frame in fixed encoding to output buffer                              //
+//----------------------------------------------------------------------------//
+void QCanDump::appendRaw(const QCanData & clDataR)
+{
+   if((slOutPosP + QCAN_FRAME_ARRAY_SIZE) > QCAN_DUMP_BUFFER_SIZE)
+   {
+      flushOutput();
+   }
+   slOutPosP += clDataR.toByteArray(&achOutBufferP[slOutPosP], 
+                                    QCAN_FRAME_ARRAY_SIZE);
+}
+
+
+//----------------------------------------------------------------------------//
+// appendText()                                                               //
+// print frame to output buffer                                               //
+//----------------------------------------------------------------------------//
+void QCanDump::appendText(const QCanData & clDataR)
+{
+   if((slOutPosP + QCAN_FRAME_STRING_SIZE + 1) > QCAN_DUMP_BUFFER_SIZE)
+   {
+      flushOutput();
+   }
+   slOutPosP += clDataR.toString(&achOutBufferP[slOutPosP], 
+                                 QCAN_FRAME_STRING_SIZE,
+                                 btTimeStampP);
+   achOutBufferP[slOutPosP++] = '\n';
+}
+
+
+//----------------------------------------------------------------------------//
+// flushOutput()                                                              //
+// write output buffer                                                        //
+//----------------------------------------------------------------------------//
+void QCanDump::flushOutput(void)
+{
+   if(slOutPosP > 0)
+   {
+      fwrite(&achOutBufferP[0], 1, slOutPosP, ptsOutFileP);
+      fflush(ptsOutFileP);
+      slOutPosP = 0;
+   }
 }
 
 
@@ -113,6 +169,8 @@ void QCanDump::aboutToQuitApp()
 //----------------------------------------------------------------------------//
 void QCanDump::quit()
 {
+   flushOutput();
+
    if((btQuitNeverP == false) && (ulQuitTimeP > 0))
    {
       fprintf(stderr, "%s %d %s\n", 
@@ -160,6 +218,24 @@ void QCanDump::runCmdParser()
          tr("Terminate after receiption of <count> CAN frames"),
          tr("count"));
    clCmdParserP.addOption(clOptCountT);
+
+   //-----------------------------------------------------------
+   // command line option: -o <mode>
+   //
+   QCommandLineOption clOptOutModeT("o", 
+         tr("Set output to [stderr|stdout|raw], raw writes binary frames"),
+         tr("mode"),
+         "stderr");     // default value
+   clCmdParserP.addOption(clOptOutModeT);
+
+   //-----------------------------------------------------------
+   // command line option: -F <msec>
+   //
+   QCommandLineOption clOptFlushT("F", 
+         tr("Write output every <msec> instead of after each batch"),
+         tr("msec"),
+         "0");          // default value
+   clCmdParserP.addOption(clOptFlushT);
    
    //-----------------------------------------------------------
    // command line option: -t 
@@ -229,6 +305,39 @@ void QCanDump::runCmdParser()
    btTimeStampP = clCmdParserP.isSet(clOptTimeStampT);
 
    
+   //----------------------------------------------------------------
+   // check for output mode, raw frames are written to stdout in
+   // fixed encoding (QCAN_FRAME_ARRAY_SIZE bytes)
+   //
+   QString clOutModeT = clCmdParserP.value(clOptOutModeT);
+   if (clOutModeT.compare("stderr", Qt::CaseInsensitive) == 0)
+   {
+      teOutModeP  = eOUT_MODE_STDERR;
+      ptsOutFileP = stderr;
+   }
+   else if (clOutModeT.compare("stdout", Qt::CaseInsensitive) == 0)
+   {
+      teOutModeP  = eOUT_MODE_STDOUT;
+      ptsOutFileP = stdout;
+   }
+   else if (clOutModeT.compare("raw", Qt::CaseInsensitive) == 0)
+   {
+      teOutModeP  = eOUT_MODE_RAW;
+      ptsOutFileP = stdout;
+   }
+   else
+   {
+      fprintf(stderr, "%s \n\n", 
+              qPrintable(tr("Error: Unknown option for output mode.")));
+      clCmdParserP.showHelp(0);
+   }
+
+   if (clCmdParserP.value(clOptFlushT).toInt(Q_NULLPTR, 10) > 0)
+   {
+      clFlushTimerP.start(clCmdParserP.value(clOptFlushT).toInt(Q_NULLPTR, 10));
+   }
+
+   
    //----------------------------------------------------------------
    // check for termination options
    //
@@ -316,7 +425,6 @@ void QCanDump::socketReceive(uint32_t ulFrameCntV)
    QCanFrame      clCanFrameT;
    QCanFrameApi   clCanApiT;
    QCanFrameError clCanErrorT;
-   QString        clCanStringT;
    QCanData::Type_e  ubFrameTypeT;
    
    if ((btQuitNeverP == false) && (ulQuitTimeP > 0))
@@ -333,16 +441,36 @@ void QCanDump::socketReceive(uint32_t ulFrameCntV)
             case QCanData::eTYPE_API:
                if (clCanApiT.fromByteArray(clCanDataT) == true)
                {
-                  clCanStringT = clCanApiT.toString(btTimeStampP);
-                  fprintf(stderr, "%s\n", qPrintable(clCanStringT));
+                  if (teOutModeP == eOUT_MODE_RAW)
+                  {
+                     appendRaw(clCanApiT);
+                  }
+                  else
+                  {
+                     appendText(clCanApiT);
+                  }
                }
                break;
                
             case QCanData::eTYPE_CAN:
                if (clCanFrameT.fromByteArray(clCanDataT) == true)
                {
-                  clCanStringT = clCanFrameT.toString(btTimeStampP);
-                  fprintf(stderr, "%s\n", qPrintable(clCanStringT));
+                  if (teOutModeP == eOUT_MODE_RAW)
+                  {
+                     appendRaw(clCanFrameT);
+                  }
+                  else
+                  {
+                     appendText(clCanFrameT);
+                  }
+               }
+               break;
+
+            case QCanData::eTYPE_ERROR:
+               if ((teOutModeP == eOUT_MODE_RAW) &&
+                   (clCanErrorT.fromByteArray(clCanDataT) == true))
+               {
+                  appendRaw(clCanErrorT);
                }
                break;
 
@@ -359,13 +487,12 @@ void QCanDump::socketReceive(uint32_t ulFrameCntV)
          quit();
       }
    }
-}
-
-
-
-
-
-
-
-
 
+   //----------------------------------------------------------------
+   // without flush timer the output is written after each batch
+   //
+   if (clFlushTimerP.isActive() == false)
+   {
+      flushOutput();
+   }
+}
@@ -32,6 +32,16 @@
 
 #include <QCanSocket>
 
+#include <stdio.h>
+
+
+//-------------------------------------------------------------------
+// size of the output buffer, the buffer is written when it can not
+// hold another frame
+//
+#define  QCAN_DUMP_BUFFER_SIZE      65536
+
+
 class QCanDump : public QObject
 {
    Q_OBJECT
@@ -39,6 +49,12 @@ class QCanDump : public QObject
 public:
    QCanDump(QObject *parent = 0);
 
+   enum OutMode_e {
+      eOUT_MODE_STDERR = 0,
+      eOUT_MODE_STDOUT,
+      eOUT_MODE_RAW
+   };
+
 
 signals:
    void finished();
@@ -46,6 +62,8 @@ signals:
 public slots:
    void aboutToQuitApp(void);
 
+   void flushOutput(void);
+
    void runCmdParser(void);
 
    void socketConnected();
@@ -56,6 +74,9 @@ public slots:
    
 private:
 
+   void                 appendRaw(const QCanData & clDataR);
+   void                 appendText(const QCanData & clDataR);
+
    QCoreApplication *   pclAppP;
 
    QCommandLineParser   clCmdParserP;
@@ -68,6 +89,16 @@ private:
    bool                 btQuitNeverP;
    uint32_t             ulQuitTimeP;
    uint32_t             ulQuitCountP;
+
+   //----------------------------------------------------------------
+   // frames are formatted into achOutBufferP, the buffer is written
+   // after each batch of received frames or by clFlushTimerP
+   //
+   OutMode_e            teOutModeP;
+   FILE *               ptsOutFileP;
+   QTimer               clFlushTimerP;
+   int32_t              slOutPosP;
+   char                 achOutBufferP[QCAN_DUMP_BUFFER_SIZE];
 };
 
 
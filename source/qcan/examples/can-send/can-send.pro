@@ -94,10 +94,13 @@ HEADERS =   qcan_socket.hpp            \
 #---------------------------------------------------------------
 # source files of project 
 #
-SOURCES =   qcan_data.cpp              \
+SOURCES =   qcan_bus_load.cpp          \
+            qcan_data.cpp              \
             qcan_frame.cpp             \
             qcan_frame_api.cpp         \
             qcan_frame_error.cpp       \
+            qcan_filter_index.cpp      \
+            qcan_shared_ring.cpp       \
             qcan_socket.cpp            \
             qcan_timestamp.cpp         \
             qcan_send.cpp
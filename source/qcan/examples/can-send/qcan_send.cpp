@@ -32,6 +32,27 @@
 #include <QTimer>
 #include <QDebug>
 
+#include "qcan_bus_load.hpp"
+
+
+//-------------------------------------------------------------------
+// generator mode: maximum time in nanoseconds the generator runs
+// before it returns to the event loop
+//
+#define  GEN_SLICE_TIME       ((uint64_t) 10000000)
+
+//-------------------------------------------------------------------
+// generator mode: remaining wait time in nanoseconds which is
+// spent by polling the elapsed timer instead of sleeping
+//
+#define  GEN_SPIN_TIME        ((uint64_t) 2000000)
+
+//-------------------------------------------------------------------
+// generator mode: the generator pauses while more bytes are 
+// waiting to be written by the socket
+//
+#define  GEN_PENDING_MAX      ((int64_t) 65536)
+
 
 //----------------------------------------------------------------------------//
 // main()                                                                     //
@@ -130,6 +151,23 @@ void QCanSend::runCmdParser(void)
    clCmdParserP.addPositionalArgument("interface", 
                                       tr("CAN interface, e.g. can1"));
 
+   //-----------------------------------------------------------
+   // command line option: -b <bitrate>
+   //
+   QCommandLineOption clOptBitrateT("b", 
+         tr("Nominal bit-rate in bit/s for bus load calculation"),
+         tr("bitrate"),
+         "500000");     // default value
+   clCmdParserP.addOption(clOptBitrateT);
+
+   //-----------------------------------------------------------
+   // command line option: -B <burst>
+   //
+   QCommandLineOption clOptBurstT("B", 
+         tr("Send bursts of <burst> frames back-to-back, separated by gap"),
+         tr("burst"));
+   clCmdParserP.addOption(clOptBurstT);
+
    //-----------------------------------------------------------
    // command line option: -D <dlc>
    //
@@ -181,6 +219,14 @@ void QCanSend::runCmdParser(void)
          tr("id"));
    clCmdParserP.addOption(clOptFrameIdT);
    
+   //-----------------------------------------------------------
+   // command line option: -l <load>
+   //
+   QCommandLineOption clOptLoadT("l", 
+         tr("Send with a bus load of <load> percent"),
+         tr("load"));
+   clCmdParserP.addOption(clOptLoadT);
+   
    //-----------------------------------------------------------
    // command line option: -n <count>
    //
@@ -198,6 +244,14 @@ void QCanSend::runCmdParser(void)
          tr("payload"));
    clCmdParserP.addOption(clOptFrameDataT);
    
+   //-----------------------------------------------------------
+   // command line option: -r <rate>
+   //
+   QCommandLineOption clOptRateT("r", 
+         tr("Send with a rate of <rate> frames per second"),
+         tr("rate"));
+   clCmdParserP.addOption(clOptRateT);
+   
    
    clCmdParserP.addVersionOption();
 
@@ -325,6 +379,57 @@ void QCanSend::runCmdParser(void)
    btIncIdP  = clCmdParserP.value(clOptIncT).contains("I", Qt::CaseInsensitive);
    btIncDlcP = clCmdParserP.value(clOptIncT).contains("D", Qt::CaseInsensitive);
    btIncDataP= clCmdParserP.value(clOptIncT).contains("P", Qt::CaseInsensitive);
+
+   //----------------------------------------------------------------
+   // the generator mode is used for a rate, a bus load or bursts
+   //
+   btGeneratorP   = false;
+   ulGenBurstP    = 1;
+   ulGenLoadP     = 0;
+   uqGenPeriodP   = 0;
+   uqGenBurstGapP = ((uint64_t) ulFrameGapP) * 1000000;
+
+   if(clCmdParserP.isSet(clOptBurstT))
+   {
+      ulGenBurstP = clCmdParserP.value(clOptBurstT).toUInt(Q_NULLPTR, 10);
+      if(ulGenBurstP == 0)
+      {
+         fprintf(stderr, "%s \n\n", 
+                 qPrintable(tr("Error: Burst size out of range.")));
+         clCmdParserP.showHelp(0);
+      }
+      btGeneratorP = true;
+   }
+
+   if(clCmdParserP.isSet(clOptRateT))
+   {
+      uint32_t ulRateT = clCmdParserP.value(clOptRateT).toUInt(Q_NULLPTR, 10);
+      if(ulRateT == 0)
+      {
+         fprintf(stderr, "%s \n\n", 
+                 qPrintable(tr("Error: Frame rate out of range.")));
+         clCmdParserP.showHelp(0);
+      }
+      uqGenPeriodP = 1000000000 / ulRateT;
+      btGeneratorP = true;
+   }
+   else if(clCmdParserP.isSet(clOptLoadT))
+   {
+      //--------------------------------------------------------
+      // the frame period is calculated from the length of the
+      // initial frame in socketConnected()
+      //
+      ulGenLoadP    = clCmdParserP.value(clOptLoadT).toUInt(Q_NULLPTR, 10);
+      ulGenBitrateP = QCanBusLoad::bitrateValue(
+                      clCmdParserP.value(clOptBitrateT).toInt(Q_NULLPTR, 10));
+      if((ulGenLoadP == 0) || (ulGenLoadP > 100) || (ulGenBitrateP == 0))
+      {
+         fprintf(stderr, "%s \n\n", 
+                 qPrintable(tr("Error: Bus load or bit-rate out of range.")));
+         clCmdParserP.showHelp(0);
+      }
+      btGeneratorP = true;
+   }
    
    //----------------------------------------------------------------
    // set host address for socket
@@ -343,92 +448,277 @@ void QCanSend::runCmdParser(void)
 }
 
 //----------------------------------------------------------------------------//
-// sendFrame()                                                                //
-//                                                                            //
+// generateFrames()                                                           //
+// generator mode: send paced frames in batches                               //
 //----------------------------------------------------------------------------//
-void QCanSend::sendFrame(void)
+void QCanSend::generateFrames(void)
 {
-   QTime          clSystemTimeT;
-   QCanTimeStamp  clCanTimeT;
-   
-   clSystemTimeT = QTime::currentTime();
-   clCanTimeT.fromMilliSeconds(clSystemTimeT.msec());
-   clCanFrameP.setTimeStamp(clCanTimeT);
-   
-   clCanSocketP.writeFrame(clCanFrameP);
-   
-   if (ulFrameCountP > 1)
+   uint64_t uqNowT;
+   uint64_t uqSliceEndT;
+   uint64_t uqWaitT;
+   uint64_t uqLatencyT;
+   uint32_t ulBurstCntT;
+   uint32_t ulAcceptedT;
+   uint32_t ulFrameT;
+   uint8_t  ubBucketT;
+
+   uqSliceEndT = clGenTimerP.nsecsElapsed() + GEN_SLICE_TIME;
+
+   while(ulFrameCountP > 0)
    {
-      ulFrameCountP--;
-      
+      uqNowT = clGenTimerP.nsecsElapsed();
+
       //--------------------------------------------------------
-      // test if identifier value must be incemented
+      // return to the event loop after a time slice or when the
+      // socket can't keep up, so it is able to write its data
       //
-      if (btIncIdP)
+      if((uqNowT >= uqSliceEndT) || 
+         (clCanSocketP.bytesToWrite() > GEN_PENDING_MAX))
       {
-         ulFrameIdP++;
-         
-         //------------------------------------------------
-         // test for wrap-around
-         //
-         if (clCanFrameP.isExtended())
+         QTimer::singleShot(0, this, SLOT(generateFrames()));
+         return;
+      }
+
+      //--------------------------------------------------------
+      // long wait times are spent in the event loop, the last
+      // part is spent polling the timer for a precise start
+      //
+      if(uqGenDueP > uqNowT)
+      {
+         uqWaitT = uqGenDueP - uqNowT;
+         if(uqWaitT > GEN_SPIN_TIME)
          {
-            if (ulFrameIdP > QCAN_FRAME_ID_MASK_EXT)
-            {
-               ulFrameIdP = 0;
-            }
+            QTimer::singleShot((int) ((uqWaitT - GEN_SPIN_TIME) / 1000000),
+                               Qt::PreciseTimer,
+                               this, SLOT(generateFrames()));
+            return;
          }
-         else
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // collect all bursts which are due, a generator which 
+      // falls behind catches up with larger batches
+      //
+      clGenBatchP.clear();
+      clGenDueListP.clear();
+      while((ulFrameCountP > 0) && (uqGenDueP <= uqNowT) &&
+            (clGenBatchP.size() < QCAN_NETWORK_BATCH_SIZE))
+      {
+         for(ulBurstCntT = 0; ulBurstCntT < ulGenBurstP; ulBurstCntT++)
          {
-            if (ulFrameIdP > QCAN_FRAME_ID_MASK_STD)
+            clGenBatchP.append(clCanFrameP);
+            clGenDueListP.append(uqGenDueP);
+            ulFrameCountP--;
+            if(ulFrameCountP == 0)
             {
-               ulFrameIdP = 0;
+               break;
             }
+            nextFrame();
          }
-         
-         //------------------------------------------------
-         // set new identifier value
-         //
-         clCanFrameP.setIdentifier(ulFrameIdP);
+         uqGenDueP += uqGenBurstGapP;
       }
+
+      ulAcceptedT = clCanSocketP.writeFrames(clGenBatchP.constData(),
+                                             clGenBatchP.size());
+
+      //--------------------------------------------------------
+      // the send latency is the time from the due time of a
+      // frame until it was accepted by the socket
+      //
+      uqNowT = clGenTimerP.nsecsElapsed();
+      ulGenSentP     += clGenBatchP.size();
+      ulGenAcceptedP += ulAcceptedT;
+      for(ulFrameT = 0; ulFrameT < ulAcceptedT; ulFrameT++)
+      {
+         uqLatencyT = uqNowT - clGenDueListP.at(ulFrameT);
+         uqLatencySumP += uqLatencyT;
+         if(uqLatencyT < uqLatencyMinP)
+         {
+            uqLatencyMinP = uqLatencyT;
+         }
+         if(uqLatencyT > uqLatencyMaxP)
+         {
+            uqLatencyMaxP = uqLatencyT;
+         }
+
+         uqLatencyT = uqLatencyT / 1000;
+         ubBucketT  = 0;
+         while((ubBucketT < (QCAN_SEND_LATENCY_BUCKETS - 1)) &&
+               (uqLatencyT > (((uint64_t) 1) << ubBucketT)))
+         {
+            ubBucketT++;
+         }
+         aulLatencyHistP[ubBucketT]++;
+      }
+
+      //--------------------------------------------------------
+      // stop if the socket does not accept frames any more
+      //
+      if(ulAcceptedT < (uint32_t) clGenBatchP.size())
+      {
+         ulFrameCountP = 0;
+      }
+   }
+
+   printReport();
+   QTimer::singleShot(50, this, SLOT(quit()));
+}
+
+
+//----------------------------------------------------------------------------//
+// nextFrame()                                                                //
+// apply the requested increments to the CAN frame                            //
+//----------------------------------------------------------------------------//
+void QCanSend::nextFrame(void)
+{
+   //----------------------------------------------------------------
+   // test if identifier value must be incemented
+   //
+   if (btIncIdP)
+   {
+      ulFrameIdP++;
       
       //--------------------------------------------------------
-      // test if DLC value must be incemented
+      // test for wrap-around
       //
-      if (btIncDlcP)
+      if (clCanFrameP.isExtended())
       {
-         ubFrameDlcP++;
-         
-         //------------------------------------------------
-         // test for wrap-around
-         //
-         if (clCanFrameP.frameFormat() > QCanFrame::eFORMAT_CAN_EXT)
+         if (ulFrameIdP > QCAN_FRAME_ID_MASK_EXT)
          {
-            if (ubFrameDlcP > 15)
-            {
-               ubFrameDlcP = 0;
-            }
+            ulFrameIdP = 0;
          }
-         else
+      }
+      else
+      {
+         if (ulFrameIdP > QCAN_FRAME_ID_MASK_STD)
          {
-            if (ubFrameDlcP > 8)
-            {
-               ubFrameDlcP = 0;
-            }
+            ulFrameIdP = 0;
          }
-         //------------------------------------------------
-         // set new DLC value
-         //
-         clCanFrameP.setDlc(ubFrameDlcP);
-      }  
+      }
+      
+      //--------------------------------------------------------
+      // set new identifier value
+      //
+      clCanFrameP.setIdentifier(ulFrameIdP);
+   }
+   
+   //----------------------------------------------------------------
+   // test if DLC value must be incemented
+   //
+   if (btIncDlcP)
+   {
+      ubFrameDlcP++;
       
       //--------------------------------------------------------
-      // test if data value must be incemented
+      // test for wrap-around
       //
-      if (btIncDataP)
+      if (clCanFrameP.frameFormat() > QCanFrame::eFORMAT_CAN_EXT)
+      {
+         if (ubFrameDlcP > 15)
+         {
+            ubFrameDlcP = 0;
+         }
+      }
+      else
+      {
+         if (ubFrameDlcP > 8)
+         {
+            ubFrameDlcP = 0;
+         }
+      }
+      //--------------------------------------------------------
+      // set new DLC value
+      //
+      clCanFrameP.setDlc(ubFrameDlcP);
+   }  
+   
+   //----------------------------------------------------------------
+   // test if data value must be incemented
+   //
+   if (btIncDataP)
+   {
+      clCanFrameP.setDataUInt32(0, clCanFrameP.dataUInt32(0) + 1);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// printReport()                                                              //
+// generator mode: print the achieved rate and the send latency               //
+//----------------------------------------------------------------------------//
+void QCanSend::printReport(void)
+{
+   uint64_t uqTimeT;
+   uint32_t ulSumT = 0;
+   uint8_t  ubBucketT;
+   uint8_t  ubPercentT;
+   double   fRateT = 0.0;
+
+   static const uint32_t aulPercentT[] = { 50, 90, 99 };
+
+   uqTimeT = clGenTimerP.nsecsElapsed();
+   if(uqTimeT > 0)
+   {
+      fRateT = ((double) ulGenAcceptedP) * 1.0e9 / ((double) uqTimeT);
+   }
+
+   fprintf(stdout, "Frames generated   : %u\n", ulGenSentP);
+   fprintf(stdout, "Frames accepted    : %u\n", ulGenAcceptedP);
+   fprintf(stdout, "Duration           : %.3f s\n", 
+           ((double) uqTimeT) / 1.0e9);
+   fprintf(stdout, "Achieved rate      : %.1f frames/s\n", fRateT);
+
+   if(ulGenAcceptedP == 0)
+   {
+      return;
+   }
+
+   fprintf(stdout, "Send latency       : min %.1f us, avg %.1f us, "
+                   "max %.1f us\n",
+           ((double) uqLatencyMinP) / 1000.0,
+           ((double) uqLatencySumP) / 1000.0 / ((double) ulGenAcceptedP),
+           ((double) uqLatencyMaxP) / 1000.0);
+
+   //----------------------------------------------------------------
+   // the percentiles are taken from the histogram, so they are
+   // given as upper limit of the bucket
+   //
+   ubPercentT = 0;
+   for(ubBucketT = 0; ubBucketT < QCAN_SEND_LATENCY_BUCKETS; ubBucketT++)
+   {
+      ulSumT += aulLatencyHistP[ubBucketT];
+      while((ubPercentT < 3) && 
+            (((uint64_t) ulSumT) * 100 >= 
+             ((uint64_t) ulGenAcceptedP) * aulPercentT[ubPercentT]))
       {
-         clCanFrameP.setDataUInt32(0, clCanFrameP.dataUInt32(0) + 1);
+         fprintf(stdout, "Send latency p%-3u  : <= %u us\n",
+                 aulPercentT[ubPercentT], 1U << ubBucketT);
+         ubPercentT++;
       }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// sendFrame()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSend::sendFrame(void)
+{
+   QTime          clSystemTimeT;
+   QCanTimeStamp  clCanTimeT;
+   
+   clSystemTimeT = QTime::currentTime();
+   clCanTimeT.fromMilliSeconds(clSystemTimeT.msec());
+   clCanFrameP.setTimeStamp(clCanTimeT);
+   
+   clCanSocketP.writeFrame(clCanFrameP);
+   
+   if (ulFrameCountP > 1)
+   {
+      ulFrameCountP--;
+      nextFrame();
       
       QTimer::singleShot(ulFrameGapP, this, SLOT(sendFrame()));
    }
@@ -456,8 +746,52 @@ void QCanSend::socketConnected()
    {
       clCanFrameP.setData(ubCntT, aubFrameDataP[ubCntT]);
    }
-    
-   QTimer::singleShot(10, this, SLOT(sendFrame()));
+
+   if(btGeneratorP == false)
+   {
+      QTimer::singleShot(10, this, SLOT(sendFrame()));
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // generator mode: calculate the frame period for the requested
+   // bus load from the length of the initial frame
+   //
+   if(ulGenLoadP > 0)
+   {
+      uint32_t ulDataBitsT;
+      uint64_t uqBitsT = QCanBusLoad::frameBits(clCanFrameP, 
+                                                QCanBusLoad::eSTUFFING_ACTUAL,
+                                                ulDataBitsT);
+      uqGenPeriodP = (uqBitsT * 1000000000 * 100) / 
+                     (((uint64_t) ulGenBitrateP) * ulGenLoadP);
+   }
+
+   //----------------------------------------------------------------
+   // with a rate or bus load the bursts are spaced in order to 
+   // meet the average frame period
+   //
+   if(uqGenPeriodP > 0)
+   {
+      uqGenBurstGapP = uqGenPeriodP * ulGenBurstP;
+   }
+
+   ulGenSentP     = 0;
+   ulGenAcceptedP = 0;
+   uqLatencyMinP  = UINT64_MAX;
+   uqLatencyMaxP  = 0;
+   uqLatencySumP  = 0;
+   for(uint8_t ubCntT = 0; ubCntT < QCAN_SEND_LATENCY_BUCKETS; ubCntT++)
+   {
+      aulLatencyHistP[ubCntT] = 0;
+   }
+
+   clGenBatchP.reserve(QCAN_NETWORK_BATCH_SIZE + ulGenBurstP);
+   clGenDueListP.reserve(QCAN_NETWORK_BATCH_SIZE + ulGenBurstP);
+   clGenTimerP.start();
+   uqGenDueP = 0;
+
+   QTimer::singleShot(0, this, SLOT(generateFrames()));
 }
 
 
@@ -28,9 +28,18 @@
 
 #include <QCoreApplication>
 #include <QCommandlineParser>
+#include <QElapsedTimer>
+#include <QVector>
 
 #include <QCanSocket>
 
+
+//-------------------------------------------------------------------
+// number of buckets of the send latency histogram, bucket n holds
+// latencies up to 2^n microseconds
+//
+#define  QCAN_SEND_LATENCY_BUCKETS  24
+
 class QCanSend : public QObject
 {
    Q_OBJECT
@@ -46,6 +55,7 @@ public slots:
 
    void runCmdParser(void);
 
+   void generateFrames(void);
    void sendFrame(void);
    void socketConnected();
    void socketDisconnected();
@@ -54,6 +64,9 @@ public slots:
    
 private:
 
+   void                 nextFrame(void);
+   void                 printReport(void);
+
    QCoreApplication *   pclAppP;
 
    QCommandLineParser   clCmdParserP;
@@ -70,6 +83,27 @@ private:
    bool                 btIncDlcP;
    bool                 btIncDataP;
    uint32_t             ulFrameCountP;
+
+   //----------------------------------------------------------------
+   // generator mode: frames are paced by clGenTimerP instead of
+   // a QTimer and written in batches
+   //
+   bool                 btGeneratorP;
+   QElapsedTimer        clGenTimerP;
+   QVector<QCanFrame>   clGenBatchP;
+   QVector<uint64_t>    clGenDueListP;
+   uint64_t             uqGenPeriodP;
+   uint64_t             uqGenBurstGapP;
+   uint64_t             uqGenDueP;
+   uint32_t             ulGenBurstP;
+   uint32_t             ulGenLoadP;
+   uint32_t             ulGenBitrateP;
+   uint32_t             ulGenSentP;
+   uint32_t             ulGenAcceptedP;
+   uint64_t             uqLatencyMinP;
+   uint64_t             uqLatencyMaxP;
+   uint64_t             uqLatencySumP;
+   uint32_t             aulLatencyHistP[QCAN_SEND_LATENCY_BUCKETS];
 };
 
 
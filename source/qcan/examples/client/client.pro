@@ -108,6 +108,8 @@ SOURCES +=  client_demo.cpp         \
             qcan_frame.cpp          \
             qcan_frame_api.cpp      \
             qcan_frame_error.cpp    \
+            qcan_filter_index.cpp   \
+            qcan_shared_ring.cpp    \
             qcan_socket.cpp
             
 H
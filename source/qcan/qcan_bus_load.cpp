@@ -0,0 +1,459 @@
+//============================================================================//
+// File:          qcan_bus_load.cpp                                           //
+// Description:   QCan classes - bus load calculation                         //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include "qcan_bus_load.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// maximum number of bits from SOF to the end of the CRC field,
+// an extended CAN FD frame with 64 data bytes has 553 bits
+//
+#define  BUS_LOAD_BIT_MAX        ((uint32_t) 600)
+
+//-------------------------------------------------------------------
+// bits after the CRC field: CRC delimiter, ACK slot, ACK delimiter,
+// end of frame (7 bits) and intermission (3 bits)
+//
+#define  BUS_LOAD_FRAME_END      ((uint32_t) 13)
+
+//-------------------------------------------------------------------
+// generator polynomial of the classic CAN CRC
+//
+#define  BUS_LOAD_CRC15_POLY     ((uint16_t) 0x4599)
+
+//-------------------------------------------------------------------
+// one second in nanoseconds
+//
+#define  BUS_LOAD_NSEC_PER_SEC   ((uint64_t) 1000000000)
+
+
+/*----------------------------------------------------------------------------*\
+** Static functions                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// AppendBits()                                                               //
+// append ubCountV bits of ulValueV (MSB first) to the bit stream             //
+//----------------------------------------------------------------------------//
+static uint32_t AppendBits(uint8_t * pubBitV, uint32_t ulPosV, 
+                           uint32_t ulValueV, uint8_t ubCountV)
+{
+   while(ubCountV > 0)
+   {
+      ubCountV--;
+      pubBitV[ulPosV] = (uint8_t) ((ulValueV >> ubCountV) & 1);
+      ulPosV++;
+   }
+   return(ulPosV);
+}
+
+
+//----------------------------------------------------------------------------//
+// CalcCrc15()                                                                //
+// calculate the CRC of a classic CAN frame                                   //
+//----------------------------------------------------------------------------//
+static uint16_t CalcCrc15(const uint8_t * pubBitV, uint32_t ulSizeV)
+{
+   uint16_t uwCrcT = 0;
+   uint32_t ulPosT;
+   uint8_t  ubCrcNextT;
+
+   for(ulPosT = 0; ulPosT < ulSizeV; ulPosT++)
+   {
+      ubCrcNextT = pubBitV[ulPosT] ^ ((uwCrcT >> 14) & 1);
+      uwCrcT     = (uwCrcT << 1) & 0x7FFF;
+      if(ubCrcNextT != 0)
+      {
+         uwCrcT ^= BUS_LOAD_CRC15_POLY;
+      }
+   }
+   return(uwCrcT);
+}
+
+
+//----------------------------------------------------------------------------//
+// CountStuffBits()                                                           //
+// count the stuff bits of a bit stream                                       //
+//----------------------------------------------------------------------------//
+static uint32_t CountStuffBits(const uint8_t * pubBitV, uint32_t ulSizeV,
+                               uint32_t ulStuffEndV, uint32_t ulSplitV,
+                               uint32_t & ulSplitCntR)
+{
+   uint32_t ulPosT;
+   uint32_t ulStuffCntT = 0;
+   uint8_t  ubLastT     = 2;
+   uint8_t  ubRunT      = 0;
+
+   ulSplitCntR = 0;
+   for(ulPosT = 0; ulPosT < ulSizeV; ulPosT++)
+   {
+      if(pubBitV[ulPosT] == ubLastT)
+      {
+         ubRunT++;
+      }
+      else
+      {
+         ubLastT = pubBitV[ulPosT];
+         ubRunT  = 1;
+      }
+
+      //--------------------------------------------------------
+      // after 5 consecutive bits of equal value a complementary
+      // bit is inserted, which is part of the next sequence
+      //
+      if((ubRunT == 5) && (ulPosT < ulStuffEndV))
+      {
+         ulStuffCntT++;
+         if(ulPosT >= ulSplitV)
+         {
+            ulSplitCntR++;
+         }
+         ubLastT = ubLastT ^ 1;
+         ubRunT  = 1;
+      }
+   }
+   return(ulStuffCntT);
+}
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanBusLoad()                                                              //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanBusLoad::QCanBusLoad()
+{
+   ubStuffingP = eSTUFFING_ACTUAL;
+   this->setBitrate(eCAN_BITRATE_500K, eCAN_BITRATE_NONE);
+   this->reset();
+}
+
+
+//----------------------------------------------------------------------------//
+// addFrame()                                                                 //
+// add transmission time of frame                                             //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::addFrame(const QCanFrame & clFrameR)
+{
+   uint32_t ulTimeT;
+
+   ulTimeT = this->frameTime(clFrameR);
+   uqBusyWindowP += ulTimeT;
+   uqBusyPeriodP += ulTimeT;
+}
+
+
+//----------------------------------------------------------------------------//
+// bitrateValue()                                                             //
+// convert bit-rate to bit/s                                                  //
+//----------------------------------------------------------------------------//
+uint32_t QCanBusLoad::bitrateValue(int32_t slBitrateV)
+{
+   uint32_t ulBitrateT = 0;
+
+   switch(slBitrateV)
+   {
+      case eCAN_BITRATE_10K:  ulBitrateT =   10000; break;
+      case eCAN_BITRATE_20K:  ulBitrateT =   20000; break;
+      case eCAN_BITRATE_50K:  ulBitrateT =   50000; break;
+      case eCAN_BITRATE_100K: ulBitrateT =  100000; break;
+      case eCAN_BITRATE_125K: ulBitrateT =  125000; break;
+      case eCAN_BITRATE_250K: ulBitrateT =  250000; break;
+      case eCAN_BITRATE_500K: ulBitrateT =  500000; break;
+      case eCAN_BITRATE_800K: ulBitrateT =  800000; break;
+      case eCAN_BITRATE_1M:   ulBitrateT = 1000000; break;
+
+      default:
+         //--------------------------------------------------------
+         // all values above eCAN_BITRATE_AUTO are in bit/s
+         //
+         if(slBitrateV > eCAN_BITRATE_AUTO)
+         {
+            ulBitrateT = (uint32_t) slBitrateV;
+         }
+         break;
+   }
+
+   return(ulBitrateT);
+}
+
+
+//----------------------------------------------------------------------------//
+// frameBits()                                                                //
+// calculate number of bits of a CAN frame                                    //
+//----------------------------------------------------------------------------//
+uint32_t QCanBusLoad::frameBits(const QCanFrame & clFrameR, 
+                                Stuffing_e ubStuffingV,
+                                uint32_t & ulDataBitsR)
+{
+   uint8_t     aubBitT[BUS_LOAD_BIT_MAX];
+   uint32_t    ulSizeT = 0;
+   uint32_t    ulSplitT;
+   uint32_t    ulStuffT;
+   uint32_t    ulStuffDataT;
+   uint32_t    ulCrcSizeT;
+   uint32_t    ulFixedT;
+   uint32_t    ulIdentifierT;
+   uint8_t     ubDataSizeT;
+   uint8_t     ubCntT;
+   bool        btFastDataT;
+
+   btFastDataT   = (clFrameR.frameFormat() > QCanFrame::eFORMAT_CAN_EXT);
+   ulIdentifierT = clFrameR.identifier();
+   ubDataSizeT   = clFrameR.dataSize();
+   if(btFastDataT == false)
+   {
+      if(clFrameR.isRemote())    ubDataSizeT = 0;
+      if(ubDataSizeT > 8)        ubDataSizeT = 8;
+   }
+
+   //----------------------------------------------------------------
+   // start of frame and arbitration field
+   //
+   ulSizeT = AppendBits(aubBitT, ulSizeT, 0, 1);
+   if(clFrameR.isExtended())
+   {
+      ulSizeT = AppendBits(aubBitT, ulSizeT, ulIdentifierT >> 18, 11);
+      ulSizeT = AppendBits(aubBitT, ulSizeT, 3, 2);            // SRR, IDE
+      ulSizeT = AppendBits(aubBitT, ulSizeT, ulIdentifierT, 18);
+   }
+   else
+   {
+      ulSizeT = AppendBits(aubBitT, ulSizeT, ulIdentifierT, 11);
+   }
+
+   //----------------------------------------------------------------
+   // control field
+   //
+   if(btFastDataT)
+   {
+      if(clFrameR.isExtended())
+      {
+         ulSizeT = AppendBits(aubBitT, ulSizeT, 2, 3);         // RRS, FDF, res
+      }
+      else
+      {
+         ulSizeT = AppendBits(aubBitT, ulSizeT, 2, 4);         // RRS, IDE, FDF, res
+      }
+      ulSizeT  = AppendBits(aubBitT, ulSizeT, clFrameR.bitrateSwitch(), 1);
+      ulSplitT = ulSizeT;
+      ulSizeT  = AppendBits(aubBitT, ulSizeT, 
+                            clFrameR.errorStateIndicator(), 1);
+   }
+   else
+   {
+      ulSizeT  = AppendBits(aubBitT, ulSizeT, clFrameR.isRemote(), 1);
+      ulSizeT  = AppendBits(aubBitT, ulSizeT, 0, 2);           // IDE/r1, r0
+      ulSplitT = ulSizeT;
+   }
+   ulSizeT = AppendBits(aubBitT, ulSizeT, clFrameR.dlc(), 4);
+
+   //----------------------------------------------------------------
+   // data field
+   //
+   for(ubCntT = 0; ubCntT < ubDataSizeT; ubCntT++)
+   {
+      ulSizeT = AppendBits(aubBitT, ulSizeT, clFrameR.data(ubCntT), 8);
+   }
+
+   //----------------------------------------------------------------
+   // Classic CAN: the CRC field is part of the stuffed bit stream
+   //
+   if(btFastDataT == false)
+   {
+      ulSizeT = AppendBits(aubBitT, ulSizeT, 
+                           CalcCrc15(&aubBitT[0], ulSizeT), 15);
+
+      if(ubStuffingV == eSTUFFING_WORST_CASE)
+      {
+         ulStuffT = (ulSizeT - 1) / 4;
+      }
+      else
+      {
+         ulStuffT = CountStuffBits(&aubBitT[0], ulSizeT, ulSizeT, ulSizeT,
+                                   ulStuffDataT);
+      }
+
+      ulDataBitsR = 0;
+      return(ulSizeT + ulStuffT + BUS_LOAD_FRAME_END);
+   }
+
+   //----------------------------------------------------------------
+   // CAN FD: the dynamic bit stuffing ends with the data field, 
+   // the stuff count and the CRC use fixed stuff bits
+   //
+   if(ubStuffingV == eSTUFFING_WORST_CASE)
+   {
+      ulStuffT     = (ulSizeT - 1) / 4;
+      ulStuffDataT = ulStuffT - ((ulSplitT - 1) / 4);
+   }
+   else
+   {
+      ulStuffT = CountStuffBits(&aubBitT[0], ulSizeT, ulSizeT - 1, ulSplitT,
+                                ulStuffDataT);
+   }
+
+   ulCrcSizeT = (ubDataSizeT > 16) ? 21 : 17;
+   ulFixedT   = 4 + ulCrcSizeT + ((4 + ulCrcSizeT + 3) / 4);
+
+   //----------------------------------------------------------------
+   // with bit-rate switch the bits from ESI to the end of the CRC
+   // are transmitted with the data bit-rate
+   //
+   if(clFrameR.bitrateSwitch())
+   {
+      ulDataBitsR = (ulSizeT - ulSplitT) + ulStuffDataT + ulFixedT;
+   }
+   else
+   {
+      ulDataBitsR = 0;
+   }
+
+   return(ulSizeT + ulStuffT + ulFixedT + BUS_LOAD_FRAME_END);
+}
+
+
+//----------------------------------------------------------------------------//
+// frameTime()                                                                //
+// calculate transmission time of a CAN frame                                 //
+//----------------------------------------------------------------------------//
+uint32_t QCanBusLoad::frameTime(const QCanFrame & clFrameR) const
+{
+   uint64_t    uqTimeT;
+   uint32_t    ulBitsT;
+   uint32_t    ulDataBitsT;
+
+   if(ulNomBitRateP == 0)
+   {
+      return(0);
+   }
+
+   ulBitsT = frameBits(clFrameR, ubStuffingP, ulDataBitsT);
+
+   uqTimeT = ((uint64_t) (ulBitsT - ulDataBitsT)) * BUS_LOAD_NSEC_PER_SEC;
+   uqTimeT = uqTimeT / ulNomBitRateP;
+   uqTimeT = uqTimeT + ((((uint64_t) ulDataBitsT) * BUS_LOAD_NSEC_PER_SEC) /
+                        ulDatBitRateP);
+
+   return((uint32_t) uqTimeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// load()                                                                     //
+// calculate bus load in percent and clear the busy time                      //
+//----------------------------------------------------------------------------//
+uint8_t QCanBusLoad::load(uint64_t & uqBusyTimeR, uint64_t uqTimeV)
+{
+   uint64_t    uqLoadT = 0;
+
+   if(uqTimeV > 0)
+   {
+      uqLoadT = (uqBusyTimeR * 100) / uqTimeV;
+      if(uqLoadT > 100)
+      {
+         uqLoadT = 100;
+      }
+   }
+   uqBusyTimeR = 0;
+
+   return((uint8_t) uqLoadT);
+}
+
+
+//----------------------------------------------------------------------------//
+// periodLoad()                                                               //
+// return bus load of the period                                              //
+//----------------------------------------------------------------------------//
+uint8_t QCanBusLoad::periodLoad(uint64_t uqPeriodV)
+{
+   return(this->load(uqBusyPeriodP, uqPeriodV));
+}
+
+
+//----------------------------------------------------------------------------//
+// reset()                                                                    //
+// clear window and period                                                    //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::reset(void)
+{
+   uqBusyWindowP = 0;
+   uqBusyPeriodP = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// setBitrate()                                                               //
+// set bit-rates for frame transmission time                                  //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV)
+{
+   ulNomBitRateP = bitrateValue(slNomBitRateV);
+   ulDatBitRateP = bitrateValue(slDatBitRateV);
+   if(ulDatBitRateP == 0)
+   {
+      ulDatBitRateP = ulNomBitRateP;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setStuffing()                                                              //
+// select calculation of stuff bits                                           //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::setStuffing(Stuffing_e ubStuffingV)
+{
+   ubStuffingP = ubStuffingV;
+}
+
+
+//----------------------------------------------------------------------------//
+// windowLoad()                                                               //
+// return bus load of the window                                              //
+//----------------------------------------------------------------------------//
+uint8_t QCanBusLoad::windowLoad(uint64_t uqWindowV)
+{
+   return(this->load(uqBusyWindowP, uqWindowV));
+}
+
@@ -0,0 +1,190 @@
+//============================================================================//
+// File:          qcan_bus_load.hpp                                           //
+// Description:   QCan classes - bus load calculation                         //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_BUS_LOAD_HPP_
+#define QCAN_BUS_LOAD_HPP_
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include "qcan_frame.hpp"
+
+//-------------------------------------------------------------------
+/*!
+** \file qcan_bus_load.hpp
+**
+*/
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanBusLoad
+** \brief   Bus load calculation
+**
+** The QCanBusLoad class calculates the bus load of a CAN network from
+** the exact bit length of each transmitted frame. The bit length covers
+** the arbitration, control, data and CRC fields, the bit stuffing,
+** the CRC delimiter, ACK field, end of frame and the intermission.
+** For CAN FD frames with bit-rate switch the data phase is timed with
+** the data bit-rate.
+** <p>
+** Each frame is added by addFrame(). The bus load is calculated for 
+** two independent time periods, a short window (windowLoad()) and 
+** a longer period (periodLoad()).
+*/
+class QCanBusLoad
+{
+public:
+
+   enum Stuffing_e {
+
+      /*! Use worst-case number of stuff bits                     */
+      eSTUFFING_WORST_CASE = 0,
+
+      /*! Count the stuff bits of the actual bit stream           */
+      eSTUFFING_ACTUAL
+   };
+
+   /*!
+   ** Construct a bus load calculation for a nominal bit-rate of 
+   ** 500 kBit/s.
+   */
+   QCanBusLoad();
+
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   **
+   ** Add the transmission time of the CAN frame \a clFrameR to the
+   ** window and to the period.
+   */
+   void     addFrame(const QCanFrame & clFrameR);
+
+   /*!
+   ** \param[in]  slBitrateV     Bit-rate value
+   ** \return     Bit-rate in bit/s
+   **
+   ** Convert the bit-rate \a slBitrateV to bit/s. The parameter may be 
+   ** a value of the enumeration CAN_Bitrate_e or a value in bit/s. The 
+   ** function returns 0 for #eCAN_BITRATE_NONE and #eCAN_BITRATE_AUTO.
+   */
+   static uint32_t bitrateValue(int32_t slBitrateV);
+
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  ubStuffingV    Calculation of stuff bits
+   ** \param[out] ulDataBitsR    Number of bits in data phase
+   ** \return     Number of bits
+   **
+   ** Returns the total number of bits of the CAN frame \a clFrameR 
+   ** including stuff bits and intermission. The parameter 
+   ** \a ulDataBitsR returns the number of bits transmitted with the 
+   ** data bit-rate, it is 0 if the bit-rate switch of a CAN FD frame
+   ** is not set.
+   */
+   static uint32_t frameBits(const QCanFrame & clFrameR, 
+                             Stuffing_e ubStuffingV, 
+                             uint32_t & ulDataBitsR);
+
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   ** \return     Transmission time in nanoseconds
+   **
+   ** Returns the transmission time of the CAN frame \a clFrameR for 
+   ** the configured bit-rates.
+   */
+   uint32_t frameTime(const QCanFrame & clFrameR) const;
+
+   /*!
+   ** \param[in]  uqPeriodV      Length of period in nanoseconds
+   ** \return     Bus load in percent
+   **
+   ** Returns the bus load of the period, which has the length 
+   ** \a uqPeriodV, and starts a new period.
+   */
+   uint8_t  periodLoad(uint64_t uqPeriodV);
+
+   /*!
+   ** Clear the window and period.
+   */
+   void     reset(void);
+
+   /*!
+   ** \param[in]  slNomBitRateV  Nominal bit-rate
+   ** \param[in]  slDatBitRateV  Data bit-rate
+   **
+   ** Set the bit-rates used for the frame transmission time, refer
+   ** to bitrateValue() for the value range. If the data bit-rate is 
+   ** not valid, the nominal bit-rate is used for the data phase.
+   */
+   void     setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV);
+
+   /*!
+   ** \param[in]  ubStuffingV    Calculation of stuff bits
+   **
+   ** Select the calculation of stuff bits, the default value is
+   ** #eSTUFFING_ACTUAL.
+   */
+   void     setStuffing(Stuffing_e ubStuffingV);
+
+   /*!
+   ** \return     Calculation of stuff bits
+   */
+   Stuffing_e stuffing(void) const  { return(ubStuffingP);   };
+
+   /*!
+   ** \param[in]  uqWindowV      Length of window in nanoseconds
+   ** \return     Bus load in percent
+   **
+   ** Returns the bus load of the window, which has the length 
+   ** \a uqWindowV, and starts a new window.
+   */
+   uint8_t  windowLoad(uint64_t uqWindowV);
+
+private:
+
+   uint8_t     load(uint64_t & uqBusyTimeR, uint64_t uqTimeV);
+
+   uint32_t    ulNomBitRateP;
+   uint32_t    ulDatBitRateP;
+   Stuffing_e  ubStuffingP;
+
+   //----------------------------------------------------------------
+   // accumulated transmission time in nanoseconds
+   //
+   uint64_t    uqBusyWindowP;
+   uint64_t    uqBusyPeriodP;
+};
+
+#endif   // QCAN_BUS_LOAD_HPP_ 
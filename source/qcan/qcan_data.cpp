@@ -32,6 +32,8 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#include <string.h>
+
 #include "qcan_data.hpp"
 
 
@@ -45,6 +47,172 @@
 
 #define  QCAN_FRAME_TYPE_ERR         ((uint32_t) 0x80000000)
 
+//-------------------------------------------------------------------
+// Bit 29 of the identifier field marks a frame in compact encoding,
+// it is never set inside a QCanData object
+//
+#define  QCAN_FRAME_COMPACT          ((uint32_t) 0x20000000)
+
+//-------------------------------------------------------------------
+// Bit values for byte 7 of compact encoding, defining the
+// optional fields which are present
+//
+#define  QCAN_COMPACT_FIELD_TIME     ((uint8_t) 0x01)
+#define  QCAN_COMPACT_FIELD_USER     ((uint8_t) 0x02)
+#define  QCAN_COMPACT_FIELD_MARKER   ((uint8_t) 0x04)
+
+//-------------------------------------------------------------------
+// Bit value for byte 7 of compact encoding, the frame has no
+// checksum at the end
+//
+#define  QCAN_COMPACT_NO_CHECKSUM    ((uint8_t) 0x80)
+
+//-------------------------------------------------------------------
+// Byte 86 of fixed encoding holds format flags, the value
+// QCAN_FIXED_NO_CHECKSUM marks a frame without a valid checksum
+// in byte 94 .. 95
+//
+#define  QCAN_FIXED_FLAGS_POS        86
+#define  QCAN_FIXED_NO_CHECKSUM      ((uint8_t) 0x01)
+
+
+/*----------------------------------------------------------------------------*\
+** Static variables                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// conversion of DLC to number of payload bytes
+//
+static const uint8_t aubDlcSizeS[16] = {  0,  1,  2,  3,  4,  5,  6,  7,
+                                          8, 12, 16, 20, 24, 32, 48, 64 };
+
+//-------------------------------------------------------------------
+// CRC-16 table (polynomial 0x1021, reflected), one entry for each
+// value of a byte, refer to QCanData::checksum()
+//
+static const uint16_t auwCrcTableS[256] = {
+   0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+   0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+   0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+   0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+   0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+   0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+   0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+   0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+   0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+   0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+   0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+   0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+   0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+   0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+   0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+   0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+   0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+   0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+   0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+   0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+   0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+   0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+   0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+   0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+   0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+   0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+   0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+   0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+   0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+   0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+   0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+   0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78
+};
+
+//-------------------------------------------------------------------
+// two upper case hexadecimal digits for each value of a byte,
+// used by formatHex() and formatHexByte()
+//
+static const char achHexTableS[513] =
+         "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+         "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+         "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+         "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+         "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+         "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+         "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+         "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+//-------------------------------------------------------------------
+// two decimal digits for each value from 0 to 99, used by
+// formatDecimal()
+//
+static const char achDecTableS[201] =
+         "0001020304050607080910111213141516171819"
+         "2021222324252627282930313233343536373839"
+         "4041424344454647484950515253545556575859"
+         "6061626364656667686970717273747576777879"
+         "8081828384858687888990919293949596979899";
+
+//-------------------------------------------------------------------
+// powers of 10 for counting the digits of a 32-bit value
+//
+static const uint32_t aulPow10S[10] = { 1, 10, 100, 1000, 10000, 100000,
+                                        1000000, 10000000, 100000000,
+                                        1000000000 };
+
+
+
+/*----------------------------------------------------------------------------*\
+** Static functions                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// getUInt16()                                                                //
+// read uint16_t value from byte array, MSB first                             //
+//----------------------------------------------------------------------------//
+static inline uint16_t getUInt16(const char * pchDataV)
+{
+   return((uint16_t) (  ((uint16_t) ((uint8_t) pchDataV[0]) << 8) |
+                        ((uint16_t) ((uint8_t) pchDataV[1]) << 0)   ));
+}
+
+
+//----------------------------------------------------------------------------//
+// getUInt32()                                                                //
+// read uint32_t value from byte array, MSB first                             //
+//----------------------------------------------------------------------------//
+static inline uint32_t getUInt32(const char * pchDataV)
+{
+   return(  ((uint32_t) ((uint8_t) pchDataV[0]) << 24) |
+            ((uint32_t) ((uint8_t) pchDataV[1]) << 16) |
+            ((uint32_t) ((uint8_t) pchDataV[2]) <<  8) |
+            ((uint32_t) ((uint8_t) pchDataV[3]) <<  0)   );
+}
+
+
+//----------------------------------------------------------------------------//
+// setUInt16()                                                                //
+// write uint16_t value to byte array, MSB first                              //
+//----------------------------------------------------------------------------//
+static inline void setUInt16(char * pchDataV, uint16_t uwValueV)
+{
+   pchDataV[0] = (char) (uwValueV >> 8);
+   pchDataV[1] = (char) (uwValueV >> 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// setUInt32()                                                                //
+// write uint32_t value to byte array, MSB first                              //
+//----------------------------------------------------------------------------//
+static inline void setUInt32(char * pchDataV, uint32_t ulValueV)
+{
+   pchDataV[0] = (char) (ulValueV >> 24);
+   pchDataV[1] = (char) (ulValueV >> 16);
+   pchDataV[2] = (char) (ulValueV >>  8);
+   pchDataV[3] = (char) (ulValueV >>  0);
+}
+
+
 /*----------------------------------------------------------------------------*\
 ** Class methods                                                              **
 **                                                                            **
@@ -75,6 +243,97 @@ QCanData::QCanData(const Type_e & ubTypeR)
          ulIdentifierP = (uint32_t) (~0);
    }
 
+   //----------------------------------------------------------------
+   // clear all other fields, unused payload bytes must be 0 for
+   // the compact encoding
+   //
+   ubMsgDlcP    = 0;
+   ubMsgCtrlP   = 0;
+   ulMsgUserP   = 0;
+   ulMsgMarkerP = 0;
+   memset(&aubByteP[0], 0, QCAN_MSG_DATA_MAX);
+}
+
+
+//----------------------------------------------------------------------------//
+// byteArraySize()                                                            //
+// size of frame at the begin of the byte array                               //
+//----------------------------------------------------------------------------//
+int32_t QCanData::byteArraySize(const QByteArray & clByteArrayR)
+{
+   return(byteArraySize(clByteArrayR.constData(), clByteArrayR.size()));
+}
+
+
+//----------------------------------------------------------------------------//
+// byteArraySize()                                                            //
+// size of frame at the begin of the buffer                                   //
+//----------------------------------------------------------------------------//
+int32_t QCanData::byteArraySize(const char * pchDataV, int32_t slSizeV)
+{
+   int32_t  slFrameSizeT = 0;
+   uint8_t  ubFieldsT;
+
+   if(slSizeV > 0)
+   {
+      if(pchDataV[0] & (char) (QCAN_FRAME_COMPACT >> 24))
+      {
+         if(slSizeV >= QCAN_FRAME_COMPACT_HEADER)
+         {
+            //--------------------------------------------------
+            // header, payload and checksum
+            //
+            ubFieldsT    = (uint8_t) pchDataV[7];
+            slFrameSizeT = QCAN_FRAME_COMPACT_HEADER + 2;
+            if(ubFieldsT & QCAN_COMPACT_NO_CHECKSUM)
+            {
+               slFrameSizeT = QCAN_FRAME_COMPACT_HEADER;
+            }
+            slFrameSizeT = slFrameSizeT + (uint8_t) pchDataV[6];
+
+            //--------------------------------------------------
+            // optional fields
+            //
+            if(ubFieldsT & QCAN_COMPACT_FIELD_TIME)
+            {
+               slFrameSizeT = slFrameSizeT + 8;
+            }
+            if(ubFieldsT & QCAN_COMPACT_FIELD_USER)
+            {
+               slFrameSizeT = slFrameSizeT + 4;
+            }
+            if(ubFieldsT & QCAN_COMPACT_FIELD_MARKER)
+            {
+               slFrameSizeT = slFrameSizeT + 4;
+            }
+         }
+      }
+      else
+      {
+         slFrameSizeT = QCAN_FRAME_ARRAY_SIZE;
+      }
+   }
+
+   return(slFrameSizeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// checksum()                                                                 //
+// CRC-16 of buffer, one table lookup for each byte                           //
+//----------------------------------------------------------------------------//
+uint16_t QCanData::checksum(const char * pchDataV, int32_t slSizeV)
+{
+   uint16_t  uwCrcT = 0xFFFF;
+
+   while(slSizeV > 0)
+   {
+      uwCrcT = (uwCrcT >> 8) ^ auwCrcTableS[(uwCrcT ^ (uint8_t) *pchDataV) & 0xFF];
+      pchDataV++;
+      slSizeV--;
+   }
+
+   return((uint16_t) ~uwCrcT);
 }
 
 
@@ -156,6 +415,122 @@ uint32_t QCanData::dataUInt32(const uint8_t & ubPosR,
 }
 
 
+//----------------------------------------------------------------------------//
+// formatDecimal()                                                            //
+// write decimal value to buffer                                              //
+//----------------------------------------------------------------------------//
+char * QCanData::formatDecimal(char * pchBufferV, uint32_t ulValueV,
+                               uint8_t ubWidthV, char chFillV)
+{
+   uint8_t  ubDigitsT = 1;
+   char *   pchDigitT;
+
+   while((ubDigitsT < 10) && (ulValueV >= aulPow10S[ubDigitsT]))
+   {
+      ubDigitsT++;
+   }
+
+   while(ubWidthV > ubDigitsT)
+   {
+      *pchBufferV++ = chFillV;
+      ubWidthV--;
+   }
+
+   //----------------------------------------------------------------
+   // the digits are written from right to left, two digits at once
+   //
+   pchBufferV += ubDigitsT;
+   pchDigitT   = pchBufferV;
+   while(ulValueV >= 100)
+   {
+      pchDigitT -= 2;
+      memcpy(pchDigitT, &achDecTableS[(ulValueV % 100) * 2], 2);
+      ulValueV = ulValueV / 100;
+   }
+
+   if(ulValueV >= 10)
+   {
+      pchDigitT -= 2;
+      memcpy(pchDigitT, &achDecTableS[ulValueV * 2], 2);
+   }
+   else
+   {
+      *(--pchDigitT) = (char) ('0' + ulValueV);
+   }
+
+   return(pchBufferV);
+}
+
+
+//----------------------------------------------------------------------------//
+// formatHex()                                                                //
+// write hexadecimal value to buffer                                          //
+//----------------------------------------------------------------------------//
+char * QCanData::formatHex(char * pchBufferV, uint32_t ulValueV,
+                           uint8_t ubWidthV, char chFillV)
+{
+   uint8_t  ubDigitsT = 1;
+   char *   pchDigitT;
+
+   while((ubDigitsT < 8) && ((ulValueV >> (ubDigitsT * 4)) != 0))
+   {
+      ubDigitsT++;
+   }
+
+   while(ubWidthV > ubDigitsT)
+   {
+      *pchBufferV++ = chFillV;
+      ubWidthV--;
+   }
+
+   //----------------------------------------------------------------
+   // the digits are written from right to left, one byte at once
+   //
+   pchBufferV += ubDigitsT;
+   pchDigitT   = pchBufferV;
+   while(ubDigitsT >= 2)
+   {
+      pchDigitT -= 2;
+      memcpy(pchDigitT, &achHexTableS[(ulValueV & 0xFF) * 2], 2);
+      ulValueV  = ulValueV >> 8;
+      ubDigitsT = ubDigitsT - 2;
+   }
+
+   if(ubDigitsT > 0)
+   {
+      *(--pchDigitT) = achHexTableS[((ulValueV & 0x0F) * 2) + 1];
+   }
+
+   return(pchBufferV);
+}
+
+
+//----------------------------------------------------------------------------//
+// formatHexByte()                                                            //
+// write byte value as two hexadecimal digits to buffer                       //
+//----------------------------------------------------------------------------//
+char * QCanData::formatHexByte(char * pchBufferV, uint8_t ubValueV)
+{
+   memcpy(pchBufferV, &achHexTableS[ubValueV * 2], 2);
+
+   return(pchBufferV + 2);
+}
+
+
+//----------------------------------------------------------------------------//
+// formatText()                                                               //
+// copy text to buffer                                                        //
+//----------------------------------------------------------------------------//
+char * QCanData::formatText(char * pchBufferV, const char * szTextV)
+{
+   size_t   szLengthT = strlen(szTextV);
+
+   memcpy(pchBufferV, szTextV, szLengthT);
+
+   return(pchBufferV + szLengthT);
+}
+
+
 QCanData::Type_e  QCanData::frameType(void) const
 {
    if(ulIdentifierP & QCAN_FRAME_TYPE_API)
@@ -176,117 +551,181 @@ QCanData::Type_e  QCanData::frameType(void) const
 // convert byte array to QCanData object                                       //
 //----------------------------------------------------------------------------//
 bool QCanData::fromByteArray(const QByteArray & clByteArrayR)
+{
+   return(fromByteArray(clByteArrayR.constData(), clByteArrayR.size()));
+}
+
+
+//----------------------------------------------------------------------------//
+// fromByteArray()                                                            //
+// convert buffer to QCanData object                                          //
+//----------------------------------------------------------------------------//
+bool QCanData::fromByteArray(const char * pchDataV, int32_t slSizeV)
 {
    //----------------------------------------------------------------
-   // test size of byte array
+   // the compact encoding is marked in the first byte
    //
-   if(clByteArrayR.size() < QCAN_FRAME_ARRAY_SIZE)
+   if((slSizeV > 0) && (pchDataV[0] & (char) (QCAN_FRAME_COMPACT >> 24)))
    {
-      return(false);
+      return(fromByteArrayCompact(pchDataV, slSizeV));
    }
-   
-   
+
    //----------------------------------------------------------------
-   // build checksum from byte 0 .. 93, and compare with checksum
-   // value at the end
+   // test size of buffer
    //
-   uint16_t uwChecksumT = clByteArrayR[94];
-   uwChecksumT = uwChecksumT << 8;
-   uwChecksumT = uwChecksumT + (uint8_t) clByteArrayR[95];
-   
-   if(uwChecksumT != qChecksum(clByteArrayR.constData(), 
-                               QCAN_FRAME_ARRAY_SIZE - 2))
+   if(slSizeV < QCAN_FRAME_ARRAY_SIZE)
    {
       return(false);
    }
-   
-   //----------------------------------------------------------------
-   // structure seems to be valid, now start copying the contents,
-   // start with the identifier value
-   //----------------------------------------------------------------
 
-   
    //----------------------------------------------------------------
-   // set identifier field from byte 0 .. 3, MSB first
+   // build checksum from byte 0 .. 93, and compare with checksum
+   // value at the end, the test is skipped if the sender did not
+   // build a checksum
    //
-   ulIdentifierP = clByteArrayR[0];
-   ulIdentifierP = ulIdentifierP << 8;
-   ulIdentifierP = ulIdentifierP + (uint8_t) clByteArrayR[1];
-   ulIdentifierP = ulIdentifierP << 8;
-   ulIdentifierP = ulIdentifierP + (uint8_t) clByteArrayR[2];
-   ulIdentifierP = ulIdentifierP << 8;
-   ulIdentifierP = ulIdentifierP + (uint8_t) clByteArrayR[3];
-
- 
+   if((pchDataV[QCAN_FIXED_FLAGS_POS] & QCAN_FIXED_NO_CHECKSUM) == 0)
+   {
+      if(getUInt16(&pchDataV[94]) != checksum(pchDataV,
+                                              QCAN_FRAME_ARRAY_SIZE - 2))
+      {
+         return(false);
+      }
+   }
+
    //----------------------------------------------------------------
-   // set DLC field from byte 4
+   // structure seems to be valid, now start copying the contents:
+   // byte 0 .. 3   : identifier field, MSB first
+   // byte 4        : DLC field
+   // byte 5        : message control field
+   // byte 6 .. 69  : message data field
+   // byte 70 .. 77 : time stamp field, MSB first
+   // byte 78 .. 81 : user field, MSB first
+   // byte 82 .. 85 : marker field, MSB first
    //
-   ubMsgDlcP = clByteArrayR[4];
+   ulIdentifierP = getUInt32(&pchDataV[0]);
+   ubMsgDlcP     = (uint8_t) pchDataV[4];
+   ubMsgCtrlP    = (uint8_t) pchDataV[5];
+
+   memcpy(&aubByteP[0], &pchDataV[6], QCAN_MSG_DATA_MAX);
+
+   clMsgTimeP.setSeconds(getUInt32(&pchDataV[70]));
+   clMsgTimeP.setNanoSeconds(getUInt32(&pchDataV[74]));
+
+   ulMsgUserP    = getUInt32(&pchDataV[78]);
+   ulMsgMarkerP  = getUInt32(&pchDataV[82]);
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// fromByteArrayCompact()                                                     //
+// convert buffer in compact encoding to QCanData object                      //
+//----------------------------------------------------------------------------//
+bool QCanData::fromByteArrayCompact(const char * pchDataV, int32_t slSizeV)
+{
+   int32_t        slFrameSizeT;
+   uint8_t        ubDataSizeT;
+   uint8_t        ubFieldsT;
+   const char *   pchFieldT;
 
    //----------------------------------------------------------------
-   // set message control field from byte 5
+   // test size of buffer
    //
-   ubMsgCtrlP = clByteArrayR[5];
-   
+   slFrameSizeT = byteArraySize(pchDataV, slSizeV);
+   if((slFrameSizeT == 0) || (slSizeV < slFrameSizeT))
+   {
+      return(false);
+   }
+
+   ubDataSizeT = (uint8_t) pchDataV[6];
+   if(ubDataSizeT > QCAN_MSG_DATA_MAX)
+   {
+      return(false);
+   }
+
    //----------------------------------------------------------------
-   // set message data field from byte 6 .. 69
+   // build checksum from all bytes except the last two and compare
+   // with checksum value at the end, the test is skipped if the
+   // sender did not build a checksum
    //
-   for(uint8_t ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
+   if(((uint8_t) pchDataV[7] & QCAN_COMPACT_NO_CHECKSUM) == 0)
    {
-      aubByteP[ubPosT] = clByteArrayR[6 + ubPosT];
-   }   
+      if(getUInt16(&pchDataV[slFrameSizeT - 2]) != checksum(pchDataV,
+                                                         slFrameSizeT - 2))
+      {
+         return(false);
+      }
+   }
 
    //----------------------------------------------------------------
-   // set message timestamp field from byte 70 .. 77, MSB first
+   // identifier, DLC and message control field
    //
-   uint32_t  ulTimeValT = 0;
-
-   ulTimeValT  = clByteArrayR[70];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[71];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[72];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[73];
-   clMsgTimeP.setSeconds(ulTimeValT);
-   
-   ulTimeValT  = 0;
-   ulTimeValT  = clByteArrayR[74];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[75];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[76];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[77];
-   clMsgTimeP.setNanoSeconds(ulTimeValT);
-   
+   ulIdentifierP = getUInt32(pchDataV) & (~QCAN_FRAME_COMPACT);
+   ubMsgDlcP     = (uint8_t) pchDataV[4];
+   ubMsgCtrlP    = (uint8_t) pchDataV[5];
+   ubFieldsT     = (uint8_t) pchDataV[7];
+   pchFieldT     = pchDataV + QCAN_FRAME_COMPACT_HEADER;
+
    //----------------------------------------------------------------
-   // set message user field from byte 78 .. 81, MSB first
+   // optional fields, a field which is not present is set to 0
    //
-   ulMsgUserP  = clByteArrayR[78];
-   ulMsgUserP  = ulMsgUserP << 8;
-   ulMsgUserP += (uint8_t) clByteArrayR[79];
-   ulMsgUserP  = ulMsgUserP << 8;
-   ulMsgUserP += (uint8_t) clByteArrayR[80];
-   ulMsgUserP  = ulMsgUserP << 8;
-   ulMsgUserP += (uint8_t) clByteArrayR[81];
-      
+   if(ubFieldsT & QCAN_COMPACT_FIELD_TIME)
+   {
+      clMsgTimeP.setSeconds(getUInt32(pchFieldT));
+      clMsgTimeP.setNanoSeconds(getUInt32(pchFieldT + 4));
+      pchFieldT = pchFieldT + 8;
+   }
+   else
+   {
+      clMsgTimeP.setSeconds(0);
+      clMsgTimeP.setNanoSeconds(0);
+   }
+
+   ulMsgUserP = 0;
+   if(ubFieldsT & QCAN_COMPACT_FIELD_USER)
+   {
+      ulMsgUserP = getUInt32(pchFieldT);
+      pchFieldT = pchFieldT + 4;
+   }
+
+   ulMsgMarkerP = 0;
+   if(ubFieldsT & QCAN_COMPACT_FIELD_MARKER)
+   {
+      ulMsgMarkerP = getUInt32(pchFieldT);
+      pchFieldT = pchFieldT + 4;
+   }
+
    //----------------------------------------------------------------
-   // set message marker field from byte 82 .. 85, MSB first
+   // payload, the bytes which are not transmitted are 0
    //
-   ulMsgMarkerP  = clByteArrayR[82];
-   ulMsgMarkerP  = ulMsgMarkerP << 8;
-   ulMsgMarkerP += (uint8_t) clByteArrayR[83];
-   ulMsgMarkerP  = ulMsgMarkerP << 8;
-   ulMsgMarkerP += (uint8_t) clByteArrayR[84];
-   ulMsgMarkerP  = ulMsgMarkerP << 8;
-   ulMsgMarkerP += (uint8_t) clByteArrayR[85];
-   
-   
+   memcpy(&aubByteP[0], pchFieldT, ubDataSizeT);
+   memset(&aubByteP[ubDataSizeT], 0, QCAN_MSG_DATA_MAX - ubDataSizeT);
+
    return(true);
 }
 
 
+//----------------------------------------------------------------------------//
+// isCompactArray()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanData::isCompactArray(const QByteArray & clByteArrayR)
+{
+   bool  btResultT = false;
+
+   if(clByteArrayR.size() > 0)
+   {
+      if(clByteArrayR.at(0) & (char) (QCAN_FRAME_COMPACT >> 24))
+      {
+         btResultT = true;
+      }
+   }
+
+   return(btResultT);
+}
+
+
 //----------------------------------------------------------------------------//
 // setDataUInt16()                                                            //
 // set data value                                                             //
@@ -359,84 +798,221 @@ void QCanData::setDataUInt32(const uint8_t & ubPosR,
 QByteArray QCanData::toByteArray() const
 {
    //----------------------------------------------------------------
-   // setup a defined length and clear contents
+   // setup a defined length, the contents is written completely
    //
-   QByteArray clByteArrayT(QCAN_FRAME_ARRAY_SIZE, 0x00);
-   
-  
+   QByteArray clByteArrayT(QCAN_FRAME_ARRAY_SIZE, Qt::Uninitialized);
+
+   toByteArray(clByteArrayT.data(), QCAN_FRAME_ARRAY_SIZE);
+
+   return(clByteArrayT);
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArray()                                                              //
+// write frame to buffer                                                      //
+//----------------------------------------------------------------------------//
+int32_t QCanData::toByteArray(char * pchDataV, int32_t slSizeV,
+                              bool btChecksumV) const
+{
    //----------------------------------------------------------------
-   // place identifier field in byte 0 .. 3, MSB first
+   // test size of buffer
    //
-   clByteArrayT[0] = (uint8_t) (ulIdentifierP >> 24);
-   clByteArrayT[1] = (uint8_t) (ulIdentifierP >> 16);
-   clByteArrayT[2] = (uint8_t) (ulIdentifierP >>  8);
-   clByteArrayT[3] = (uint8_t) (ulIdentifierP >>  0);
-   
+   if(slSizeV < QCAN_FRAME_ARRAY_SIZE)
+   {
+      return(0);
+   }
+
    //----------------------------------------------------------------
-   // place message DLC field in byte 4
+   // byte 0 .. 3   : identifier field, MSB first
+   // byte 4        : DLC field
+   // byte 5        : message control field
+   // byte 6 .. 69  : message data field
    //
-   clByteArrayT[4] = ubMsgDlcP;
+   setUInt32(&pchDataV[0], ulIdentifierP);
+   pchDataV[4] = (char) ubMsgDlcP;
+   pchDataV[5] = (char) ubMsgCtrlP;
+   memcpy(&pchDataV[6], &aubByteP[0], QCAN_MSG_DATA_MAX);
 
    //----------------------------------------------------------------
-   // place message control field in byte 5
+   // byte 70 .. 77 : time stamp field, MSB first
+   // byte 78 .. 81 : user field, MSB first
+   // byte 82 .. 85 : marker field, MSB first
    //
-   clByteArrayT[5] = ubMsgCtrlP;
+   setUInt32(&pchDataV[70], clMsgTimeP.seconds());
+   setUInt32(&pchDataV[74], clMsgTimeP.nanoSeconds());
+   setUInt32(&pchDataV[78], ulMsgUserP);
+   setUInt32(&pchDataV[82], ulMsgMarkerP);
 
    //----------------------------------------------------------------
-   // place message data field in byte 6 .. 69
+   // byte 86       : format flags
+   // byte 87 .. 93 (i.e. 7 bytes) are not used, set to 0
+   //
+   memset(&pchDataV[86], 0, 8);
+
+   //----------------------------------------------------------------
+   // build checksum from byte 0 .. 93, add checksum at the end
    //
-   for(uint8_t ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
+   if(btChecksumV == true)
    {
-      clByteArrayT[6 + ubPosT] = aubByteP[ubPosT];
+      setUInt16(&pchDataV[94], checksum(pchDataV, QCAN_FRAME_ARRAY_SIZE - 2));
    }
+   else
+   {
+      pchDataV[QCAN_FIXED_FLAGS_POS] = (char) QCAN_FIXED_NO_CHECKSUM;
+      setUInt16(&pchDataV[94], 0);
+   }
+
+   return(QCAN_FRAME_ARRAY_SIZE);
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanData::toByteArrayCompact() const
+{
+   char     achDataT[QCAN_FRAME_COMPACT_MAX];
+   int32_t  slSizeT;
+
+   slSizeT = toByteArrayCompact(&achDataT[0], QCAN_FRAME_COMPACT_MAX);
+
+   return(QByteArray(&achDataT[0], slSizeT));
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+// write frame in compact encoding to buffer                                  //
+//----------------------------------------------------------------------------//
+int32_t QCanData::toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                     bool btChecksumV) const
+{
+   uint8_t  ubDataSizeT;
+   uint8_t  ubFieldsT;
+   int32_t  slFrameSizeT;
+   char *   pchFieldT;
 
    //----------------------------------------------------------------
-   // place message timestamp field in byte 70 .. 77, MSB first
+   // number of payload bytes: a CAN frame transmits only the bytes
+   // defined by the DLC, trailing bytes with value 0 are not
+   // transmitted at all
    //
-   uint32_t  ulTimeValT = 0;
-
-   ulTimeValT = clMsgTimeP.seconds();
-   clByteArrayT[70] = (uint8_t) (ulTimeValT >> 24);
-   clByteArrayT[71] = (uint8_t) (ulTimeValT >> 16);
-   clByteArrayT[72] = (uint8_t) (ulTimeValT >>  8);
-   clByteArrayT[73] = (uint8_t) (ulTimeValT >>  0);
-
-   ulTimeValT = clMsgTimeP.nanoSeconds();
-   clByteArrayT[74] = (uint8_t) (ulTimeValT >>  24);
-   clByteArrayT[75] = (uint8_t) (ulTimeValT >>  16);
-   clByteArrayT[76] = (uint8_t) (ulTimeValT >>   8);
-   clByteArrayT[77] = (uint8_t) (ulTimeValT >>   0);
-   
+   ubDataSizeT = QCAN_MSG_DATA_MAX;
+   if(frameType() == eTYPE_CAN)
+   {
+      ubDataSizeT = aubDlcSizeS[ubMsgDlcP & 0x0F];
+
+      //--------------------------------------------------------
+      // classic CAN frame (FDF bit not set)
+      //
+      if(((ubMsgCtrlP & 0x02) == 0) && (ubDataSizeT > 8))
+      {
+         ubDataSizeT = 8;
+      }
+   }
+
+   while((ubDataSizeT > 0) && (aubByteP[ubDataSizeT - 1] == 0))
+   {
+      ubDataSizeT--;
+   }
+
    //----------------------------------------------------------------
-   // place message user field in byte 78 .. 81, MSB first
+   // optional fields and total size
    //
-   clByteArrayT[78] = (uint8_t) (ulMsgUserP >>  24);
-   clByteArrayT[79] = (uint8_t) (ulMsgUserP >>  16);
-   clByteArrayT[80] = (uint8_t) (ulMsgUserP >>   8);
-   clByteArrayT[81] = (uint8_t) (ulMsgUserP >>   0);
+   ubFieldsT    = 0;
+   slFrameSizeT = QCAN_FRAME_COMPACT_HEADER + ubDataSizeT + 2;
+   if(btChecksumV == false)
+   {
+      ubFieldsT    |= QCAN_COMPACT_NO_CHECKSUM;
+      slFrameSizeT -= 2;
+   }
+   if((clMsgTimeP.seconds() != 0) || (clMsgTimeP.nanoSeconds() != 0))
+   {
+      ubFieldsT    |= QCAN_COMPACT_FIELD_TIME;
+      slFrameSizeT += 8;
+   }
+   if(ulMsgUserP != 0)
+   {
+      ubFieldsT    |= QCAN_COMPACT_FIELD_USER;
+      slFrameSizeT += 4;
+   }
+   if(ulMsgMarkerP != 0)
+   {
+      ubFieldsT    |= QCAN_COMPACT_FIELD_MARKER;
+      slFrameSizeT += 4;
+   }
 
    //----------------------------------------------------------------
-   // place message marker field in byte 82 .. 85, MSB first
+   // test size of buffer
    //
-   clByteArrayT[82] = (uint8_t) (ulMsgMarkerP >>  24);
-   clByteArrayT[83] = (uint8_t) (ulMsgMarkerP >>  16);
-   clByteArrayT[84] = (uint8_t) (ulMsgMarkerP >>   8);
-   clByteArrayT[85] = (uint8_t) (ulMsgMarkerP >>   0);
-   
+   if(slSizeV < slFrameSizeT)
+   {
+      return(0);
+   }
+
    //----------------------------------------------------------------
-   // byte 86 .. 93 (i.e. 8 bytes) are not used, set to 0
+   // header
+   //
+   setUInt32(pchDataV, ulIdentifierP | QCAN_FRAME_COMPACT);
+   pchDataV[4] = (char) ubMsgDlcP;
+   pchDataV[5] = (char) ubMsgCtrlP;
+   pchDataV[6] = (char) ubDataSizeT;
+   pchDataV[7] = (char) ubFieldsT;
+   pchFieldT   = pchDataV + QCAN_FRAME_COMPACT_HEADER;
+
+   //----------------------------------------------------------------
+   // optional fields
+   //
+   if(ubFieldsT & QCAN_COMPACT_FIELD_TIME)
+   {
+      setUInt32(pchFieldT,     clMsgTimeP.seconds());
+      setUInt32(pchFieldT + 4, clMsgTimeP.nanoSeconds());
+      pchFieldT = pchFieldT + 8;
+   }
+   if(ubFieldsT & QCAN_COMPACT_FIELD_USER)
+   {
+      setUInt32(pchFieldT, ulMsgUserP);
+      pchFieldT = pchFieldT + 4;
+   }
+   if(ubFieldsT & QCAN_COMPACT_FIELD_MARKER)
+   {
+      setUInt32(pchFieldT, ulMsgMarkerP);
+      pchFieldT = pchFieldT + 4;
+   }
+
    //----------------------------------------------------------------
-   
+   // payload
+   //
+   memcpy(pchFieldT, &aubByteP[0], ubDataSizeT);
+
    //----------------------------------------------------------------
-   // build checksum from byte 0 .. 93, add checksum at the end
-   // 
-   uint16_t uwChecksumT = qChecksum(clByteArrayT.constData(), 
-                                    QCAN_FRAME_ARRAY_SIZE - 2);
-   
-   clByteArrayT[94] = (uint8_t) (uwChecksumT >> 8);
-   clByteArrayT[95] = (uint8_t) (uwChecksumT >> 0);
+   // build checksum from all bytes except the last two
+   //
+   if(btChecksumV == true)
+   {
+      setUInt16(&pchDataV[slFrameSizeT - 2],
+                checksum(pchDataV, slFrameSizeT - 2));
+   }
 
-   return(clByteArrayT);
+   return(slFrameSizeT);
 }
 
 
+//----------------------------------------------------------------------------//
+// toString()                                                                 //
+// the base class has no text representation                                  //
+//----------------------------------------------------------------------------//
+int32_t QCanData::toString(char * pchBufferV, int32_t slSizeV,
+                           bool btShowTimeV) const
+{
+   Q_UNUSED(btShowTimeV);
+
+   if((pchBufferV != Q_NULLPTR) && (slSizeV > 0))
+   {
+      *pchBufferV = 0;
+   }
+
+   return(0);
+}
@@ -68,6 +68,38 @@
 #define  QCAN_FRAME_ARRAY_SIZE       96
 
 
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_FRAME_COMPACT_HEADER
+**
+** The symbol QCAN_FRAME_COMPACT_HEADER defines the number of bytes
+** which are required to calculate the size of a frame in compact
+** encoding, refer to QCanData::toByteArrayCompact().
+*/
+#define  QCAN_FRAME_COMPACT_HEADER   8
+
+
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_FRAME_COMPACT_MAX
+**
+** The symbol QCAN_FRAME_COMPACT_MAX defines the maximum size of
+** a frame in compact encoding.
+*/
+#define  QCAN_FRAME_COMPACT_MAX      (QCAN_FRAME_COMPACT_HEADER + 16 + \
+                                      QCAN_MSG_DATA_MAX + 2)
+
+
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_FRAME_STRING_SIZE
+**
+** The symbol QCAN_FRAME_STRING_SIZE defines the size of a buffer
+** which holds the text of any frame, refer to QCanData::toString().
+*/
+#define  QCAN_FRAME_STRING_SIZE      320
+
+
 //-----------------------------------------------------------------------------
 /*!
 ** \class   QCanData
@@ -135,9 +167,123 @@ public:
 
 
    Type_e      frameType(void) const;
-   
+
+   /*!
+   ** \param[in]  clByteArrayR   Byte array holding a frame
+   ** \return     \c true if frame is converted
+   ** \see        toByteArray(), toByteArrayCompact()
+   **
+   ** The function converts the byte array \a clByteArrayR to a QCanData
+   ** object. Both the fixed encoding (QCAN_FRAME_ARRAY_SIZE bytes) and
+   ** the compact encoding are accepted. The function returns \c false
+   ** if the byte array is too short or the checksum is wrong.
+   */
    virtual bool       fromByteArray(const QByteArray & clByteArrayR);
 
+   /*!
+   ** \param[in]  pchDataV       Pointer to buffer holding a frame
+   ** \param[in]  slSizeV        Number of bytes in buffer
+   ** \return     \c true if frame is converted
+   ** \see        toByteArray()
+   **
+   ** This is an overloaded function, which reads the frame from a
+   ** buffer provided by the caller. No memory is allocated.
+   */
+   bool               fromByteArray(const char * pchDataV, int32_t slSizeV);
+
+   /*!
+   ** \param[in]  clByteArrayR   Byte array holding the begin of a frame
+   ** \return     Size of frame in bytes
+   **
+   ** The function returns the size of the frame in bytes, which starts
+   ** at the first byte of \a clByteArrayR. For a frame in compact
+   ** encoding at least QCAN_FRAME_COMPACT_HEADER bytes are required to
+   ** determine the size, otherwise the function returns 0.
+   ** The function is used to split a stream of frames.
+   */
+   static int32_t     byteArraySize(const QByteArray & clByteArrayR);
+
+   /*!
+   ** \param[in]  pchDataV       Pointer to buffer holding the begin of a frame
+   ** \param[in]  slSizeV        Number of bytes in buffer
+   ** \return     Size of frame in bytes
+   **
+   ** This is an overloaded function, using a buffer provided by
+   ** the caller.
+   */
+   static int32_t     byteArraySize(const char * pchDataV, int32_t slSizeV);
+
+   /*!
+   ** \param[in]  pchDataV       Pointer to buffer
+   ** \param[in]  slSizeV        Number of bytes in buffer
+   ** \return     CRC-16 of buffer
+   **
+   ** The function calculates the checksum which is used by the
+   ** fixed and the compact encoding. The result is identical to
+   ** qChecksum(), the calculation uses a table with one entry for
+   ** each value of a byte.
+   */
+   static uint16_t    checksum(const char * pchDataV, int32_t slSizeV);
+
+   /*!
+   ** \param[out] pchBufferV     Pointer to buffer
+   ** \param[in]  ulValueV       Value
+   ** \param[in]  ubWidthV       Minimum number of characters
+   ** \param[in]  chFillV        Fill character
+   ** \return     Pointer behind the last character written
+   ** \see        formatHex()
+   **
+   ** The function writes the decimal value \a ulValueV right-justified
+   ** to the buffer \a pchBufferV, it is preceded by \a chFillV up to
+   ** a length of \a ubWidthV characters. The buffer must hold at least
+   ** 10 characters or \a ubWidthV characters, no terminating zero is
+   ** written. Two digits are converted at once by a table, no memory
+   ** is allocated.
+   */
+   static char *      formatDecimal(char * pchBufferV, uint32_t ulValueV,
+                                    uint8_t ubWidthV = 0, 
+                                    char chFillV = ' ');
+
+   /*!
+   ** \param[out] pchBufferV     Pointer to buffer
+   ** \param[in]  ulValueV       Value
+   ** \param[in]  ubWidthV       Minimum number of characters
+   ** \param[in]  chFillV        Fill character
+   ** \return     Pointer behind the last character written
+   ** \see        formatDecimal()
+   **
+   ** The function writes the value \a ulValueV with upper case 
+   ** hexadecimal digits, otherwise it works like formatDecimal().
+   */
+   static char *      formatHex(char * pchBufferV, uint32_t ulValueV,
+                                uint8_t ubWidthV = 0, char chFillV = ' ');
+
+   /*!
+   ** \param[out] pchBufferV     Pointer to buffer
+   ** \param[in]  ubValueV       Value
+   ** \return     Pointer behind the last character written
+   **
+   ** The function writes the byte \a ubValueV as two upper case 
+   ** hexadecimal digits.
+   */
+   static char *      formatHexByte(char * pchBufferV, uint8_t ubValueV);
+
+   /*!
+   ** \param[out] pchBufferV     Pointer to buffer
+   ** \param[in]  szTextV        Zero terminated text
+   ** \return     Pointer behind the last character written
+   **
+   ** The function copies the text \a szTextV without the terminating
+   ** zero to the buffer.
+   */
+   static char *      formatText(char * pchBufferV, const char * szTextV);
+
+   /*!
+   ** \param[in]  clByteArrayR   Byte array holding a frame
+   ** \return     \c true if frame uses the compact encoding
+   */
+   static bool        isCompactArray(const QByteArray & clByteArrayR);
+
 
    /*!
    ** \param[in]  ubPosR         Index of payload
@@ -166,9 +312,92 @@ public:
    
    virtual QByteArray toByteArray() const;
 
+   /*!
+   ** \param[out] pchDataV       Pointer to buffer
+   ** \param[in]  slSizeV        Size of buffer
+   ** \param[in]  btChecksumV    Build checksum
+   ** \return     Number of bytes written
+   ** \see        fromByteArray()
+   **
+   ** The function writes the frame with QCAN_FRAME_ARRAY_SIZE bytes to a
+   ** buffer provided by the caller. No memory is allocated. If the buffer
+   ** is too small, the function returns 0.
+   ** <p>
+   ** If \a btChecksumV is \c false the checksum is not calculated,
+   ** byte 86 of the buffer marks the missing checksum and
+   ** fromByteArray() skips the test.
+   */
+   int32_t            toByteArray(char * pchDataV, int32_t slSizeV,
+                                  bool btChecksumV = true) const;
+
+   /*!
+   ** \return     Byte array in compact encoding
+   ** \see        toByteArray()
+   **
+   ** The function converts the QCanData object to a byte array with
+   ** variable length. Only the used payload bytes are transmitted,
+   ** time stamp, user and marker field are only present when they
+   ** are not 0. Bit 29 of the identifier field marks the compact
+   ** encoding:
+   ** <ul>
+   ** <li>Byte 0 .. 3: identifier, MSB first
+   ** <li>Byte 4: DLC
+   ** <li>Byte 5: message control
+   ** <li>Byte 6: payload size N
+   ** <li>Byte 7: present fields (time stamp, user, marker, checksum)
+   ** <li>optional: time stamp (8 bytes), user (4 bytes), marker (4 bytes)
+   ** <li>N bytes of payload
+   ** <li>optional: checksum (2 bytes)
+   ** </ul>
+   */
+   virtual QByteArray toByteArrayCompact() const;
+
+   /*!
+   ** \param[out] pchDataV       Pointer to buffer
+   ** \param[in]  slSizeV        Size of buffer
+   ** \param[in]  btChecksumV    Build checksum
+   ** \return     Number of bytes written
+   **
+   ** The function writes the frame in compact encoding to a buffer
+   ** provided by the caller. A buffer with QCAN_FRAME_COMPACT_MAX bytes
+   ** is sufficient for all frames. If the buffer is too small, the
+   ** function returns 0. If \a btChecksumV is \c false the
+   ** checksum is omitted.
+   */
+   int32_t            toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                         bool btChecksumV = true) const;
+
+   /*!
+   ** \param[out] pchBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Size of buffer
+   ** \param[in]  btShowTimeV    Print time-stamp
+   ** \return     Number of characters written
+   **
+   ** The function writes the frame as text to a buffer provided by the
+   ** caller, the text is terminated by a zero. A buffer with
+   ** QCAN_FRAME_STRING_SIZE bytes is sufficient for all frames. If the
+   ** buffer is too small, the function returns 0. No memory is 
+   ** allocated, so the function is suitable for logging of frames at
+   ** full bus load. The classes QCanFrame, QCanFrameApi and 
+   ** QCanFrameError implement the text format, the QString variant of
+   ** toString() uses this function.
+   */
+   virtual int32_t    toString(char * pchBufferV, int32_t slSizeV,
+                               bool btShowTimeV = false) const;
+
 
 protected:
-   
+
+   /*!
+   ** \param[in]  pchDataV       Pointer to buffer in compact encoding
+   ** \param[in]  slSizeV        Number of bytes in buffer
+   ** \return     \c true if frame is converted
+   **
+   ** Convert a buffer in compact encoding, the function is called
+   ** by fromByteArray().
+   */
+   bool     fromByteArrayCompact(const char * pchDataV, int32_t slSizeV);
+
    /*!   
    ** The identifier field may have 11 bits for standard frames
    ** (CAN specification 2.0A) or 29 bits for extended frames
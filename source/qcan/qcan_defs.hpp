@@ -86,6 +86,278 @@
 #define  QCAN_NETWORK_MAX           8
 
 
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_NETWORK_BATCH_SIZE
+** \ingroup QCAN_NW
+** \brief   Default batch size for socket writes
+**
+** This symbol defines the default number of frames which are collected
+** for a socket before they are written in one operation.
+** Please refer to QCanNetwork::setBatchSize() for details.
+*/
+#define  QCAN_NETWORK_BATCH_SIZE    32
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_NETWORK_QUEUE_SIZE
+** \ingroup QCAN_NW
+** \brief   Default size of socket send queue
+**
+** This symbol defines the default number of frames which are queued
+** for a socket that does not read its data in time.
+** Please refer to QCanNetwork::setSendQueueSize() for details.
+*/
+#define  QCAN_NETWORK_QUEUE_SIZE    4096
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SEND_POLICY_DROP_OLDEST
+** \ingroup QCAN_NW
+** \brief   Drop oldest frames of a full send queue
+**
+** The value defines the handling of a full send queue of a socket:
+** the oldest frames are removed from the queue in order to store
+** the new frame. Please refer to QCanNetwork::setSendPolicy().
+*/
+#define  QCAN_SEND_POLICY_DROP_OLDEST  ((uint8_t) (0x00))
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SEND_POLICY_DROP_NEWEST
+** \ingroup QCAN_NW
+** \brief   Drop new frames for a full send queue
+**
+** The value defines the handling of a full send queue of a socket:
+** new frames are dropped until the socket has read queued frames.
+*/
+#define  QCAN_SEND_POLICY_DROP_NEWEST  ((uint8_t) (0x01))
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SEND_POLICY_DISCONNECT
+** \ingroup QCAN_NW
+** \brief   Disconnect socket with full send queue
+**
+** The value defines the handling of a full send queue of a socket:
+** the socket is disconnected from the network.
+*/
+#define  QCAN_SEND_POLICY_DISCONNECT   ((uint8_t) (0x02))
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_WIRE_FORMAT_COMPACT
+** \ingroup QCAN_NW
+** \brief   Compact encoding of frames
+**
+** The bit-mask value defines the compact encoding of frames on a
+** socket connection (refer to QCanData::toByteArrayCompact()). The
+** encoding is negotiated between QCanNetwork and QCanSocket via the
+** API function QCanFrameApi::eAPI_FUNC_WIRE_FORMAT.
+*/
+#define  QCAN_WIRE_FORMAT_COMPACT   ((uint8_t) (0x01))
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_WIRE_FORMAT_NO_CHECKSUM
+** \ingroup QCAN_NW
+** \brief   Frames without checksum
+**
+** The bit-mask value defines that frames on a socket connection are
+** sent without checksum. TCP already protects the data, so building
+** and testing the checksum for each frame can be skipped. The option
+** is negotiated like QCAN_WIRE_FORMAT_COMPACT.
+*/
+#define  QCAN_WIRE_FORMAT_NO_CHECKSUM  ((uint8_t) (0x02))
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_WIRE_FORMAT_MASK
+** \ingroup QCAN_NW
+** \brief   All wire format options
+**
+** The bit-mask value combines all supported wire format options.
+*/
+#define  QCAN_WIRE_FORMAT_MASK      (QCAN_WIRE_FORMAT_COMPACT | \
+                                     QCAN_WIRE_FORMAT_NO_CHECKSUM)
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_FILTER_API_ENTRY_MAX
+** \ingroup QCAN_NW
+** \brief   Filter entries per API frame
+**
+** The symbol defines the maximum number of identifier / mask pairs
+** which are transferred by one API frame of type
+** QCanFrameApi::eAPI_FUNC_FILTER. Larger filter sets are sent as
+** several frames, refer to QCanFrameApi::setFilter().
+*/
+#define  QCAN_FILTER_API_ENTRY_MAX  7
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SHARED_RING_SLOTS
+** \ingroup QCAN_NW
+** \brief   Number of frames in shared memory ring
+**
+** This symbol defines the number of frames which are stored in the
+** shared memory ring of a QCanNetwork (refer to QCanSharedRing). The
+** value must be a power of 2.
+*/
+#define  QCAN_SHARED_RING_SLOTS     1024
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SHARED_RING_READERS
+** \ingroup QCAN_NW
+** \brief   Number of readers of shared memory ring
+**
+** This symbol defines the maximum number of sockets which read the
+** shared memory ring at the same time. Further sockets get the frames
+** via their connection. The value must not exceed 32.
+*/
+#define  QCAN_SHARED_RING_READERS   32
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_FRAME_QUEUE_SIZE
+** \ingroup QCAN_NW
+** \brief   Number of frames in receive queue of CAN interface
+**
+** This symbol defines the default number of frames which are stored
+** in a QCanFrameQueue. The queue is filled by the receive thread of
+** a CAN interface plugin. The value must be a power of 2.
+*/
+#define  QCAN_FRAME_QUEUE_SIZE      4096
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SCHEDULER_TICK
+** \ingroup QCAN_NW
+** \brief   Tick time of cyclic transmit scheduler
+**
+** This symbol defines the resolution of the cyclic transmit scheduler
+** (refer to QCanScheduler) in microseconds. The period of a transmit
+** job is rounded to a multiple of this value.
+*/
+#define  QCAN_SCHEDULER_TICK        100
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SCHEDULER_SLOTS
+** \ingroup QCAN_NW
+** \brief   Number of slots of the scheduler timer wheel
+**
+** This symbol defines the number of slots of the timer wheel inside
+** the QCanScheduler. One revolution of the wheel takes
+** QCAN_SCHEDULER_SLOTS * QCAN_SCHEDULER_TICK microseconds, jobs with
+** a longer period stay in their slot for several revolutions. The 
+** value must be a power of 2.
+*/
+#define  QCAN_SCHEDULER_SLOTS       256
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_SCHEDULER_JOB_MAX
+** \ingroup QCAN_NW
+** \brief   Maximum number of cyclic transmit jobs
+**
+** This symbol defines the maximum number of cyclic transmit jobs 
+** of a QCanNetwork, i.e. for all sockets of the network.
+*/
+#define  QCAN_SCHEDULER_JOB_MAX     512
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_CYCLIC_NO_INCREMENT
+** \ingroup QCAN_NW
+** \brief   Cyclic transmit job without payload increment
+**
+** The value is used as position of the payload increment of a cyclic
+** transmit job (refer to QCanFrameApi::setCyclic()) if the payload
+** is not modified.
+*/
+#define  QCAN_CYCLIC_NO_INCREMENT   ((uint8_t) (0xFF))
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_RECORDER_QUEUE_SIZE
+** \ingroup QCAN_NW
+** \brief   Number of frames in queue of trace recorder
+**
+** This symbol defines the number of frames which are queued between
+** the dispatcher of a QCanNetwork and the thread of the trace
+** recorder (refer to QCanRecorder). The value must be a power of 2.
+*/
+#define  QCAN_RECORDER_QUEUE_SIZE   32768
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_RECORDER_BUFFER_SIZE
+** \ingroup QCAN_NW
+** \brief   Size of write buffer of trace recorder
+**
+** This symbol defines the size of the buffer in bytes which collects
+** the records of the trace recorder before they are written to the
+** file in one operation.
+*/
+#define  QCAN_RECORDER_BUFFER_SIZE  (256 * 1024)
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_RECORDER_SEGMENT_SIZE
+** \ingroup QCAN_NW
+** \brief   Default segment size of trace recorder
+**
+** This symbol defines the default size of a trace file segment in
+** bytes. Please refer to QCanRecorder::setSegmentSize() for details.
+*/
+#define  QCAN_RECORDER_SEGMENT_SIZE (64 * 1024 * 1024)
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_RECORDER_POLL_TIME
+** \ingroup QCAN_NW
+** \brief   Poll period of trace recorder
+**
+** This symbol defines the period in milliseconds the thread of the
+** trace recorder checks its queue for new frames.
+*/
+#define  QCAN_RECORDER_POLL_TIME    10
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_LOCAL_SERVER_NAME
+** \ingroup QCAN_NW
+** \brief   Name prefix of local server
+**
+** This symbol defines the name prefix of the local server of a
+** QCanNetwork. The full name is build by appending the TCP port
+** number of the network, e.g. "QCanServer_55660".
+*/
+#define  QCAN_LOCAL_SERVER_NAME     "QCanServer_"
+
+
 //-------------------------------------------------------------------
 /*!
 ** \defgroup QCAN_IF QCan interface definitions
@@ -130,5 +402,18 @@
 #define  QCAN_IF_SUPPORT_CAN_FD           ((uint32_t) (0x00000004))
 
 
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_IF_BATCH_SIZE
+** \ingroup QCAN_IF
+** \brief   Number of frames per batch transfer
+**
+** This symbol defines the maximum number of frames which are
+** transferred by one call of QCanInterface::readBatch() or
+** QCanInterface::writeBatch() from a QCanNetwork.
+*/
+#define  QCAN_IF_BATCH_SIZE               64
+
+
 
 #endif // QCAN_DEFS_HPP_
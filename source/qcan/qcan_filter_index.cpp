@@ -0,0 +1,204 @@
+//============================================================================//
+// File:          qcan_filter_index.cpp                                       //
+// Description:   QCan classes - acceptance filter index                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include "qcan_filter_index.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// valid identifier bits for standard and extended frame format
+//
+static const uint32_t aulFormatMaskS[2] = { 0x000007FF, 0x1FFFFFFF };
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanFilterIndex()                                                          //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanFilterIndex::QCanFilterIndex()
+{
+   this->clear();
+}
+
+
+//----------------------------------------------------------------------------//
+// clear()                                                                    //
+// remove all filters                                                         //
+//----------------------------------------------------------------------------//
+void QCanFilterIndex::clear(void)
+{
+   uqEntryValidP = 0;
+   this->rebuild();
+}
+
+
+//----------------------------------------------------------------------------//
+// match()                                                                    //
+// return bit-mask of all entries accepting the identifier                    //
+//----------------------------------------------------------------------------//
+uint64_t QCanFilterIndex::match(uint32_t ulIdentifierV, bool btExtendedV) const
+{
+   uint64_t    uqResultT;
+   uint8_t     ubFormatT;
+   int32_t     slGroupT;
+
+   ubFormatT      = btExtendedV ? 1 : 0;
+   ulIdentifierV &= aulFormatMaskS[ubFormatT];
+
+   //----------------------------------------------------------------
+   // entries with full acceptance mask
+   //
+   uqResultT = aclExactHashP[ubFormatT].value(ulIdentifierV, 0);
+
+   //----------------------------------------------------------------
+   // one lookup for each group of partial acceptance masks
+   //
+   for(slGroupT = 0; slGroupT < aclGroupP[ubFormatT].size(); slGroupT++)
+   {
+      const QCanFilterGroup_ts & tsGroupR = aclGroupP[ubFormatT].at(slGroupT);
+      uqResultT |= tsGroupR.clEntryHashM.value(ulIdentifierV & 
+                                               tsGroupR.ulAcceptMaskM, 0);
+   }
+
+   return(uqResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// rebuild()                                                                  //
+// build the index from the filter entries                                    //
+//----------------------------------------------------------------------------//
+void QCanFilterIndex::rebuild(void)
+{
+   uint8_t              ubEntryT;
+   uint8_t              ubFormatT;
+   int32_t              slGroupT;
+   uint32_t             ulAcceptMaskT;
+   uint32_t             ulIdentifierT;
+   uint64_t             uqEntryBitT;
+   QCanFilterGroup_ts   tsGroupT;
+
+   for(ubFormatT = 0; ubFormatT < 2; ubFormatT++)
+   {
+      aclExactHashP[ubFormatT].clear();
+      aclGroupP[ubFormatT].clear();
+   }
+
+   for(ubEntryT = 0; ubEntryT < QCAN_FILTER_INDEX_MAX; ubEntryT++)
+   {
+      uqEntryBitT = ((uint64_t) 1) << ubEntryT;
+      if((uqEntryValidP & uqEntryBitT) == 0) continue;
+
+      ubFormatT     = atsEntryP[ubEntryT].btExtendedM ? 1 : 0;
+      ulAcceptMaskT = atsEntryP[ubEntryT].ulAcceptMaskM & 
+                      aulFormatMaskS[ubFormatT];
+      ulIdentifierT = atsEntryP[ubEntryT].ulIdentifierM & ulAcceptMaskT;
+
+      //--------------------------------------------------------
+      // a full acceptance mask is an exact match
+      //
+      if(ulAcceptMaskT == aulFormatMaskS[ubFormatT])
+      {
+         aclExactHashP[ubFormatT][ulIdentifierT] |= uqEntryBitT;
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // add partial acceptance mask to the group of equal masks
+      //
+      for(slGroupT = 0; slGroupT < aclGroupP[ubFormatT].size(); slGroupT++)
+      {
+         if(aclGroupP[ubFormatT].at(slGroupT).ulAcceptMaskM == ulAcceptMaskT)
+         {
+            break;
+         }
+      }
+
+      if(slGroupT == aclGroupP[ubFormatT].size())
+      {
+         tsGroupT.ulAcceptMaskM = ulAcceptMaskT;
+         tsGroupT.clEntryHashM.clear();
+         aclGroupP[ubFormatT].append(tsGroupT);
+      }
+      aclGroupP[ubFormatT][slGroupT].clEntryHashM[ulIdentifierT] |= uqEntryBitT;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// removeEntry()                                                              //
+// remove filter entry                                                        //
+//----------------------------------------------------------------------------//
+void QCanFilterIndex::removeEntry(uint8_t ubEntryV)
+{
+   uint64_t    uqEntryBitT;
+
+   if(ubEntryV >= QCAN_FILTER_INDEX_MAX) return;
+
+   uqEntryBitT = ((uint64_t) 1) << ubEntryV;
+   if((uqEntryValidP & uqEntryBitT) != 0)
+   {
+      uqEntryValidP &= ~uqEntryBitT;
+      this->rebuild();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setEntry()                                                                 //
+// set filter entry                                                           //
+//----------------------------------------------------------------------------//
+bool QCanFilterIndex::setEntry(uint8_t ubEntryV, uint32_t ulIdentifierV, 
+                               uint32_t ulAcceptMaskV, bool btExtendedV)
+{
+   if(ubEntryV >= QCAN_FILTER_INDEX_MAX) return(false);
+
+   atsEntryP[ubEntryV].ulIdentifierM = ulIdentifierV;
+   atsEntryP[ubEntryV].ulAcceptMaskM = ulAcceptMaskV;
+   atsEntryP[ubEntryV].btExtendedM   = btExtendedV;
+   uqEntryValidP |= ((uint64_t) 1) << ubEntryV;
+   this->rebuild();
+
+   return(true);
+}
+
@@ -0,0 +1,163 @@
+//============================================================================//
+// File:          qcan_filter_index.hpp                                       //
+// Description:   QCan classes - acceptance filter index                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_FILTER_INDEX_HPP_
+#define QCAN_FILTER_INDEX_HPP_
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QHash>
+#include <QVector>
+
+//-------------------------------------------------------------------
+/*!
+** \file qcan_filter_index.hpp
+**
+*/
+
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_FILTER_INDEX_MAX
+** 
+** The symbol QCAN_FILTER_INDEX_MAX defines the maximum number of
+** entries of a QCanFilterIndex. The result of QCanFilterIndex::match()
+** holds one bit for every entry.
+*/
+#define  QCAN_FILTER_INDEX_MAX      64
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanFilterIndex
+** \brief   Acceptance filter index
+**
+** The QCanFilterIndex class stores a set of acceptance filters, each
+** consisting of an identifier, an acceptance mask and the frame format
+** (standard or extended). A bit that is set in the acceptance mask 
+** must be equal in the identifier of the received frame and the 
+** identifier of the filter.
+** <p>
+** Every change of the filter set rebuilds a precompiled index:
+** filters with a full acceptance mask are stored in an exact-match 
+** hash table, filters with a partial mask are grouped by their mask 
+** value. Hence the cost of match() depends on the number of different 
+** partial masks, not on the number of filters.
+*/
+class QCanFilterIndex
+{
+public:
+   
+   /*!
+   ** Construct an empty filter index.
+   */
+   QCanFilterIndex();
+
+   /*!
+   ** Remove all filters from the index.
+   */
+   void     clear(void);
+
+   /*!
+   ** \return  \c true if the index holds no filter
+   */
+   inline bool isEmpty(void) const  { return(uqEntryValidP == 0);  };
+
+   /*!
+   ** \param[in]  ulIdentifierV - identifier of received frame
+   ** \param[in]  btExtendedV   - \c true for extended frame format
+   ** \return     bit-mask of matching entries
+   ** 
+   ** Returns a bit-mask of all entries which accept a frame with the 
+   ** identifier \a ulIdentifierV. Bit 0 of the return value corresponds 
+   ** to entry 0. A return value of 0 denotes that no entry accepts the
+   ** frame.
+   */
+   uint64_t match(uint32_t ulIdentifierV, bool btExtendedV) const;
+
+   /*!
+   ** \param[in]  ubEntryV - entry number
+   ** 
+   ** Remove the filter of entry \a ubEntryV from the index.
+   */
+   void     removeEntry(uint8_t ubEntryV);
+   
+   /*!
+   ** \param[in]  ubEntryV      - entry number
+   ** \param[in]  ulIdentifierV - identifier
+   ** \param[in]  ulAcceptMaskV - acceptance mask
+   ** \param[in]  btExtendedV   - \c true for extended frame format
+   ** \return     \c false if \a ubEntryV is out of range
+   ** 
+   ** Set the filter of entry \a ubEntryV, a previous filter of this entry
+   ** is replaced. The value of \a ubEntryV must be less than 
+   ** #QCAN_FILTER_INDEX_MAX.
+   */
+   bool     setEntry(uint8_t ubEntryV, uint32_t ulIdentifierV, 
+                     uint32_t ulAcceptMaskV, bool btExtendedV);
+
+private:
+
+   //-------------------------------------------------------------------
+   // filter definition of one entry
+   //
+   typedef struct QCanFilterEntry_s {
+      uint32_t    ulIdentifierM;
+      uint32_t    ulAcceptMaskM;
+      bool        btExtendedM;
+   } QCanFilterEntry_ts;
+
+   //-------------------------------------------------------------------
+   // entries with the same partial acceptance mask
+   //
+   typedef struct QCanFilterGroup_s {
+      uint32_t                   ulAcceptMaskM;
+      QHash<uint32_t, uint64_t>  clEntryHashM;
+   } QCanFilterGroup_ts;
+
+   void     rebuild(void);
+
+   QCanFilterEntry_ts            atsEntryP[QCAN_FILTER_INDEX_MAX];
+   uint64_t                      uqEntryValidP;
+
+   //-------------------------------------------------------------------
+   // the index is separated by frame format: 0 = standard, 
+   // 1 = extended
+   //
+   QHash<uint32_t, uint64_t>     aclExactHashP[2];
+   QVector<QCanFilterGroup_ts>   aclGroupP[2];
+};
+
+#endif   // QCAN_FILTER_INDEX_HPP_ 
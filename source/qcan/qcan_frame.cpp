@@ -32,6 +32,8 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#include <string.h>
+
 #include <QCanFrame>
 
 
@@ -301,16 +303,27 @@ QCanFrame::Format_e  QCanFrame::frameFormat(void) const
 //                                                                            //
 //----------------------------------------------------------------------------//
 bool QCanFrame::fromByteArray(const QByteArray & clByteArrayR)
+{
+   return (fromByteArray(clByteArrayR.constData(), clByteArrayR.size()));
+}
+
+
+//----------------------------------------------------------------------------//
+// fromByteArray()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrame::fromByteArray(const char * pchDataV, int32_t slSizeV)
 {
    bool  btResultT = false;
    
    //----------------------------------------------------------------
-   // a CAN frame must have the three MSB bits set to 0 in the first 
-   // byte, refer to QCanData class implementation (0b000xxxxx)
+   // a CAN frame must have the two MSB bits set to 0 in the first 
+   // byte, refer to QCanData class implementation (0b00xxxxxx),
+   // bit 5 marks the compact encoding
    //
-   if ((clByteArrayR.at(0) & 0xE0) == 0)
+   if ((slSizeV > 0) && ((pchDataV[0] & 0xC0) == 0))
    {
-      btResultT = (QCanData::fromByteArray(clByteArrayR)); 
+      btResultT = (QCanData::fromByteArray(pchDataV, slSizeV)); 
    }
    
    return (btResultT);
@@ -668,33 +681,84 @@ QByteArray QCanFrame::toByteArray() const
    return(QCanData::toByteArray());
 }
 
+
+//----------------------------------------------------------------------------//
+// toByteArray()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrame::toByteArray(char * pchDataV, int32_t slSizeV,
+                               bool btChecksumV) const
+{
+   return(QCanData::toByteArray(pchDataV, slSizeV, btChecksumV));
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanFrame::toByteArrayCompact() const
+{
+   return(QCanData::toByteArrayCompact());
+}
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrame::toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                      bool btChecksumV) const
+{
+   return(QCanData::toByteArrayCompact(pchDataV, slSizeV, btChecksumV));
+}
+
 //----------------------------------------------------------------------------//
 // toString()                                                                 //
 // print CAN frame                                                            //
 //----------------------------------------------------------------------------//
 QString QCanFrame::toString(const bool & btShowTimeR) 
 {
+   char     achStringT[QCAN_FRAME_STRING_SIZE];
+   int32_t  slSizeT;
+
+   slSizeT = toString(&achStringT[0], QCAN_FRAME_STRING_SIZE, btShowTimeR);
+
+   return(QString::fromLatin1(&achStringT[0], slSizeT));
+}
+
+
+//----------------------------------------------------------------------------//
+// toString()                                                                 //
+// print CAN frame to buffer                                                  //
+//----------------------------------------------------------------------------//
+int32_t QCanFrame::toString(char * pchBufferV, int32_t slSizeV,
+                            bool btShowTimeV) const
+{
+   char *   pchOutT = pchBufferV;
+
+   if((pchBufferV == Q_NULLPTR) || (slSizeV < QCAN_FRAME_STRING_SIZE))
+   {
+      return(0);
+   }
+
    //----------------------------------------------------------------
-   // setup a string object
+   // print time-stamp with a resolution of 10 us
    //
-   QString clStringT; //(QCAN_FRAME_STRING_SIZE, '\0');
-   uint32_t ulSecondsT = 0;
-   uint32_t ulNanoSecT = 0;
-   
-   
-   if(btShowTimeR == true)
+   if(btShowTimeV == true)
    {
-      ulSecondsT = this->timeStamp().seconds();
-      ulNanoSecT = this->timeStamp().nanoSeconds();
-      ulNanoSecT = ulNanoSecT / 10000;
-      clStringT = QString("%1.%2 ").arg(ulSecondsT, 5, 10).arg(ulNanoSecT, 5, 10, QChar('0'));
+      pchOutT = formatDecimal(pchOutT, clMsgTimeP.seconds(), 5);
+      *pchOutT++ = '.';
+      pchOutT = formatDecimal(pchOutT, clMsgTimeP.nanoSeconds() / 10000,
+                              5, '0');
+      *pchOutT++ = ' ';
    }
-   
-   
+
    //----------------------------------------------------------------
    // print identifier
    //
-   clStringT += QString("%1  ").arg(identifier(), 8, 16).toUpper();
+   pchOutT = formatHex(pchOutT, identifier(), 8);
+   *pchOutT++ = ' ';
+   *pchOutT++ = ' ';
 
    //----------------------------------------------------------------
    // print frame format
@@ -702,19 +766,23 @@ QString QCanFrame::toString(const bool & btShowTimeR)
    switch(frameFormat())
    {
       case eFORMAT_CAN_STD:
-         clStringT += "CBFF ";
+         memcpy(pchOutT, "CBFF ", 5);
+         pchOutT += 5;
          break;
          
       case eFORMAT_CAN_EXT:
-         clStringT += "CEFF ";
+         memcpy(pchOutT, "CEFF ", 5);
+         pchOutT += 5;
          break;
          
       case eFORMAT_FD_STD:
-         clStringT += "FBFF ";
+         memcpy(pchOutT, "FBFF ", 5);
+         pchOutT += 5;
          break;
          
       case eFORMAT_FD_EXT:
-         clStringT += "FEFF ";
+         memcpy(pchOutT, "FEFF ", 5);
+         pchOutT += 5;
          break;
          
       default:
@@ -725,9 +793,10 @@ QString QCanFrame::toString(const bool & btShowTimeR)
    //----------------------------------------------------------------
    // print DLC
    //
-   clStringT += QString("%1  ").arg(dlc(), 2, 10);
+   pchOutT = formatDecimal(pchOutT, dlc(), 2);
+   *pchOutT++ = ' ';
+   *pchOutT++ = ' ';
 
-   
    //----------------------------------------------------------------
    // print data
    //
@@ -738,22 +807,24 @@ QString QCanFrame::toString(const bool & btShowTimeR)
       //
       if((ubCntT > 0) && ((ubCntT % 32) == 0))
       {
-         if(btShowTimeR == true)
+         *pchOutT++ = '\n';
+         if(btShowTimeV == true)
          {
-            clStringT +="\n                               ";
+            memset(pchOutT, ' ', 31);
+            pchOutT += 31;
          }
          else
          {
-            clStringT +="\n                   ";
+            memset(pchOutT, ' ', 19);
+            pchOutT += 19;
          }
       }
-      clStringT += QString("%1 ").arg( data(ubCntT),
-                                       2,          // 2 digits
-                                      16,          // hex value
-                                      QLatin1Char('0')).toUpper();
+      pchOutT = formatHexByte(pchOutT, aubByteP[ubCntT]);
+      *pchOutT++ = ' ';
    }
-   
-   return(clStringT);
+   *pchOutT = 0;
+
+   return((int32_t) (pchOutT - pchBufferV));
 }
    
 uint32_t  QCanFrame::marker(void) const
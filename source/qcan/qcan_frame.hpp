@@ -192,6 +192,16 @@ public:
 
    bool        fromByteArray(const QByteArray & clByteArrayR);
 
+   /*!
+   ** \param[in]  pchDataV       Pointer to buffer holding a frame
+   ** \param[in]  slSizeV        Number of bytes in buffer
+   ** \return     \c true if CAN frame is converted
+   **
+   ** This is an overloaded function, which reads the CAN frame from
+   ** a buffer provided by the caller. No memory is allocated.
+   */
+   bool        fromByteArray(const char * pchDataV, int32_t slSizeV);
+
 
    /*!
    ** \return  \c true if error state indicator is set
@@ -396,6 +406,40 @@ public:
 
    
    QByteArray toByteArray() const;
+
+   /*!
+   ** \param[out] pchDataV       Pointer to buffer
+   ** \param[in]  slSizeV        Size of buffer
+   ** \param[in]  btChecksumV    Build checksum
+   ** \return     Number of bytes written
+   **
+   ** This is an overloaded function, which writes the CAN frame to
+   ** a buffer provided by the caller. No memory is allocated.
+   ** Please refer to QCanData::toByteArray() for \a btChecksumV.
+   */
+   int32_t    toByteArray(char * pchDataV, int32_t slSizeV,
+                          bool btChecksumV = true) const;
+
+   /*!
+   ** \return     CAN frame as byte array in compact encoding
+   ** \see        toByteArray()
+   **
+   ** The function converts the CAN frame to a byte array with variable
+   ** length, please refer to QCanData::toByteArrayCompact() for details.
+   */
+   QByteArray toByteArrayCompact() const;
+
+   /*!
+   ** \param[out] pchDataV       Pointer to buffer
+   ** \param[in]  slSizeV        Size of buffer
+   ** \param[in]  btChecksumV    Build checksum
+   ** \return     Number of bytes written
+   **
+   ** This is an overloaded function, which writes the CAN frame in
+   ** compact encoding to a buffer provided by the caller.
+   */
+   int32_t    toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                 bool btChecksumV = true) const;
    
    /*!
    ** \return     CAN frame as QString object
@@ -406,6 +450,18 @@ public:
    **
    */
    virtual QString    toString(const bool & btShowTimeR = false);
+
+   /*!
+   ** \param[out] pchBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Size of buffer
+   ** \param[in]  btShowTimeV    Print time-stamp
+   ** \return     Number of characters written
+   **
+   ** This is an overloaded function, it writes the text to a buffer
+   ** provided by the caller. Refer to QCanData::toString() for details.
+   */
+   int32_t            toString(char * pchBufferV, int32_t slSizeV,
+                               bool btShowTimeV = false) const;
    
    uint32_t    user(void) const;
              
@@ -33,6 +33,8 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#include <string.h>
+
 #include <QDebug>
 #include "qcan_frame_api.hpp"
 
@@ -41,6 +43,59 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+//-------------------------------------------------------------------
+// payload of eAPI_FUNC_FILTER: byte 0 holds the flags, byte 1 the
+// number of entries, bytes 2 .. 3 are reserved for frame type
+// filters. Each entry uses 8 bytes: identifier (bit 31 marks the
+// extended frame format) followed by the acceptance mask.
+//
+#define  FILTER_POS_FLAGS     0
+#define  FILTER_POS_COUNT     1
+#define  FILTER_POS_ENTRY     4
+#define  FILTER_ENTRY_SIZE    8
+
+#define  FILTER_FLAG_APPEND   ((uint8_t) 0x01)
+#define  FILTER_ID_EXTENDED   ((uint32_t) 0x80000000)
+
+//-------------------------------------------------------------------
+// payload of eAPI_FUNC_SHARED_MEMORY: byte 0 holds the handshake
+// step, bytes 4 .. 7 the value and bytes 8 .. 63 the key
+//
+#define  SHM_POS_STEP         0
+#define  SHM_POS_VALUE        4
+#define  SHM_POS_KEY          8
+
+//-------------------------------------------------------------------
+// payload of eAPI_FUNC_QUEUE_STATUS: byte 0 holds the policy, bytes
+// 4 .. 7 the depth, bytes 8 .. 11 the limit and bytes 12 .. 15 the
+// number of dropped frames, a request has no payload
+//
+#define  QUEUE_POS_POLICY     0
+#define  QUEUE_POS_DEPTH      4
+#define  QUEUE_POS_LIMIT      8
+#define  QUEUE_POS_DROPPED    12
+#define  QUEUE_STATUS_SIZE    16
+
+//-------------------------------------------------------------------
+// payload of eAPI_FUNC_CYCLIC: byte 0 holds the job number, byte 1
+// the frame format (bit 0 .. 1) and the flags, byte 2 the DLC and
+// byte 3 the position of the payload increment. Bytes 4 .. 7 hold
+// the identifier, bytes 8 .. 11 the period, bytes 12 .. 15 the
+// number of transmissions and bytes 16 .. 63 the payload.
+//
+#define  CYCLIC_POS_JOB       0
+#define  CYCLIC_POS_FORMAT    1
+#define  CYCLIC_POS_DLC       2
+#define  CYCLIC_POS_INCREMENT 3
+#define  CYCLIC_POS_ID        4
+#define  CYCLIC_POS_PERIOD    8
+#define  CYCLIC_POS_COUNT     12
+#define  CYCLIC_POS_DATA      16
+
+#define  CYCLIC_FORMAT_MASK   ((uint8_t) 0x03)
+#define  CYCLIC_FLAG_RTR      ((uint8_t) 0x10)
+#define  CYCLIC_FLAG_BRS      ((uint8_t) 0x20)
+
 
 /*----------------------------------------------------------------------------*\
 ** Class methods                                                              **
@@ -68,6 +123,51 @@ QCanFrameApi::~QCanFrameApi()
 }
 
 
+//----------------------------------------------------------------------------//
+// appendFilter()                                                             //
+// add identifier / mask pair to filter set                                   //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::appendFilter(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                                bool btExtendedV)
+{
+   uint8_t  ubCountT;
+   uint8_t  ubPosT;
+
+   if(ulMsgMarkerP != QCanFrameApi::eAPI_FUNC_FILTER)
+   {
+      return(false);
+   }
+
+   ubCountT = aubByteP[FILTER_POS_COUNT];
+   if(ubCountT >= QCAN_FILTER_API_ENTRY_MAX)
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // the frame format is stored in bit 31 of the identifier
+   //
+   if(btExtendedV == true)
+   {
+      ulIdentifierV = (ulIdentifierV & 0x1FFFFFFF) | FILTER_ID_EXTENDED;
+   }
+   else
+   {
+      ulIdentifierV = ulIdentifierV & 0x000007FF;
+   }
+
+   ubPosT = FILTER_POS_ENTRY + (ubCountT * FILTER_ENTRY_SIZE);
+   setDataUInt32(ubPosT, ulIdentifierV);
+   setDataUInt32(ubPosT + 4, ulMaskV);
+
+   ubCountT++;
+   aubByteP[FILTER_POS_COUNT] = ubCountT;
+   ubMsgDlcP = FILTER_POS_ENTRY + (ubCountT * FILTER_ENTRY_SIZE);
+
+   return(true);
+}
+
+
 
 //----------------------------------------------------------------------------//
 // bitrate()                                                                  //
@@ -97,11 +197,114 @@ int32_t QCanFrameApi::bitrateNominal(void)
    return (dataUInt32(0));
 }
 
+//----------------------------------------------------------------------------//
+// cyclic()                                                                   //
+// get cyclic transmit job                                                    //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::cyclic(uint8_t & ubJobR, QCanFrame & clFrameR, 
+                          uint32_t & ulPeriodR, uint32_t & ulCountR, 
+                          uint8_t & ubIncPosR)
+{
+   uint8_t  ubFlagsT;
+   uint8_t  ubPosT;
+
+   if((ulMsgMarkerP != QCanFrameApi::eAPI_FUNC_CYCLIC) ||
+      (ubMsgDlcP < CYCLIC_POS_DATA))
+   {
+      return(false);
+   }
+
+   ubJobR    = aubByteP[CYCLIC_POS_JOB];
+   ubIncPosR = aubByteP[CYCLIC_POS_INCREMENT];
+   ulPeriodR = dataUInt32(CYCLIC_POS_PERIOD);
+   ulCountR  = dataUInt32(CYCLIC_POS_COUNT);
+
+   //----------------------------------------------------------------
+   // build the CAN frame, the format is set first because it
+   // limits the DLC
+   //
+   ubFlagsT = aubByteP[CYCLIC_POS_FORMAT];
+   clFrameR.setFrameFormat((QCanFrame::Format_e) (ubFlagsT & 
+                                                  CYCLIC_FORMAT_MASK));
+   clFrameR.setIdentifier(dataUInt32(CYCLIC_POS_ID));
+   clFrameR.setDlc(aubByteP[CYCLIC_POS_DLC]);
+   clFrameR.setRemote((ubFlagsT & CYCLIC_FLAG_RTR) != 0);
+   clFrameR.setBitrateSwitch((ubFlagsT & CYCLIC_FLAG_BRS) != 0);
+
+   for(ubPosT = 0; ubPosT < clFrameR.dataSize(); ubPosT++)
+   {
+      if((CYCLIC_POS_DATA + ubPosT) >= QCAN_MSG_DATA_MAX)
+      {
+         break;
+      }
+      clFrameR.setData(ubPosT, aubByteP[CYCLIC_POS_DATA + ubPosT]);
+   }
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// filter()                                                                   //
+// get identifier / mask pair of filter set                                   //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::filter(uint8_t ubEntryV, uint32_t & ulIdentifierR,
+                          uint32_t & ulMaskR, bool & btExtendedR)
+{
+   bool     btResultT = false;
+   uint8_t  ubPosT;
+
+   if((ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_FILTER) &&
+      (ubEntryV < filterCount()))
+   {
+      ubPosT        = FILTER_POS_ENTRY + (ubEntryV * FILTER_ENTRY_SIZE);
+      ulIdentifierR = dataUInt32(ubPosT);
+      ulMaskR       = dataUInt32(ubPosT + 4);
+      btExtendedR   = ((ulIdentifierR & FILTER_ID_EXTENDED) != 0);
+      ulIdentifierR = ulIdentifierR & (~FILTER_ID_EXTENDED);
+      btResultT     = true;
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// filterAppend()                                                             //
+// test if entries are added to the filter set                                //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::filterAppend(void)
+{
+   return((aubByteP[FILTER_POS_FLAGS] & FILTER_FLAG_APPEND) != 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// filterCount()                                                              //
+// number of filter entries (byte 1)                                          //
+//----------------------------------------------------------------------------//
+uint8_t QCanFrameApi::filterCount(void) const
+{
+   uint8_t  ubCountT = 0;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_FILTER)
+   {
+      ubCountT = aubByteP[FILTER_POS_COUNT];
+      if(ubCountT > QCAN_FILTER_API_ENTRY_MAX)
+      {
+         ubCountT = QCAN_FILTER_API_ENTRY_MAX;
+      }
+   }
+
+   return(ubCountT);
+}
+
+
 //----------------------------------------------------------------------------//
 // function()                                                                 //
 // determine the function code                                                //
 //----------------------------------------------------------------------------//
-QCanFrameApi::ApiFunc_e QCanFrameApi::function(void)
+QCanFrameApi::ApiFunc_e QCanFrameApi::function(void) const
 {
    return((QCanFrameApi::ApiFunc_e) ulMsgMarkerP);
 
@@ -159,6 +362,57 @@ void QCanFrameApi::setMode(CAN_Mode_e teModeV)
 }
 
 
+//----------------------------------------------------------------------------//
+// setCyclic()                                                                //
+// Byte 0 .. 15: job parameters, Byte 16 .. 63: payload                       //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::setCyclic(uint8_t ubJobV, const QCanFrame & clFrameR,
+                             uint32_t ulPeriodV, uint32_t ulCountV,
+                             uint8_t ubIncPosV)
+{
+   uint8_t  ubFlagsT;
+   uint8_t  ubPosT;
+
+   if(clFrameR.dataSize() > (QCAN_MSG_DATA_MAX - CYCLIC_POS_DATA))
+   {
+      return(false);
+   }
+
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_CYCLIC;
+
+   for(ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
+   {
+      aubByteP[ubPosT] = 0;
+   }
+
+   ubFlagsT = (uint8_t) clFrameR.frameFormat() & CYCLIC_FORMAT_MASK;
+   if(clFrameR.isRemote())
+   {
+      ubFlagsT |= CYCLIC_FLAG_RTR;
+   }
+   if(clFrameR.bitrateSwitch())
+   {
+      ubFlagsT |= CYCLIC_FLAG_BRS;
+   }
+
+   aubByteP[CYCLIC_POS_JOB]       = ubJobV;
+   aubByteP[CYCLIC_POS_FORMAT]    = ubFlagsT;
+   aubByteP[CYCLIC_POS_DLC]       = clFrameR.dlc();
+   aubByteP[CYCLIC_POS_INCREMENT] = ubIncPosV;
+   setDataUInt32(CYCLIC_POS_ID,     clFrameR.identifier());
+   setDataUInt32(CYCLIC_POS_PERIOD, ulPeriodV);
+   setDataUInt32(CYCLIC_POS_COUNT,  ulCountV);
+
+   for(ubPosT = 0; ubPosT < clFrameR.dataSize(); ubPosT++)
+   {
+      aubByteP[CYCLIC_POS_DATA + ubPosT] = clFrameR.data(ubPosT);
+   }
+   ubMsgDlcP = CYCLIC_POS_DATA + clFrameR.dataSize();
+
+   return(true);
+}
+
+
 void QCanFrameApi::setDriverInit()
 {
    ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_DRIVER_INIT;
@@ -170,6 +424,29 @@ void QCanFrameApi::setDriverRelease()
 
 }
 
+//----------------------------------------------------------------------------//
+// setFilter()                                                                //
+// start filter set without entries                                           //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setFilter(bool btAppendV)
+{
+   uint8_t  ubPosT;
+
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_FILTER;
+   ubMsgDlcP    = FILTER_POS_ENTRY;
+
+   for(ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
+   {
+      aubByteP[ubPosT] = 0;
+   }
+
+   if(btAppendV == true)
+   {
+      aubByteP[FILTER_POS_FLAGS] = FILTER_FLAG_APPEND;
+   }
+}
+
+
 void QCanFrameApi::setName(QString clNameV)
 {
    int32_t  slSizeT;
@@ -201,11 +478,172 @@ void QCanFrameApi::setName(QString clNameV)
 }
 
 
+//----------------------------------------------------------------------------//
+// queueStatus()                                                              //
+// get status of send queue                                                   //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::queueStatus(uint32_t & ulDepthR, uint32_t & ulLimitR,
+                               uint32_t & ulDroppedR, uint8_t & ubPolicyR)
+{
+   bool  btResultT = false;
+
+   if((ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_QUEUE_STATUS) &&
+      (ubMsgDlcP >= QUEUE_STATUS_SIZE))
+   {
+      ubPolicyR  = aubByteP[QUEUE_POS_POLICY];
+      ulDepthR   = dataUInt32(QUEUE_POS_DEPTH);
+      ulLimitR   = dataUInt32(QUEUE_POS_LIMIT);
+      ulDroppedR = dataUInt32(QUEUE_POS_DROPPED);
+      btResultT  = true;
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setQueueStatus()                                                           //
+// request status of send queue, no payload                                   //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setQueueStatus(void)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_QUEUE_STATUS;
+   ubMsgDlcP    = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// setQueueStatus()                                                           //
+// Byte 0: policy, Byte 4 .. 15: depth, limit, dropped frames                 //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setQueueStatus(uint32_t ulDepthV, uint32_t ulLimitV,
+                                  uint32_t ulDroppedV, uint8_t ubPolicyV)
+{
+   uint8_t  ubPosT;
+
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_QUEUE_STATUS;
+   ubMsgDlcP    = QUEUE_STATUS_SIZE;
+
+   for(ubPosT = 0; ubPosT < QUEUE_STATUS_SIZE; ubPosT++)
+   {
+      aubByteP[ubPosT] = 0;
+   }
+   aubByteP[QUEUE_POS_POLICY] = ubPolicyV;
+   setDataUInt32(QUEUE_POS_DEPTH,   ulDepthV);
+   setDataUInt32(QUEUE_POS_LIMIT,   ulLimitV);
+   setDataUInt32(QUEUE_POS_DROPPED, ulDroppedV);
+}
+
+
+//----------------------------------------------------------------------------//
+// setSharedMemory()                                                          //
+// Byte 0: step, Byte 4 .. 7: value, Byte 8 .. 63: key                        //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setSharedMemory(SharedMemory_e teStepV, uint32_t ulValueV,
+                                   const QString & clKeyR)
+{
+   int32_t  slSizeT;
+   int32_t  slPosT;
+
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_SHARED_MEMORY;
+
+   for(slPosT = 0; slPosT < QCAN_MSG_DATA_MAX; slPosT++)
+   {
+      aubByteP[slPosT] = 0;
+   }
+   aubByteP[SHM_POS_STEP] = (uint8_t) teStepV;
+   setDataUInt32(SHM_POS_VALUE, ulValueV);
+
+   //----------------------------------------------------------------
+   // the key is limited by the size of the payload
+   //
+   slSizeT = clKeyR.size();
+   if(slSizeT > (QCAN_MSG_DATA_MAX - SHM_POS_KEY))
+   {
+      slSizeT = QCAN_MSG_DATA_MAX - SHM_POS_KEY;
+   }
+
+   for(slPosT = 0; slPosT < slSizeT; slPosT++)
+   {
+      aubByteP[SHM_POS_KEY + slPosT] = clKeyR.at(slPosT).toLatin1();
+   }
+   ubMsgDlcP = (uint8_t) (SHM_POS_KEY + slSizeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// sharedMemory()                                                             //
+// get shared memory handshake                                                //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::sharedMemory(SharedMemory_e & teStepR, uint32_t & ulValueR,
+                                QString & clKeyR)
+{
+   bool     btResultT = false;
+   uint8_t  ubPosT;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_SHARED_MEMORY)
+   {
+      teStepR  = (SharedMemory_e) aubByteP[SHM_POS_STEP];
+      ulValueR = dataUInt32(SHM_POS_VALUE);
+
+      clKeyR.clear();
+      for(ubPosT = SHM_POS_KEY; 
+          (ubPosT < ubMsgDlcP) && (ubPosT < QCAN_MSG_DATA_MAX); ubPosT++)
+      {
+         clKeyR.append(aubByteP[ubPosT]);
+      }
+      btResultT = true;
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setWireFormat()                                                            //
+// Byte 0: bit-mask of wire format options                                    //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setWireFormat(uint8_t ubFormatV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_WIRE_FORMAT;
+   ubMsgDlcP    = 1;
+   aubByteP[0]  = ubFormatV;
+}
+
+
+//----------------------------------------------------------------------------//
+// wireFormat()                                                               //
+// get wire format options (byte 0)                                           //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::wireFormat(uint8_t & ubFormatR)
+{
+   bool  btResultT = false;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_WIRE_FORMAT)
+   {
+      ubFormatR = aubByteP[0];
+      btResultT = true;
+   }
+
+   return(btResultT);
+}
+
+
 //----------------------------------------------------------------------------//
 // fromByteArray()                                                            //
 //                                                                            //
 //----------------------------------------------------------------------------//
 bool QCanFrameApi::fromByteArray(const QByteArray & clByteArrayR)
+{
+   return (fromByteArray(clByteArrayR.constData(), clByteArrayR.size()));
+}
+
+
+//----------------------------------------------------------------------------//
+// fromByteArray()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::fromByteArray(const char * pchDataV, int32_t slSizeV)
 {
    bool  btResultT = false;
    
@@ -213,9 +651,9 @@ bool QCanFrameApi::fromByteArray(const QByteArray & clByteArrayR)
    // an API frame must have the value 0x40 in the first byte,
    // refer to QCanData class implementation
    //
-   if ((clByteArrayR.at(0) & 0x40) > 0)
+   if ((slSizeV > 0) && ((pchDataV[0] & 0x40) > 0))
    {
-      btResultT = (QCanData::fromByteArray(clByteArrayR)); 
+      btResultT = (QCanData::fromByteArray(pchDataV, slSizeV)); 
    }
    
    return (btResultT);
@@ -232,23 +670,68 @@ QByteArray QCanFrameApi::toByteArray() const
 }
 
 
+//----------------------------------------------------------------------------//
+// toByteArray()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrameApi::toByteArray(char * pchDataV, int32_t slSizeV,
+                                  bool btChecksumV) const
+{
+   return QCanData::toByteArray(pchDataV, slSizeV, btChecksumV);
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanFrameApi::toByteArrayCompact() const
+{
+   return QCanData::toByteArrayCompact();
+}
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrameApi::toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                         bool btChecksumV) const
+{
+   return QCanData::toByteArrayCompact(pchDataV, slSizeV, btChecksumV);
+}
+
+
 //----------------------------------------------------------------------------//
 // toString()                                                                 //
 // print API frame                                                            //
 //----------------------------------------------------------------------------//
 QString QCanFrameApi::toString(const bool & btShowTimeR)
 {
-   //----------------------------------------------------------------
-   // setup a string object
-   //
-   QString clStringT; 
-   
-   if(btShowTimeR == true)
+   char     achStringT[QCAN_FRAME_STRING_SIZE];
+   int32_t  slSizeT;
+
+   slSizeT = toString(&achStringT[0], QCAN_FRAME_STRING_SIZE, btShowTimeR);
+
+   return(QString::fromLatin1(&achStringT[0], slSizeT));
+}
+
+
+//----------------------------------------------------------------------------//
+// toString()                                                                 //
+// print API frame to buffer                                                  //
+//----------------------------------------------------------------------------//
+int32_t QCanFrameApi::toString(char * pchBufferV, int32_t slSizeV,
+                               bool btShowTimeV) const
+{
+   char *   pchOutT = pchBufferV;
+   uint8_t  ubSizeT;
+
+   Q_UNUSED(btShowTimeV);
+
+   if((pchBufferV == Q_NULLPTR) || (slSizeV < QCAN_FRAME_STRING_SIZE))
    {
-      
+      return(0);
    }
-   
-   
 
    //----------------------------------------------------------------
    // print information
@@ -256,18 +739,44 @@ QString QCanFrameApi::toString(const bool & btShowTimeR)
    switch(function())
    {
       case eAPI_FUNC_BITRATE:
-         clStringT = "Bit-rate:";
+         pchOutT = formatText(pchOutT, "Bit-rate:");
          break;
 
       case eAPI_FUNC_NAME:
-         name(clStringT);
+         ubSizeT = qMin(ubMsgDlcP, (uint8_t) QCAN_MSG_DATA_MAX);
+         memcpy(pchOutT, &aubByteP[0], ubSizeT);
+         pchOutT += ubSizeT;
+         break;
+
+      case eAPI_FUNC_FILTER:
+         pchOutT = formatText(pchOutT, "Filter: ");
+         pchOutT = formatDecimal(pchOutT, filterCount());
+         pchOutT = formatText(pchOutT, " entries");
+         break;
+
+      case eAPI_FUNC_CYCLIC:
+         pchOutT = formatText(pchOutT, "Cyclic: job ");
+         pchOutT = formatDecimal(pchOutT, aubByteP[CYCLIC_POS_JOB]);
+         pchOutT = formatText(pchOutT, ", period ");
+         pchOutT = formatDecimal(pchOutT, dataUInt32(CYCLIC_POS_PERIOD));
+         pchOutT = formatText(pchOutT, " us");
+         break;
+
+      case eAPI_FUNC_QUEUE_STATUS:
+         pchOutT = formatText(pchOutT, "Queue: ");
+         pchOutT = formatDecimal(pchOutT, dataUInt32(QUEUE_POS_DEPTH));
+         pchOutT = formatText(pchOutT, " / ");
+         pchOutT = formatDecimal(pchOutT, dataUInt32(QUEUE_POS_LIMIT));
+         pchOutT = formatText(pchOutT, ", dropped ");
+         pchOutT = formatDecimal(pchOutT, dataUInt32(QUEUE_POS_DROPPED));
          break;
          
       default:
          
          break;
    }
-   
-   return(clStringT);
+   *pchOutT = 0;
+
+   return((int32_t) (pchOutT - pchBufferV));
 }
       
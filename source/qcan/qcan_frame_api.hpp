@@ -38,6 +38,7 @@
 \*----------------------------------------------------------------------------*/
 
 #include "qcan_data.hpp"
+#include "qcan_frame.hpp"
 
 using namespace QCan;
 
@@ -70,16 +71,67 @@ public:
 
       eAPI_FUNC_NAME,
 
-      eAPI_FUNC_STATE
+      eAPI_FUNC_STATE,
+
+      /*! Wire format of socket connection               */
+      eAPI_FUNC_WIRE_FORMAT,
+
+      /*! Acceptance filter of socket connection         */
+      eAPI_FUNC_FILTER,
+
+      /*! Shared memory transport of socket connection   */
+      eAPI_FUNC_SHARED_MEMORY,
+
+      /*! Send queue status of socket connection         */
+      eAPI_FUNC_QUEUE_STATUS,
+
+      /*! Cyclic transmit job of socket connection       */
+      eAPI_FUNC_CYCLIC
 
    };
 
+   /*!
+   ** Handshake steps of eAPI_FUNC_SHARED_MEMORY
+   */
+   enum SharedMemory_e {
+
+      eSHM_NONE = 0,
+
+      /*! QCanNetwork offers the shared memory ring      */
+      eSHM_OFFER,
+
+      /*! QCanSocket has attached to the ring            */
+      eSHM_ATTACH,
+
+      /*! QCanNetwork writes frames only to the ring     */
+      eSHM_START,
+
+      /*! QCanNetwork has written new frames to the ring */
+      eSHM_NOTIFY
+   };
+
 
    QCanFrameApi();
    
    
    ~QCanFrameApi();
 
+   /*!
+   ** \param[in]  ulIdentifierV  Identifier value
+   ** \param[in]  ulMaskV        Acceptance mask
+   ** \param[in]  btExtendedV    \c true for extended frame format
+   ** \return     \c true if the entry has been added
+   ** \see        setFilter()
+   **
+   ** The function adds an identifier / mask pair to an API frame of
+   ** type eAPI_FUNC_FILTER. A bit that is set in the acceptance mask
+   ** must be equal in the identifier of a CAN frame and the identifier
+   ** of the entry. The function returns \c false if the frame already
+   ** holds QCAN_FILTER_API_ENTRY_MAX entries.
+   */
+   bool  appendFilter(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                      bool btExtendedV);
+
    bool  bitrate(int32_t & slNomBitRateV, int32_t & slDatBitRateV);
 
    int32_t  bitrateData(void);
@@ -88,27 +140,201 @@ public:
    
    //bool  hdi(CpHdi_ts & tsHdiR);
 
-   ApiFunc_e function(void);
+   /*!
+   ** \param[out] ubJobR         Job number
+   ** \param[out] clFrameR       CAN frame
+   ** \param[out] ulPeriodR      Period in microseconds
+   ** \param[out] ulCountR       Number of transmissions
+   ** \param[out] ubIncPosR      Position of payload increment
+   ** \return     \c true if frame holds a cyclic transmit job
+   ** \see        setCyclic()
+   */
+   bool  cyclic(uint8_t & ubJobR, QCanFrame & clFrameR, uint32_t & ulPeriodR,
+                uint32_t & ulCountR, uint8_t & ubIncPosR);
+
+   /*!
+   ** \param[in]  ubEntryV       Entry index
+   ** \param[out] ulIdentifierR  Identifier value
+   ** \param[out] ulMaskR        Acceptance mask
+   ** \param[out] btExtendedR    \c true for extended frame format
+   ** \return     \c true if frame holds the filter entry
+   ** \see        appendFilter()
+   */
+   bool  filter(uint8_t ubEntryV, uint32_t & ulIdentifierR,
+                uint32_t & ulMaskR, bool & btExtendedR);
+
+   /*!
+   ** \return     \c true if the entries are added to the filter set
+   ** \see        setFilter()
+   */
+   bool  filterAppend(void);
+
+   /*!
+   ** \return     Number of filter entries
+   ** \see        appendFilter()
+   */
+   uint8_t  filterCount(void) const;
+
+   ApiFunc_e function(void) const;
 
    bool  name(QString & clNameR);
 
    CAN_Mode_e  mode(void);
 
+   /*!
+   ** \param[out] ulDepthR       Number of queued frames
+   ** \param[out] ulLimitR       Size of send queue
+   ** \param[out] ulDroppedR     Number of dropped frames
+   ** \param[out] ubPolicyR      Policy for a full send queue
+   ** \return     \c true if frame holds the queue status
+   ** \see        setQueueStatus()
+   **
+   ** The function returns \c false for a request without status.
+   */
+   bool  queueStatus(uint32_t & ulDepthR, uint32_t & ulLimitR,
+                     uint32_t & ulDroppedR, uint8_t & ubPolicyR);
+
    void setBitrate(int32_t slBitrateV, int32_t slBrsClockV);
 
+   /*!
+   ** \param[in]  ubJobV         Job number
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  ulPeriodV      Period in microseconds
+   ** \param[in]  ulCountV       Number of transmissions
+   ** \param[in]  ubIncPosV      Position of payload increment
+   ** \return     \c true if the job fits into the API frame
+   ** \see        cyclic()
+   **
+   ** The function sets the API function eAPI_FUNC_CYCLIC. The QCanNetwork
+   ** transmits the CAN frame \c clFrameR every \c ulPeriodV microseconds
+   ** on its CAN interface, the timing does not depend on the event loop
+   ** of the socket or the network. A value of 0 for \c ulCountV transmits
+   ** the frame until the job is stopped, otherwise the job ends after 
+   ** \c ulCountV transmissions. If \c ubIncPosV is a valid position 
+   ** in the payload, the data byte at this position is incremented
+   ** after each transmission. A value of QCAN_CYCLIC_NO_INCREMENT keeps
+   ** the payload.
+   **
+   ** Each socket has its own job numbers, a job with the same number
+   ** replaces a running job. A period of 0 stops the job. All jobs of
+   ** a socket are stopped when the socket is closed.
+   **
+   ** The payload of the CAN frame is limited to 48 bytes, the function
+   ** returns \c false for a CAN FD frame with 64 bytes.
+   */
+   bool  setCyclic(uint8_t ubJobV, const QCanFrame & clFrameR, 
+                   uint32_t ulPeriodV, uint32_t ulCountV = 0,
+                   uint8_t ubIncPosV = QCAN_CYCLIC_NO_INCREMENT);
+
    void  setDriverInit();
 
    void  setDriverRelease();
 
+   /*!
+   ** \param[in]  btAppendV      \c true to add entries to the filter set
+   ** \see        appendFilter()
+   **
+   ** The function sets the API function eAPI_FUNC_FILTER without any
+   ** filter entry. Entries are added by appendFilter(). The QCanNetwork
+   ** stores the acceptance filters for each socket and writes only
+   ** CAN frames which pass one of the filters to the socket. If
+   ** \c btAppendV is \c false, the frame replaces the filter set of
+   ** the socket, otherwise its entries are added to the filter set.
+   ** Hence larger filter sets are transferred by several frames.
+   ** A filter set without entries accepts all CAN frames.
+   */
+   void  setFilter(bool btAppendV = false);
+
    void  setMode(CAN_Mode_e teModeV);
 
    void  setName(QString clNameV);
 
+   /*!
+   ** \see        queueStatus()
+   **
+   ** The function sets the API function eAPI_FUNC_QUEUE_STATUS without
+   ** status values. A QCanSocket writes this frame in order to request
+   ** the status of its send queue inside the QCanNetwork. The network
+   ** answers with the status values.
+   */
+   void  setQueueStatus(void);
+
+   /*!
+   ** \param[in]  ulDepthV       Number of queued frames
+   ** \param[in]  ulLimitV       Size of send queue
+   ** \param[in]  ulDroppedV     Number of dropped frames
+   ** \param[in]  ubPolicyV      Policy for a full send queue
+   ** \see        queueStatus()
+   **
+   ** The function sets the API function eAPI_FUNC_QUEUE_STATUS with the
+   ** status of the send queue of a socket. The policy values are
+   ** defined in qcan_defs.hpp, e.g. QCAN_SEND_POLICY_DROP_OLDEST.
+   */
+   void  setQueueStatus(uint32_t ulDepthV, uint32_t ulLimitV,
+                        uint32_t ulDroppedV, uint8_t ubPolicyV);
+
+   /*!
+   ** \param[in]  teStepV        Handshake step
+   ** \param[in]  ulValueV       Value of handshake step
+   ** \param[in]  clKeyR         Key of shared memory segment
+   ** \see        sharedMemory()
+   **
+   ** The function sets the API function eAPI_FUNC_SHARED_MEMORY. A
+   ** QCanNetwork offers its shared memory ring (refer to QCanSharedRing)
+   ** to sockets on the same host, \c ulValueV holds a unique ID of the
+   ** socket connection. The QCanSocket attaches to the ring and answers
+   ** with the step eSHM_ATTACH and the same ID. The QCanNetwork sends
+   ** all further CAN frames only through the ring and answers with the
+   ** step eSHM_START, \c ulValueV holds the position of the next frame
+   ** in the ring. After each dispatch pass which has written frames to
+   ** the ring, the QCanNetwork sends the step eSHM_NOTIFY without key,
+   ** so the socket is woken up by its connection. The key is limited to
+   ** 56 characters.
+   */
+   void  setSharedMemory(SharedMemory_e teStepV, uint32_t ulValueV,
+                         const QString & clKeyR);
+
+   /*!
+   ** \param[out] teStepR        Handshake step
+   ** \param[out] ulValueR       Value of handshake step
+   ** \param[out] clKeyR         Key of shared memory segment
+   ** \return     \c true if frame holds the shared memory handshake
+   ** \see        setSharedMemory()
+   */
+   bool  sharedMemory(SharedMemory_e & teStepR, uint32_t & ulValueR,
+                      QString & clKeyR);
+
+   /*!
+   ** \param[in]  ubFormatV      Bit-mask of wire format options
+   ** \see        wireFormat()
+   **
+   ** The function sets the API function eAPI_FUNC_WIRE_FORMAT. The
+   ** QCanNetwork sends the supported options to a new socket, the
+   ** QCanSocket answers with the options it uses. The bit-mask values
+   ** are defined in qcan_defs.hpp, e.g. QCAN_WIRE_FORMAT_COMPACT.
+   */
+   void  setWireFormat(uint8_t ubFormatV);
+
+   /*!
+   ** \param[out] ubFormatR      Bit-mask of wire format options
+   ** \return     \c true if frame holds the wire format
+   ** \see        setWireFormat()
+   */
+   bool  wireFormat(uint8_t & ubFormatR);
+
    //void  setHdi(CpHdi_ts * tsHdiV);
    
    bool       fromByteArray(const QByteArray & clByteArrayR);
+   bool       fromByteArray(const char * pchDataV, int32_t slSizeV);
    QByteArray toByteArray() const;
+   int32_t    toByteArray(char * pchDataV, int32_t slSizeV,
+                          bool btChecksumV = true) const;
+   QByteArray toByteArrayCompact() const;
+   int32_t    toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                 bool btChecksumV = true) const;
    virtual QString   toString(const bool & btShowTimeR = false);
+   int32_t    toString(char * pchBufferV, int32_t slSizeV,
+                       bool btShowTimeV = false) const;
 
 private:
    
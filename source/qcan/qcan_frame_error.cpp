@@ -156,6 +156,16 @@ void QCanFrameError::setErrorType(ErrorType_e ubTypeV)
 //                                                                            //
 //----------------------------------------------------------------------------//
 bool QCanFrameError::fromByteArray(const QByteArray & clByteArrayR)
+{
+   return (fromByteArray(clByteArrayR.constData(), clByteArrayR.size()));
+}
+
+
+//----------------------------------------------------------------------------//
+// fromByteArray()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameError::fromByteArray(const char * pchDataV, int32_t slSizeV)
 {
    bool  btResultT = false;
    
@@ -163,9 +173,9 @@ bool QCanFrameError::fromByteArray(const QByteArray & clByteArrayR)
    // an API frame must have the value 0x80 in the first byte,
    // refer to QCanData class implementation
    //
-   if ((clByteArrayR.at(0) & 0x80) > 0)
+   if ((slSizeV > 0) && ((pchDataV[0] & 0x80) > 0))
    {
-      btResultT = (QCanData::fromByteArray(clByteArrayR)); 
+      btResultT = (QCanData::fromByteArray(pchDataV, slSizeV)); 
    }
    
    return (btResultT);
@@ -181,51 +191,97 @@ QByteArray QCanFrameError::toByteArray() const
    return QCanData::toByteArray();
 }
 
+
+//----------------------------------------------------------------------------//
+// toByteArray()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrameError::toByteArray(char * pchDataV, int32_t slSizeV,
+                                    bool btChecksumV) const
+{
+   return QCanData::toByteArray(pchDataV, slSizeV, btChecksumV);
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanFrameError::toByteArrayCompact() const
+{
+   return QCanData::toByteArrayCompact();
+}
+
+//----------------------------------------------------------------------------//
+// toByteArrayCompact()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrameError::toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                           bool btChecksumV) const
+{
+   return QCanData::toByteArrayCompact(pchDataV, slSizeV, btChecksumV);
+}
+
 //----------------------------------------------------------------------------//
 // toString()                                                                 //
 // print CAN frame                                                            //
 //----------------------------------------------------------------------------//
 QString QCanFrameError::toString(const bool & btShowTimeR)
 {
-   //----------------------------------------------------------------
-   // setup a string object
-   //
-   QString clStringT;
-   
-   if(btShowTimeR == true)
+   char     achStringT[QCAN_FRAME_STRING_SIZE];
+   int32_t  slSizeT;
+
+   slSizeT = toString(&achStringT[0], QCAN_FRAME_STRING_SIZE, btShowTimeR);
+
+   return(QString::fromLatin1(&achStringT[0], slSizeT));
+}
+
+
+//----------------------------------------------------------------------------//
+// toString()                                                                 //
+// print CAN error frame to buffer                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrameError::toString(char * pchBufferV, int32_t slSizeV,
+                                 bool btShowTimeV) const
+{
+   char *   pchOutT = pchBufferV;
+
+   Q_UNUSED(btShowTimeV);
+
+   if((pchBufferV == Q_NULLPTR) || (slSizeV < QCAN_FRAME_STRING_SIZE))
    {
-      
+      return(0);
    }
-   
 
    //----------------------------------------------------------------
    // print frame format
    //
-   clStringT += "CAN error frame   ";
+   pchOutT = formatText(pchOutT, "CAN error frame   ");
 
    switch(this->errorState())
    {
       case eCAN_STATE_BUS_ACTIVE:
-         clStringT += "Error active";
+         pchOutT = formatText(pchOutT, "Error active");
          break;
 
       case eCAN_STATE_BUS_WARN:
-         clStringT += "Warning level reached";
+         pchOutT = formatText(pchOutT, "Warning level reached");
          break;
 
       case eCAN_STATE_BUS_PASSIVE:
-         clStringT += "Error passive";
+         pchOutT = formatText(pchOutT, "Error passive");
          break;
 
       case eCAN_STATE_BUS_OFF:
-         clStringT += "Bus off";
+         pchOutT = formatText(pchOutT, "Bus off");
          break;
 
       default:
 
          break;
    }
-   
-   return(clStringT);
+   *pchOutT = 0;
+
+   return((int32_t) (pchOutT - pchBufferV));
 }
       
@@ -178,8 +178,16 @@ public:
    void setErrorType(ErrorType_e ubTypeV);
 
    bool       fromByteArray(const QByteArray & clByteArrayR);
+   bool       fromByteArray(const char * pchDataV, int32_t slSizeV);
    QByteArray toByteArray() const;
+   int32_t    toByteArray(char * pchDataV, int32_t slSizeV,
+                          bool btChecksumV = true) const;
+   QByteArray toByteArrayCompact() const;
+   int32_t    toByteArrayCompact(char * pchDataV, int32_t slSizeV,
+                                 bool btChecksumV = true) const;
    virtual QString   toString(const bool & btShowTimeR = false);
+   int32_t    toString(char * pchBufferV, int32_t slSizeV,
+                       bool btShowTimeV = false) const;
    
 private:
    
@@ -0,0 +1,221 @@
+//============================================================================//
+// File:          qcan_frame_queue.cpp                                        //
+// Description:   QCan classes - lock-free frame queue                        //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "qcan_frame_queue.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanFrameQueue()                                                           //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanFrameQueue::QCanFrameQueue(uint32_t ulSlotCountV)
+{
+   uint32_t ulSizeT = 1;
+
+   //----------------------------------------------------------------
+   // the index is masked, so the number of slots is a power of 2
+   //
+   while((ulSizeT < ulSlotCountV) && (ulSizeT < 0x80000000))
+   {
+      ulSizeT = ulSizeT << 1;
+   }
+   clSlotP.resize(ulSizeT);
+   ptsSlotP    = clSlotP.data();
+   ulSlotMaskP = ulSizeT - 1;
+
+   ulWriteIdxP.store(0);
+   ulReadIdxP.store(0);
+   ulOverrunCntP.store(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanFrameQueue()                                                          //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanFrameQueue::~QCanFrameQueue()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// clear()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrameQueue::clear(void)
+{
+   ulWriteIdxP.store(0);
+   ulReadIdxP.store(0);
+   ulOverrunCntP.store(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// count()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanFrameQueue::count(void) const
+{
+   return(ulWriteIdxP.loadAcquire() - ulReadIdxP.loadAcquire());
+}
+
+
+//----------------------------------------------------------------------------//
+// pop()                                                                      //
+// remove oldest frame, called by reader thread                               //
+//----------------------------------------------------------------------------//
+bool QCanFrameQueue::pop(QByteArray & clDataR, uint32_t * pulTagV)
+{
+   uint32_t          ulReadIdxT;
+   QCanQueueSlot_ts * ptsSlotT;
+
+   //----------------------------------------------------------------
+   // the acquire operation makes the slot contents of the writer
+   // visible
+   //
+   ulReadIdxT = ulReadIdxP.load();
+   if(ulWriteIdxP.loadAcquire() == ulReadIdxT)
+   {
+      return(false);
+   }
+
+   ptsSlotT = &ptsSlotP[ulReadIdxT & ulSlotMaskP];
+   clDataR.resize(ptsSlotT->slSizeM);
+   memcpy(clDataR.data(), &ptsSlotT->achDataM[0], ptsSlotT->slSizeM);
+   if(pulTagV != Q_NULLPTR)
+   {
+      *pulTagV = ptsSlotT->ulTagM;
+   }
+
+   //----------------------------------------------------------------
+   // the slot is released after the copy
+   //
+   ulReadIdxP.storeRelease(ulReadIdxT + 1);
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// popBatch()                                                                 //
+// remove several frames at once, called by reader thread                     //
+//----------------------------------------------------------------------------//
+uint32_t QCanFrameQueue::popBatch(char * pchDataV, uint32_t ulFrameMaxV)
+{
+   uint32_t          ulReadIdxT;
+   uint32_t          ulFrameCntT;
+   uint32_t          ulCntT;
+   QCanQueueSlot_ts * ptsSlotT;
+
+   //----------------------------------------------------------------
+   // all frames available at this point are copied, the indices
+   // are synchronised only once for the whole batch
+   //
+   ulReadIdxT  = ulReadIdxP.load();
+   ulFrameCntT = ulWriteIdxP.loadAcquire() - ulReadIdxT;
+   if(ulFrameCntT > ulFrameMaxV)
+   {
+      ulFrameCntT = ulFrameMaxV;
+   }
+
+   for(ulCntT = 0; ulCntT < ulFrameCntT; ulCntT++)
+   {
+      ptsSlotT = &ptsSlotP[(ulReadIdxT + ulCntT) & ulSlotMaskP];
+      memcpy(pchDataV, &ptsSlotT->achDataM[0], ptsSlotT->slSizeM);
+      pchDataV += QCAN_FRAME_ARRAY_SIZE;
+   }
+
+   if(ulFrameCntT > 0)
+   {
+      ulReadIdxP.storeRelease(ulReadIdxT + ulFrameCntT);
+   }
+
+   return(ulFrameCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// push()                                                                     //
+// add frame, called by writer thread                                         //
+//----------------------------------------------------------------------------//
+bool QCanFrameQueue::push(const char * pchDataV, int32_t slSizeV, 
+                          uint32_t ulTagV)
+{
+   uint32_t          ulWriteIdxT;
+   QCanQueueSlot_ts * ptsSlotT;
+
+   if((pchDataV == Q_NULLPTR) || (slSizeV <= 0) || 
+      (slSizeV > QCAN_FRAME_ARRAY_SIZE))
+   {
+      return(false);
+   }
+
+   ulWriteIdxT = ulWriteIdxP.load();
+   if((ulWriteIdxT - ulReadIdxP.loadAcquire()) > ulSlotMaskP)
+   {
+      ulOverrunCntP.fetchAndAddRelaxed(1);
+      return(false);
+   }
+
+   ptsSlotT = &ptsSlotP[ulWriteIdxT & ulSlotMaskP];
+   ptsSlotT->slSizeM = slSizeV;
+   ptsSlotT->ulTagM  = ulTagV;
+   memcpy(&ptsSlotT->achDataM[0], pchDataV, slSizeV);
+
+   //----------------------------------------------------------------
+   // the release operation publishes the slot to the reader
+   //
+   ulWriteIdxP.storeRelease(ulWriteIdxT + 1);
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// push()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameQueue::push(const QByteArray & clDataR)
+{
+   return(push(clDataR.constData(), clDataR.size()));
+}
@@ -0,0 +1,171 @@
+//============================================================================//
+// File:          qcan_frame_queue.hpp                                        //
+// Description:   QCan classes - lock-free frame queue                        //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+#ifndef QCAN_FRAME_QUEUE_HPP_
+#define QCAN_FRAME_QUEUE_HPP_
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <QVector>
+
+#include "qcan_data.hpp"
+
+//-------------------------------------------------------------------
+/*!
+** \file qcan_frame_queue.hpp
+**
+*/
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanFrameQueue
+** \brief   Lock-free frame queue
+**
+** The QCanFrameQueue class is a ring of frame slots for exactly one
+** writer thread and one reader thread. A CAN interface plugin uses
+** the queue to pass frames from its receive thread to read(), which
+** is called by the QCanNetwork. Neither thread waits for the other:
+** a frame is dropped if the queue is full, the number of dropped
+** frames is reported by overruns().
+*/
+class QCanFrameQueue
+{
+public:
+
+   /*!
+   ** \param[in]  ulSlotCountV   Number of slots, must be a power of 2
+   **
+   ** Construct an empty queue. A value which is not a power of 2 is
+   ** rounded up.
+   */
+   QCanFrameQueue(uint32_t ulSlotCountV = QCAN_FRAME_QUEUE_SIZE);
+
+   ~QCanFrameQueue();
+
+   /*!
+   ** Remove all frames and clear the overrun counter. The function
+   ** must not be called while the writer or the reader is active.
+   */
+   void     clear(void);
+
+   /*!
+   ** \return     Number of frames in the queue
+   */
+   uint32_t count(void) const;
+
+   /*!
+   ** \return     \c true if the queue holds no frame
+   */
+   inline bool isEmpty(void) const     { return(count() == 0);          };
+
+   /*!
+   ** \return     Number of frames dropped because the queue was full
+   */
+   inline uint32_t overruns(void) const { return(ulOverrunCntP.load()); };
+
+   /*!
+   ** \param[out] clDataR        Frame data
+   ** \param[out] pulTagV        Pointer to tag of frame, may be Q_NULLPTR
+   ** \return     \c true if a frame has been removed from the queue
+   ** \see        push()
+   **
+   ** Remove the oldest frame from the queue, the function must only
+   ** be called by the reader thread.
+   */
+   bool     pop(QByteArray & clDataR, uint32_t * pulTagV = Q_NULLPTR);
+
+   /*!
+   ** \param[out] pchDataV       Pointer to buffer for frames
+   ** \param[in]  ulFrameMaxV    Maximum number of frames
+   ** \return     Number of frames removed from the queue
+   ** \see        QCanInterface::readBatch()
+   **
+   ** Remove up to \c ulFrameMaxV frames from the queue, the function
+   ** must only be called by the reader thread. Frame \c n is copied to
+   ** offset \c n * QCAN_FRAME_ARRAY_SIZE of \c pchDataV.
+   */
+   uint32_t popBatch(char * pchDataV, uint32_t ulFrameMaxV);
+
+   /*!
+   ** \param[in]  pchDataV       Pointer to frame data
+   ** \param[in]  slSizeV        Size of frame data
+   ** \param[in]  ulTagV         Tag of frame, returned by pop()
+   ** \return     \c true if the frame has been added to the queue
+   ** \see        pop()
+   **
+   ** Add a frame to the queue, the function must only be called by
+   ** the writer thread. The size of the frame is limited to
+   ** QCAN_FRAME_ARRAY_SIZE. If the queue is full, the frame is dropped
+   ** and the overrun counter is incremented. The writer may pass
+   ** additional information about the frame in \c ulTagV.
+   */
+   bool     push(const char * pchDataV, int32_t slSizeV, 
+                 uint32_t ulTagV = 0);
+
+   /*!
+   ** \param[in]  clDataR        Frame data
+   ** \return     \c true if the frame has been added to the queue
+   **
+   ** This is an overloaded function, using QByteArray as parameter.
+   */
+   bool     push(const QByteArray & clDataR);
+
+private:
+
+   typedef struct QCanQueueSlot_s {
+      int32_t                    slSizeM;
+      uint32_t                   ulTagM;
+      char                       achDataM[QCAN_FRAME_ARRAY_SIZE];
+   } QCanQueueSlot_ts;
+
+   QVector<QCanQueueSlot_ts>     clSlotP;
+   QCanQueueSlot_ts *            ptsSlotP;
+   uint32_t                      ulSlotMaskP;
+
+   //----------------------------------------------------------------
+   // the write index is only modified by the writer, the read
+   // index only by the reader
+   //
+   QAtomicInteger<uint32_t>      ulWriteIdxP;
+   QAtomicInteger<uint32_t>      ulReadIdxP;
+   QAtomicInteger<uint32_t>      ulOverrunCntP;
+};
+
+#endif   // QCAN_FRAME_QUEUE_HPP_
@@ -41,6 +41,7 @@
 #define QCAN_INTERFACE_HPP_
 
 #include <stdint.h>
+#include <string.h>
 #include "qcan_defs.hpp"
 #include "qcan_frame.hpp"
 
@@ -59,6 +60,7 @@ using namespace QCan;
 */
 class QCanInterface : public QObject
 {
+   Q_OBJECT
 
 public:
 
@@ -159,6 +161,45 @@ public:
    virtual InterfaceError_e   read( QCanFrame &clFrameR) = 0;
 
    virtual InterfaceError_e   read( QByteArray &clDataR) = 0;
+
+   /*!
+   ** \param[out] pchDataV       Pointer to buffer for frames
+   ** \param[in]  ulFrameMaxV    Maximum number of frames
+   ** \param[out] ulFrameCntR    Number of frames read
+   ** \return     Status code defined by InterfaceError_e
+   ** \see        writeBatch()
+   **
+   ** The function reads up to \c ulFrameMaxV frames from the CAN
+   ** interface with one call. The buffer \c pchDataV must provide
+   ** QCAN_FRAME_ARRAY_SIZE bytes for each frame, frame \c n is
+   ** stored at offset \c n * QCAN_FRAME_ARRAY_SIZE using the fixed
+   ** encoding of read(QByteArray &). The function returns
+   ** eERROR_FIFO_RCV_EMPTY if no frame has been read.
+   **
+   ** The default implementation calls read() for each frame, a CAN
+   ** interface should provide an implementation which fetches
+   ** several frames from the driver at once.
+   */
+   virtual InterfaceError_e   readBatch(char * pchDataV, uint32_t ulFrameMaxV,
+                                        uint32_t & ulFrameCntR)
+   {
+      QByteArray  clDataT;
+
+      ulFrameCntR = 0;
+      while ((ulFrameCntR < ulFrameMaxV) && (read(clDataT) == eERROR_NONE))
+      {
+         memcpy(pchDataV + (ulFrameCntR * QCAN_FRAME_ARRAY_SIZE),
+                clDataT.constData(),
+                qMin(clDataT.size(), QCAN_FRAME_ARRAY_SIZE));
+         ulFrameCntR++;
+      }
+
+      if (ulFrameCntR == 0)
+      {
+         return (eERROR_FIFO_RCV_EMPTY);
+      }
+      return (eERROR_NONE);
+   };
    
    /*!
    ** \param[in]  slNomBitRateV  Nominal Bit-rate value
@@ -210,10 +251,53 @@ public:
    */
    virtual InterfaceError_e	write(const QCanFrame &clFrameR) = 0;
 
+   /*!
+   ** \param[in]  pclFrameV      Pointer to array of frames
+   ** \param[in]  ulFrameCntV    Number of frames
+   ** \param[out] ulWrittenR     Number of frames written
+   ** \return     Status code defined by InterfaceError_e
+   ** \see        readBatch()
+   **
+   ** The function writes \c ulFrameCntV frames to the CAN interface
+   ** with one call. If not all frames could be written, the function
+   ** returns the status of the first failed frame, \c ulWrittenR
+   ** holds the number of frames written before.
+   **
+   ** The default implementation calls write() for each frame.
+   */
+   virtual InterfaceError_e   writeBatch(const QCanFrame * pclFrameV,
+                                         uint32_t ulFrameCntV,
+                                         uint32_t & ulWrittenR)
+   {
+      InterfaceError_e  teResultT = eERROR_NONE;
+
+      ulWrittenR = 0;
+      while (ulWrittenR < ulFrameCntV)
+      {
+         teResultT = write(pclFrameV[ulWrittenR]);
+         if (teResultT != eERROR_NONE)
+         {
+            break;
+         }
+         ulWrittenR++;
+      }
+
+      return (teResultT);
+   };
+
 
 
 Q_SIGNALS:
     void errorOccurred(int32_t slCanBusErrorV);     //  QCanBusDevice::CanBusError
+
+    /*!
+    ** \param[in]  ulFramesCountV  Number of frames received
+    **
+    ** This signal is emitted by the CAN interface when new frames are
+    ** available in the receive FIFO. A QCanNetwork reads the frames
+    ** immediately via read(), hence an interface emitting this signal
+    ** is not subject to the dispatcher polling time.
+    */
     void framesReceived(uint32_t ulFramesCountV);
     void framesWritten(uint32_t ulFramesCountV);
     void stateChanged(int32_t slCanBusDevStatusV);
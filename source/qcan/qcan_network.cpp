@@ -37,6 +37,7 @@
 #include "qcan_defs.hpp"
 #include "qcan_interface.hpp"
 #include "qcan_network.hpp"
+#include "qcan_trace.hpp"
 
 
 /*----------------------------------------------------------------------------*\
@@ -50,12 +51,19 @@
 //
 #define  QCAN_SOCKET_CAN_IF      22345
 
+//-------------------------------------------------------------------
+// the key of the shared memory ring is build from this prefix and
+// the TCP port of the network
+//
+#define  QCAN_SHARED_RING_KEY    "QCanNetwork_"
+
 
 /*----------------------------------------------------------------------------*\
 ** Static variables                                                           **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
-uint8_t  QCanNetwork::ubNetIdP = 0;
+uint8_t        QCanNetwork::ubNetIdP = 0;
+QElapsedTimer  QCanNetwork::clTimeBaseP;
 
 /*----------------------------------------------------------------------------*\
 ** Class methods                                                              **
@@ -90,33 +98,97 @@ QCanNetwork::QCanNetwork(QObject * pclParentV,
    //----------------------------------------------------------------
    // create initial socket list
    //
-   pclTcpSockListP = new QVector<QTcpSocket *>;
-   pclTcpSockListP->reserve(QCAN_TCP_SOCKET_MAX);
+   pclSockListP = new QVector<QIODevice *>;
+   pclSockListP->reserve(QCAN_TCP_SOCKET_MAX);
+
+   pclSockInfoListP = new QVector<SockInfo_ts>;
+   pclSockInfoListP->reserve(QCAN_TCP_SOCKET_MAX);
+   ulBatchSizeP    = QCAN_NETWORK_BATCH_SIZE;
+   ulClientIdP     = 0;
+   ulQueueSizeP    = QCAN_NETWORK_QUEUE_SIZE;
+   ubSendPolicyP   = QCAN_SEND_POLICY_DROP_OLDEST;
+   ulCntFrameDropP = 0;
+
+   //----------------------------------------------------------------
+   // the shared memory ring is created when the network is enabled,
+   // the notification for its readers is always the same frame
+   //
+   QCanFrameApi clShmNotifyT;
+   clShmNotifyT.setSharedMemory(QCanFrameApi::eSHM_NOTIFY, 0, QString());
+   clShmNotifyP    = clShmNotifyT.toByteArray();
+   ulShmNotifyIdxP = 0;
+   ulShmSockCntP   = 0;
+   btShmEnabledP   = true;
+
+   //----------------------------------------------------------------
+   // frames of cyclic transmit jobs are dispatched like frames
+   // of the CAN interface
+   //
+   connect( &clSchedulerP, SIGNAL(framesSent()),
+            this, SLOT(onInterfaceReceive()));
+
+   //----------------------------------------------------------------
+   // the time base for ingress time-stamps is started by the
+   // first network, it is shared by all networks
+   //
+   btTimeStampEnabledP = false;
+   if(clTimeBaseP.isValid() == false)
+   {
+      clTimeBaseP.start();
+   }
 
    //----------------------------------------------------------------
    // setup a new local server which is listening to the
    // default network name
    //
-   pclTcpSrvP = new QTcpServer();
+   pclTcpSrvP = new QTcpServer(this);
 
    clTcpHostAddrP = QHostAddress(QHostAddress::Any);
    uwTcpPortP = uwPortV;
 
+   //----------------------------------------------------------------
+   // the local server uses a name which is derived from the port
+   //
+   pclLocalSrvP    = new QLocalServer(this);
+   btLocalEnabledP = true;
+
    //----------------------------------------------------------------
    // clear statistic
    //
    ulCntFrameApiP = 0;
    ulCntFrameCanP = 0;
    ulCntFrameErrP = 0;
-   ulCntBitCurP   = 0;
+   ulFrameCntSaveP = 0;
+   ubBusLoadP       = 0;
+   ubBusLoadWindowP = 0;
+   clLoadWindowTmrP.start();
+   clLoadPeriodTmrP.start();
 
    //----------------------------------------------------------------
    // setup timing values
    //
    ulDispatchTimeP  = 20;
    ulStatisticTimeP = 1000;
-   ulStatisticTickP = ulStatisticTimeP / ulDispatchTimeP;
 
+   //----------------------------------------------------------------
+   // The timers are children of the network, so they are moved
+   // together with the network to a dispatcher thread
+   //
+   clDispatchTmrP.setParent(this);
+   clStatisticTmrP.setParent(this);
+
+   //----------------------------------------------------------------
+   // The dispatcher timer polls the physical CAN interface, frames
+   // from sockets are dispatched upon the readyRead() signal.
+   // The statistic values are signaled by a separate timer.
+   //
+   clDispatchTmrP.setInterval(ulDispatchTimeP);
+   connect( &clDispatchTmrP, SIGNAL(timeout()),
+            this, SLOT(onInterfaceReceive()));
+
+   clStatisticTmrP.setInterval(ulStatisticTimeP);
+   connect( &clStatisticTmrP, SIGNAL(timeout()),
+            this, SLOT(onStatisticEvent()));
 
    //----------------------------------------------------------------
    // setup default bit-rate
@@ -131,6 +203,13 @@ QCanNetwork::QCanNetwork(QObject * pclParentV,
 //----------------------------------------------------------------------------//
 QCanNetwork::~QCanNetwork()
 {
+   //----------------------------------------------------------------
+   // stop cyclic transmit jobs and the trace recorder
+   //
+   clSchedulerP.setEnabled(false);
+   clSchedulerP.setInterface(Q_NULLPTR, Q_NULLPTR);
+   clRecorderP.stopRecording();
+
    //----------------------------------------------------------------
    // close TCP server
    //
@@ -140,6 +219,12 @@ QCanNetwork::~QCanNetwork()
    }
    delete(pclTcpSrvP);
 
+   if(pclLocalSrvP->isListening())
+   {
+      pclLocalSrvP->close();
+   }
+   delete(pclLocalSrvP);
+
    ubNetIdP--;
 }
 
@@ -152,6 +237,23 @@ bool QCanNetwork::addInterface(QCanInterface * pclCanIfV)
 {
    bool  btResultT = false;
 
+   //----------------------------------------------------------------
+   // If the network runs in a dedicated thread, the CAN interface
+   // is moved to this thread before it is configured there.
+   //
+   if(isNetworkThread() == false)
+   {
+      if(pclCanIfV->thread() == QThread::currentThread())
+      {
+         pclCanIfV->moveToThread(this->thread());
+      }
+      QMetaObject::invokeMethod(this, "addInterface",
+                                Qt::BlockingQueuedConnection,
+                                Q_RETURN_ARG(bool, btResultT),
+                                Q_ARG(QCanInterface *, pclCanIfV));
+      return (btResultT);
+   }
+
    if(pclInterfaceP.isNull())
    {
       //--------------------------------------------------------
@@ -159,12 +261,20 @@ bool QCanNetwork::addInterface(QCanInterface * pclCanIfV)
       //
       if(pclCanIfV->connect() == QCanInterface::eERROR_NONE)
       {
-         qDebug() << "addInterface() using bit-rate" << slNomBitRateP << slDatBitRateP;
+         qCanTrace(qcanTraceNetwork) << "addInterface() using bit-rate" << slNomBitRateP << slDatBitRateP;
          if(pclCanIfV->setBitrate(slNomBitRateP, slDatBitRateP) == QCanInterface::eERROR_NONE)
          {
             if (pclCanIfV->setMode(eCAN_MODE_START) == QCanInterface::eERROR_NONE)
             {
                pclInterfaceP = pclCanIfV;
+               clSchedulerP.setInterface(pclCanIfV, &clIfWriteMutexP);
+
+               //-------------------------------------------
+               // frames from the interface are dispatched
+               // as soon as they are signaled
+               //
+               connect( pclCanIfV, SIGNAL(framesReceived(uint32_t)),
+                        this, SLOT(onInterfaceReceive()));
                btResultT = true;
             }
          }
@@ -175,6 +285,16 @@ bool QCanNetwork::addInterface(QCanInterface * pclCanIfV)
 }
 
 
+//----------------------------------------------------------------------------//
+// isNetworkThread()                                                          //
+// check if the caller runs in the thread of the network                      //
+//----------------------------------------------------------------------------//
+bool QCanNetwork::isNetworkThread(void)
+{
+   return (QThread::currentThread() == this->thread());
+}
+
+
 //----------------------------------------------------------------------------//
 // hasErrorFramesSupport()                                                    //
 // Check if the CAN interface has error frame support                         //
@@ -273,216 +393,1257 @@ bool QCanNetwork::hasListenOnlySupport(void)
 
 
 //----------------------------------------------------------------------------//
-// frameType()                                                                //
-//                                                                            //
+// dispatchInterface()                                                        //
+// read all frames from the physical CAN interface and dispatch them          //
 //----------------------------------------------------------------------------//
-QCanData::Type_e  QCanNetwork::frameType(const QByteArray & clSockDataR)
+void QCanNetwork::dispatchInterface(void)
 {
-   QCanData::Type_e  ubTypeT;
-   
-   //----------------------------------------------------------------
-   // The frame type can be tested via the first byte of the array,
-   // please refer to the implmentation of QCanData for details.
-   //
-   switch(clSockDataR.at(0) & 0xE0)
+   int32_t        slSockIdxT;
+   uint32_t       ulFrameCntT;
+   uint32_t       ulFrameIdxT;
+   char           aachBatchT[QCAN_IF_BATCH_SIZE][QCAN_FRAME_ARRAY_SIZE];
+   QByteArray     clSockDataT;
+
+   if(pclInterfaceP.isNull() == false)
    {
-      case 0x00:
-         ubTypeT = QCanData::eTYPE_CAN;
-         break;
-      
-      case 0x40:
-         ubTypeT = QCanData::eTYPE_API;
-         break;
-      
-      case 0x80:
-         ubTypeT = QCanData::eTYPE_ERROR;
-         break;
-         
-      default:
-         ubTypeT = QCanData::eTYPE_UNKNOWN;
-         break;
+      slSockIdxT = QCAN_SOCKET_CAN_IF;
+
+      //--------------------------------------------------------
+      // Frames are fetched from the interface in batches. The
+      // byte array is reused for all frames, memory is only
+      // allocated once.
+      //
+      clSockDataT.resize(QCAN_FRAME_ARRAY_SIZE);
+      while(pclInterfaceP->readBatch(&aachBatchT[0][0], QCAN_IF_BATCH_SIZE,
+                                     ulFrameCntT) == QCanInterface::eERROR_NONE)
+      {
+         for(ulFrameIdxT = 0; ulFrameIdxT < ulFrameCntT; ulFrameIdxT++)
+         {
+            memcpy(clSockDataT.data(), &aachBatchT[ulFrameIdxT][0],
+                   QCAN_FRAME_ARRAY_SIZE);
+            switch(frameType(clSockDataT))
+            {
+               //-----------------------------------------------------
+               // handle API frames
+               //
+               case QCanData::eTYPE_API:
+                  handleApiFrame(slSockIdxT, clSockDataT);
+                  break;
+
+               //-------------------------------------
+               // write CAN frame to other sockets
+               //
+               case QCanData::eTYPE_CAN:
+                  handleCanFrame(slSockIdxT, clSockDataT);
+                  break;
+
+               //--------------------------------------------------
+               // handle error frames
+               //
+               case QCanData::eTYPE_ERROR:
+                  handleErrFrame(slSockIdxT, clSockDataT);
+                  break;
+
+               //-------------------------------------
+               // nothing we can handle
+               //
+               default:
+
+                  break;
+            }
+         }
+
+         //-------------------------------------------------
+         // a partial batch empties the receive FIFO
+         //
+         if(ulFrameCntT < QCAN_IF_BATCH_SIZE)
+         {
+            break;
+         }
+      }
    }
 
-   return (ubTypeT);
+   //----------------------------------------------------------------
+   // the cyclic transmit jobs also run on a virtual CAN network
+   //
+   dispatchScheduler();
+
+   //----------------------------------------------------------------
+   // write collected frames to the sockets
+   //
+   flushSockets();
 }
 
 
 //----------------------------------------------------------------------------//
-// handleApiFrame()                                                           //
-//                                                                            //
+// dispatchScheduler()                                                        //
+// dispatch frames written by the cyclic transmit jobs                        //
 //----------------------------------------------------------------------------//
-bool  QCanNetwork::handleApiFrame(int32_t & slSockSrcR,
-                                  QByteArray & clSockDataR)
+void QCanNetwork::dispatchScheduler(void)
 {
-   bool           btResultT = false;
-   QCanFrameApi   clApiFrameT;
-   
-   clApiFrameT.fromByteArray(clSockDataR);
-   
-   if(slSockSrcR != QCAN_SOCKET_CAN_IF)
+   int32_t        slSockIdxT;
+   int32_t        slSizeT;
+   uint32_t       ulOwnerT;
+   uint8_t        ubFormatT;
+   QCanFrame      clCanFrameT;
+   QByteArray     clSockDataT;
+
+   clSockDataT.reserve(QCAN_FRAME_ARRAY_SIZE);
+   while(clSchedulerP.readFrame(clSockDataT, ulOwnerT))
    {
-      switch(clApiFrameT.function())
+      //--------------------------------------------------------
+      // a frame of a job is dispatched like a frame written by
+      // the socket which owns the job, so the socket does not
+      // receive its own frames
+      //
+      for(slSockIdxT = 0; slSockIdxT < pclSockInfoListP->size(); slSockIdxT++)
       {
-         case QCanFrameApi::eAPI_FUNC_NONE:
-
+         if(((*pclSockInfoListP)[slSockIdxT].ulClientIdM == ulOwnerT) &&
+            ((*pclSockInfoListP)[slSockIdxT].btCloseM == false))
+         {
             break;
+         }
+      }
 
-         case QCanFrameApi::eAPI_FUNC_BITRATE:
-            qDebug() << "Got bitrate setting" << clApiFrameT.bitrateNominal();
-            this->setBitrate( clApiFrameT.bitrateNominal(), 
-                              clApiFrameT.bitrateData());
-            if(!pclInterfaceP.isNull())
+      if(slSockIdxT == pclSockInfoListP->size())
+      {
+         //-------------------------------------------------
+         // the socket has been closed meanwhile: a frame on
+         // the CAN bus is passed like a frame of the CAN
+         // interface, on a virtual network it is dropped
+         //
+         if(pclInterfaceP.isNull())
+         {
+            continue;
+         }
+         slSockIdxT = QCAN_SOCKET_CAN_IF;
+      }
+      else
+      {
+         if(clCanFrameT.fromByteArray(clSockDataT.constData(),
+                                      clSockDataT.size()) == false)
+         {
+            continue;
+         }
+
+         //-------------------------------------------------
+         // frames of the sockets are added for the bus load
+         // when they are written to the bus
+         //
+         if(pclInterfaceP.isNull() == false)
+         {
+            clBusLoadP.addFrame(clCanFrameT);
+         }
+
+         //-------------------------------------------------
+         // the scheduler uses the fixed encoding with
+         // checksum, the frame is converted to the wire
+         // format of the socket
+         //
+         ubFormatT = (*pclSockInfoListP)[slSockIdxT].ubFormatM;
+         if(ubFormatT != 0)
+         {
+            clSockDataT.resize(QCAN_FRAME_ARRAY_SIZE);
+            if(ubFormatT & QCAN_WIRE_FORMAT_COMPACT)
             {
-               //pclInterfaceP->setBitrate( clApiFrameT.bitrate(),
-               //                           clApiFrameT.brsClock());
+               slSizeT = clCanFrameT.toByteArrayCompact(clSockDataT.data(),
+                           QCAN_FRAME_ARRAY_SIZE,
+                           (ubFormatT & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
             }
-            btResultT = true;
-            break;
+            else
+            {
+               slSizeT = clCanFrameT.toByteArray(clSockDataT.data(),
+                           QCAN_FRAME_ARRAY_SIZE,
+                           (ubFormatT & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+            }
+            clSockDataT.resize(slSizeT);
+         }
+      }
 
-         case QCanFrameApi::eAPI_FUNC_CAN_MODE:
+      handleCanFrame(slSockIdxT, clSockDataT);
+   }
+}
 
-            break;
 
-         case QCanFrameApi::eAPI_FUNC_DRIVER_INIT:
+//----------------------------------------------------------------------------//
+// dispatchSocket()                                                           //
+// read all complete frames from a socket and dispatch them                   //
+//----------------------------------------------------------------------------//
+void QCanNetwork::dispatchSocket(int32_t slSockIdxV)
+{
+   int32_t        slFrameSizeT;
+   int32_t        slHeadSizeT;
+   char           achHeadT[QCAN_FRAME_COMPACT_HEADER];
+   QIODevice *    pclSockT;
+   QCanFrame      aclCanFrameT[QCAN_IF_BATCH_SIZE];
+   uint32_t       ulFrameCntT = 0;
+   QByteArray     clSockDataT;
+
+   //----------------------------------------------------------------
+   // the byte array is reused for all frames of this pass, memory
+   // is only allocated once
+   //
+   clSockDataT.reserve(QCAN_FRAME_ARRAY_SIZE);
+
+   pclSockT = pclSockListP->at(slSockIdxV);
+   while(true)
+   {
+      //--------------------------------------------------------
+      // A socket may use the fixed or the compact encoding,
+      // the size of the next frame is taken from its header.
+      // Only complete frames are read.
+      //
+      slHeadSizeT  = pclSockT->peek(&achHeadT[0], QCAN_FRAME_COMPACT_HEADER);
+      slFrameSizeT = QCanData::byteArraySize(&achHeadT[0], slHeadSizeT);
+      if((slFrameSizeT == 0) || (pclSockT->bytesAvailable() < slFrameSizeT))
+      {
+         break;
+      }
+      clSockDataT.resize(slFrameSizeT);
+      pclSockT->read(clSockDataT.data(), slFrameSizeT);
 
+      switch(frameType(clSockDataT))
+      {
+         //-----------------------------------------------------
+         // handle API frames
+         //
+         case QCanData::eTYPE_API:
+            handleApiFrame(slSockIdxV, clSockDataT);
             break;
 
-         case QCanFrameApi::eAPI_FUNC_DRIVER_RELEASE:
+         //-----------------------------------------------------
+         // handle CAN frames
+         //
+         case QCanData::eTYPE_CAN:
+            //---------------------------------------------
+            // check for active CAN interface, frames are
+            // collected and written as batch
+            //
+            if(pclInterfaceP.isNull() == false)
+            {
+               aclCanFrameT[ulFrameCntT].fromByteArray(clSockDataT.constData(),
+                                                       clSockDataT.size());
+               ulFrameCntT++;
+               if(ulFrameCntT == QCAN_IF_BATCH_SIZE)
+               {
+                  writeInterface(&aclCanFrameT[0], ulFrameCntT);
+                  ulFrameCntT = 0;
+               }
+            }
 
+            //---------------------------------------------
+            // write to other sockets
+            //
+            handleCanFrame(slSockIdxV, clSockDataT);
             break;
 
+         //--------------------------------------------------
+         // handle error frames
+         //
+         case QCanData::eTYPE_ERROR:
+            handleErrFrame(slSockIdxV, clSockDataT);
+            break;
 
          default:
 
             break;
       }
+   }
 
-      ulCntFrameApiP++;
-      
+   //----------------------------------------------------------------
+   // write remaining frames to the CAN interface
+   //
+   if((ulFrameCntT > 0) && (pclInterfaceP.isNull() == false))
+   {
+      writeInterface(&aclCanFrameT[0], ulFrameCntT);
    }
-   return(btResultT);
+
+   //----------------------------------------------------------------
+   // write collected frames to the other sockets
+   //
+   flushSockets();
 }
 
 
 //----------------------------------------------------------------------------//
-// handleCanFrame()                                                           //
-// push QCan frame to all open sockets                                        //
+// flushSockets()                                                             //
+// write outbound buffers of all sockets                                      //
 //----------------------------------------------------------------------------//
-bool  QCanNetwork::handleCanFrame(int32_t & slSockSrcR,
-                                  QByteArray & clSockDataR)
+void QCanNetwork::flushSockets(void)
 {
    int32_t        slSockIdxT;
-   bool           btResultT = false;
-   QTcpSocket *   pclSockS;
-
+   uint32_t       ulWriteIdxT;
+   bool           btNotifyT = false;
 
    //----------------------------------------------------------------
-   // check all open sockets and write CAN frame
+   // Sockets which read the shared memory ring are woken up once per
+   // dispatch pass if new frames have been written to the ring. The
+   // notification is sent via the connection of the socket.
    //
-   for(slSockIdxT = 0; slSockIdxT < pclTcpSockListP->size(); slSockIdxT++)
+   if(ulShmSockCntP > 0)
    {
-      if(slSockIdxT != slSockSrcR)
+      ulWriteIdxT = clShmRingP.writeIndex();
+      if(ulWriteIdxT != ulShmNotifyIdxP)
       {
-         pclSockS = pclTcpSockListP->at(slSockIdxT);
-         pclSockS->write(clSockDataR);
-         pclSockS->flush();
-         btResultT = true;
+         ulShmNotifyIdxP = ulWriteIdxT;
+         btNotifyT       = true;
       }
    }
 
-
-   //----------------------------------------------------------------
-   // count frame if source is a CAN interface or if the message
-   // could be dispatched
-   //
-   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
+   for(slSockIdxT = 0; slSockIdxT < pclSockInfoListP->size(); slSockIdxT++)
    {
-      ulCntFrameCanP++;
+      SockInfo_ts & tsSockInfoT = (*pclSockInfoListP)[slSockIdxT];
+
+      if(tsSockInfoT.btCloseM == true)
+      {
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // a socket with pending data on its connection is woken
+      // up by that data, it needs no further notification
+      //
+      if((btNotifyT == true) && (tsSockInfoT.btSharedM == true) &&
+         (tsSockInfoT.ulFrameCntM == 0))
+      {
+         tsSockInfoT.clBufferM.append(clShmNotifyP);
+         tsSockInfoT.ulFrameCntM++;
+      }
+
+      if(tsSockInfoT.ulFrameCntM > 0)
+      {
+         writeSocket(slSockIdxT);
+      }
    }
-   return(btResultT);
 }
 
 
 //----------------------------------------------------------------------------//
-// handleErrorFrame()                                                         //
-//                                                                            //
+// sendFrame()                                                                //
+// add frame to outbound buffer of all sockets except the source              //
 //----------------------------------------------------------------------------//
-bool  QCanNetwork::handleErrFrame(int32_t & slSockSrcR,
-                                  QByteArray & clSockDataR)
+bool QCanNetwork::sendFrame(int32_t slSockSrcV, const QByteArray & clSockDataR,
+                            const QCanFrame * pclCanFrameV)
 {
    int32_t        slSockIdxT;
-   bool           btResultT = false;
-   QTcpSocket *   pclSockS;
+   bool           btResultT  = false;
+   bool           btDecodedT = false;
+   uint8_t        ubFormatT;
+   uint8_t        ubSrcFormatT = 0;
+   uint32_t       ulSourceIdT;
+   uint32_t       ulSkipMaskT  = 0;
+   QCanData       clDataT(QCanData::eTYPE_UNKNOWN);
+   char           aachFrameT[QCAN_WIRE_FORMAT_MASK + 1][QCAN_FRAME_ARRAY_SIZE];
+   const char *   apchFrameT[QCAN_WIRE_FORMAT_MASK + 1];
+   int32_t        aslSizeT[QCAN_WIRE_FORMAT_MASK + 1];
 
    //----------------------------------------------------------------
-   // check all open sockets and write CAN frame
+   // The frame is converted at most once to each combination of
+   // wire format options which is used by the receiving sockets,
+   // the conversion uses buffers on the stack. Frames of the
+   // CAN interface use the fixed encoding with checksum.
    //
-   for(slSockIdxT = 0; slSockIdxT < pclTcpSockListP->size(); slSockIdxT++)
+   for(ubFormatT = 0; ubFormatT <= QCAN_WIRE_FORMAT_MASK; ubFormatT++)
    {
-      if(slSockIdxT != slSockSrcR)
-      {
-         pclSockS = pclTcpSockListP->at(slSockIdxT);
-         pclSockS->write(clSockDataR);
-         pclSockS->flush();
-         btResultT = true;
-      }
+      apchFrameT[ubFormatT] = Q_NULLPTR;
+      aslSizeT[ubFormatT]   = 0;
    }
 
+   if(slSockSrcV != QCAN_SOCKET_CAN_IF)
+   {
+      ubSrcFormatT = (*pclSockInfoListP)[slSockSrcV].ubFormatM;
+   }
+   apchFrameT[ubSrcFormatT] = clSockDataR.constData();
+   aslSizeT[ubSrcFormatT]   = clSockDataR.size();
 
    //----------------------------------------------------------------
-   // count frame if source is a CAN interface or if the message
-   // could be dispatched
+   // check all open sockets and add the frame to the outbound
+   // buffer, the buffers are written by flushSockets()
    //
-   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
+   for(slSockIdxT = 0; slSockIdxT < pclSockListP->size(); slSockIdxT++)
    {
-      ulCntFrameErrP++;
-   }
-   return(btResultT);
-}
+      if(slSockIdxT != slSockSrcV)
+      {
+         SockInfo_ts & tsSockInfoT = (*pclSockInfoListP)[slSockIdxT];
+         btResultT = true;
 
+         if(tsSockInfoT.btCloseM == true)
+         {
+            continue;
+         }
 
-QHostAddress QCanNetwork::serverAddress(void)
-{
-   return (pclTcpSrvP->serverAddress());
-}
+         //--------------------------------------------------------
+         // a CAN frame is only added if it passes the acceptance
+         // filter of the socket, an empty filter accepts all frames
+         //
+         if((pclCanFrameV != Q_NULLPTR) && 
+            (tsSockInfoT.clFilterM.isEmpty() == false))
+         {
+            if(tsSockInfoT.clFilterM.match(pclCanFrameV->identifier(),
+                                          pclCanFrameV->isExtended()) == 0)
+            {
+               if(tsSockInfoT.btSharedM == true)
+               {
+                  ulSkipMaskT |= ((uint32_t) 1) << tsSockInfoT.slShmReaderM;
+               }
+               continue;
+            }
+         }
 
+         //--------------------------------------------------------
+         // a socket which reads the shared memory ring gets the
+         // frame from there, unless its queue in the ring is full
+         //
+         if(tsSockInfoT.btSharedM == true)
+         {
+            if(checkSharedQueue(slSockIdxT) == false)
+            {
+               ulSkipMaskT |= ((uint32_t) 1) << tsSockInfoT.slShmReaderM;
+            }
+            continue;
+         }
 
-//----------------------------------------------------------------------------//
-// onSocketConnect()                                                          //
-// slot that manages a new local server connection                            //
-//----------------------------------------------------------------------------//
-void QCanNetwork::onSocketConnect(void)
-{
-   QTcpSocket *   pclSocketT;
-   QCanFrameApi   clFrameApiT;
+         if(checkSendQueue(slSockIdxT) == false)
+         {
+            continue;
+         }
+
+         ubFormatT = tsSockInfoT.ubFormatM;
+         if(apchFrameT[ubFormatT] == Q_NULLPTR)
+         {
+            if(btDecodedT == false)
+            {
+               clDataT.fromByteArray(clSockDataR.constData(), 
+                                     clSockDataR.size());
+               btDecodedT = true;
+            }
+
+            if(ubFormatT & QCAN_WIRE_FORMAT_COMPACT)
+            {
+               aslSizeT[ubFormatT] = clDataT.toByteArrayCompact(
+                           &aachFrameT[ubFormatT][0], QCAN_FRAME_ARRAY_SIZE,
+                           (ubFormatT & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+            }
+            else
+            {
+               aslSizeT[ubFormatT] = clDataT.toByteArray(
+                           &aachFrameT[ubFormatT][0], QCAN_FRAME_ARRAY_SIZE,
+                           (ubFormatT & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+            }
+            apchFrameT[ubFormatT] = &aachFrameT[ubFormatT][0];
+         }
+         tsSockInfoT.clBufferM.append(apchFrameT[ubFormatT], 
+                                      aslSizeT[ubFormatT]);
+
+         tsSockInfoT.ulFrameCntM++;
+         if(tsSockInfoT.ulFrameCntM >= ulBatchSizeP)
+         {
+            writeSocket(slSockIdxT);
+         }
+      }
+   }
+
+   //----------------------------------------------------------------
+   // Sockets which are attached to the shared memory ring read the
+   // frame from there: it is written only once, using the fixed
+   // encoding without checksum. The frame carries the ID of the 
+   // source connection, so a socket can skip its own frames.
+   //
+   if(ulShmSockCntP > 0)
+   {
+      ubFormatT = QCAN_WIRE_FORMAT_NO_CHECKSUM;
+      if(apchFrameT[ubFormatT] == Q_NULLPTR)
+      {
+         if(btDecodedT == false)
+         {
+            clDataT.fromByteArray(clSockDataR.constData(), 
+                                  clSockDataR.size());
+         }
+         aslSizeT[ubFormatT] = clDataT.toByteArray(&aachFrameT[ubFormatT][0],
+                                                   QCAN_FRAME_ARRAY_SIZE,
+                                                   false);
+         apchFrameT[ubFormatT] = &aachFrameT[ubFormatT][0];
+      }
+
+      if(slSockSrcV == QCAN_SOCKET_CAN_IF)
+      {
+         ulSourceIdT = 0;
+      }
+      else
+      {
+         ulSourceIdT = (*pclSockInfoListP)[slSockSrcV].ulClientIdM;
+      }
+      clShmRingP.write(ulSourceIdT, apchFrameT[ubFormatT], aslSizeT[ubFormatT],
+                       ulSkipMaskT);
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkSendQueue()                                                           //
+// apply send policy if the send queue of a socket is full                    //
+//----------------------------------------------------------------------------//
+bool QCanNetwork::checkSendQueue(int32_t slSockIdxV)
+{
+   SockInfo_ts &  tsSockInfoT = (*pclSockInfoListP)[slSockIdxV];
+
+   //----------------------------------------------------------------
+   // the send queue of a socket which does not read its
+   // data is limited, the policy defines what happens
+   //
+   if(tsSockInfoT.ulFrameCntM < ulQueueSizeP)
+   {
+      return(true);
+   }
+
+   if(ubSendPolicyP == QCAN_SEND_POLICY_DROP_NEWEST)
+   {
+      tsSockInfoT.ulDropCntM++;
+      ulCntFrameDropP++;
+      return(false);
+   }
+
+   if(ubSendPolicyP == QCAN_SEND_POLICY_DISCONNECT)
+   {
+      dropFrames(slSockIdxV, tsSockInfoT.ulFrameCntM);
+      tsSockInfoT.ulDropCntM++;
+      ulCntFrameDropP++;
+      tsSockInfoT.btCloseM = true;
+      QMetaObject::invokeMethod(this, "onSocketClose",
+                                Qt::QueuedConnection);
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // Removing the oldest frames moves the remaining
+   // data of the buffer, so one batch is removed at once.
+   //
+   dropFrames(slSockIdxV, ulBatchSizeP);
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkSharedQueue()                                                         //
+// apply send policy to a socket which reads the shared memory ring           //
+//----------------------------------------------------------------------------//
+bool QCanNetwork::checkSharedQueue(int32_t slSockIdxV)
+{
+   bool           btResultT = true;
+   uint32_t       ulLagT;
+   uint32_t       ulDropT   = 0;
+   SockInfo_ts &  tsSockInfoT = (*pclSockInfoListP)[slSockIdxV];
+
+   //----------------------------------------------------------------
+   // The send queue of the socket are the frames of the ring it has
+   // not read yet, frames it skips are included. A frame which is
+   // not added is marked to be skipped by the socket.
+   //
+   ulLagT = clShmRingP.readerLag(tsSockInfoT.slShmReaderM);
+   if(ulLagT >= ulQueueSizeP)
+   {
+      if(ubSendPolicyP == QCAN_SEND_POLICY_DROP_NEWEST)
+      {
+         tsSockInfoT.ulDropCntM++;
+         ulCntFrameDropP++;
+         btResultT = false;
+      }
+      else if(ubSendPolicyP == QCAN_SEND_POLICY_DISCONNECT)
+      {
+         ulDropT = clShmRingP.dropFrames(tsSockInfoT.slShmReaderM, ulLagT);
+         tsSockInfoT.ulDropCntM++;
+         ulCntFrameDropP++;
+         tsSockInfoT.btCloseM = true;
+         QMetaObject::invokeMethod(this, "onSocketClose",
+                                   Qt::QueuedConnection);
+         btResultT = false;
+      }
+      else
+      {
+         ulDropT = clShmRingP.dropFrames(tsSockInfoT.slShmReaderM, 
+                                         ulBatchSizeP);
+      }
+      ulLagT -= ulDropT;
+   }
+
+   //----------------------------------------------------------------
+   // The next write overwrites the oldest slot of the ring. If the
+   // socket did not read it yet, it is removed here, so the frame
+   // is counted like any other frame dropped by the send policy.
+   //
+   if(ulLagT >= (clShmRingP.slotCount() - 1))
+   {
+      ulDropT += clShmRingP.dropFrames(tsSockInfoT.slShmReaderM, 
+                                       ulLagT - clShmRingP.slotCount() + 2);
+   }
+
+   tsSockInfoT.ulDropCntM += ulDropT;
+   ulCntFrameDropP        += ulDropT;
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setFilter()                                                                //
+// replace or extend the acceptance filter of a socket                        //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setFilter(int32_t slSockIdxV, QCanFrameApi & clApiFrameR)
+{
+   uint8_t        ubEntryT;
+   uint32_t       ulIdentifierT;
+   uint32_t       ulMaskT;
+   bool           btExtendedT;
+   SockInfo_ts &  tsSockInfoT = (*pclSockInfoListP)[slSockIdxV];
+
+   if(clApiFrameR.filterAppend() == false)
+   {
+      tsSockInfoT.clFilterM.clear();
+      tsSockInfoT.ubFilterCntM = 0;
+   }
+
+   //----------------------------------------------------------------
+   // entries which exceed the size of the filter index are ignored
+   //
+   for(ubEntryT = 0; ubEntryT < clApiFrameR.filterCount(); ubEntryT++)
+   {
+      if(tsSockInfoT.ubFilterCntM >= QCAN_FILTER_INDEX_MAX)
+      {
+         qCanTrace(qcanTraceNetwork) << "QCanNetwork::setFilter() - filter set of socket" 
+                                     << slSockIdxV << "is full";
+         break;
+      }
+
+      if(clApiFrameR.filter(ubEntryT, ulIdentifierT, ulMaskT, btExtendedT))
+      {
+         tsSockInfoT.clFilterM.setEntry(tsSockInfoT.ubFilterCntM,
+                                        ulIdentifierT, ulMaskT, btExtendedT);
+         tsSockInfoT.ubFilterCntM++;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setSharedMemory()                                                          //
+// switch socket to shared memory ring after it has attached                  //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setSharedMemory(int32_t slSockIdxV, 
+                                  QCanFrameApi & clApiFrameR)
+{
+   QCanFrameApi::SharedMemory_e  teStepT;
+   uint32_t                      ulValueT;
+   int32_t                       slReaderT;
+   QString                       clKeyT;
+   SockInfo_ts &                 tsSockInfoT = (*pclSockInfoListP)[slSockIdxV];
+
+   if(clApiFrameR.sharedMemory(teStepT, ulValueT, clKeyT) == false)
+   {
+      return;
+   }
+
+   if((teStepT != QCanFrameApi::eSHM_ATTACH)     ||
+      (ulValueT != tsSockInfoT.ulClientIdM)      ||
+      (clKeyT != clShmRingP.key())               ||
+      (clShmRingP.isAttached() == false)         ||
+      (tsSockInfoT.btSharedM == true))
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // the socket has claimed a reader entry when attaching, its read
+   // position is used to apply the send policy
+   //
+   slReaderT = clShmRingP.readerIndex(tsSockInfoT.ulClientIdM);
+   if(slReaderT < 0)
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // The answer is written after all frames in the outbound buffer,
+   // it holds the ring position of the next frame. Hence the socket
+   // neither loses nor duplicates frames.
+   //
+   tsSockInfoT.btSharedM    = true;
+   tsSockInfoT.slShmReaderM = slReaderT;
+   ulShmSockCntP++;
+
+   clApiFrameR.setSharedMemory(QCanFrameApi::eSHM_START,
+                               clShmRingP.writeIndex(), clKeyT);
+   tsSockInfoT.clBufferM.append(clApiFrameR.toByteArray());
+   tsSockInfoT.ulFrameCntM++;
+   writeSocket(slSockIdxV);
+}
+
+
+//----------------------------------------------------------------------------//
+// dropFrames()                                                               //
+// remove oldest frames from send queue of one socket                         //
+//----------------------------------------------------------------------------//
+void QCanNetwork::dropFrames(int32_t slSockIdxV, uint32_t ulFrameCntV)
+{
+   int32_t        slPosT  = 0;
+   int32_t        slSizeT;
+   uint32_t       ulDropT = 0;
+   SockInfo_ts &  tsSockInfoT = (*pclSockInfoListP)[slSockIdxV];
+
+   //----------------------------------------------------------------
+   // the frames may use different encodings, the size of each
+   // frame is taken from its header
+   //
+   while((ulDropT < ulFrameCntV) && (slPosT < tsSockInfoT.clBufferM.size()))
+   {
+      slSizeT = QCanData::byteArraySize(tsSockInfoT.clBufferM.constData() + 
+                                        slPosT,
+                                        tsSockInfoT.clBufferM.size() - slPosT);
+      if(slSizeT == 0)
+      {
+         break;
+      }
+      slPosT += slSizeT;
+      ulDropT++;
+   }
+
+   tsSockInfoT.clBufferM.remove(0, slPosT);
+   tsSockInfoT.ulFrameCntM -= ulDropT;
+   tsSockInfoT.ulDropCntM  += ulDropT;
+   ulCntFrameDropP         += ulDropT;
+}
+
+
+//----------------------------------------------------------------------------//
+// writeSocket()                                                              //
+// write outbound buffer of one socket in a single operation                  //
+//----------------------------------------------------------------------------//
+void QCanNetwork::writeSocket(int32_t slSockIdxV)
+{
+   QIODevice *    pclSockT;
+   SockInfo_ts &  tsSockInfoT = (*pclSockInfoListP)[slSockIdxV];
+
+   //----------------------------------------------------------------
+   // Data which could not be passed to the operating system stays
+   // in the write buffer of the socket. The frames are kept in the
+   // send queue until onSocketWritten() signals the complete write,
+   // so the write buffer of the socket does not grow any further.
+   //
+   pclSockT = pclSockListP->at(slSockIdxV);
+   if(pclSockT->bytesToWrite() > 0)
+   {
+      return;
+   }
+   pclSockT->write(tsSockInfoT.clBufferM);
+
+   //----------------------------------------------------------------
+   // clear() would release the memory, resize() keeps the
+   // capacity for the next dispatch pass. The buffer is cleared
+   // before the flush, so the data is never written twice.
+   //
+   tsSockInfoT.clBufferM.resize(0);
+   tsSockInfoT.ulFrameCntM  = 0;
+
+   //----------------------------------------------------------------
+   // flush() is not part of QIODevice, it is provided by both
+   // socket classes
+   //
+   if(tsSockInfoT.btLocalM == true)
+   {
+      static_cast<QLocalSocket *>(pclSockT)->flush();
+   }
+   else
+   {
+      static_cast<QTcpSocket *>(pclSockT)->flush();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// writeInterface()                                                           //
+// write frames of the sockets to the CAN interface                           //
+//----------------------------------------------------------------------------//
+void QCanNetwork::writeInterface(const QCanFrame * pclCanFrameV,
+                                 uint32_t ulFrameCntV)
+{
+   uint32_t ulWrittenT = 0;
+   uint32_t ulFrameIdxT;
+
+   clIfWriteMutexP.lock();
+   pclInterfaceP->writeBatch(pclCanFrameV, ulFrameCntV, ulWrittenT);
+   clIfWriteMutexP.unlock();
+
+   //----------------------------------------------------------------
+   // only frames which have been passed to the CAN interface are
+   // added for the bus load
+   //
+   for(ulFrameIdxT = 0; ulFrameIdxT < ulWrittenT; ulFrameIdxT++)
+   {
+      clBusLoadP.addFrame(pclCanFrameV[ulFrameIdxT]);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// frameType()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanData::Type_e  QCanNetwork::frameType(const QByteArray & clSockDataR)
+{
+   QCanData::Type_e  ubTypeT;
    
    //----------------------------------------------------------------
-   // Get next pending connect and add this socket to the
-   // the socket list
+   // The frame type can be tested via the first byte of the array,
+   // please refer to the implmentation of QCanData for details.
+   // Bit 5 marks the compact encoding and is not evaluated here.
+   //
+   switch(clSockDataR.at(0) & 0xC0)
+   {
+      case 0x00:
+         ubTypeT = QCanData::eTYPE_CAN;
+         break;
+      
+      case 0x40:
+         ubTypeT = QCanData::eTYPE_API;
+         break;
+      
+      case 0x80:
+         ubTypeT = QCanData::eTYPE_ERROR;
+         break;
+         
+      default:
+         ubTypeT = QCanData::eTYPE_UNKNOWN;
+         break;
+   }
+
+   return (ubTypeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleApiFrame()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleApiFrame(int32_t & slSockSrcR,
+                                  QByteArray & clSockDataR)
+{
+   bool           btResultT = false;
+   uint8_t        ubFormatT;
+   uint8_t        ubPolicyT;
+   uint32_t       ulDepthT;
+   uint32_t       ulLimitT;
+   uint32_t       ulDroppedT;
+   uint8_t        ubJobT;
+   uint8_t        ubIncPosT;
+   uint32_t       ulPeriodT;
+   uint32_t       ulCountT;
+   uint32_t       ulClientIdT;
+   QCanFrame      clCanFrameT;
+   QCanFrameApi   clApiFrameT;
+   
+   clApiFrameT.fromByteArray(clSockDataR);
+   
+   if(slSockSrcR != QCAN_SOCKET_CAN_IF)
+   {
+      switch(clApiFrameT.function())
+      {
+         case QCanFrameApi::eAPI_FUNC_NONE:
+
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_BITRATE:
+            qCanTrace(qcanTraceNetwork) << "Got bitrate setting" << clApiFrameT.bitrateNominal();
+            this->setBitrate( clApiFrameT.bitrateNominal(), 
+                              clApiFrameT.bitrateData());
+            if(!pclInterfaceP.isNull())
+            {
+               //pclInterfaceP->setBitrate( clApiFrameT.bitrate(),
+               //                           clApiFrameT.brsClock());
+            }
+            btResultT = true;
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_CAN_MODE:
+
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_DRIVER_INIT:
+
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_DRIVER_RELEASE:
+
+            break;
+
+         //-----------------------------------------------------
+         // the socket installs its acceptance filter
+         //
+         case QCanFrameApi::eAPI_FUNC_FILTER:
+            setFilter(slSockSrcR, clApiFrameT);
+            btResultT = true;
+            break;
+
+         //-----------------------------------------------------
+         // the socket has attached to the shared memory ring
+         //
+         case QCanFrameApi::eAPI_FUNC_SHARED_MEMORY:
+            setSharedMemory(slSockSrcR, clApiFrameT);
+            btResultT = true;
+            break;
+
+         //-----------------------------------------------------
+         // the socket requests the status of its send queue,
+         // the answer is queued behind all pending frames and
+         // is subject to the send policy like any other frame
+         //
+         case QCanFrameApi::eAPI_FUNC_QUEUE_STATUS:
+            if(clApiFrameT.queueStatus(ulDepthT, ulLimitT, 
+                                       ulDroppedT, ubPolicyT) == false)
+            {
+               SockInfo_ts & tsSockInfoT = (*pclSockInfoListP)[slSockSrcR];
+               if((tsSockInfoT.btCloseM == false) &&
+                  (checkSendQueue(slSockSrcR) == true))
+               {
+                  ulDepthT = tsSockInfoT.ulFrameCntM;
+                  if(tsSockInfoT.btSharedM == true)
+                  {
+                     ulDepthT += clShmRingP.readerLag(tsSockInfoT.slShmReaderM);
+                  }
+                  clApiFrameT.setQueueStatus(ulDepthT, 
+                                             ulQueueSizeP,
+                                             tsSockInfoT.ulDropCntM,
+                                             ubSendPolicyP);
+                  tsSockInfoT.clBufferM.append(clApiFrameT.toByteArray());
+                  tsSockInfoT.ulFrameCntM++;
+               }
+            }
+            btResultT = true;
+            break;
+
+         //-----------------------------------------------------
+         // the socket starts or stops a cyclic transmit job,
+         // a period of 0 stops the job
+         //
+         case QCanFrameApi::eAPI_FUNC_CYCLIC:
+            if(clApiFrameT.cyclic(ubJobT, clCanFrameT, ulPeriodT,
+                                  ulCountT, ubIncPosT))
+            {
+               ulClientIdT = (*pclSockInfoListP)[slSockSrcR].ulClientIdM;
+               if(ulPeriodT == 0)
+               {
+                  clSchedulerP.removeJob(ulClientIdT, ubJobT);
+               }
+               else if(clSchedulerP.addJob(ulClientIdT, ubJobT, clCanFrameT,
+                                           ulPeriodT, ulCountT, 
+                                           ubIncPosT) == false)
+               {
+                  qCanTrace(qcanTraceNetwork) << "QCanNetwork::handleApiFrame() - no cyclic job left";
+               }
+            }
+            btResultT = true;
+            break;
+
+         //-----------------------------------------------------
+         // the socket selects the wire format options, only
+         // supported options are accepted
+         //
+         case QCanFrameApi::eAPI_FUNC_WIRE_FORMAT:
+            if(clApiFrameT.wireFormat(ubFormatT))
+            {
+               (*pclSockInfoListP)[slSockSrcR].ubFormatM = ubFormatT &
+                                          QCAN_WIRE_FORMAT_MASK;
+            }
+            btResultT = true;
+            break;
+
+
+         default:
+
+            break;
+      }
+
+      ulCntFrameApiP++;
+
+      //--------------------------------------------------------
+      // add the frame to the trace
+      //
+      if(clRecorderP.isRecording())
+      {
+         clRecorderP.record(clSockDataR);
+      }
+   }
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleCanFrame()                                                           //
+// push QCan frame to all open sockets                                        //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleCanFrame(int32_t & slSockSrcR,
+                                  QByteArray & clSockDataR)
+{
+   bool           btResultT;
+   bool           btDecodedT;
+   QCanFrame      clCanFrameT;
+
+   //----------------------------------------------------------------
+   // the decoded frame is needed for the acceptance filters of
+   // the sockets and for the bus load
+   //
+   btDecodedT = clCanFrameT.fromByteArray(clSockDataR.constData(), 
+                                          clSockDataR.size());
+
+   //----------------------------------------------------------------
+   // replace the time-stamp by the time of reception, the frame
+   // is encoded again using the wire format of the source
+   //
+   if((btTimeStampEnabledP == true) && (btDecodedT == true))
+   {
+      stampFrame(slSockSrcR, clSockDataR, clCanFrameT);
+   }
+
+   //----------------------------------------------------------------
+   // add the frame to the outbound buffer of all other sockets
+   //
+   if(btDecodedT == true)
+   {
+      btResultT = sendFrame(slSockSrcR, clSockDataR, &clCanFrameT);
+   }
+   else
+   {
+      btResultT = sendFrame(slSockSrcR, clSockDataR);
+   }
+
+
+   //----------------------------------------------------------------
+   // add the transmission time of a frame received by the CAN
+   // interface for the bus load, frames of the sockets are added
+   // by writeInterface() when they are written to the bus
+   //
+   if((slSockSrcR == QCAN_SOCKET_CAN_IF) && (btDecodedT == true))
+   {
+      clBusLoadP.addFrame(clCanFrameT);
+   }
+
+   //----------------------------------------------------------------
+   // count frame if source is a CAN interface or if the message
+   // could be dispatched
+   //
+   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
+   {
+      ulCntFrameCanP++;
+
+      //--------------------------------------------------------
+      // add the frame to the trace, the time-stamp is already
+      // replaced if ingress time-stamps are enabled
+      //
+      if(clRecorderP.isRecording())
+      {
+         clRecorderP.record(clSockDataR);
+      }
+   }
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// stampFrame()                                                               //
+// set ingress time-stamp of CAN frame                                        //
+//----------------------------------------------------------------------------//
+void QCanNetwork::stampFrame(int32_t slSockSrcV, QByteArray & clSockDataR,
+                             QCanFrame & clCanFrameR)
+{
+   uint8_t        ubFormatT = 0;
+   int32_t        slSizeT;
+   QCanTimeStamp  clTimeStampT;
+
+   clTimeStampT.fromNanoSeconds((uint64_t) clTimeBaseP.nsecsElapsed());
+   clCanFrameR.setTimeStamp(clTimeStampT);
+
+   //----------------------------------------------------------------
+   // frames of the CAN interface use the fixed encoding with
+   // checksum
+   //
+   if(slSockSrcV != QCAN_SOCKET_CAN_IF)
+   {
+      ubFormatT = (*pclSockInfoListP)[slSockSrcV].ubFormatM;
+   }
+
+   clSockDataR.resize(QCAN_FRAME_ARRAY_SIZE);
+   if(ubFormatT & QCAN_WIRE_FORMAT_COMPACT)
+   {
+      slSizeT = clCanFrameR.toByteArrayCompact(clSockDataR.data(), 
+                           QCAN_FRAME_ARRAY_SIZE,
+                           (ubFormatT & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+   }
+   else
+   {
+      slSizeT = clCanFrameR.toByteArray(clSockDataR.data(), 
+                           QCAN_FRAME_ARRAY_SIZE,
+                           (ubFormatT & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+   }
+   clSockDataR.resize(slSizeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleErrorFrame()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleErrFrame(int32_t & slSockSrcR,
+                                  QByteArray & clSockDataR)
+{
+   bool           btResultT;
+
+   //----------------------------------------------------------------
+   // add the frame to the outbound buffer of all other sockets
+   //
+   btResultT = sendFrame(slSockSrcR, clSockDataR);
+
+
+   //----------------------------------------------------------------
+   // count frame if source is a CAN interface or if the message
+   // could be dispatched
+   //
+   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
+   {
+      ulCntFrameErrP++;
+
+      //--------------------------------------------------------
+      // add the frame to the trace
+      //
+      if(clRecorderP.isRecording())
+      {
+         clRecorderP.record(clSockDataR);
+      }
+   }
+   return(btResultT);
+}
+
+
+QHostAddress QCanNetwork::serverAddress(void)
+{
+   return (pclTcpSrvP->serverAddress());
+}
+
+
+//----------------------------------------------------------------------------//
+// addSocket()                                                                //
+// add socket of TCP server or local server to the network                    //
+//----------------------------------------------------------------------------//
+void QCanNetwork::addSocket(QIODevice * pclSocketV, bool btLocalV, 
+                            bool btSameHostV)
+{
+   QCanFrameApi   clFrameApiT;
+   
+   //----------------------------------------------------------------
+   // add this socket to the the socket list
    //
-   pclSocketT =  pclTcpSrvP->nextPendingConnection();
    clTcpSockMutexP.lock();
-   pclTcpSockListP->append(pclSocketT);
+   pclSockListP->append(pclSocketV);
+   SockInfo_ts tsSockInfoT;
+   tsSockInfoT.ubFormatM    = 0;
+   tsSockInfoT.ulFrameCntM  = 0;
+   tsSockInfoT.ulDropCntM   = 0;
+   tsSockInfoT.btCloseM     = false;
+   tsSockInfoT.ubFilterCntM = 0;
+   tsSockInfoT.ulClientIdM  = ++ulClientIdP;
+   tsSockInfoT.btSharedM    = false;
+   tsSockInfoT.slShmReaderM = -1;
+   tsSockInfoT.btLocalM     = btLocalV;
+   pclSockInfoListP->append(tsSockInfoT);
    clTcpSockMutexP.unlock();
 
-   qDebug() << "QCanNetwork::onSocketConnect()" << pclTcpSockListP->size() << "open sockets";
-   qDebug() << "Socket" << pclSocketT;
+   qCanTrace(qcanTraceNetwork) << "QCanNetwork::addSocket()" << pclSockListP->size() << "open sockets";
+   qCanTrace(qcanTraceNetwork) << "Socket" << pclSocketV;
 
    //----------------------------------------------------------------
    // Add a slot that handles the disconnection of the socket
    // from the local server
    //
-   connect( pclSocketT,
+   connect( pclSocketV,
             SIGNAL(disconnected()),
             this,
             SLOT(onSocketDisconnect())   );
+
+   //----------------------------------------------------------------
+   // Frames of the socket are dispatched as soon as they arrive
+   //
+   connect( pclSocketV,
+            SIGNAL(readyRead()),
+            this,
+            SLOT(onSocketReceive())   );
+
+   //----------------------------------------------------------------
+   // Queued frames are written when the socket has written its data.
+   // The signal is emitted by flush() inside writeSocket(), i.e. while
+   // the dispatcher holds clTcpSockMutexP, hence the slot must be
+   // called from the event loop.
+   //
+   connect( pclSocketV,
+            SIGNAL(bytesWritten(qint64)),
+            this,
+            SLOT(onSocketWritten()),
+            Qt::QueuedConnection   );
    
    //----------------------------------------------------------------
    // 
    clFrameApiT.setName(clNetNameP);
-   pclSocketT->write(clFrameApiT.toByteArray());
+   pclSocketV->write(clFrameApiT.toByteArray());
    clFrameApiT.setBitrate(slNomBitRateP, slDatBitRateP);
-   pclSocketT->write(clFrameApiT.toByteArray());
+   pclSocketV->write(clFrameApiT.toByteArray());
+
+   //----------------------------------------------------------------
+   // offer the supported wire format options, the socket uses the
+   // fixed encoding until it has selected an option
+   //
+   clFrameApiT.setWireFormat(QCAN_WIRE_FORMAT_MASK);
+   pclSocketV->write(clFrameApiT.toByteArray());
+
+   //----------------------------------------------------------------
+   // offer the shared memory ring to a socket on the same host
+   //
+   if((clShmRingP.isAttached() == true) && (btSameHostV == true))
+   {
+      clFrameApiT.setSharedMemory(QCanFrameApi::eSHM_OFFER, 
+                                  tsSockInfoT.ulClientIdM, clShmRingP.key());
+      pclSocketV->write(clFrameApiT.toByteArray());
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onLocalSocketConnect()                                                     //
+// slot that manages a new local server connection                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onLocalSocketConnect(void)
+{
+   QLocalSocket * pclSocketT;
+
+   pclSocketT = pclLocalSrvP->nextPendingConnection();
+   if(pclSocketT != Q_NULLPTR)
+   {
+      addSocket(pclSocketT, true, true);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onSocketConnect()                                                          //
+// slot that manages a new TCP server connection                              //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onSocketConnect(void)
+{
+   QTcpSocket *   pclSocketT;
+
+   pclSocketT = pclTcpSrvP->nextPendingConnection();
+   if(pclSocketT != Q_NULLPTR)
+   {
+      addSocket(pclSocketT, false, pclSocketT->peerAddress().isLoopback());
+   }
 }
 
 
@@ -493,198 +1654,213 @@ void QCanNetwork::onSocketConnect(void)
 void QCanNetwork::onSocketDisconnect(void)
 {
    int32_t      slSockIdxT;
-   QTcpSocket * pclSockT;
-   QTcpSocket * pclSenderT;
+   QIODevice *  pclSockT;
+   QIODevice *  pclSenderT;
 
 
    //----------------------------------------------------------------
    // get sender of signal
    //
-   pclSenderT = (QTcpSocket* ) QObject::sender();
+   pclSenderT = (QIODevice* ) QObject::sender();
 
    clTcpSockMutexP.lock();
-   for(slSockIdxT = 0; slSockIdxT < pclTcpSockListP->size(); slSockIdxT++)
+   for(slSockIdxT = 0; slSockIdxT < pclSockListP->size(); slSockIdxT++)
    {
-      pclSockT = pclTcpSockListP->at(slSockIdxT);
+      pclSockT = pclSockListP->at(slSockIdxT);
       if(pclSockT == pclSenderT)
       {
-         pclTcpSockListP->remove(slSockIdxT);
+         if(pclSockInfoListP->at(slSockIdxT).btSharedM == true)
+         {
+            ulShmSockCntP--;
+         }
+
+         //-------------------------------------------------
+         // the reader entry of a socket which did not detach
+         // from the ring, e.g. after a crash, is released here
+         //
+         clShmRingP.releaseReader(pclSockInfoListP->at(slSockIdxT).ulClientIdM);
+         clSchedulerP.removeJobs(pclSockInfoListP->at(slSockIdxT).ulClientIdM);
+         pclSockListP->remove(slSockIdxT);
+         pclSockInfoListP->remove(slSockIdxT);
          break;
       }
    }
    clTcpSockMutexP.unlock();
 
-   qDebug() << "QCanNetwork::onSocketDisconnect()" << pclTcpSockListP->size() << "open sockets";
+   qCanTrace(qcanTraceNetwork) << "QCanNetwork::onSocketDisconnect()" << pclSockListP->size() << "open sockets";
 
 }
 
 
 //----------------------------------------------------------------------------//
-// onTimerEvent()                                                             //
-// remove local socket from list                                              //
+// onInterfaceReceive()                                                       //
+// dispatch frames of physical CAN interface                                  //
 //----------------------------------------------------------------------------//
-void QCanNetwork::onTimerEvent(void)
+void QCanNetwork::onInterfaceReceive(void)
 {
-   int32_t        slSockIdxT;
-   int32_t        slListSizeT;
-   uint32_t       ulFrameCntT;
-   uint32_t       ulFrameMaxT;
-   uint32_t       ulMsgPerSecT;
-   uint32_t       ulMsgBitCntT;
-   QTcpSocket *   pclSockT;
-   QCanFrame      clCanFrameT;
-   QByteArray     clSockDataT;
+   clTcpSockMutexP.lock();
+   dispatchInterface();
+   clTcpSockMutexP.unlock();
+
+   //----------------------------------------------------------------
+   // calculate the bus load when the dispatch window has elapsed,
+   // this function is also called by the CAN interface
+   //
+   if(clLoadWindowTmrP.elapsed() >= (qint64) ulDispatchTimeP)
+   {
+      ubBusLoadWindowP = clBusLoadP.windowLoad(
+                                          clLoadWindowTmrP.nsecsElapsed());
+      clLoadWindowTmrP.restart();
+   }
+}
 
 
+//----------------------------------------------------------------------------//
+// onSocketReceive()                                                          //
+// dispatch frames of socket which has new data available                     //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onSocketReceive(void)
+{
+   int32_t      slSockIdxT;
+   QIODevice *  pclSenderT;
+
    //----------------------------------------------------------------
-   // lock socket list
+   // get sender of signal
    //
+   pclSenderT = (QIODevice* ) QObject::sender();
+
    clTcpSockMutexP.lock();
 
    //----------------------------------------------------------------
-   // read messages from active CAN interface
+   // the socket index is required to exclude the sender from
+   // the dispatching
    //
-   if(pclInterfaceP.isNull() == false)
+   slSockIdxT = pclSockListP->indexOf(pclSenderT);
+   if(slSockIdxT >= 0)
    {
-      slSockIdxT = QCAN_SOCKET_CAN_IF;
-      while(pclInterfaceP->read(clSockDataT) == QCanInterface::eERROR_NONE)
-      {
-         switch(frameType(clSockDataT))
-         {
-            //-----------------------------------------------------
-            // handle API frames
-            //
-            case QCanData::eTYPE_API:
-               handleApiFrame(slSockIdxT, clSockDataT);
-               break;
-               
-            //-------------------------------------
-            // write CAN frame to other sockets
-            //
-            case QCanData::eTYPE_CAN:
-               handleCanFrame(slSockIdxT, clSockDataT);
-               break;
-               
-            //--------------------------------------------------
-            // handle error frames
-            //
-            case QCanData::eTYPE_ERROR:
-               handleErrFrame(slSockIdxT, clSockDataT);
-               break;
-               
-            //-------------------------------------
-            // nothing we can handle
-            //
-            default:
-               
-               break;
-         }
-      }
+      dispatchSocket(slSockIdxT);
    }
+   clTcpSockMutexP.unlock();
+}
 
-   //----------------------------------------------------------------
-   // check all open sockets and read messages
-   //
-   slListSizeT = pclTcpSockListP->size();
-   for(slSockIdxT = 0; slSockIdxT < slListSizeT; slSockIdxT++)
-   {
-      pclSockT = pclTcpSockListP->at(slSockIdxT);
-      ulFrameMaxT = (pclSockT->bytesAvailable()) / QCAN_FRAME_ARRAY_SIZE;
-      for(ulFrameCntT = 0; ulFrameCntT < ulFrameMaxT; ulFrameCntT++)
-      {
-         clSockDataT = pclSockT->read(QCAN_FRAME_ARRAY_SIZE);
 
-         switch(frameType(clSockDataT))
-         {
-            //-----------------------------------------------------
-            // handle API frames
-            //
-            case QCanData::eTYPE_API:
-               handleApiFrame(slSockIdxT, clSockDataT);
-               break;
+//----------------------------------------------------------------------------//
+// onSocketWritten()                                                          //
+// write queued frames after the socket has written its data                  //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onSocketWritten(void)
+{
+   int32_t      slSockIdxT;
+   QIODevice *  pclSenderT;
 
-            //-----------------------------------------------------
-            // handle CAN frames
-            //
-            case QCanData::eTYPE_CAN:
-               //---------------------------------------------
-               // check for active CAN interface
-               //
-               if(pclInterfaceP.isNull() == false)
-               {
-                  clCanFrameT.fromByteArray(clSockDataT);
-                  pclInterfaceP->write(clCanFrameT);
-               }
+   pclSenderT = (QIODevice* ) QObject::sender();
 
-               //---------------------------------------------
-               // write to other sockets
-               //
-               handleCanFrame(slSockIdxT, clSockDataT);
-               break;
-                  
-            //--------------------------------------------------
-            // handle error frames
-            //
-            case QCanData::eTYPE_ERROR:
-               handleErrFrame(slSockIdxT, clSockDataT);
-               break;         
-               
-            default:
-               
-               break;
-         }
+   clTcpSockMutexP.lock();
+   slSockIdxT = pclSockListP->indexOf(pclSenderT);
+   if((slSockIdxT >= 0) && (pclSenderT->bytesToWrite() == 0))
+   {
+      if((pclSockInfoListP->at(slSockIdxT).ulFrameCntM > 0) &&
+         (pclSockInfoListP->at(slSockIdxT).btCloseM == false))
+      {
+         writeSocket(slSockIdxT);
       }
    }
    clTcpSockMutexP.unlock();
+}
+
+
+//----------------------------------------------------------------------------//
+// onSocketClose()                                                            //
+// close sockets which are disconnected by the send policy                    //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onSocketClose(void)
+{
+   int32_t                 slSockIdxT;
+   QVector<QIODevice *>    clCloseListT;
+   QVector<bool>           clLocalListT;
 
    //----------------------------------------------------------------
-   // signal current statistic values
+   // abort() emits the signal disconnected(), so the sockets are
+   // closed after the socket list has been unlocked
    //
-   if(ulStatisticTickP > 0)
+   clTcpSockMutexP.lock();
+   for(slSockIdxT = 0; slSockIdxT < pclSockListP->size(); slSockIdxT++)
    {
-      ulStatisticTickP--;
+      if(pclSockInfoListP->at(slSockIdxT).btCloseM == true)
+      {
+         clCloseListT.append(pclSockListP->at(slSockIdxT));
+         clLocalListT.append(pclSockInfoListP->at(slSockIdxT).btLocalM);
+      }
    }
-   else
+   clTcpSockMutexP.unlock();
+
+   for(slSockIdxT = 0; slSockIdxT < clCloseListT.size(); slSockIdxT++)
    {
-      //--------------------------------------------------------
-      // reload tick value
-      //
-      ulStatisticTickP = ulStatisticTimeP / ulDispatchTimeP;
+      qCanTrace(qcanTraceNetwork) << "QCanNetwork::onSocketClose() - send queue of socket" 
+                                  << clCloseListT.at(slSockIdxT) << "exceeded";
+      if(clLocalListT.at(slSockIdxT) == true)
+      {
+         static_cast<QLocalSocket *>(clCloseListT.at(slSockIdxT))->abort();
+      }
+      else
+      {
+         static_cast<QTcpSocket *>(clCloseListT.at(slSockIdxT))->abort();
+      }
+   }
+}
 
-      //--------------------------------------------------------
-      // signal current counter values
-      //
-      showApiFrames(ulCntFrameApiP);
-      showCanFrames(ulCntFrameCanP);
-      showErrFrames(ulCntFrameErrP);
 
-      //--------------------------------------------------------
-      // calculate messages per second
-      //
-      ulMsgPerSecT = ulCntFrameCanP - ulFrameCntSaveP;
+//----------------------------------------------------------------------------//
+// onStatisticEvent()                                                         //
+// signal current statistic values                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onStatisticEvent(void)
+{
+   uint32_t       ulMsgPerSecT;
+   uint32_t       ulDepthMaxT = 0;
+   int32_t        slSockIdxT;
 
-      //--------------------------------------------------------
-      // calculate bus load
-      //
-      ulCntBitCurP = ulCntBitCurP * 100;
-      ulCntBitCurP = ulCntBitCurP / ulCntBitMaxP;
-      if(ulCntBitCurP > 100)
+   //----------------------------------------------------------------
+   // signal current counter values
+   //
+   showApiFrames(ulCntFrameApiP);
+   showCanFrames(ulCntFrameCanP);
+   showErrFrames(ulCntFrameErrP);
+
+   //----------------------------------------------------------------
+   // calculate messages per second
+   //
+   ulMsgPerSecT = ulCntFrameCanP - ulFrameCntSaveP;
+
+   //----------------------------------------------------------------
+   // calculate bus load of the elapsed period
+   //
+   ubBusLoadP = clBusLoadP.periodLoad(clLoadPeriodTmrP.nsecsElapsed());
+   clLoadPeriodTmrP.restart();
+
+   //----------------------------------------------------------------
+   // signal bus load and msg/sec
+   //
+   showLoad(ubBusLoadP, ulMsgPerSecT);
+
+   //----------------------------------------------------------------
+   // signal largest send queue and dropped frames
+   //
+   clTcpSockMutexP.lock();
+   for(slSockIdxT = 0; slSockIdxT < pclSockInfoListP->size(); slSockIdxT++)
+   {
+      if(pclSockInfoListP->at(slSockIdxT).ulFrameCntM > ulDepthMaxT)
       {
-         ulCntBitCurP = 100;
+         ulDepthMaxT = pclSockInfoListP->at(slSockIdxT).ulFrameCntM;
       }
-      //--------------------------------------------------------
-      // signal bus load and msg/sec
-      //
-      showLoad((uint8_t) ulCntBitCurP, ulMsgPerSecT);
-      ulCntBitCurP = 0;
-
-      //--------------------------------------------------------
-      // store actual frame counter value
-      //
-      ulFrameCntSaveP = ulCntFrameCanP;
    }
+   clTcpSockMutexP.unlock();
+   showQueue(ulDepthMaxT, ulCntFrameDropP);
 
-   clDispatchTmrP.singleShot(ulDispatchTimeP, this, SLOT(onTimerEvent()));
+   //----------------------------------------------------------------
+   // store actual frame counter value
+   //
+   ulFrameCntSaveP = ulCntFrameCanP;
 }
 
 
@@ -694,8 +1870,20 @@ void QCanNetwork::onTimerEvent(void)
 //----------------------------------------------------------------------------//
 void QCanNetwork::removeInterface(void)
 {
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "removeInterface",
+                                Qt::BlockingQueuedConnection);
+      return;
+   }
+
    if(pclInterfaceP.isNull() == false)
    {
+      clSchedulerP.setInterface(Q_NULLPTR, Q_NULLPTR);
+
+      disconnect( pclInterfaceP, SIGNAL(framesReceived(uint32_t)),
+                  this, SLOT(onInterfaceReceive()));
+
       if (pclInterfaceP->connected())
       {
          pclInterfaceP->disconnect();
@@ -711,6 +1899,15 @@ void QCanNetwork::removeInterface(void)
 //----------------------------------------------------------------------------//
 void QCanNetwork::setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV)
 {
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setBitrate",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(int32_t, slNomBitRateV),
+                                Q_ARG(int32_t, slDatBitRateV));
+      return;
+   }
+
    //----------------------------------------------------------------
    // Store new bit-rates:
    // If there is no CAN FD support, the data bit rate will be set
@@ -737,21 +1934,38 @@ void QCanNetwork::setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV)
       pclInterfaceP->setMode(eCAN_MODE_START);
    }
    //----------------------------------------------------------------
-   // configure bit-counter for bus-load calculation
+   // configure bit-rates for bus-load calculation
+   //
+   clBusLoadP.setBitrate(slNomBitRateP, slDatBitRateP);
+}
+
+
+//----------------------------------------------------------------------------//
+// setBatchSize()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setBatchSize(uint32_t ulFrameMaxV)
+{
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setBatchSize",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint32_t, ulFrameMaxV));
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // at least one frame per write
    //
-   switch(slNomBitRateV)
+   if(ulFrameMaxV == 0)
    {
-      case eCAN_BITRATE_125K:
-         ulCntBitMaxP = 125000;
-         break;
-         
-      case eCAN_BITRATE_250K:
-         ulCntBitMaxP = 250000;
-         break;
+      ulFrameMaxV = 1;
+   }
+   ulBatchSizeP = ulFrameMaxV;
 
-      case eCAN_BITRATE_500K:
-         ulCntBitMaxP = 500000;
-         break;
+   if(ulQueueSizeP < ulBatchSizeP)
+   {
+      ulQueueSizeP = ulBatchSizeP;
    }
 }
 
@@ -762,7 +1976,16 @@ void QCanNetwork::setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV)
 //----------------------------------------------------------------------------//
 void QCanNetwork::setDispatcherTime(uint32_t ulTimeV)
 {
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setDispatcherTime",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint32_t, ulTimeV));
+      return;
+   }
+
    ulDispatchTimeP = ulTimeV;
+   clDispatchTmrP.setInterval(ulDispatchTimeP);
 }
 
 
@@ -772,6 +1995,14 @@ void QCanNetwork::setDispatcherTime(uint32_t ulTimeV)
 //----------------------------------------------------------------------------//
 void QCanNetwork::setErrorFramesEnabled(bool btEnableV)
 {
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setErrorFramesEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
    if(hasErrorFramesSupport() == true)
    {
       btErrorFramesEnabledP = btEnableV;
@@ -789,6 +2020,14 @@ void QCanNetwork::setErrorFramesEnabled(bool btEnableV)
 //----------------------------------------------------------------------------//
 void QCanNetwork::setFastDataEnabled(bool btEnableV)
 {
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setFastDataEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
    if(hasFastDataSupport() == true)
    {
       btFastDataEnabledP = btEnableV;
@@ -802,12 +2041,38 @@ void QCanNetwork::setFastDataEnabled(bool btEnableV)
 
 
 
+//----------------------------------------------------------------------------//
+// setLocalServerEnabled()                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setLocalServerEnabled(bool btEnableV)
+{
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setLocalServerEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
+   btLocalEnabledP = btEnableV;
+}
+
+
 //----------------------------------------------------------------------------//
 // setListenOnlyEnabled()                                                     //
 //                                                                            //
 //----------------------------------------------------------------------------//
 void QCanNetwork::setListenOnlyEnabled(bool btEnableV)
 {
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setListenOnlyEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
    if(hasListenOnlySupport() == true)
    {
       btListenOnlyEnabledP = btEnableV;
@@ -819,12 +2084,108 @@ void QCanNetwork::setListenOnlyEnabled(bool btEnableV)
 }
 
 
+//----------------------------------------------------------------------------//
+// setSendPolicy()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setSendPolicy(uint8_t ubPolicyV)
+{
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setSendPolicy",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint8_t, ubPolicyV));
+      return;
+   }
+
+   if(ubPolicyV <= QCAN_SEND_POLICY_DISCONNECT)
+   {
+      ubSendPolicyP = ubPolicyV;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setSendQueueSize()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setSendQueueSize(uint32_t ulFrameMaxV)
+{
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setSendQueueSize",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint32_t, ulFrameMaxV));
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // the queue holds at least one batch
+   //
+   if(ulFrameMaxV < ulBatchSizeP)
+   {
+      ulFrameMaxV = ulBatchSizeP;
+   }
+   ulQueueSizeP = ulFrameMaxV;
+}
+
+
+//----------------------------------------------------------------------------//
+// setSharedMemoryEnabled()                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setSharedMemoryEnabled(bool btEnableV)
+{
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setSharedMemoryEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
+   btShmEnabledP = btEnableV;
+}
+
+
+//----------------------------------------------------------------------------//
+// setTimeStampEnabled()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setTimeStampEnabled(bool btEnableV)
+{
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setTimeStampEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
+   btTimeStampEnabledP = btEnableV;
+}
+
+
 //----------------------------------------------------------------------------//
 // setNetworkEnabled()                                                        //
 // start / stop the TCP server                                                //
 //----------------------------------------------------------------------------//
 void QCanNetwork::setNetworkEnabled(bool btEnableV)
 {
+   int32_t  slSockIdxT;
+   QString  clLocalNameT;
+
+   //----------------------------------------------------------------
+   // The TCP server and the timers belong to the thread of the
+   // network, they must not be started or stopped from another thread
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setNetworkEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
 
    if(btEnableV == true)
    {
@@ -835,7 +2196,7 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
 
       if(!pclTcpSrvP->listen(clTcpHostAddrP, uwTcpPortP))
       {
-         qDebug() << "QCanNetwork(): can not listen to " << clNetNameP;
+         qCanTrace(qcanTraceNetwork) << "QCanNetwork(): can not listen to " << clNetNameP;
       }
 
       //--------------------------------------------------------
@@ -845,11 +2206,54 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
       connect( pclTcpSrvP, SIGNAL(newConnection()),
                this, SLOT(onSocketConnect()));
 
+      //--------------------------------------------------------
+      // The local server is optional, a socket file of a previous
+      // process is removed before. On Unix systems the access is
+      // limited by the file permissions.
+      //
+      if(btLocalEnabledP == true)
+      {
+         clLocalNameT = QCAN_LOCAL_SERVER_NAME + QString::number(uwTcpPortP);
+         QLocalServer::removeServer(clLocalNameT);
+         pclLocalSrvP->setSocketOptions(QLocalServer::UserAccessOption |
+                                        QLocalServer::GroupAccessOption);
+         pclLocalSrvP->setMaxPendingConnections(QCAN_TCP_SOCKET_MAX);
+         if(pclLocalSrvP->listen(clLocalNameT) == true)
+         {
+            connect( pclLocalSrvP, SIGNAL(newConnection()),
+                     this, SLOT(onLocalSocketConnect()));
+         }
+         else
+         {
+            qCanTrace(qcanTraceNetwork) << "QCanNetwork(): can not listen to " << clLocalNameT;
+         }
+      }
+
+
+      //--------------------------------------------------------
+      // create the shared memory ring, sockets use the TCP
+      // connection if this fails
+      //
+      if(btShmEnabledP == true)
+      {
+         if(clShmRingP.create(QCAN_SHARED_RING_KEY + 
+                              QString::number(uwTcpPortP)) == false)
+         {
+            qCanTrace(qcanTraceNetwork) << "QCanNetwork(): no shared memory for " << clNetNameP;
+         }
+      }
+
+      //--------------------------------------------------------
+      // start interface polling and statistic
+      //
+      clDispatchTmrP.start();
+      clStatisticTmrP.start();
 
       //--------------------------------------------------------
-      // start network thread
+      // start the cyclic transmit jobs, they also run without
+      // a CAN interface
       //
-      clDispatchTmrP.singleShot(ulDispatchTimeP, this, SLOT(onTimerEvent()));
+      clSchedulerP.setEnabled(true);
 
 
       //--------------------------------------------------------
@@ -861,9 +2265,11 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
    else
    {
       //--------------------------------------------------------
-      // stop timer for message dispatching
+      // stop timer for interface polling and statistic
       //
       clDispatchTmrP.stop();
+      clStatisticTmrP.stop();
+      clSchedulerP.setEnabled(false);
 
       //--------------------------------------------------------
       // remove signal / slot connection
@@ -875,9 +2281,30 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
       //--------------------------------------------------------
       // close TCP server
       //
-      qDebug() << "Close server";
+      qCanTrace(qcanTraceNetwork) << "Close server";
       pclTcpSrvP->close();
 
+      if(pclLocalSrvP->isListening())
+      {
+         disconnect( pclLocalSrvP, SIGNAL(newConnection()),
+                     this, SLOT(onLocalSocketConnect()));
+         pclLocalSrvP->close();
+      }
+
+      //--------------------------------------------------------
+      // release the shared memory ring, connected sockets get
+      // the frames via TCP again
+      //
+      clTcpSockMutexP.lock();
+      for(slSockIdxT = 0; slSockIdxT < pclSockInfoListP->size(); slSockIdxT++)
+      {
+         (*pclSockInfoListP)[slSockIdxT].btSharedM    = false;
+         (*pclSockInfoListP)[slSockIdxT].slShmReaderM = -1;
+      }
+      ulShmSockCntP = 0;
+      clTcpSockMutexP.unlock();
+      clShmRingP.detach();
+
       //--------------------------------------------------------
       // set flag for further operations
       //
@@ -907,3 +2334,31 @@ bool QCanNetwork::setServerAddress(QHostAddress clHostAddressV)
 
    return(btResultT);
 }
+
+
+//----------------------------------------------------------------------------//
+// startRecording()                                                           //
+// start binary trace of all routed frames                                    //
+//----------------------------------------------------------------------------//
+bool QCanNetwork::startRecording(const QString & clFileNameR)
+{
+   bool  btResultT;
+
+   btResultT = clRecorderP.startRecording(clFileNameR, &clTimeBaseP);
+   if(btResultT == false)
+   {
+      qCanTrace(qcanTraceNetwork) << "QCanNetwork::startRecording() - failed for" << clNetNameP;
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// stopRecording()                                                            //
+// stop binary trace                                                          //
+//----------------------------------------------------------------------------//
+void QCanNetwork::stopRecording(void)
+{
+   clRecorderP.stopRecording();
+}
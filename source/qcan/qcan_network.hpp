@@ -35,15 +35,24 @@
 ** Include files                                                              **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
+#include <QElapsedTimer>
+#include <QLocalServer>
+#include <QLocalSocket>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QThread>
 #include <QMutex>
 #include <QPointer>
 #include <QTimer>
 
+#include "qcan_bus_load.hpp"
+#include "qcan_filter_index.hpp"
 #include "qcan_frame.hpp"
 #include "qcan_frame_api.hpp"
 #include "qcan_frame_error.hpp"
+#include "qcan_recorder.hpp"
+#include "qcan_scheduler.hpp"
+#include "qcan_shared_ring.hpp"
 
 using namespace QCan;
 
@@ -98,8 +107,11 @@ public:
 	** <p>
 	** The function returns \c true if the CAN interface is added, otherwise
 	** it will return \c false.
+	** <p>
+	** If the network runs in a dedicated thread (see QCanServer), the
+	** CAN interface is moved to this thread.
 	*/
-	bool addInterface(QCanInterface * pclCanIfV);
+	Q_INVOKABLE bool addInterface(QCanInterface * pclCanIfV);
 
    /*!
    ** \return     Bit-rate value for Nominal Bit Timing
@@ -116,6 +128,33 @@ public:
    */
 	inline int32_t  bitrate(void)          {  return (slNomBitRateP);    };
 
+   /*!
+   ** \return     Maximum number of frames per socket write
+   ** \see        setBatchSize()
+   **
+   ** This function returns the maximum number of frames which are
+   ** collected for a socket before they are written.
+   */
+   uint32_t batchSize(void)         {return (ulBatchSizeP); };
+
+   /*!
+   ** \return     Bus load in percent
+   ** \see        showLoad()
+   **
+   ** This function returns the bus load of the last statistic period
+   ** (one second).
+   */
+   uint8_t  busLoad(void)           {return (ubBusLoadP); };
+
+   /*!
+   ** \return     Bus load in percent
+   **
+   ** This function returns the bus load of the last dispatch window,
+   ** i.e. the last poll period of the physical CAN interface
+   ** (refer to setDispatcherTime()).
+   */
+   uint8_t  busLoadWindow(void)     {return (ubBusLoadWindowP); };
+
 	inline int32_t  nominalBitrate(void)   {  return (slNomBitRateP);    };
 
 	inline int32_t  dataBitrate(void)      {  return (slDatBitRateP);    };
@@ -124,8 +163,10 @@ public:
    ** \return     Current dispatcher time
    ** \see        setDispatcherTime()
    **
-   ** This function returns the current dispatcher time for the
-   ** internal CAN frame handler in milliseconds.
+   ** This function returns the current dispatcher time in milliseconds.
+   ** Frames from sockets and from CAN interfaces emitting
+   ** QCanInterface::framesReceived() are dispatched immediately, the
+   ** dispatcher time only defines the poll period of the CAN interface.
    */
 	uint32_t dispatcherTime(void)    {return (ulDispatchTimeP); };
 
@@ -141,6 +182,12 @@ public:
 
    bool isListenOnlyEnabled(void)   {return (btListenOnlyEnabledP);  };
 
+   /*!
+   ** \return     \c true if local server is enabled
+   ** \see        setLocalServerEnabled()
+   */
+   bool isLocalServerEnabled(void)  {return (btLocalEnabledP);       };
+
    /*!
    ** \return     \c true if CAN is enabled
    ** \see        setNetworkEnabled()
@@ -150,9 +197,48 @@ public:
    */
    bool isNetworkEnabled(void)      {return (btNetworkEnabledP);     };
 
+   /*!
+   ** \return     \c true if the trace recorder is active
+   ** \see        startRecording()
+   */
+   bool isRecording(void)           {return (clRecorderP.isRecording()); };
+
+   /*!
+   ** \return     \c true if shared memory transport is enabled
+   ** \see        setSharedMemoryEnabled()
+   */
+   bool isSharedMemoryEnabled(void) {return (btShmEnabledP);         };
+
+   /*!
+   ** \return     \c true if ingress time-stamps are enabled
+   ** \see        setTimeStampEnabled()
+   */
+   bool isTimeStampEnabled(void)    {return (btTimeStampEnabledP);   };
+
 
 	QString  name()   { return(clNetNameP); };
 
+   /*!
+   ** \return     Pointer to trace recorder
+   ** \see        startRecording()
+   **
+   ** The trace recorder provides the statistic of the recording and
+   ** the settings of the trace file segments.
+   */
+   QCanRecorder * recorder(void)    {return (&clRecorderP); };
+
+   /*!
+   ** \return     Policy for a full send queue
+   ** \see        setSendPolicy()
+   */
+   uint8_t  sendPolicy(void)        {return (ubSendPolicyP); };
+
+   /*!
+   ** \return     Maximum number of queued frames per socket
+   ** \see        setSendQueueSize()
+   */
+   uint32_t sendQueueSize(void)     {return (ulQueueSizeP); };
+
 	void reset(void);
 
    /*!
@@ -160,7 +246,7 @@ public:
    **
    ** Remove a physical CAN interface from the CAN network.
    */
-	void removeInterface(void);
+	Q_INVOKABLE void removeInterface(void);
 
    QHostAddress serverAddress(void);
 
@@ -179,18 +265,31 @@ public:
    ** For selection of predefined bit-rates the value can be taken from
    ** the enumeration CANpie::CAN_Bitrate_e.
    */
-	void setBitrate(int32_t slNomBitRateV,
-	                int32_t slDatBitRateV = eCAN_BITRATE_NONE);
+	Q_INVOKABLE void setBitrate(int32_t slNomBitRateV,
+	                            int32_t slDatBitRateV = eCAN_BITRATE_NONE);
 
 
+   /*!
+   ** \param[in]  ulFrameMaxV    Maximum number of frames per write
+   ** \see        batchSize()
+   **
+   ** Frames dispatched during one pass are collected in an outbound
+   ** buffer for each socket and written with one operation at the end
+   ** of the pass. This function limits the number of frames collected
+   ** for a socket, a full buffer is written immediately. A value of 1
+   ** writes each frame separately. The default value is defined
+   ** by QCAN_NETWORK_BATCH_SIZE.
+   */
+   Q_INVOKABLE void setBatchSize(uint32_t ulFrameMaxV);
+
    /*!
    ** \param[in]  ulTimeV        Dispatcher time
    ** \see        dispatcherTime()
    **
-   ** This function sets the dispatcher time for the internal CAN frame
-   ** handler in milliseconds.
+   ** This function sets the poll period of the physical CAN interface
+   ** in milliseconds.
    */
-	void setDispatcherTime(uint32_t ulTimeV);
+	Q_INVOKABLE void setDispatcherTime(uint32_t ulTimeV);
 
 
    /*!
@@ -200,12 +299,27 @@ public:
    ** This function enables the dispatching of CAN error frames if \a btEnable
    ** is \c true, it is disabled on \c false.
    */
-   void setErrorFramesEnabled(bool btEnableV = true);
+   Q_INVOKABLE void setErrorFramesEnabled(bool btEnableV = true);
 
 
-   void setFastDataEnabled(bool btEnableV = true);
+   Q_INVOKABLE void setFastDataEnabled(bool btEnableV = true);
 
-   void setListenOnlyEnabled(bool btEnableV = true);
+   Q_INVOKABLE void setListenOnlyEnabled(bool btEnableV = true);
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable local server
+   ** \see        isLocalServerEnabled()
+   **
+   ** Besides the TCP server, the network listens on a local server
+   ** (QLocalServer) with the name QCAN_LOCAL_SERVER_NAME followed by
+   ** the TCP port number. A QCanSocket on the same host connects to
+   ** the local server and skips the TCP/IP stack. On Unix systems
+   ** the access is limited to the user and the group of the server
+   ** by the file permissions of the socket. The setting takes effect
+   ** when the network is enabled by setNetworkEnabled(). The local
+   ** server is enabled by default.
+   */
+   Q_INVOKABLE void setLocalServerEnabled(bool btEnableV = true);
 
    /*!
    ** \param[in]  btEnableV      Enable / disable network
@@ -214,10 +328,86 @@ public:
    ** This function enables the dispatching of CAN frames if \a btEnable is
    ** \c true, it is disabled on \c false.
    */
-   void setNetworkEnabled(bool btEnableV = true);
+   Q_INVOKABLE void setNetworkEnabled(bool btEnableV = true);
+
+   /*!
+   ** \param[in]  ubPolicyV      Policy for a full send queue
+   ** \see        sendPolicy()
+   **
+   ** This function defines the handling of a socket whose send queue
+   ** is full (refer to setSendQueueSize()). The value is one of
+   ** QCAN_SEND_POLICY_DROP_OLDEST (default), QCAN_SEND_POLICY_DROP_NEWEST
+   ** or QCAN_SEND_POLICY_DISCONNECT. Dropped frames are counted for
+   ** each socket, a socket can request its counters by an API frame
+   ** of type QCanFrameApi::eAPI_FUNC_QUEUE_STATUS.
+   */
+   Q_INVOKABLE void setSendPolicy(uint8_t ubPolicyV);
+
+   /*!
+   ** \param[in]  ulFrameMaxV    Maximum number of queued frames
+   ** \see        sendQueueSize()
+   **
+   ** Frames are only written to a socket as long as the socket has
+   ** passed all previously written data to the operating system. The
+   ** frames of a socket that does not read its data in time are queued
+   ** by the network. This function limits the number of queued frames
+   ** for each socket, the policy for a full queue is defined by
+   ** setSendPolicy(). The value is at least the batch size, the default
+   ** value is defined by QCAN_NETWORK_QUEUE_SIZE.
+   */
+   Q_INVOKABLE void setSendQueueSize(uint32_t ulFrameMaxV);
 
    bool setServerAddress(QHostAddress clHostAddressV);
 
+   /*!
+   ** \param[in]  btEnableV      Enable / disable shared memory transport
+   ** \see        isSharedMemoryEnabled()
+   **
+   ** If the shared memory transport is enabled, the network writes each
+   ** frame once to a shared memory ring (refer to QCanSharedRing).
+   ** Sockets on the same host attach to the ring during the connection
+   ** handshake and read frames from the ring instead of the TCP
+   ** connection. The setting takes effect when the network is enabled
+   ** by setNetworkEnabled(). The transport is enabled by default.
+   */
+   Q_INVOKABLE void setSharedMemoryEnabled(bool btEnableV = true);
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable ingress time-stamps
+   ** \see        isTimeStampEnabled()
+   **
+   ** If ingress time-stamps are enabled, the network replaces the
+   ** time-stamp of each CAN frame it receives from a socket or from the
+   ** CAN interface by the time of reception. All networks use the same
+   ** monotonic clock with nanosecond resolution, so the time-stamps of 
+   ** frames from different clients, interfaces and networks are 
+   ** comparable. The option is disabled by default, the time-stamp of
+   ** the sender is kept then.
+   */
+   Q_INVOKABLE void setTimeStampEnabled(bool btEnableV = true);
+
+   /*!
+   ** \param[in]  clFileNameR    Name of trace file
+   ** \return     \c true if the recording has been started
+   ** \see        stopRecording()
+   **
+   ** This function starts the recording of all CAN frames, error frames
+   ** and API frames which are routed by the network to a binary trace
+   ** file. The dispatcher only copies each frame to a queue, the file
+   ** is written by the thread of the trace recorder (refer to
+   ** QCanRecorder). The time of reception is taken from the same clock
+   ** as the ingress time-stamps (refer to setTimeStampEnabled()), so
+   ** the traces of different networks are comparable.
+   */
+   bool startRecording(const QString & clFileNameR);
+
+   /*!
+   ** \see        startRecording()
+   **
+   ** This function stops the recording and closes the trace file.
+   */
+   void stopRecording(void);
+
 signals:
    /*!
    ** \param[in]  ulFrameTotalV  Total number of frames
@@ -249,22 +439,68 @@ signals:
    **
    **
    ** This signal is emitted every second. The parameter \a ubLoadV
-   ** denotes the bus load in percent (value range 0 .. 100).
+   ** denotes the bus load in percent (value range 0 .. 100). The bus
+   ** load is calculated from the bit length of all dispatched CAN 
+   ** frames, refer to QCanBusLoad.
    */
    void  showLoad(uint8_t ubLoadV, uint32_t ulMsgPerSecV);
 
+   /*!
+   ** \param[in]  ulDepthMaxV    Maximum number of queued frames
+   ** \param[in]  ulDroppedV     Total number of dropped frames
+   **
+   ** This signal is emitted every second. The parameter \a ulDepthMaxV
+   ** denotes the largest send queue of all sockets, \a ulDroppedV
+   ** denotes the total number of frames dropped by the send policy
+   ** (refer to setSendPolicy()).
+   */
+   void  showQueue(uint32_t ulDepthMaxV, uint32_t ulDroppedV);
+
 private slots:
    /*!
    ** This function is called upon socket connection.
    */
    void onSocketConnect(void);
 
+   /*!
+   ** This function is called upon socket connection to the local server.
+   */
+   void onLocalSocketConnect(void);
+
    /*!
    ** This function is called upon socket disconnection.
    */
    void onSocketDisconnect(void);
 
-   void onTimerEvent(void);
+   /*!
+   ** This function is called when a socket has new data available.
+   ** The frames are dispatched immediately.
+   */
+   void onSocketReceive(void);
+
+   /*!
+   ** This function is called when a socket has written data. Queued
+   ** frames are written as soon as all previous data is written.
+   */
+   void onSocketWritten(void);
+
+   /*!
+   ** This function closes all sockets which exceeded their send queue
+   ** using the policy QCAN_SEND_POLICY_DISCONNECT. It is invoked as
+   ** queued call, because the socket list is locked during dispatching.
+   */
+   void onSocketClose(void);
+
+   /*!
+   ** This function is called when the physical CAN interface signals
+   ** new frames and by the dispatcher timer (interface polling).
+   */
+   void onInterfaceReceive(void);
+
+   /*!
+   ** This function is called by the statistic timer.
+   */
+   void onStatisticEvent(void);
 
 
 
@@ -278,12 +514,41 @@ private:
    bool  handleCanFrame(int32_t & slSockSrcR, QByteArray & clSockDataR);
    bool  handleErrFrame(int32_t & slSockSrcR, QByteArray & clSockDataR);
 
+   void  addSocket(QIODevice * pclSocketV, bool btLocalV, bool btSameHostV);
+
+   bool  isNetworkThread(void);
+
+   bool  checkSendQueue(int32_t slSockIdxV);
+   bool  checkSharedQueue(int32_t slSockIdxV);
+
+   void  dispatchInterface(void);
+   void  dispatchScheduler(void);
+   void  dispatchSocket(int32_t slSockIdxV);
+
+   void  dropFrames(int32_t slSockIdxV, uint32_t ulFrameCntV);
+
+   void  flushSockets(void);
+   bool  sendFrame(int32_t slSockSrcV, const QByteArray & clSockDataR,
+                   const QCanFrame * pclCanFrameV = Q_NULLPTR);
+   void  setFilter(int32_t slSockIdxV, QCanFrameApi & clApiFrameR);
+   void  setSharedMemory(int32_t slSockIdxV, QCanFrameApi & clApiFrameR);
+   void  stampFrame(int32_t slSockSrcV, QByteArray & clSockDataR,
+                    QCanFrame & clCanFrameR);
+   void  writeSocket(int32_t slSockIdxV);
+   void  writeInterface(const QCanFrame * pclCanFrameV,
+                        uint32_t ulFrameCntV);
+
 
    //----------------------------------------------------------------
    // unique network ID
    //
    static uint8_t          ubNetIdP;
 
+   //----------------------------------------------------------------
+   // common time base for ingress time-stamps of all networks
+   //
+   static QElapsedTimer    clTimeBaseP;
+
    //----------------------------------------------------------------
    // unique network name
    //
@@ -291,17 +556,74 @@ private:
 
    QPointer<QCanInterface> pclInterfaceP;
    QPointer<QTcpServer>    pclTcpSrvP;
-   QVector<QTcpSocket *> * pclTcpSockListP;
+   QPointer<QLocalServer>  pclLocalSrvP;
+   QVector<QIODevice *> *  pclSockListP;
    QHostAddress            clTcpHostAddrP;
    uint16_t                uwTcpPortP;
    QMutex                  clTcpSockMutexP;
 
    //----------------------------------------------------------------
-   // Frame dispatcher time
+   // information for each socket, the index is the same as
+   // for the socket list
+   //
+   typedef struct SockInfo_s {
+      QByteArray        clBufferM;     // outbound buffer
+      uint32_t          ulFrameCntM;   // number of frames in buffer
+      uint32_t          ulDropCntM;    // number of dropped frames
+      bool              btCloseM;      // disconnect by send policy
+      uint8_t           ubFormatM;     // wire format options
+      QCanFilterIndex   clFilterM;     // acceptance filter
+      uint8_t           ubFilterCntM;  // number of filter entries
+      uint32_t          ulClientIdM;   // unique ID of connection
+      bool              btSharedM;     // frames are read from ring
+      int32_t           slShmReaderM;  // index of reader in ring
+      bool              btLocalM;      // socket of local server
+   } SockInfo_ts;
+
+   QVector<SockInfo_ts> *  pclSockInfoListP;
+   uint32_t                ulBatchSizeP;
+   uint32_t                ulClientIdP;
+
+   //----------------------------------------------------------------
+   // send queue for sockets which do not read their data in time
+   //
+   uint32_t                ulQueueSizeP;
+   uint8_t                 ubSendPolicyP;
+   uint32_t                ulCntFrameDropP;
+
+   //----------------------------------------------------------------
+   // shared memory transport for sockets on the same host
+   //
+   QCanSharedRing          clShmRingP;
+   QByteArray              clShmNotifyP;
+   uint32_t                ulShmNotifyIdxP;
+   uint32_t                ulShmSockCntP;
+   bool                    btShmEnabledP;
+
+   //----------------------------------------------------------------
+   // cyclic transmit jobs of the sockets, write access to the
+   // CAN interface is shared with the scheduler thread
+   //
+   QCanScheduler           clSchedulerP;
+   QMutex                  clIfWriteMutexP;
+
+   //----------------------------------------------------------------
+   // binary trace of all routed frames, the file is written by
+   // the thread of the recorder
+   //
+   QCanRecorder            clRecorderP;
+
+   //----------------------------------------------------------------
+   // Frame dispatcher time (poll period of CAN interface)
    //
    QTimer                  clDispatchTmrP;
    uint32_t                ulDispatchTimeP;
 
+   //----------------------------------------------------------------
+   // Statistic timer
+   //
+   QTimer                  clStatisticTmrP;
+
    //----------------------------------------------------------------
    // bit-rate settings
    //
@@ -316,15 +638,18 @@ private:
    uint32_t                ulCntFrameErrP;
 
    //----------------------------------------------------------------
-   // statistic bit counter
+   // bus load calculation, the window is the poll period of
+   // the CAN interface, the period is defined by the statistic timer
    //
-   uint32_t                ulCntBitMaxP;
-   uint32_t                ulCntBitCurP;
+   QCanBusLoad             clBusLoadP;
+   QElapsedTimer           clLoadWindowTmrP;
+   QElapsedTimer           clLoadPeriodTmrP;
+   uint8_t                 ubBusLoadP;
+   uint8_t                 ubBusLoadWindowP;
 
    //----------------------------------------------------------------
    // statistic timing
    //
-   uint32_t                ulStatisticTickP;
    uint32_t                ulStatisticTimeP;
    uint32_t                ulFramePerSecMaxP;
    uint32_t                ulFrameCntSaveP;
@@ -333,6 +658,8 @@ private:
    bool                    btFastDataEnabledP;
    bool                    btListenOnlyEnabledP;
    bool                    btNetworkEnabledP;
+   bool                    btLocalEnabledP;
+   bool                    btTimeStampEnabledP;
 };
 
 #endif   // QCAN_NETWORK_HPP_
@@ -70,7 +70,12 @@ private:
 
 };
 
-#define QCanPlugin_iid "net.microcontrol.Qt.qcan.QCanPlugin"
+//-------------------------------------------------------------------
+// The version of the interface identifier must be incremented each
+// time the virtual functions of QCanPlugin or QCanInterface change,
+// so plugins built for an older interface are rejected by the loader.
+//
+#define QCanPlugin_iid "net.microcontrol.Qt.qcan.QCanPlugin/2.0"
 Q_DECLARE_INTERFACE(QCanPlugin, QCanPlugin_iid)
 
 
@@ -0,0 +1,496 @@
+//============================================================================//
+// File:          qcan_recorder.cpp                                           //
+// Description:   QCan classes - binary trace recorder                        //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include "qcan_recorder.hpp"
+#include "qcan_trace.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// size of the time field in front of each frame
+//
+#define  RECORDER_TIME_SIZE      8
+
+//-------------------------------------------------------------------
+// maximum size of one record in the write buffer
+//
+#define  RECORDER_RECORD_MAX     (RECORDER_TIME_SIZE + QCAN_FRAME_COMPACT_MAX)
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanRecorder()                                                             //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanRecorder::QCanRecorder()
+{
+   //----------------------------------------------------------------
+   // the queue and the write buffer are allocated by the first
+   // call of startRecording(), a network which is not recorded
+   // does not need the memory
+   //
+   ptsRecordP    = Q_NULLPTR;
+   ulRecordMaskP = 0;
+   ulWriteIdxP.store(0);
+   ulReadIdxP.store(0);
+   ulOverrunCntP.store(0);
+
+   pclTimeBaseP  = &clTimeBaseP;
+   uqStartTimeP  = 0;
+   sqEpochTimeP  = 0;
+
+   slBufferPosP   = 0;
+   ulSegmentP     = 0;
+   ulSegmentPosP  = 0;
+   ulSegmentMaxP.store(0);
+   ulSegmentSizeP.store(QCAN_RECORDER_SEGMENT_SIZE);
+   btFileErrorP   = false;
+
+   ulFrameCntP.store(0);
+   ulRunP.store(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanRecorder()                                                            //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanRecorder::~QCanRecorder()
+{
+   stopRecording();
+}
+
+
+//----------------------------------------------------------------------------//
+// openSegment()                                                              //
+// create next segment of trace file                                          //
+//----------------------------------------------------------------------------//
+bool QCanRecorder::openSegment(void)
+{
+   char     achHeaderT[QCAN_RECORDER_HEADER_SIZE];
+   uint32_t ulSegmentMaxT;
+
+   if(clFileP.isOpen())
+   {
+      clFileP.close();
+   }
+   ulSegmentP++;
+
+   //----------------------------------------------------------------
+   // the records are collected in the write buffer, so the file
+   // itself is not buffered
+   //
+   clFileP.setFileName(segmentName(ulSegmentP));
+   if(clFileP.open(QIODevice::WriteOnly | QIODevice::Truncate |
+                   QIODevice::Unbuffered) == false)
+   {
+      qCanTrace(qcanTraceNetwork) << "QCanRecorder::openSegment() - can't create" << clFileP.fileName();
+      btFileErrorP = true;
+      return(false);
+   }
+
+   memset(&achHeaderT[0], 0, QCAN_RECORDER_HEADER_SIZE);
+   memcpy(&achHeaderT[0], QCAN_RECORDER_MAGIC, 8);
+   setUInt64(&achHeaderT[8], (uint64_t) sqEpochTimeP);
+   setUInt32(&achHeaderT[16], ulSegmentP);
+   if(clFileP.write(&achHeaderT[0], QCAN_RECORDER_HEADER_SIZE) !=
+      QCAN_RECORDER_HEADER_SIZE)
+   {
+      btFileErrorP = true;
+      return(false);
+   }
+   ulSegmentPosP = QCAN_RECORDER_HEADER_SIZE;
+
+   //----------------------------------------------------------------
+   // remove the oldest segment if the number of segments is limited
+   //
+   ulSegmentMaxT = ulSegmentMaxP.load();
+   if((ulSegmentMaxT > 0) && (ulSegmentP > ulSegmentMaxT))
+   {
+      QFile::remove(segmentName(ulSegmentP - ulSegmentMaxT));
+   }
+
+   btFileErrorP = false;
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// record()                                                                   //
+// queue frame, called by the dispatcher                                      //
+//----------------------------------------------------------------------------//
+bool QCanRecorder::record(const QByteArray & clDataR)
+{
+   uint32_t          ulWriteIdxT;
+   QCanRecord_ts *   ptsRecordT;
+
+   //----------------------------------------------------------------
+   // the acquire operation makes the queue of startRecording()
+   // visible
+   //
+   if(ulRunP.loadAcquire() == 0)
+   {
+      return(false);
+   }
+
+   if((clDataR.size() <= 0) || (clDataR.size() > QCAN_FRAME_ARRAY_SIZE))
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // drop the frame if the thread has not emptied the queue in time,
+   // the dispatcher must not wait for the file system
+   //
+   ulWriteIdxT = ulWriteIdxP.load();
+   if((ulWriteIdxT - ulReadIdxP.loadAcquire()) > ulRecordMaskP)
+   {
+      ulOverrunCntP.fetchAndAddRelaxed(1);
+      return(false);
+   }
+
+   ptsRecordT = &ptsRecordP[ulWriteIdxT & ulRecordMaskP];
+   ptsRecordT->uqTimeM = (uint64_t) pclTimeBaseP->nsecsElapsed();
+   ptsRecordT->slSizeM = clDataR.size();
+   memcpy(&ptsRecordT->achDataM[0], clDataR.constData(), clDataR.size());
+
+   //----------------------------------------------------------------
+   // the release operation publishes the slot contents
+   //
+   ulWriteIdxP.storeRelease(ulWriteIdxT + 1);
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// run()                                                                      //
+// thread of recorder                                                         //
+//----------------------------------------------------------------------------//
+void QCanRecorder::run(void)
+{
+   while(ulRunP.load() != 0)
+   {
+      //--------------------------------------------------------
+      // collect all queued frames and write them with one
+      // operation, a full buffer is written by writeRecords()
+      //
+      writeRecords();
+      writeBuffer();
+
+      QThread::msleep(QCAN_RECORDER_POLL_TIME);
+   }
+
+   //----------------------------------------------------------------
+   // the frames queued before the stop are written
+   //
+   writeRecords();
+   writeBuffer();
+   clFileP.close();
+}
+
+
+//----------------------------------------------------------------------------//
+// segmentName()                                                              //
+// file name of segment                                                       //
+//----------------------------------------------------------------------------//
+QString QCanRecorder::segmentName(uint32_t ulSegmentV) const
+{
+   QFileInfo   clFileInfoT(clFileNameP);
+   QString     clNameT;
+
+   clNameT = clFileInfoT.path() + "/" + clFileInfoT.completeBaseName() +
+             QString("_%1").arg(ulSegmentV, 4, 10, QChar('0'));
+   if(clFileInfoT.suffix().isEmpty())
+   {
+      clNameT += ".qcr";
+   }
+   else
+   {
+      clNameT += "." + clFileInfoT.suffix();
+   }
+
+   return(clNameT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setSegmentCount()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanRecorder::setSegmentCount(uint32_t ulCountV)
+{
+   ulSegmentMaxP.store(ulCountV);
+}
+
+
+//----------------------------------------------------------------------------//
+// setSegmentSize()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanRecorder::setSegmentSize(uint32_t ulSizeV)
+{
+   //----------------------------------------------------------------
+   // a segment holds at least one write buffer
+   //
+   if(ulSizeV < QCAN_RECORDER_BUFFER_SIZE)
+   {
+      ulSizeV = QCAN_RECORDER_BUFFER_SIZE;
+   }
+   ulSegmentSizeP.store(ulSizeV);
+}
+
+
+//----------------------------------------------------------------------------//
+// setUInt32()                                                                //
+// store value MSB first                                                      //
+//----------------------------------------------------------------------------//
+void QCanRecorder::setUInt32(char * pchDataV, uint32_t ulValueV)
+{
+   pchDataV[0] = (char) (ulValueV >> 24);
+   pchDataV[1] = (char) (ulValueV >> 16);
+   pchDataV[2] = (char) (ulValueV >>  8);
+   pchDataV[3] = (char) (ulValueV);
+}
+
+
+//----------------------------------------------------------------------------//
+// setUInt64()                                                                //
+// store value MSB first                                                      //
+//----------------------------------------------------------------------------//
+void QCanRecorder::setUInt64(char * pchDataV, uint64_t uqValueV)
+{
+   setUInt32(&pchDataV[0], (uint32_t) (uqValueV >> 32));
+   setUInt32(&pchDataV[4], (uint32_t) (uqValueV));
+}
+
+
+//----------------------------------------------------------------------------//
+// startRecording()                                                           //
+// create first segment and start thread                                      //
+//----------------------------------------------------------------------------//
+bool QCanRecorder::startRecording(const QString & clFileNameR,
+                                  const QElapsedTimer * pclTimeBaseV)
+{
+   uint32_t ulSizeT = 1;
+
+   stopRecording();
+
+   //----------------------------------------------------------------
+   // the queue and the write buffer are kept once they are allocated,
+   // the index of the queue is masked, so the number of slots is
+   // a power of 2
+   //
+   if(clRecordP.isEmpty())
+   {
+      while(ulSizeT < QCAN_RECORDER_QUEUE_SIZE)
+      {
+         ulSizeT = ulSizeT << 1;
+      }
+      clRecordP.resize(ulSizeT);
+      ptsRecordP    = clRecordP.data();
+      ulRecordMaskP = ulSizeT - 1;
+
+      clBufferP.resize(QCAN_RECORDER_BUFFER_SIZE);
+   }
+   slBufferPosP = 0;
+
+   //----------------------------------------------------------------
+   // the time base of the header is the wall clock time which
+   // corresponds to a time of reception of 0
+   //
+   if(pclTimeBaseV != Q_NULLPTR)
+   {
+      pclTimeBaseP = pclTimeBaseV;
+   }
+   else
+   {
+      clTimeBaseP.start();
+      pclTimeBaseP = &clTimeBaseP;
+   }
+   uqStartTimeP = (uint64_t) pclTimeBaseP->nsecsElapsed();
+   sqEpochTimeP = QDateTime::currentMSecsSinceEpoch() -
+                  pclTimeBaseP->elapsed();
+
+   clFileNameP = clFileNameR;
+   ulSegmentP  = 0;
+   if(openSegment() == false)
+   {
+      return(false);
+   }
+
+   ulFrameCntP.store(0);
+   ulOverrunCntP.store(0);
+
+   //----------------------------------------------------------------
+   // the release operation publishes the queue to record()
+   //
+   ulRunP.storeRelease(1);
+   start();
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// stopRecording()                                                            //
+// stop thread, the remaining frames are written                              //
+//----------------------------------------------------------------------------//
+void QCanRecorder::stopRecording(void)
+{
+   ulRunP.store(0);
+   if(isRunning())
+   {
+      wait();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// writeBuffer()                                                              //
+// write buffer to trace file, called by the thread                           //
+//----------------------------------------------------------------------------//
+void QCanRecorder::writeBuffer(void)
+{
+   if(slBufferPosP == 0)
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // open the next segment if the buffer does not fit, the buffer
+   // holds complete records only, so no record is split
+   //
+   if((ulSegmentPosP > QCAN_RECORDER_HEADER_SIZE) &&
+      ((ulSegmentPosP + (uint32_t) slBufferPosP) > ulSegmentSizeP.load()))
+   {
+      openSegment();
+   }
+
+   //----------------------------------------------------------------
+   // after a file error the records are discarded until the
+   // next segment has been created
+   //
+   if(btFileErrorP == false)
+   {
+      if(clFileP.write(clBufferP.constData(), slBufferPosP) != slBufferPosP)
+      {
+         qCanTrace(qcanTraceNetwork) << "QCanRecorder::writeBuffer() - write failed" << clFileP.fileName();
+         btFileErrorP = true;
+      }
+   }
+   ulSegmentPosP += (uint32_t) slBufferPosP;
+   slBufferPosP   = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// writeRecords()                                                             //
+// move queued frames to write buffer, called by the thread                   //
+//----------------------------------------------------------------------------//
+uint32_t QCanRecorder::writeRecords(void)
+{
+   uint32_t          ulReadIdxT;
+   uint32_t          ulWriteIdxT;
+   uint32_t          ulFrameCntT = 0;
+   int32_t           slSizeT;
+   char *            pchBufferT;
+   QCanRecord_ts *   ptsRecordT;
+   QCanData          clDataT(QCanData::eTYPE_CAN);
+
+   ulReadIdxT  = ulReadIdxP.load();
+   ulWriteIdxT = ulWriteIdxP.loadAcquire();
+   while(ulReadIdxT != ulWriteIdxT)
+   {
+      ptsRecordT = &ptsRecordP[ulReadIdxT & ulRecordMaskP];
+
+      //--------------------------------------------------------
+      // frames which have been queued after the previous
+      // recording was stopped are skipped
+      //
+      if(ptsRecordT->uqTimeM >= uqStartTimeP)
+      {
+         if((slBufferPosP + RECORDER_RECORD_MAX) > clBufferP.size())
+         {
+            writeBuffer();
+         }
+         pchBufferT = clBufferP.data() + slBufferPosP;
+
+         //------------------------------------------------
+         // the frame is stored in compact encoding with
+         // checksum, independent of the wire format of the
+         // source
+         //
+         slSizeT = 0;
+         if(clDataT.fromByteArray(&ptsRecordT->achDataM[0],
+                                  ptsRecordT->slSizeM))
+         {
+            slSizeT = clDataT.toByteArrayCompact(
+                                       pchBufferT + RECORDER_TIME_SIZE,
+                                       QCAN_FRAME_COMPACT_MAX);
+         }
+
+         if(slSizeT > 0)
+         {
+            setUInt64(pchBufferT, ptsRecordT->uqTimeM);
+            slBufferPosP += RECORDER_TIME_SIZE + slSizeT;
+            ulFrameCntT++;
+         }
+      }
+
+      //--------------------------------------------------------
+      // the slot is released after the copy
+      //
+      ulReadIdxT++;
+      ulReadIdxP.storeRelease(ulReadIdxT);
+   }
+
+   ulFrameCntP.fetchAndAddRelaxed(ulFrameCntT);
+
+   return(ulFrameCntT);
+}
@@ -0,0 +1,290 @@
+//============================================================================//
+// File:          qcan_recorder.hpp                                           //
+// Description:   QCan classes - binary trace recorder                        //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+#ifndef QCAN_RECORDER_HPP_
+#define QCAN_RECORDER_HPP_
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QThread>
+#include <QVector>
+
+#include "qcan_data.hpp"
+
+//-------------------------------------------------------------------
+/*!
+** \file qcan_recorder.hpp
+**
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_RECORDER_HEADER_SIZE
+**
+** The symbol QCAN_RECORDER_HEADER_SIZE defines the size of the header
+** at the begin of each trace file segment.
+*/
+#define  QCAN_RECORDER_HEADER_SIZE  24
+
+
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_RECORDER_MAGIC
+**
+** The symbol QCAN_RECORDER_MAGIC defines the first 8 bytes of a trace
+** file segment, the last character is the version of the format.
+*/
+#define  QCAN_RECORDER_MAGIC        "QCANREC1"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanRecorder
+** \brief   Binary trace recorder
+**
+** The QCanRecorder class writes all frames which are routed by a
+** QCanNetwork to a binary trace file. The dispatcher of the network
+** passes each frame to record(), which copies the frame together
+** with the time of reception to a lock-free queue and returns. A
+** dedicated thread collects the queued frames in a buffer of
+** #QCAN_RECORDER_BUFFER_SIZE bytes and writes the buffer with one
+** operation, so the dispatcher never waits for the file system. If
+** the queue is full, the frame is dropped and counted by overruns().
+**
+** The trace is split into segments of a maximum size, refer to
+** setSegmentSize() and setSegmentCount(). Each segment starts with a
+** header of #QCAN_RECORDER_HEADER_SIZE bytes:
+** <ul>
+** <li>Byte 0 .. 7: #QCAN_RECORDER_MAGIC
+** <li>Byte 8 .. 15: time base, milliseconds since the epoch (UTC),
+**     MSB first
+** <li>Byte 16 .. 19: segment number, MSB first
+** <li>Byte 20 .. 23: reserved, 0
+** </ul>
+** The header is followed by the records, each record consists of:
+** <ul>
+** <li>Byte 0 .. 7: time of reception in nanoseconds relative to the
+**     time base, MSB first
+** <li>the frame in compact encoding with checksum, the size is
+**     returned by QCanData::byteArraySize()
+** </ul>
+*/
+class QCanRecorder : public QThread
+{
+   Q_OBJECT
+
+public:
+
+   QCanRecorder();
+
+   ~QCanRecorder();
+
+   /*!
+   ** \return     Name of trace file
+   ** \see        startRecording()
+   */
+   QString  fileName(void) const       { return(clFileNameP);          };
+
+   /*!
+   ** \return     Number of frames written to the trace
+   */
+   uint32_t frameCount(void) const     { return(ulFrameCntP.load());   };
+
+   /*!
+   ** \return     \c true if the recorder is active
+   ** \see        startRecording()
+   */
+   bool     isRecording(void) const    { return(ulRunP.load() != 0);   };
+
+   /*!
+   ** \return     Number of frames dropped because the queue was full
+   */
+   uint32_t overruns(void) const       { return(ulOverrunCntP.load()); };
+
+   /*!
+   ** \param[in]  clDataR        Frame data
+   ** \return     \c true if the frame has been queued
+   **
+   ** Queue a frame for the trace file, the frame may use the fixed or
+   ** the compact encoding. The function must only be called by one
+   ** thread, i.e. the dispatcher of the network. It does not allocate
+   ** memory and does not wait. The function returns \c false if the
+   ** recorder is not active or the queue is full.
+   */
+   bool     record(const QByteArray & clDataR);
+
+   /*!
+   ** \return     Maximum number of segments
+   ** \see        setSegmentCount()
+   */
+   uint32_t segmentCount(void) const   { return(ulSegmentMaxP.load());  };
+
+   /*!
+   ** \param[in]  ulSegmentV     Segment number
+   ** \return     File name of segment
+   **
+   ** The file name of a segment is derived from the name passed to
+   ** startRecording(), the segment number is appended to the base
+   ** name, e.g. "trace_0001.qcr" for "trace.qcr". Segments are
+   ** numbered starting with 1.
+   */
+   QString  segmentName(uint32_t ulSegmentV) const;
+
+   /*!
+   ** \return     Maximum size of a segment in bytes
+   ** \see        setSegmentSize()
+   */
+   uint32_t segmentSize(void) const    { return(ulSegmentSizeP.load()); };
+
+   /*!
+   ** \param[in]  ulCountV       Maximum number of segments
+   ** \see        segmentCount()
+   **
+   ** Limit the number of segments on disk. When a new segment is
+   ** opened, the oldest segment is removed, so the trace holds the
+   ** most recent frames. A value of 0 (default) keeps all segments.
+   ** The setting takes effect when the next segment is opened.
+   */
+   void     setSegmentCount(uint32_t ulCountV);
+
+   /*!
+   ** \param[in]  ulSizeV        Maximum size of a segment in bytes
+   ** \see        segmentSize()
+   **
+   ** A new segment is opened when the current segment reaches this
+   ** size. The value is at least #QCAN_RECORDER_BUFFER_SIZE, the
+   ** default value is defined by #QCAN_RECORDER_SEGMENT_SIZE. The
+   ** setting takes effect with the next write to the trace file.
+   */
+   void     setSegmentSize(uint32_t ulSizeV);
+
+   /*!
+   ** \param[in]  clFileNameR    Name of trace file
+   ** \param[in]  pclTimeBaseV   Pointer to time base
+   ** \return     \c true if the first segment has been created
+   ** \see        stopRecording()
+   **
+   ** Start the thread of the recorder and create the first segment of
+   ** the trace file, refer to segmentName(). Existing segments are
+   ** overwritten. The time of reception of each frame is taken from
+   ** \c pclTimeBaseV, which must be started. A value of \c Q_NULLPTR
+   ** uses a time base which is started by this function.
+   */
+   bool     startRecording(const QString & clFileNameR,
+                           const QElapsedTimer * pclTimeBaseV = Q_NULLPTR);
+
+   /*!
+   ** \see        startRecording()
+   **
+   ** Write all queued frames to the trace file, close the file and
+   ** stop the thread of the recorder.
+   */
+   void     stopRecording(void);
+
+protected:
+
+   void     run(void) Q_DECL_OVERRIDE;
+
+private:
+
+   typedef struct QCanRecord_s {
+      uint64_t          uqTimeM;       // time of reception
+      int32_t           slSizeM;       // size of frame data
+      char              achDataM[QCAN_FRAME_ARRAY_SIZE];
+   } QCanRecord_ts;
+
+   bool     openSegment(void);
+   void     writeBuffer(void);
+   uint32_t writeRecords(void);
+
+   static void setUInt32(char * pchDataV, uint32_t ulValueV);
+   static void setUInt64(char * pchDataV, uint64_t uqValueV);
+
+   //----------------------------------------------------------------
+   // queue between dispatcher and thread, the write index is only
+   // modified by record(), the read index only by the thread
+   //
+   QVector<QCanRecord_ts>     clRecordP;
+   QCanRecord_ts *            ptsRecordP;
+   uint32_t                   ulRecordMaskP;
+   QAtomicInteger<uint32_t>   ulWriteIdxP;
+   QAtomicInteger<uint32_t>   ulReadIdxP;
+   QAtomicInteger<uint32_t>   ulOverrunCntP;
+
+   //----------------------------------------------------------------
+   // time base for the time of reception, records which are older
+   // than the start of the recording are skipped
+   //
+   const QElapsedTimer *      pclTimeBaseP;
+   QElapsedTimer              clTimeBaseP;
+   uint64_t                   uqStartTimeP;
+   int64_t                    sqEpochTimeP;
+
+   //----------------------------------------------------------------
+   // trace file, only accessed by the thread while it is running
+   //
+   QString                    clFileNameP;
+   QFile                      clFileP;
+   QVector<char>              clBufferP;
+   int32_t                    slBufferPosP;
+   uint32_t                   ulSegmentP;
+   uint32_t                   ulSegmentPosP;
+   bool                       btFileErrorP;
+
+   //----------------------------------------------------------------
+   // segment limits, set by the thread of the caller and read by
+   // the thread of the recorder
+   //
+   QAtomicInteger<uint32_t>   ulSegmentMaxP;
+   QAtomicInteger<uint32_t>   ulSegmentSizeP;
+
+   QAtomicInteger<uint32_t>   ulFrameCntP;
+   QAtomicInteger<uint32_t>   ulRunP;
+};
+
+#endif   // QCAN_RECORDER_HPP_
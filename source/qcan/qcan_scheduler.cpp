@@ -0,0 +1,554 @@
+//============================================================================//
+// File:          qcan_scheduler.cpp                                          //
+// Description:   QCan classes - cyclic transmit scheduler                    //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include <QElapsedTimer>
+
+#include "qcan_scheduler.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// the thread waits for a new job up to this time in milliseconds
+// if no job is active
+//
+#define  SCHEDULER_IDLE_TIME     100
+
+//-------------------------------------------------------------------
+// index value for end of a job list
+//
+#define  SCHEDULER_JOB_NONE      ((int32_t) -1)
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanScheduler()                                                            //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanScheduler::QCanScheduler()
+{
+   clJobP.resize(QCAN_SCHEDULER_JOB_MAX);
+   ptsJobP = clJobP.data();
+   uqTickP = 0;
+   clearJobs();
+
+   pclInterfaceP  = Q_NULLPTR;
+   pclWriteMutexP = Q_NULLPTR;
+   ulRunP.store(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanScheduler()                                                           //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanScheduler::~QCanScheduler()
+{
+   setEnabled(false);
+}
+
+
+//----------------------------------------------------------------------------//
+// addJob()                                                                   //
+// add transmit job                                                           //
+//----------------------------------------------------------------------------//
+bool QCanScheduler::addJob(uint32_t ulOwnerV, uint8_t ubJobV,
+                           const QCanFrame & clFrameR, uint32_t ulPeriodV,
+                           uint32_t ulCountV, uint8_t ubIncPosV)
+{
+   int32_t  slJobIdxT;
+
+   if(ulPeriodV == 0)
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // an existing job with the same number is replaced
+   //
+   removeJob(ulOwnerV, ubJobV);
+
+   clJobMutexP.lock();
+   slJobIdxT = slFreeIdxP;
+   if(slJobIdxT == SCHEDULER_JOB_NONE)
+   {
+      clJobMutexP.unlock();
+      return(false);
+   }
+   slFreeIdxP = ptsJobP[slJobIdxT].slNextM;
+
+   QCanJob_ts & tsJobT = ptsJobP[slJobIdxT];
+   tsJobT.clFrameM  = clFrameR;
+   tsJobT.ulOwnerM  = ulOwnerV;
+   tsJobT.ubJobM    = ubJobV;
+   tsJobT.ubIncPosM = ubIncPosV;
+   tsJobT.ulCountM  = ulCountV;
+   tsJobT.btActiveM = true;
+
+   //----------------------------------------------------------------
+   // the period is rounded to the next tick, the minimum period
+   // is one tick
+   //
+   tsJobT.ulPeriodM = (ulPeriodV + (QCAN_SCHEDULER_TICK / 2)) / 
+                      QCAN_SCHEDULER_TICK;
+   if(tsJobT.ulPeriodM == 0)
+   {
+      tsJobT.ulPeriodM = 1;
+   }
+
+   insertJob(slJobIdxT, uqTickP);
+   ulJobCntP++;
+   clJobMutexP.unlock();
+
+   //----------------------------------------------------------------
+   // the thread waits for the first job
+   //
+   clJobEventP.wakeAll();
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// clearJobs()                                                                //
+// remove all jobs, the job mutex must be locked                              //
+//----------------------------------------------------------------------------//
+void QCanScheduler::clearJobs(void)
+{
+   int32_t  slIdxT;
+
+   for(slIdxT = 0; slIdxT < QCAN_SCHEDULER_SLOTS; slIdxT++)
+   {
+      aslSlotP[slIdxT] = SCHEDULER_JOB_NONE;
+   }
+
+   //----------------------------------------------------------------
+   // all jobs are linked to the free list
+   //
+   for(slIdxT = 0; slIdxT < QCAN_SCHEDULER_JOB_MAX; slIdxT++)
+   {
+      ptsJobP[slIdxT].btActiveM = false;
+      ptsJobP[slIdxT].slNextM   = slIdxT + 1;
+   }
+   ptsJobP[QCAN_SCHEDULER_JOB_MAX - 1].slNextM = SCHEDULER_JOB_NONE;
+   slFreeIdxP = 0;
+   ulJobCntP  = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// insertJob()                                                                //
+// add job to timer wheel, the job mutex must be locked                       //
+//----------------------------------------------------------------------------//
+void QCanScheduler::insertJob(int32_t slJobIdxV, uint64_t uqTickV)
+{
+   uint32_t ulSlotT;
+
+   //----------------------------------------------------------------
+   // the slot of the due tick is visited once per revolution of
+   // the wheel, the job is executed when no revolution is left
+   //
+   ulSlotT = (uint32_t) (uqTickV & (QCAN_SCHEDULER_SLOTS - 1));
+   ptsJobP[slJobIdxV].ulRoundsM = (uint32_t) ((uqTickV - uqTickP) / 
+                                              QCAN_SCHEDULER_SLOTS);
+   ptsJobP[slJobIdxV].slNextM   = aslSlotP[ulSlotT];
+   aslSlotP[ulSlotT] = slJobIdxV;
+}
+
+
+//----------------------------------------------------------------------------//
+// jobCount()                                                                 //
+// number of active jobs                                                      //
+//----------------------------------------------------------------------------//
+uint32_t QCanScheduler::jobCount(void)
+{
+   uint32_t ulCountT;
+
+   clJobMutexP.lock();
+   ulCountT = ulJobCntP;
+   clJobMutexP.unlock();
+
+   return(ulCountT);
+}
+
+
+//----------------------------------------------------------------------------//
+// processTick()                                                              //
+// execute all jobs of the next tick                                          //
+//----------------------------------------------------------------------------//
+uint32_t QCanScheduler::processTick(QVector<QCanFrame> & clFrameListR,
+                                   QVector<uint32_t> * pclOwnerListV)
+{
+   uint32_t ulSlotT;
+   uint32_t ulFrameCntT = 0;
+   int32_t  slJobIdxT;
+   int32_t  slNextIdxT;
+   uint8_t  ubIncPosT;
+
+   clJobMutexP.lock();
+
+   //----------------------------------------------------------------
+   // the job list of the slot is detached, jobs which stay in the
+   // slot are added to a new list
+   //
+   ulSlotT   = (uint32_t) (uqTickP & (QCAN_SCHEDULER_SLOTS - 1));
+   slJobIdxT = aslSlotP[ulSlotT];
+   aslSlotP[ulSlotT] = SCHEDULER_JOB_NONE;
+   uqTickP++;
+
+   while(slJobIdxT != SCHEDULER_JOB_NONE)
+   {
+      QCanJob_ts & tsJobT = ptsJobP[slJobIdxT];
+      slNextIdxT = tsJobT.slNextM;
+
+      if(tsJobT.btActiveM == false)
+      {
+         //-------------------------------------------------
+         // the job has been removed, release the entry
+         //
+         tsJobT.slNextM = slFreeIdxP;
+         slFreeIdxP     = slJobIdxT;
+      }
+      else if(tsJobT.ulRoundsM > 0)
+      {
+         //-------------------------------------------------
+         // the job is due in a later revolution
+         //
+         tsJobT.ulRoundsM--;
+         tsJobT.slNextM    = aslSlotP[ulSlotT];
+         aslSlotP[ulSlotT] = slJobIdxT;
+      }
+      else
+      {
+         clFrameListR.append(tsJobT.clFrameM);
+         if(pclOwnerListV != Q_NULLPTR)
+         {
+            pclOwnerListV->append(tsJobT.ulOwnerM);
+         }
+         ulFrameCntT++;
+
+         ubIncPosT = tsJobT.ubIncPosM;
+         if(ubIncPosT < tsJobT.clFrameM.dataSize())
+         {
+            tsJobT.clFrameM.setData(ubIncPosT, 
+                                    tsJobT.clFrameM.data(ubIncPosT) + 1);
+         }
+
+         //-------------------------------------------------
+         // a value of 0 for the counter transmits the frame
+         // until the job is removed
+         //
+         if((tsJobT.ulCountM > 0) && (--tsJobT.ulCountM == 0))
+         {
+            tsJobT.btActiveM = false;
+            tsJobT.slNextM   = slFreeIdxP;
+            slFreeIdxP       = slJobIdxT;
+            ulJobCntP--;
+         }
+         else
+         {
+            insertJob(slJobIdxT, uqTickP - 1 + tsJobT.ulPeriodM);
+         }
+      }
+
+      slJobIdxT = slNextIdxT;
+   }
+
+   //----------------------------------------------------------------
+   // removed jobs in other slots are released at once if no job
+   // is left
+   //
+   if(ulJobCntP == 0)
+   {
+      clearJobs();
+   }
+
+   clJobMutexP.unlock();
+
+   return(ulFrameCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// readFrame()                                                                //
+// read frame which has been written to the CAN interface                     //
+//----------------------------------------------------------------------------//
+bool QCanScheduler::readFrame(QByteArray & clDataR, uint32_t & ulOwnerR)
+{
+   return(clSentQueueP.pop(clDataR, &ulOwnerR));
+}
+
+
+//----------------------------------------------------------------------------//
+// removeJob()                                                                //
+// stop transmit job                                                          //
+//----------------------------------------------------------------------------//
+void QCanScheduler::removeJob(uint32_t ulOwnerV, uint8_t ubJobV)
+{
+   int32_t  slJobIdxT;
+
+   //----------------------------------------------------------------
+   // the job is marked inactive, the entry is released when the
+   // slot of the job is processed or when no job is left
+   //
+   clJobMutexP.lock();
+   for(slJobIdxT = 0; slJobIdxT < QCAN_SCHEDULER_JOB_MAX; slJobIdxT++)
+   {
+      QCanJob_ts & tsJobT = ptsJobP[slJobIdxT];
+      if((tsJobT.btActiveM == true) && (tsJobT.ulOwnerM == ulOwnerV) &&
+         (tsJobT.ubJobM == ubJobV))
+      {
+         tsJobT.btActiveM = false;
+         ulJobCntP--;
+         break;
+      }
+   }
+
+   if(ulJobCntP == 0)
+   {
+      clearJobs();
+   }
+   clJobMutexP.unlock();
+}
+
+
+//----------------------------------------------------------------------------//
+// removeJobs()                                                               //
+// stop all transmit jobs of owner                                            //
+//----------------------------------------------------------------------------//
+void QCanScheduler::removeJobs(uint32_t ulOwnerV)
+{
+   int32_t  slJobIdxT;
+
+   clJobMutexP.lock();
+   for(slJobIdxT = 0; slJobIdxT < QCAN_SCHEDULER_JOB_MAX; slJobIdxT++)
+   {
+      QCanJob_ts & tsJobT = ptsJobP[slJobIdxT];
+      if((tsJobT.btActiveM == true) && (tsJobT.ulOwnerM == ulOwnerV))
+      {
+         tsJobT.btActiveM = false;
+         ulJobCntP--;
+      }
+   }
+
+   if(ulJobCntP == 0)
+   {
+      clearJobs();
+   }
+   clJobMutexP.unlock();
+}
+
+
+//----------------------------------------------------------------------------//
+// run()                                                                      //
+// thread of scheduler                                                        //
+//----------------------------------------------------------------------------//
+void QCanScheduler::run(void)
+{
+   QElapsedTimer        clTimerT;
+   QVector<QCanFrame>   clFrameListT;
+   QVector<uint32_t>    clOwnerListT;
+   uint64_t             uqStartTickT;
+   uint64_t             uqNextTickT;
+   uint64_t             uqDueTickT;
+   int64_t              sqWaitT;
+
+   clFrameListT.reserve(QCAN_SCHEDULER_JOB_MAX);
+   clOwnerListT.reserve(QCAN_SCHEDULER_JOB_MAX);
+
+   clJobMutexP.lock();
+   uqStartTickT = uqTickP;
+   clJobMutexP.unlock();
+   uqNextTickT = uqStartTickT;
+   clTimerT.start();
+
+   while(ulRunP.load() != 0)
+   {
+      //--------------------------------------------------------
+      // without any job the thread waits, the time base starts
+      // again with the next job
+      //
+      clJobMutexP.lock();
+      if(ulJobCntP == 0)
+      {
+         clJobEventP.wait(&clJobMutexP, SCHEDULER_IDLE_TIME);
+         uqStartTickT = uqTickP;
+         uqNextTickT  = uqStartTickT;
+         clTimerT.restart();
+         clJobMutexP.unlock();
+         continue;
+      }
+      clJobMutexP.unlock();
+
+      //--------------------------------------------------------
+      // process all ticks which are due, the due time is
+      // calculated from the start, so the period does not drift
+      //
+      uqDueTickT = uqStartTickT + (uint64_t) clTimerT.nsecsElapsed() / 
+                                  (QCAN_SCHEDULER_TICK * 1000ULL);
+      while(uqNextTickT <= uqDueTickT)
+      {
+         processTick(clFrameListT, &clOwnerListT);
+         uqNextTickT++;
+      }
+
+      if(clFrameListT.isEmpty() == false)
+      {
+         writeFrames(clFrameListT, clOwnerListT);
+         clFrameListT.clear();
+         clOwnerListT.clear();
+      }
+
+      //--------------------------------------------------------
+      // sleep until the next tick is due
+      //
+      sqWaitT = (int64_t) (uqNextTickT - uqStartTickT) * 
+                QCAN_SCHEDULER_TICK * 1000LL;
+      sqWaitT = (sqWaitT - clTimerT.nsecsElapsed()) / 1000LL;
+      if(sqWaitT > 0)
+      {
+         QThread::usleep((unsigned long) sqWaitT);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setEnabled()                                                               //
+// start / stop thread                                                        //
+//----------------------------------------------------------------------------//
+void QCanScheduler::setEnabled(bool btEnableV)
+{
+   if(btEnableV == true)
+   {
+      if(isRunning() == false)
+      {
+         ulRunP.store(1);
+         start(QThread::TimeCriticalPriority);
+      }
+   }
+   else
+   {
+      if(isRunning())
+      {
+         ulRunP.store(0);
+         clJobEventP.wakeAll();
+         wait();
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setInterface()                                                             //
+// set CAN interface                                                          //
+//----------------------------------------------------------------------------//
+void QCanScheduler::setInterface(QCanInterface * pclCanIfV, QMutex * pclMutexV)
+{
+   bool  btRunningT;
+
+   //----------------------------------------------------------------
+   // stop a running thread before the interface is changed
+   //
+   btRunningT = isRunning();
+   setEnabled(false);
+
+   pclInterfaceP  = pclCanIfV;
+   pclWriteMutexP = pclMutexV;
+
+   setEnabled(btRunningT);
+}
+
+
+//----------------------------------------------------------------------------//
+// writeFrames()                                                              //
+// write due frames to CAN interface                                          //
+//----------------------------------------------------------------------------//
+void QCanScheduler::writeFrames(const QVector<QCanFrame> & clFrameListR,
+                                const QVector<uint32_t> & clOwnerListR)
+{
+   uint32_t ulWrittenT = 0;
+   uint32_t ulFrameIdxT;
+   int32_t  slSizeT;
+   bool     btSignalT;
+   char     achDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   //----------------------------------------------------------------
+   // on a virtual CAN network all frames are passed to the network
+   //
+   if(pclInterfaceP == Q_NULLPTR)
+   {
+      ulWrittenT = (uint32_t) clFrameListR.size();
+   }
+   else
+   {
+      if(pclWriteMutexP != Q_NULLPTR)
+      {
+         pclWriteMutexP->lock();
+      }
+      pclInterfaceP->writeBatch(clFrameListR.constData(), 
+                                (uint32_t) clFrameListR.size(), ulWrittenT);
+      if(pclWriteMutexP != Q_NULLPTR)
+      {
+         pclWriteMutexP->unlock();
+      }
+   }
+
+   //----------------------------------------------------------------
+   // pass the written frames to the network together with the
+   // owner of the job, the signal is only required if the network
+   // has read all previous frames
+   //
+   btSignalT = clSentQueueP.isEmpty();
+   for(ulFrameIdxT = 0; ulFrameIdxT < ulWrittenT; ulFrameIdxT++)
+   {
+      slSizeT = clFrameListR.at(ulFrameIdxT).toByteArray(&achDataT[0],
+                                                QCAN_FRAME_ARRAY_SIZE);
+      clSentQueueP.push(&achDataT[0], slSizeT, 
+                        clOwnerListR.at(ulFrameIdxT));
+   }
+
+   if((ulWrittenT > 0) && (btSignalT == true))
+   {
+      emit framesSent();
+   }
+}
@@ -0,0 +1,230 @@
+//============================================================================//
+// File:          qcan_scheduler.hpp                                          //
+// Description:   QCan classes - cyclic transmit scheduler                    //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+#ifndef QCAN_SCHEDULER_HPP_
+#define QCAN_SCHEDULER_HPP_
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "qcan_frame.hpp"
+#include "qcan_frame_queue.hpp"
+#include "qcan_interface.hpp"
+
+//-------------------------------------------------------------------
+/*!
+** \file qcan_scheduler.hpp
+**
+*/
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanScheduler
+** \brief   Cyclic transmit scheduler
+**
+** The QCanScheduler class transmits CAN frames periodically on a CAN
+** network. A QCanNetwork creates a transmit job for each API frame
+** of type QCanFrameApi::eAPI_FUNC_CYCLIC it receives from a socket.
+**
+** The jobs are kept in a timer wheel with #QCAN_SCHEDULER_SLOTS slots,
+** each slot covers #QCAN_SCHEDULER_TICK microseconds. A dedicated thread
+** processes the slots in the order of their due time, so adding,
+** removing and executing a job does not depend on the number of jobs.
+** The due time of a job is calculated from the start of the thread,
+** hence the period does not drift. All frames which are due within
+** one tick are written by QCanInterface::writeBatch(). Without a CAN
+** interface (virtual CAN network) the frames are only passed to the
+** network.
+**
+** Frames which are written to the CAN interface are also passed to
+** the network together with the owner of the job, they are read by
+** readFrame().
+*/
+class QCanScheduler : public QThread
+{
+   Q_OBJECT
+
+public:
+
+   QCanScheduler();
+
+   ~QCanScheduler();
+
+   /*!
+   ** \param[in]  ulOwnerV       Owner of the job
+   ** \param[in]  ubJobV         Job number
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  ulPeriodV      Period in microseconds
+   ** \param[in]  ulCountV       Number of transmissions, 0 = endless
+   ** \param[in]  ubIncPosV      Position of payload increment
+   ** \return     \c true if the job has been added
+   ** \see        removeJob()
+   **
+   ** Add a transmit job, the frame is transmitted with the next tick.
+   ** The period is rounded to a multiple of #QCAN_SCHEDULER_TICK. A
+   ** job is identified by its owner and its number, an existing job
+   ** is replaced. The function returns \c false if the period is 0
+   ** or if #QCAN_SCHEDULER_JOB_MAX jobs are active.
+   */
+   bool     addJob(uint32_t ulOwnerV, uint8_t ubJobV, 
+                   const QCanFrame & clFrameR, uint32_t ulPeriodV, 
+                   uint32_t ulCountV = 0,
+                   uint8_t ubIncPosV = QCAN_CYCLIC_NO_INCREMENT);
+
+   /*!
+   ** \return     Number of active jobs
+   */
+   uint32_t jobCount(void);
+
+   /*!
+   ** \param[out] clFrameListR   List of due frames
+   ** \param[out] pclOwnerListV  Pointer to list of job owners
+   ** \return     Number of due frames
+   **
+   ** Advance the timer wheel by one tick and append the frames which
+   ** are due to \c clFrameListR. The owner of each job is appended to
+   ** \c pclOwnerListV, if the pointer is not \c Q_NULLPTR. The
+   ** function is called by the thread of the scheduler, it does not
+   ** write to the CAN interface.
+   */
+   uint32_t processTick(QVector<QCanFrame> & clFrameListR,
+                        QVector<uint32_t> * pclOwnerListV = Q_NULLPTR);
+
+   /*!
+   ** \param[out] clDataR        Frame data
+   ** \param[out] ulOwnerR       Owner of the job
+   ** \return     \c true if a frame has been read
+   **
+   ** Read the next frame which has been written to the CAN interface,
+   ** the frame uses the fixed encoding. The function must only be 
+   ** called by one thread.
+   */
+   bool     readFrame(QByteArray & clDataR, uint32_t & ulOwnerR);
+
+   /*!
+   ** \param[in]  ulOwnerV       Owner of the job
+   ** \param[in]  ubJobV         Job number
+   ** \see        addJob()
+   **
+   ** Stop the transmit job \c ubJobV of \c ulOwnerV.
+   */
+   void     removeJob(uint32_t ulOwnerV, uint8_t ubJobV);
+
+   /*!
+   ** \param[in]  ulOwnerV       Owner of the jobs
+   **
+   ** Stop all transmit jobs of \c ulOwnerV.
+   */
+   void     removeJobs(uint32_t ulOwnerV);
+
+   /*!
+   ** \param[in]  btEnableV      \c true to start the thread
+   **
+   ** Start or stop the thread of the scheduler. Jobs are only
+   ** executed while the thread is running.
+   */
+   void     setEnabled(bool btEnableV);
+
+   /*!
+   ** \param[in]  pclCanIfV      Pointer to CAN interface
+   ** \param[in]  pclMutexV      Pointer to mutex for write access
+   **
+   ** Set the CAN interface for the transmit jobs, a value of
+   ** \c Q_NULLPTR removes the CAN interface. A running thread is
+   ** stopped while the interface is changed. The mutex \c pclMutexV
+   ** is locked for each write operation, so the CAN interface can 
+   ** also be written by another thread.
+   */
+   void     setInterface(QCanInterface * pclCanIfV, QMutex * pclMutexV);
+
+signals:
+
+   /*!
+   ** The signal is emitted if frames have been written to the CAN
+   ** interface while no frame was waiting to be read by readFrame().
+   */
+   void     framesSent(void);
+
+protected:
+
+   void     run(void) Q_DECL_OVERRIDE;
+
+private:
+
+   typedef struct QCanJob_s {
+      QCanFrame         clFrameM;      // frame to transmit
+      uint32_t          ulOwnerM;      // owner of job
+      uint32_t          ulPeriodM;     // period in ticks
+      uint32_t          ulCountM;      // remaining transmissions
+      uint32_t          ulRoundsM;     // remaining wheel revolutions
+      int32_t           slNextM;       // next job in slot / free list
+      uint8_t           ubJobM;        // job number
+      uint8_t           ubIncPosM;     // position of payload increment
+      bool              btActiveM;     // job is active
+   } QCanJob_ts;
+
+   void     clearJobs(void);
+   void     insertJob(int32_t slJobIdxV, uint64_t uqTickV);
+   void     writeFrames(const QVector<QCanFrame> & clFrameListR,
+                        const QVector<uint32_t> & clOwnerListR);
+
+   //----------------------------------------------------------------
+   // job table and timer wheel, each slot holds a list of jobs,
+   // protected by clJobMutexP
+   //
+   QVector<QCanJob_ts>        clJobP;
+   QCanJob_ts *               ptsJobP;
+   int32_t                    aslSlotP[QCAN_SCHEDULER_SLOTS];
+   int32_t                    slFreeIdxP;
+   uint32_t                   ulJobCntP;
+   uint64_t                   uqTickP;
+   QMutex                     clJobMutexP;
+   QWaitCondition             clJobEventP;
+
+   QCanInterface *            pclInterfaceP;
+   QMutex *                   pclWriteMutexP;
+   QCanFrameQueue             clSentQueueP;
+   QAtomicInteger<uint32_t>   ulRunP;
+};
+
+#endif   // QCAN_SCHEDULER_HPP_
@@ -34,6 +34,7 @@
 
 #include <QDebug>
 
+#include "qcan_interface.hpp"
 #include "qcan_server.hpp"
 
 
@@ -57,9 +58,11 @@
 //----------------------------------------------------------------------------//
 QCanServer::QCanServer( QObject * pclParentV,
                         uint16_t  uwPortStartV,
-                        uint8_t   ubNetworkNumV)
+                        uint8_t   ubNetworkNumV,
+                        bool      btThreadedV)
 {
    QCanNetwork *  pclCanNetT;
+   QThread *      pclThreadT;
 
    //----------------------------------------------------------------
    // set the parent
@@ -72,9 +75,44 @@ QCanServer::QCanServer( QObject * pclParentV,
    pclListNetsP = new QVector<QCanNetwork *>;
    pclListNetsP->reserve(ubNetworkNumV);
 
+   pclListThreadsP = new QVector<QThread *>;
+   btThreadedP     = btThreadedV;
+
+   //----------------------------------------------------------------
+   // signals of networks in a dispatcher thread are queued, the
+   // parameter types must be known to the meta-object system
+   //
+   if(btThreadedP)
+   {
+      pclListThreadsP->reserve(ubNetworkNumV);
+      qRegisterMetaType<int32_t>("int32_t");
+      qRegisterMetaType<uint8_t>("uint8_t");
+      qRegisterMetaType<uint32_t>("uint32_t");
+      qRegisterMetaType<QCanInterface *>("QCanInterface *");
+   }
+
    for(uint8_t ubNetCntT = 0; ubNetCntT < ubNetworkNumV; ubNetCntT++)
    {
-      pclCanNetT = new QCanNetwork(pclParentV, uwPortStartV + ubNetCntT);
+      if(btThreadedP)
+      {
+         //-----------------------------------------------------
+         // An object with a parent can not be moved to another
+         // thread, the network is deleted when its thread
+         // has finished.
+         //
+         pclCanNetT = new QCanNetwork(Q_NULLPTR, uwPortStartV + ubNetCntT);
+         pclThreadT = new QThread(this);
+         pclThreadT->setObjectName(pclCanNetT->name());
+         pclCanNetT->moveToThread(pclThreadT);
+         connect( pclThreadT, SIGNAL(finished()),
+                  pclCanNetT, SLOT(deleteLater()));
+         pclThreadT->start();
+         pclListThreadsP->append(pclThreadT);
+      }
+      else
+      {
+         pclCanNetT = new QCanNetwork(pclParentV, uwPortStartV + ubNetCntT);
+      }
       pclListNetsP->append(pclCanNetT);
 
    }
@@ -88,7 +126,20 @@ QCanServer::QCanServer( QObject * pclParentV,
 //----------------------------------------------------------------------------//
 QCanServer::~QCanServer()
 {
+   QThread *   pclThreadT;
+
+   //----------------------------------------------------------------
+   // stop all dispatcher threads, the networks are deleted
+   // when the thread has finished
+   //
+   for(int32_t slThreadIdxT = 0; slThreadIdxT < pclListThreadsP->size(); slThreadIdxT++)
+   {
+      pclThreadT = pclListThreadsP->at(slThreadIdxT);
+      pclThreadT->quit();
+      pclThreadT->wait();
+   }
 
+   delete(pclListThreadsP);
 }
 
 uint8_t QCanServer::maximumNetwork(void) const
@@ -36,6 +36,7 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 #include <QObject>
+#include <QThread>
 
 #include "qcan_network.hpp"
 
@@ -47,6 +48,11 @@
 **
 ** This class represents a CAN server, which incorporates up to
 ** QCAN_NETWORK_MAX number of CAN networks (QCanNetwork).
+** <p>
+** If the server is created with \c btThreadedV set to \c true, each
+** CAN network runs in a dedicated thread. The TCP server, the sockets
+** and the CAN interface of the network are handled in this thread, so
+** the networks do not block each other or the user interface.
 **
 */
 class QCanServer : public QObject
@@ -56,13 +62,16 @@ class QCanServer : public QObject
 public:
     QCanServer( QObject * pclParentV = Q_NULLPTR,
                 uint16_t  uwPortStartV = QCAN_TCP_DEFAULT_PORT,
-                uint8_t   ubNetworkNumV = QCAN_NETWORK_MAX);
+                uint8_t   ubNetworkNumV = QCAN_NETWORK_MAX,
+                bool      btThreadedV = false);
 
     ~QCanServer();
 
 
     uint32_t      dispatcherTime(void)    { return (ulDispatchTimeP);   };
 
+    bool          isThreaded(void)        { return (btThreadedP);       };
+
     QCanNetwork * network(uint8_t ubNetworkIdxV);
 
     uint8_t       maximumNetwork(void) const;
@@ -76,6 +85,8 @@ public:
 private:
 
     QVector<QCanNetwork *> *  pclListNetsP;
+    QVector<QThread *> *      pclListThreadsP;
+    bool                      btThreadedP;
     QHostAddress              clServerAddressP;
     uint32_t                  ulDispatchTimeP;
 };
@@ -0,0 +1,517 @@
+//============================================================================//
+// File:          qcan_shared_ring.cpp                                        //
+// Description:   QCan classes - shared memory frame ring                     //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include <atomic>
+#include <new>
+
+#include <string.h>
+
+#include "qcan_shared_ring.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// identifies a valid ring header ("QCRC"), the last character is
+// incremented when the layout of the segment changes
+//
+#define  QCAN_SHARED_RING_MAGIC     ((uint32_t) 0x51435243)
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanSharedRing()                                                           //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanSharedRing::QCanSharedRing()
+{
+   pclHeadP      = Q_NULLPTR;
+   ptsSlotP      = Q_NULLPTR;
+   ptsReaderP    = Q_NULLPTR;
+   ulReaderMaskP = 0;
+   ulClientIdP   = 0;
+   ulSlotMaskP   = 0;
+   ulLostCntP    = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanSharedRing()                                                          //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanSharedRing::~QCanSharedRing()
+{
+   detach();
+}
+
+
+//----------------------------------------------------------------------------//
+// attach()                                                                   //
+// attach to ring of existing segment for reading                             //
+//----------------------------------------------------------------------------//
+bool QCanSharedRing::attach(const QString & clKeyR, uint32_t ulClientIdV)
+{
+   QCanRingHead_ts * pclHeadT;
+   int32_t           slSizeT;
+   int32_t           slReaderT;
+
+   detach();
+
+   if(ulClientIdV == 0)
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // the reader publishes its read position in the segment, hence
+   // it needs write access
+   //
+   clShmP.setKey(clKeyR);
+   if(clShmP.attach() == false)
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // the segment must hold a valid header and all slots
+   //
+   pclHeadT = static_cast<QCanRingHead_ts *>(clShmP.data());
+   slSizeT  = clShmP.size();
+   if( (slSizeT < (int32_t) sizeof(QCanRingHead_ts))               ||
+       (pclHeadT->ulMagicM    != QCAN_SHARED_RING_MAGIC)          ||
+       (pclHeadT->ulSlotSizeM != sizeof(QCanRingSlot_ts))          ||
+       (pclHeadT->ulSlotCountM == 0)                              ||
+       ((pclHeadT->ulSlotCountM & (pclHeadT->ulSlotCountM - 1)) != 0) ||
+       (slSizeT < (int32_t) (sizeof(QCanRingHead_ts) + 
+                             (pclHeadT->ulSlotCountM * sizeof(QCanRingSlot_ts)))))
+   {
+      clShmP.detach();
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // claim a free reader entry, the read position is valid before
+   // the writer is able to find the entry
+   //
+   for(slReaderT = 0; slReaderT < QCAN_SHARED_RING_READERS; slReaderT++)
+   {
+      if(pclHeadT->atsReaderM[slReaderT].ulClientIdM.testAndSetOrdered(0, 
+                                                          ulClientIdV))
+      {
+         break;
+      }
+   }
+
+   if(slReaderT == QCAN_SHARED_RING_READERS)
+   {
+      clShmP.detach();
+      return(false);
+   }
+
+   pclHeadP      = pclHeadT;
+   ptsSlotP      = reinterpret_cast<QCanRingSlot_ts *>(pclHeadT + 1);
+   ptsReaderP    = &pclHeadT->atsReaderM[slReaderT];
+   ulReaderMaskP = ((uint32_t) 1) << slReaderT;
+   ulClientIdP   = ulClientIdV;
+   ulSlotMaskP   = pclHeadT->ulSlotCountM - 1;
+   ulLostCntP    = 0;
+   ptsReaderP->ulReadIdxM.storeRelease(pclHeadT->ulWriteIdxM.loadAcquire());
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// create()                                                                   //
+// create new segment for writing                                             //
+//----------------------------------------------------------------------------//
+bool QCanSharedRing::create(const QString & clKeyR, uint32_t ulSlotCountV)
+{
+   int32_t  slSizeT;
+
+   detach();
+
+   if((ulSlotCountV == 0) || ((ulSlotCountV & (ulSlotCountV - 1)) != 0))
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // On Unix systems the segment of a crashed process is not
+   // released, attaching and detaching releases it if there is
+   // no other process attached.
+   //
+   clShmP.setKey(clKeyR);
+   if(clShmP.attach() == true)
+   {
+      clShmP.detach();
+   }
+
+   slSizeT = sizeof(QCanRingHead_ts) + (ulSlotCountV * sizeof(QCanRingSlot_ts));
+   if(clShmP.create(slSizeT) == false)
+   {
+      return(false);
+   }
+
+   memset(clShmP.data(), 0, slSizeT);
+   pclHeadP = new (clShmP.data()) QCanRingHead_ts;
+   pclHeadP->ulSlotCountM = ulSlotCountV;
+   pclHeadP->ulSlotSizeM  = sizeof(QCanRingSlot_ts);
+   pclHeadP->ulWriteIdxM.storeRelease(0);
+   ptsSlotP      = reinterpret_cast<QCanRingSlot_ts *>(pclHeadP + 1);
+   ptsReaderP    = Q_NULLPTR;
+   ulReaderMaskP = 0;
+   ulClientIdP   = 0;
+   ulSlotMaskP   = ulSlotCountV - 1;
+   ulLostCntP    = 0;
+
+   //----------------------------------------------------------------
+   // the magic value is written last, a reader does not accept
+   // a segment which is not initialised completely
+   //
+   std::atomic_thread_fence(std::memory_order_release);
+   pclHeadP->ulMagicM = QCAN_SHARED_RING_MAGIC;
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// detach()                                                                   //
+// detach from shared memory segment                                          //
+//----------------------------------------------------------------------------//
+void QCanSharedRing::detach(void)
+{
+   //----------------------------------------------------------------
+   // the entry is only released if the writer did not assign it
+   // to another reader in the meantime
+   //
+   if(ptsReaderP != Q_NULLPTR)
+   {
+      ptsReaderP->ulClientIdM.testAndSetOrdered(ulClientIdP, 0);
+   }
+
+   if(clShmP.isAttached())
+   {
+      clShmP.detach();
+   }
+   pclHeadP      = Q_NULLPTR;
+   ptsSlotP      = Q_NULLPTR;
+   ptsReaderP    = Q_NULLPTR;
+   ulReaderMaskP = 0;
+   ulClientIdP   = 0;
+   ulSlotMaskP   = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// dropFrames()                                                               //
+// remove oldest unread frames of a reader                                    //
+//----------------------------------------------------------------------------//
+uint32_t QCanSharedRing::dropFrames(int32_t slReaderV, uint32_t ulFrameCntV)
+{
+   uint32_t             ulReadIdxT;
+   uint32_t             ulDropT;
+   QCanRingReader_ts *  ptsReaderT;
+
+   if((pclHeadP == Q_NULLPTR) || (slReaderV < 0) || 
+      (slReaderV >= QCAN_SHARED_RING_READERS))
+   {
+      return(0);
+   }
+
+   //----------------------------------------------------------------
+   // the reader may advance its read position at the same time,
+   // the read position is only moved forward
+   //
+   ptsReaderT = &pclHeadP->atsReaderM[slReaderV];
+   do
+   {
+      ulReadIdxT = ptsReaderT->ulReadIdxM.loadAcquire();
+      ulDropT    = pclHeadP->ulWriteIdxM.loadAcquire() - ulReadIdxT;
+      if(ulDropT > ulFrameCntV)
+      {
+         ulDropT = ulFrameCntV;
+      }
+   } while(ptsReaderT->ulReadIdxM.testAndSetOrdered(ulReadIdxT, 
+                                                    ulReadIdxT + ulDropT) == false);
+
+   return(ulDropT);
+}
+
+
+//----------------------------------------------------------------------------//
+// framesPending()                                                            //
+// number of unread frames                                                    //
+//----------------------------------------------------------------------------//
+uint32_t QCanSharedRing::framesPending(void) const
+{
+   uint32_t ulPendingT = 0;
+
+   if(ptsReaderP != Q_NULLPTR)
+   {
+      ulPendingT = pclHeadP->ulWriteIdxM.loadAcquire() - 
+                   ptsReaderP->ulReadIdxM.loadAcquire();
+      if(ulPendingT > (ulSlotMaskP + 1))
+      {
+         ulPendingT = ulSlotMaskP + 1;
+      }
+   }
+
+   return(ulPendingT);
+}
+
+
+//----------------------------------------------------------------------------//
+// read()                                                                     //
+// copy next frame from the ring                                              //
+//----------------------------------------------------------------------------//
+int32_t QCanSharedRing::read(uint32_t & ulSourceR, char * pchDataV, 
+                             int32_t slSizeV)
+{
+   uint32_t                ulReadIdxT;
+   uint32_t                ulWriteIdxT;
+   uint32_t                ulSkipMaskT;
+   int32_t                 slFrameSizeT;
+   const QCanRingSlot_ts * ptsSlotT;
+
+   if(ptsReaderP == Q_NULLPTR)
+   {
+      return(0);
+   }
+
+   while(true)
+   {
+      ulReadIdxT  = ptsReaderP->ulReadIdxM.loadAcquire();
+      ulWriteIdxT = pclHeadP->ulWriteIdxM.loadAcquire();
+      if(ulWriteIdxT == ulReadIdxT)
+      {
+         return(0);
+      }
+
+      //--------------------------------------------------------
+      // The writer is writing the slot of ulWriteIdxT, which
+      // is the same slot as ulWriteIdxT - slot count. Hence
+      // only the newer slots can be read.
+      //
+      if((ulWriteIdxT - ulReadIdxT) > ulSlotMaskP)
+      {
+         if(ptsReaderP->ulReadIdxM.testAndSetOrdered(ulReadIdxT, 
+                                          ulWriteIdxT - ulSlotMaskP))
+         {
+            ulLostCntP += (ulWriteIdxT - ulReadIdxT) - ulSlotMaskP;
+         }
+         continue;
+      }
+
+      ptsSlotT     = &ptsSlotP[ulReadIdxT & ulSlotMaskP];
+      ulSourceR    = ptsSlotT->ulSourceM;
+      ulSkipMaskT  = ptsSlotT->ulSkipMaskM;
+      slFrameSizeT = ptsSlotT->slSizeM;
+      if((slFrameSizeT < 0) || (slFrameSizeT > slSizeV) ||
+         (slFrameSizeT > QCAN_FRAME_ARRAY_SIZE) ||
+         ((ulSkipMaskT & ulReaderMaskP) != 0))
+      {
+         slFrameSizeT = 0;
+      }
+      memcpy(pchDataV, &ptsSlotT->achDataM[0], slFrameSizeT);
+
+      //--------------------------------------------------------
+      // the copy is only valid if the writer did not start to
+      // overwrite the slot in the meantime
+      //
+      std::atomic_thread_fence(std::memory_order_acquire);
+      ulWriteIdxT = pclHeadP->ulWriteIdxM.load();
+      if((ulWriteIdxT - ulReadIdxT) > ulSlotMaskP)
+      {
+         if(ptsReaderP->ulReadIdxM.testAndSetOrdered(ulReadIdxT, 
+                                                     ulReadIdxT + 1))
+         {
+            ulLostCntP++;
+         }
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // the frame is discarded if the writer has removed it
+      // by dropFrames() in the meantime
+      //
+      if(ptsReaderP->ulReadIdxM.testAndSetOrdered(ulReadIdxT, 
+                                                  ulReadIdxT + 1) == false)
+      {
+         continue;
+      }
+
+      if(slFrameSizeT > 0)
+      {
+         return(slFrameSizeT);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// readerIndex()                                                              //
+// index of reader entry                                                      //
+//----------------------------------------------------------------------------//
+int32_t QCanSharedRing::readerIndex(uint32_t ulClientIdV) const
+{
+   int32_t  slReaderT;
+
+   if((pclHeadP != Q_NULLPTR) && (ulClientIdV != 0))
+   {
+      for(slReaderT = 0; slReaderT < QCAN_SHARED_RING_READERS; slReaderT++)
+      {
+         if(pclHeadP->atsReaderM[slReaderT].ulClientIdM.loadAcquire() == 
+            ulClientIdV)
+         {
+            return(slReaderT);
+         }
+      }
+   }
+
+   return(-1);
+}
+
+
+//----------------------------------------------------------------------------//
+// readerLag()                                                                //
+// number of frames not read by a reader                                      //
+//----------------------------------------------------------------------------//
+uint32_t QCanSharedRing::readerLag(int32_t slReaderV) const
+{
+   uint32_t ulLagT = 0;
+
+   if((pclHeadP != Q_NULLPTR) && (slReaderV >= 0) && 
+      (slReaderV < QCAN_SHARED_RING_READERS))
+   {
+      ulLagT = pclHeadP->ulWriteIdxM.loadAcquire() - 
+               pclHeadP->atsReaderM[slReaderV].ulReadIdxM.loadAcquire();
+      if(ulLagT > (ulSlotMaskP + 1))
+      {
+         ulLagT = ulSlotMaskP + 1;
+      }
+   }
+
+   return(ulLagT);
+}
+
+
+//----------------------------------------------------------------------------//
+// releaseReader()                                                            //
+// release entry of a reader                                                  //
+//----------------------------------------------------------------------------//
+void QCanSharedRing::releaseReader(uint32_t ulClientIdV)
+{
+   int32_t  slReaderT;
+
+   slReaderT = readerIndex(ulClientIdV);
+   if(slReaderT >= 0)
+   {
+      pclHeadP->atsReaderM[slReaderT].ulClientIdM.testAndSetOrdered(ulClientIdV,
+                                                                    0);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setReadIndex()                                                             //
+// set read position                                                          //
+//----------------------------------------------------------------------------//
+void QCanSharedRing::setReadIndex(uint32_t ulIndexV)
+{
+   if(ptsReaderP != Q_NULLPTR)
+   {
+      ptsReaderP->ulReadIdxM.storeRelease(ulIndexV);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// write()                                                                    //
+// copy frame to the next slot and publish it                                 //
+//----------------------------------------------------------------------------//
+bool QCanSharedRing::write(uint32_t ulSourceV, const char * pchDataV,
+                           int32_t slSizeV, uint32_t ulSkipMaskV)
+{
+   uint32_t          ulWriteIdxT;
+   QCanRingSlot_ts * ptsSlotT;
+
+   if((pclHeadP == Q_NULLPTR) || (slSizeV <= 0) || 
+      (slSizeV > QCAN_FRAME_ARRAY_SIZE))
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // There is only one writer, the write position is published
+   // after the slot has been written. The fence makes sure that a
+   // reader which sees a part of the new slot content also sees
+   // the write position which marks the old content as invalid.
+   //
+   ulWriteIdxT = pclHeadP->ulWriteIdxM.load();
+   ptsSlotT    = &ptsSlotP[ulWriteIdxT & ulSlotMaskP];
+   std::atomic_thread_fence(std::memory_order_release);
+   ptsSlotT->ulSourceM   = ulSourceV;
+   ptsSlotT->ulSkipMaskM = ulSkipMaskV;
+   ptsSlotT->slSizeM     = slSizeV;
+   memcpy(&ptsSlotT->achDataM[0], pchDataV, slSizeV);
+   pclHeadP->ulWriteIdxM.storeRelease(ulWriteIdxT + 1);
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// writeIndex()                                                               //
+// current write position                                                     //
+//----------------------------------------------------------------------------//
+uint32_t QCanSharedRing::writeIndex(void) const
+{
+   uint32_t ulWriteIdxT = 0;
+
+   if(pclHeadP != Q_NULLPTR)
+   {
+      ulWriteIdxT = pclHeadP->ulWriteIdxM.loadAcquire();
+   }
+
+   return(ulWriteIdxT);
+}
@@ -0,0 +1,261 @@
+//============================================================================//
+// File:          qcan_shared_ring.hpp                                        //
+// Description:   QCan classes - shared memory frame ring                     //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_SHARED_RING_HPP_
+#define QCAN_SHARED_RING_HPP_
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QAtomicInteger>
+#include <QSharedMemory>
+#include <QString>
+
+#include "qcan_data.hpp"
+
+//-------------------------------------------------------------------
+/*!
+** \file qcan_shared_ring.hpp
+**
+*/
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanSharedRing
+** \brief   Shared memory frame ring
+**
+** The QCanSharedRing class places a ring of frame slots into a shared
+** memory segment. There is exactly one writer, the QCanNetwork, which
+** creates the segment by calling create(). Any number of readers attach
+** to the segment by calling attach(), each reader keeps its own read
+** position. Hence a frame is written only once, independent of the
+** number of readers.
+** <p>
+** The writer never waits for a reader: a reader which is too slow 
+** loses the oldest frames, the number of lost frames is reported by
+** lostFrames(). A slot is copied by the reader and checked afterwards,
+** a slot which has been overwritten during the copy is discarded.
+** <p>
+** The read position of each reader is kept in the segment, so the
+** writer is able to check how far a reader lags behind (refer to
+** readerLag()) and to apply its send policy: it may remove the oldest
+** frames of a reader by dropFrames() or mark a frame to be skipped by
+** single readers when calling write().
+*/
+class QCanSharedRing
+{
+public:
+
+   /*!
+   ** Construct a ring which is not attached to a shared memory segment.
+   */
+   QCanSharedRing();
+
+   ~QCanSharedRing();
+
+   /*!
+   ** \param[in]  clKeyR         Key of shared memory segment
+   ** \param[in]  ulClientIdV    Unique ID of reader, must not be 0
+   ** \return     \c true if the ring has been attached
+   ** \see        create()
+   **
+   ** Attach to the ring of an existing segment for reading. The read
+   ** position is set to the current write position. The function
+   ** fails if #QCAN_SHARED_RING_READERS readers are attached already.
+   */
+   bool     attach(const QString & clKeyR, uint32_t ulClientIdV);
+
+   /*!
+   ** \param[in]  clKeyR         Key of shared memory segment
+   ** \param[in]  ulSlotCountV   Number of slots, must be a power of 2
+   ** \return     \c true if the ring has been created
+   ** \see        attach()
+   **
+   ** Create a new shared memory segment for writing. A segment of a 
+   ** previous process with the same key is released before.
+   */
+   bool     create(const QString & clKeyR, 
+                   uint32_t ulSlotCountV = QCAN_SHARED_RING_SLOTS);
+
+   /*!
+   ** Detach from the shared memory segment.
+   */
+   void     detach(void);
+
+   /*!
+   ** \param[in]  slReaderV      Index of reader
+   ** \param[in]  ulFrameCntV    Number of frames
+   ** \return     Number of frames removed
+   ** \see        readerIndex()
+   **
+   ** Remove the oldest unread frames of a reader, the function is
+   ** called by the writer.
+   */
+   uint32_t dropFrames(int32_t slReaderV, uint32_t ulFrameCntV);
+
+   /*!
+   ** \return     Number of unread frames
+   **
+   ** The value includes frames which are discarded by the reader later,
+   ** e.g. frames of the reader itself.
+   */
+   uint32_t framesPending(void) const;
+
+   /*!
+   ** \return     \c true if attached to a shared memory segment
+   */
+   inline bool isAttached(void) const  { return(pclHeadP != Q_NULLPTR); };
+
+   /*!
+   ** \return     Key of the shared memory segment
+   */
+   inline QString key(void) const      { return(clShmP.key());          };
+
+   /*!
+   ** \return     Number of frames lost by this reader
+   */
+   inline uint32_t lostFrames(void) const { return(ulLostCntP);         };
+
+   /*!
+   ** \param[out] ulSourceR      Source of the frame
+   ** \param[out] pchDataV       Pointer to buffer
+   ** \param[in]  slSizeV        Size of buffer
+   ** \return     Size of the frame, 0 if no frame is available
+   ** \see        write()
+   **
+   ** Read the next frame from the ring into the buffer \a pchDataV.
+   ** Frames which are marked to be skipped by this reader are not
+   ** returned.
+   */
+   int32_t  read(uint32_t & ulSourceR, char * pchDataV, int32_t slSizeV);
+
+   /*!
+   ** \param[in]  ulClientIdV    Unique ID of reader
+   ** \return     Index of reader, -1 if the reader is not attached
+   **
+   ** The index of a reader is used by the writer for the functions
+   ** dropFrames(), readerLag() and write().
+   */
+   int32_t  readerIndex(uint32_t ulClientIdV) const;
+
+   /*!
+   ** \param[in]  slReaderV      Index of reader
+   ** \return     Number of frames not read by the reader
+   ** \see        readerIndex()
+   */
+   uint32_t readerLag(int32_t slReaderV) const;
+
+   /*!
+   ** \param[in]  ulClientIdV    Unique ID of reader
+   **
+   ** Release the entry of a reader, e.g. after the connection to the
+   ** reader has been closed. The function is called by the writer.
+   */
+   void     releaseReader(uint32_t ulClientIdV);
+
+   /*!
+   ** \param[in]  ulIndexV       Read position
+   **
+   ** Set the read position, e.g. to a value of writeIndex() which has
+   ** been transferred by the writer.
+   */
+   void     setReadIndex(uint32_t ulIndexV);
+
+   /*!
+   ** \return     Number of slots
+   */
+   inline uint32_t slotCount(void) const { return(ulSlotMaskP + 1);     };
+
+   /*!
+   ** \param[in]  ulSourceV      Source of the frame
+   ** \param[in]  pchDataV       Pointer to frame data
+   ** \param[in]  slSizeV        Size of frame data
+   ** \param[in]  ulSkipMaskV    Readers which skip the frame
+   ** \return     \c true if the frame has been written
+   ** \see        read()
+   **
+   ** Write a frame to the ring, the size of the frame is limited to
+   ** QCAN_FRAME_ARRAY_SIZE. Bit n of \a ulSkipMaskV marks the frame to
+   ** be skipped by the reader with index n, refer to readerIndex().
+   */
+   bool     write(uint32_t ulSourceV, const char * pchDataV, int32_t slSizeV,
+                  uint32_t ulSkipMaskV = 0);
+
+   /*!
+   ** \return     Current write position
+   */
+   uint32_t writeIndex(void) const;
+
+private:
+
+   //-------------------------------------------------------------------
+   // entry of a reader, the read position is modified by the reader
+   // and by dropFrames() of the writer
+   //
+   typedef struct QCanRingReader_s {
+      QAtomicInteger<uint32_t>   ulClientIdM;
+      QAtomicInteger<uint32_t>   ulReadIdxM;
+   } QCanRingReader_ts;
+
+   //-------------------------------------------------------------------
+   // header at the start of the segment, it is followed by the slots
+   //
+   typedef struct QCanRingHead_s {
+      uint32_t                   ulMagicM;
+      uint32_t                   ulSlotCountM;
+      uint32_t                   ulSlotSizeM;
+      QAtomicInteger<uint32_t>   ulWriteIdxM;
+      QCanRingReader_ts          atsReaderM[QCAN_SHARED_RING_READERS];
+   } QCanRingHead_ts;
+
+   typedef struct QCanRingSlot_s {
+      uint32_t                   ulSourceM;
+      uint32_t                   ulSkipMaskM;
+      int32_t                    slSizeM;
+      char                       achDataM[QCAN_FRAME_ARRAY_SIZE];
+   } QCanRingSlot_ts;
+
+   QSharedMemory                 clShmP;
+   QCanRingHead_ts *             pclHeadP;
+   QCanRingSlot_ts *             ptsSlotP;
+   QCanRingReader_ts *           ptsReaderP;
+   uint32_t                      ulReaderMaskP;
+   uint32_t                      ulClientIdP;
+   uint32_t                      ulSlotMaskP;
+   uint32_t                      ulLostCntP;
+};
+
+#endif   // QCAN_SHARED_RING_HPP_
@@ -67,6 +67,17 @@ QCanSocket::QCanSocket(QObject * pclParentV)
    //
    pclTcpSockP = new QTcpSocket(this);
    btIsConnectedP = false;
+   ubWireFormatP  = 0;
+
+   //----------------------------------------------------------------
+   // the shared memory ring is attached during the connection
+   // handshake, new frames of the ring are signalled by the
+   // QCanNetwork via the connection
+   //
+   ulShmClientIdP  = 0;
+   btShmActiveP    = false;
+   btShmEnabledP   = true;
+   ubFilterCntP    = 0;
 
    //----------------------------------------------------------------
    // set default values for host address and port
@@ -74,6 +85,16 @@ QCanSocket::QCanSocket(QObject * pclParentV)
    clTcpHostAddrP = QHostAddress(QHostAddress::LocalHost);
    uwTcpPortP = QCAN_TCP_DEFAULT_PORT;
 
+   //----------------------------------------------------------------
+   // the local socket is used for a network on the same host,
+   // the TCP socket is the default
+   //
+   pclLocalSockP   = new QLocalSocket(this);
+   pclSockP        = pclTcpSockP;
+   uwNetPortP    = 0;
+   btLocalActiveP  = false;
+   btLocalEnabledP = true;
+
    //----------------------------------------------------------------
    // make signal / slot connection for TCP socket
    //
@@ -88,13 +109,45 @@ QCanSocket::QCanSocket(QObject * pclParentV)
 
    connect( pclTcpSockP, SIGNAL(readyRead()),
             this, SLOT(onSocketReceive()));
+
+   //----------------------------------------------------------------
+   // make signal / slot connection for local socket
+   //
+   connect( pclLocalSockP, SIGNAL(connected()),
+            this, SLOT(onSocketConnect()));
+
+   connect( pclLocalSockP, SIGNAL(disconnected()),
+            this, SLOT(onSocketDisconnect()));
+
+   connect( pclLocalSockP, SIGNAL(error(QLocalSocket::LocalSocketError)),
+            this, SLOT(onLocalError(QLocalSocket::LocalSocketError)));
+
+   connect( pclLocalSockP, SIGNAL(readyRead()),
+            this, SLOT(onSocketReceive()));
 }
 
 
 QCanSocket::~QCanSocket()
 {
    delete(pclTcpSockP);
+   delete(pclLocalSockP);
+}
 
+
+//----------------------------------------------------------------------------//
+// bytesToWrite()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int64_t QCanSocket::bytesToWrite(void) const
+{
+   int64_t  sqBytesT = 0;
+
+   if(btIsConnectedP == true)
+   {
+      sqBytesT = pclSockP->bytesToWrite();
+   }
+
+   return(sqBytesT);
 }
 
 
@@ -114,7 +167,26 @@ bool QCanSocket::connectNetwork(CAN_Channel_e ubChannelV)
       qDebug() << "QCanSocket::connectNetwork() " << ubChannelV;
 
       pclTcpSockP->abort();
-      pclTcpSockP->connectToHost(clTcpHostAddrP, uwTcpPortP + ubChannelV - 1);
+      pclLocalSockP->abort();
+
+      //--------------------------------------------------------
+      // a network on the same host is connected via its local
+      // server, onLocalError() falls back to TCP on failure
+      //
+      uwNetPortP = uwTcpPortP + ubChannelV - 1;
+      if((btLocalEnabledP == true) && (clTcpHostAddrP.isLoopback() == true))
+      {
+         pclSockP       = pclLocalSockP;
+         btLocalActiveP = true;
+         pclLocalSockP->connectToServer(QCAN_LOCAL_SERVER_NAME +
+                                        QString::number(uwNetPortP));
+      }
+      else
+      {
+         pclSockP       = pclTcpSockP;
+         btLocalActiveP = false;
+         pclTcpSockP->connectToHost(clTcpHostAddrP, uwNetPortP);
+      }
       btResultT = true;
    }
 
@@ -129,7 +201,14 @@ bool QCanSocket::connectNetwork(CAN_Channel_e ubChannelV)
 void QCanSocket::disconnectNetwork(void)
 {
    qDebug() << "QCanSocket::disconnectNetwork() ";
-   pclTcpSockP->disconnectFromHost();
+   if(btLocalActiveP == true)
+   {
+      pclLocalSockP->disconnectFromServer();
+   }
+   else
+   {
+      pclTcpSockP->disconnectFromHost();
+   }
 }
 
 
@@ -149,7 +228,7 @@ QAbstractSocket::SocketError QCanSocket::error() const
 //----------------------------------------------------------------------------//
 QString QCanSocket::errorString() const
 {
-   return(pclTcpSockP->errorString());
+   return(pclSockP->errorString());
 }
 
 
@@ -159,11 +238,142 @@ QString QCanSocket::errorString() const
 //----------------------------------------------------------------------------//
 int32_t QCanSocket::framesAvailable(void) const
 {
-   uint32_t    ulFrameCountT;
+   int32_t     slFrameCountT = 0;
+   int32_t     slFrameSizeT;
+   int32_t     slPosT = 0;
+   QByteArray  clDataT;
+
+   //----------------------------------------------------------------
+   // the frames may have different size (compact encoding), count
+   // all complete frames in the receive buffer, notifications of
+   // the shared memory ring are not passed to the application
+   //
+   clDataT = pclSockP->peek(pclSockP->bytesAvailable());
+   while(slPosT < clDataT.size())
+   {
+      slFrameSizeT = QCanData::byteArraySize(clDataT.constData() + slPosT,
+                                             clDataT.size() - slPosT);
+      if((slFrameSizeT == 0) || ((slPosT + slFrameSizeT) > clDataT.size()))
+      {
+         break;
+      }
+      if(isNotify(clDataT.constData() + slPosT, slFrameSizeT) == false)
+      {
+         slFrameCountT++;
+      }
+      slPosT = slPosT + slFrameSizeT;
+   }
+
+   //----------------------------------------------------------------
+   // frames of the shared memory ring, the value includes frames
+   // which are skipped by the socket
+   //
+   if(btShmActiveP == true)
+   {
+      slFrameCountT += clShmRingP.framesPending();
+   }
+
+   return(slFrameCountT);
+}
+
+
+//----------------------------------------------------------------------------//
+// nextFrameSize()                                                            //
+// size of next frame in receive buffer, 0 if not complete                    //
+//----------------------------------------------------------------------------//
+int32_t QCanSocket::nextFrameSize(void) const
+{
+   int32_t  slFrameSizeT;
+   int32_t  slHeadSizeT;
+   char     achHeadT[QCAN_FRAME_COMPACT_HEADER];
+
+   slHeadSizeT  = pclSockP->peek(&achHeadT[0], QCAN_FRAME_COMPACT_HEADER);
+   slFrameSizeT = QCanData::byteArraySize(&achHeadT[0], slHeadSizeT);
+   if(pclSockP->bytesAvailable() < slFrameSizeT)
+   {
+      slFrameSizeT = 0;
+   }
+
+   return(slFrameSizeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkApiFrame()                                                            //
+// answer wire format and shared memory offer of CAN network                  //
+//----------------------------------------------------------------------------//
+void QCanSocket::checkApiFrame(const char * pchDataV, int32_t slSizeV)
+{
+   QCanFrameApi   clFrameApiT;
+   uint8_t        ubFormatT;
+   char           achFixedT[QCAN_FRAME_ARRAY_SIZE];
+
+   if(clFrameApiT.fromByteArray(pchDataV, slSizeV) == true)
+   {
+      if(clFrameApiT.function() == QCanFrameApi::eAPI_FUNC_SHARED_MEMORY)
+      {
+         checkSharedMemory(clFrameApiT);
+      }
+      else if(clFrameApiT.wireFormat(ubFormatT) == true)
+      {
+         //--------------------------------------------------------
+         // the selection is the last frame in fixed encoding
+         //
+         ubWireFormatP = 0;
+         clFrameApiT.setWireFormat(ubFormatT & QCAN_WIRE_FORMAT_MASK);
+         writeData(&achFixedT[0],
+                   clFrameApiT.toByteArray(&achFixedT[0], QCAN_FRAME_ARRAY_SIZE));
+         ubWireFormatP = ubFormatT & QCAN_WIRE_FORMAT_MASK;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// checkSharedMemory()                                                        //
+// attach to shared memory ring of CAN network                                //
+//----------------------------------------------------------------------------//
+void QCanSocket::checkSharedMemory(QCanFrameApi & clFrameApiR)
+{
+   QCanFrameApi::SharedMemory_e  teStepT;
+   uint32_t                      ulValueT;
+   QString                       clKeyT;
 
+   clFrameApiR.sharedMemory(teStepT, ulValueT, clKeyT);
+   switch(teStepT)
+   {
+      //-----------------------------------------------------
+      // the ring is only used for a network on the same host
+      //
+      case QCanFrameApi::eSHM_OFFER:
+         if((btShmEnabledP == true) && (clTcpHostAddrP.isLoopback() == true))
+         {
+            if(clShmRingP.attach(clKeyT, ulValueT) == true)
+            {
+               ulShmClientIdP = ulValueT;
+               clFrameApiR.setSharedMemory(QCanFrameApi::eSHM_ATTACH,
+                                           ulValueT, clKeyT);
+               writeFrame(clFrameApiR);
+            }
+         }
+         break;
 
-   ulFrameCountT = pclTcpSockP->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE;
-   return(ulFrameCountT);
+      //-----------------------------------------------------
+      // All frames up to this point have been received via
+      // TCP, the ring is read from the given position on.
+      //
+      case QCanFrameApi::eSHM_START:
+         if((clShmRingP.isAttached() == true) && (clKeyT == clShmRingP.key()))
+         {
+            clShmRingP.setReadIndex(ulValueT);
+            btShmActiveP = true;
+         }
+         break;
+
+      default:
+
+         break;
+   }
 }
 
 
@@ -177,6 +387,58 @@ bool QCanSocket::isConnected(void)
 }
 
 
+//----------------------------------------------------------------------------//
+// isNotify()                                                                 //
+// check for notification of the shared memory ring                           //
+//----------------------------------------------------------------------------//
+bool QCanSocket::isNotify(const char * pchDataV, int32_t slSizeV)
+{
+   bool                          btResultT = false;
+   QCanFrameApi                  clFrameApiT;
+   QCanFrameApi::SharedMemory_e  teStepT;
+   uint32_t                      ulValueT;
+   QString                       clKeyT;
+
+   if((slSizeV > 0) && ((pchDataV[0] & 0xC0) == 0x40))
+   {
+      if((clFrameApiT.fromByteArray(pchDataV, slSizeV) == true) &&
+         (clFrameApiT.sharedMemory(teStepT, ulValueT, clKeyT) == true))
+      {
+         btResultT = (teStepT == QCanFrameApi::eSHM_NOTIFY);
+      }
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// onLocalError()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::onLocalError(QLocalSocket::LocalSocketError teSocketErrorV)
+{
+   //----------------------------------------------------------------
+   // The local server of the network is not available, so try
+   // to connect via TCP.
+   //
+   if(btIsConnectedP == false)
+   {
+      pclLocalSockP->abort();
+      pclSockP       = pclTcpSockP;
+      btLocalActiveP = false;
+      pclTcpSockP->connectToHost(clTcpHostAddrP, uwNetPortP);
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // the error codes of QLocalSocket are the same as the codes
+   // of QAbstractSocket
+   //
+   onSocketError((QAbstractSocket::SocketError) teSocketErrorV);
+}
+
+
 //----------------------------------------------------------------------------//
 // onSocketConnect()                                                          //
 //                                                                            //
@@ -190,6 +452,10 @@ void QCanSocket::onSocketConnect(void)
    // variable
    //
    btIsConnectedP = true;
+   ubWireFormatP  = 0;
+   btShmActiveP   = false;
+   ubFilterCntP   = 0;
+   clFilterP.clear();
    emit connected();
 }
 
@@ -207,6 +473,13 @@ void QCanSocket::onSocketDisconnect(void)
    // variable
    //
    btIsConnectedP = false;
+
+   //----------------------------------------------------------------
+   // release the shared memory ring
+   //
+   clShmRingP.detach();
+   btShmActiveP = false;
+
    emit disconnected();
 }
 
@@ -226,7 +499,14 @@ void QCanSocket::onSocketError(QAbstractSocket::SocketError teSocketErrorV)
       //
       case QAbstractSocket::RemoteHostClosedError:
       case QAbstractSocket::NetworkError:
-         pclTcpSockP->abort();
+         if(btLocalActiveP == true)
+         {
+            pclLocalSockP->abort();
+         }
+         else
+         {
+            pclTcpSockP->abort();
+         }
          btIsConnectedP = false;
          emit disconnected();
          break;
@@ -253,21 +533,46 @@ void QCanSocket::onSocketReceive(void)
 {
    uint32_t    ulFrameCountT;
 
-   ulFrameCountT = pclTcpSockP->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE;
+   ulFrameCountT = framesAvailable();
    framesReceived(ulFrameCountT);
 }
 
 bool QCanSocket::read(QByteArray & clFrameDataR, 
                       QCanData::Type_e * pubFrameTypeV)
 {
-   bool  btResultT = false;
+   bool     btResultT = false;
+   int32_t  slFrameSizeT;
+   char     achDatagramT[QCAN_FRAME_ARRAY_SIZE];
+
+   //----------------------------------------------------------------
+   // the TCP connection is read first, it holds the API frames and
+   // all frames received before the shared memory ring was started
+   //
+   if(btShmActiveP == true)
+   {
+      skipNotify();
+   }
+   slFrameSizeT = nextFrameSize();
+   if(slFrameSizeT > 0)
+   {
+      clFrameDataR.resize(slFrameSizeT);
+      pclSockP->read(clFrameDataR.data(), slFrameSizeT);
+      checkApiFrame(clFrameDataR.constData(), slFrameSizeT);
+   }
+   else if(btShmActiveP == true)
+   {
+      slFrameSizeT = readShared(&achDatagramT[0], QCAN_FRAME_ARRAY_SIZE);
+      if(slFrameSizeT > 0)
+      {
+         clFrameDataR = QByteArray(&achDatagramT[0], slFrameSizeT);
+      }
+   }
 
-   if(framesAvailable() > 0)
+   if(slFrameSizeT > 0)
    {
-      clFrameDataR = pclTcpSockP->read(QCAN_FRAME_ARRAY_SIZE);
       if (pubFrameTypeV != Q_NULLPTR)
       {
-         switch(clFrameDataR.at(0) & 0xE0)
+         switch(clFrameDataR.at(0) & 0xC0)
          {
             case 0x00:
                *pubFrameTypeV = QCanData::eTYPE_CAN;
@@ -299,18 +604,118 @@ bool QCanSocket::read(QByteArray & clFrameDataR,
 //----------------------------------------------------------------------------//
 bool QCanSocket::readFrame(QCanFrame & clFrameR)
 {
-   bool  btResultT = false;
-   QByteArray  clDatagramT;
+   bool        btResultT = false;
+   int32_t     slFrameSizeT;
+   char        achDatagramT[QCAN_FRAME_ARRAY_SIZE];
 
-   if(framesAvailable() > 0)
+   //----------------------------------------------------------------
+   // the frame is read into a buffer on the stack, no memory is
+   // allocated on this path
+   //
+   if(btShmActiveP == true)
+   {
+      skipNotify();
+   }
+   slFrameSizeT = nextFrameSize();
+   if(slFrameSizeT > 0)
    {
-      clDatagramT = pclTcpSockP->read(QCAN_FRAME_ARRAY_SIZE);
-      btResultT = clFrameR.fromByteArray(clDatagramT);
+      pclSockP->read(&achDatagramT[0], slFrameSizeT);
+      checkApiFrame(&achDatagramT[0], slFrameSizeT);
+      btResultT = clFrameR.fromByteArray(&achDatagramT[0], slFrameSizeT);
+   }
+   else if(btShmActiveP == true)
+   {
+      slFrameSizeT = readShared(&achDatagramT[0], QCAN_FRAME_ARRAY_SIZE);
+      if(slFrameSizeT > 0)
+      {
+         btResultT = clFrameR.fromByteArray(&achDatagramT[0], slFrameSizeT);
+      }
    }
    return(btResultT);
 }
 
 
+//----------------------------------------------------------------------------//
+// readShared()                                                               //
+// read next frame of the shared memory ring which is not skipped             //
+//----------------------------------------------------------------------------//
+int32_t QCanSocket::readShared(char * pchDataV, int32_t slSizeV)
+{
+   int32_t     slFrameSizeT;
+   uint32_t    ulSourceT;
+   QCanFrame   clFrameT;
+
+   while(true)
+   {
+      slFrameSizeT = clShmRingP.read(ulSourceT, pchDataV, slSizeV);
+      if(slFrameSizeT == 0)
+      {
+         break;
+      }
+
+      //--------------------------------------------------------
+      // skip frames written by this socket
+      //
+      if(ulSourceT == ulShmClientIdP)
+      {
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // the CAN network applies the acceptance filter only to
+      // frames sent via TCP, it is applied here for the ring
+      //
+      if((clFilterP.isEmpty() == false) && ((pchDataV[0] & 0xC0) == 0x00))
+      {
+         if(clFrameT.fromByteArray(pchDataV, slFrameSizeT) == true)
+         {
+            if(clFilterP.match(clFrameT.identifier(), 
+                               clFrameT.isExtended()) == 0)
+            {
+               continue;
+            }
+         }
+      }
+      break;
+   }
+
+   return(slFrameSizeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setFilter()                                                                //
+// keep copy of acceptance filter sent to the CAN network                     //
+//----------------------------------------------------------------------------//
+void QCanSocket::setFilter(QCanFrameApi & clFrameApiR)
+{
+   uint8_t     ubEntryT;
+   uint32_t    ulIdentifierT;
+   uint32_t    ulMaskT;
+   bool        btExtendedT;
+
+   if(clFrameApiR.filterAppend() == false)
+   {
+      clFilterP.clear();
+      ubFilterCntP = 0;
+   }
+
+   for(ubEntryT = 0; ubEntryT < clFrameApiR.filterCount(); ubEntryT++)
+   {
+      if(ubFilterCntP >= QCAN_FILTER_INDEX_MAX)
+      {
+         break;
+      }
+
+      if(clFrameApiR.filter(ubEntryT, ulIdentifierT, ulMaskT, btExtendedT))
+      {
+         clFilterP.setEntry(ubFilterCntP, ulIdentifierT, ulMaskT, btExtendedT);
+         ubFilterCntP++;
+      }
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // setHostAddress()                                                           //
 //                                                                            //
@@ -323,22 +728,83 @@ void QCanSocket::setHostAddress(QHostAddress clHostAddressV)
    }
 }
 
+
+//----------------------------------------------------------------------------//
+// setLocalConnectionEnabled()                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::setLocalConnectionEnabled(bool btEnableV)
+{
+   if(btIsConnectedP == false)
+   {
+      btLocalEnabledP = btEnableV;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setSharedMemoryEnabled()                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::setSharedMemoryEnabled(bool btEnableV)
+{
+   btShmEnabledP = btEnableV;
+}
+
+//----------------------------------------------------------------------------//
+// skipNotify()                                                               //
+// remove notifications of the shared memory ring from receive buffer         //
+//----------------------------------------------------------------------------//
+void QCanSocket::skipNotify(void)
+{
+   int32_t  slFrameSizeT;
+   char     achDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   while(true)
+   {
+      slFrameSizeT = nextFrameSize();
+      if((slFrameSizeT == 0) || (slFrameSizeT > QCAN_FRAME_ARRAY_SIZE))
+      {
+         break;
+      }
+
+      pclSockP->peek(&achDataT[0], slFrameSizeT);
+      if(isNotify(&achDataT[0], slFrameSizeT) == false)
+      {
+         break;
+      }
+      pclSockP->read(&achDataT[0], slFrameSizeT);
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // writeFrame()                                                               //
 //                                                                            //
 //----------------------------------------------------------------------------//
 bool QCanSocket::writeFrame(const QCanFrame & clFrameR)
 {
-   bool  btResultT = false;
+   bool     btResultT = false;
+   bool     btChecksumT;
+   int32_t  slSizeT;
+   char     achDatagramT[QCAN_FRAME_ARRAY_SIZE];
 
    if(btIsConnectedP == true)
    {
-      QByteArray  clDatagramT = clFrameR.toByteArray();
-      if(pclTcpSockP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+      btChecksumT = ((ubWireFormatP & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+      if(ubWireFormatP & QCAN_WIRE_FORMAT_COMPACT)
       {
-         pclTcpSockP->flush();
-         btResultT = true;
+         slSizeT = clFrameR.toByteArrayCompact(&achDatagramT[0],
+                                               QCAN_FRAME_ARRAY_SIZE,
+                                               btChecksumT);
+      }
+      else
+      {
+         slSizeT = clFrameR.toByteArray(&achDatagramT[0],
+                                        QCAN_FRAME_ARRAY_SIZE,
+                                        btChecksumT);
       }
+      btResultT = writeData(&achDatagramT[0], slSizeT);
    }
 
    return(btResultT);
@@ -350,18 +816,118 @@ bool QCanSocket::writeFrame(const QCanFrame & clFrameR)
 //----------------------------------------------------------------------------//
 bool QCanSocket::writeFrame(const QCanFrameApi & clFrameR)
 {
-   bool  btResultT = false;
+   bool           btResultT = false;
+   bool           btChecksumT;
+   int32_t        slSizeT;
+   char           achDatagramT[QCAN_FRAME_ARRAY_SIZE];
+   QCanFrameApi   clFrameApiT(clFrameR);
 
    if(btIsConnectedP == true)
    {
-      QByteArray  clDatagramT = clFrameR.toByteArray();
-      if(pclTcpSockP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+      if(clFrameApiT.function() == QCanFrameApi::eAPI_FUNC_FILTER)
       {
-         pclTcpSockP->flush();
-         btResultT = true;
+         setFilter(clFrameApiT);
       }
+
+      btChecksumT = ((ubWireFormatP & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+      if(ubWireFormatP & QCAN_WIRE_FORMAT_COMPACT)
+      {
+         slSizeT = clFrameR.toByteArrayCompact(&achDatagramT[0],
+                                               QCAN_FRAME_ARRAY_SIZE,
+                                               btChecksumT);
+      }
+      else
+      {
+         slSizeT = clFrameR.toByteArray(&achDatagramT[0],
+                                        QCAN_FRAME_ARRAY_SIZE,
+                                        btChecksumT);
+      }
+      btResultT = writeData(&achDatagramT[0], slSizeT);
    }
 
    return(btResultT);
 }
 
+
+//----------------------------------------------------------------------------//
+// writeFrames()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanSocket::writeFrames(const QCanFrame * pclFrameV, uint32_t ulCountV)
+{
+   uint32_t ulWriteCntT = 0;
+   uint32_t ulBatchCntT;
+   bool     btChecksumT;
+   int32_t  slSizeT;
+   int32_t  slPosT;
+   char     achDatagramT[QCAN_NETWORK_BATCH_SIZE * QCAN_FRAME_ARRAY_SIZE];
+
+   if((btIsConnectedP == false) || (pclFrameV == Q_NULLPTR))
+   {
+      return(0);
+   }
+
+   btChecksumT = ((ubWireFormatP & QCAN_WIRE_FORMAT_NO_CHECKSUM) == 0);
+
+   while(ulWriteCntT < ulCountV)
+   {
+      //--------------------------------------------------------
+      // encode up to QCAN_NETWORK_BATCH_SIZE frames into the
+      // buffer and write them with a single operation
+      //
+      slPosT      = 0;
+      ulBatchCntT = 0;
+      while((ulBatchCntT < QCAN_NETWORK_BATCH_SIZE) &&
+            ((ulWriteCntT + ulBatchCntT) < ulCountV))
+      {
+         const QCanFrame & clFrameR = pclFrameV[ulWriteCntT + ulBatchCntT];
+         if(ubWireFormatP & QCAN_WIRE_FORMAT_COMPACT)
+         {
+            slSizeT = clFrameR.toByteArrayCompact(&achDatagramT[slPosT],
+                                                  QCAN_FRAME_ARRAY_SIZE,
+                                                  btChecksumT);
+         }
+         else
+         {
+            slSizeT = clFrameR.toByteArray(&achDatagramT[slPosT],
+                                           QCAN_FRAME_ARRAY_SIZE,
+                                           btChecksumT);
+         }
+         slPosT += slSizeT;
+         ulBatchCntT++;
+      }
+
+      if(writeData(&achDatagramT[0], slPosT) == false)
+      {
+         break;
+      }
+      ulWriteCntT += ulBatchCntT;
+   }
+
+   return(ulWriteCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// writeData()                                                                //
+// write encoded frame to TCP socket or local socket                          //
+//----------------------------------------------------------------------------//
+bool QCanSocket::writeData(const char * pchDataV, int32_t slSizeV)
+{
+   bool  btResultT = false;
+
+   if((slSizeV > 0) && (pclSockP->write(pchDataV, slSizeV) == slSizeV))
+   {
+      if(btLocalActiveP == true)
+      {
+         pclLocalSockP->flush();
+      }
+      else
+      {
+         pclTcpSockP->flush();
+      }
+      btResultT = true;
+   }
+
+   return(btResultT);
+}
@@ -32,15 +32,18 @@
 
 
 #include <QHostAddress>
+#include <QLocalSocket>
 #include <QPointer>
 #include <QString>
 #include <QTcpSocket>
 #include <QVector>
 
 #include "qcan_defs.hpp"
+#include "qcan_filter_index.hpp"
 #include "qcan_frame.hpp"
 #include "qcan_frame_api.hpp"
 #include "qcan_frame_error.hpp"
+#include "qcan_shared_ring.hpp"
 
 
 
@@ -57,6 +60,22 @@
 ** state can be evaluated with isConnected() and error(). Each CAN socket
 ** has an unique identifier for socket management (uuidString()).
 **
+** When the QCanNetwork offers the compact encoding of frames during the
+** connection handshake, the socket selects it upon reading the offer
+** and writes all further frames in compact encoding. Frames in both
+** encodings are accepted for reading.
+**
+** A QCanNetwork on the same host offers its shared memory ring
+** (QCanSharedRing) during the connection handshake. The socket attaches
+** to the ring and reads CAN frames from there instead of the TCP
+** connection, frames are still written via TCP. If the ring is not
+** available, the socket keeps using the TCP connection.
+**
+** For a QCanNetwork on the same host the socket connects to the local
+** server of the network (refer to QCanNetwork::setLocalServerEnabled())
+** instead of the TCP server. If the local server is not available, the
+** socket falls back to the TCP connection.
+**
 */
 
 class QCanSocket : public QObject
@@ -74,6 +93,16 @@ public:
 	
 	virtual ~QCanSocket();
 
+   /*!
+   ** \return     Number of bytes waiting to be written
+   **
+   ** Returns the number of bytes which have been written to the socket
+   ** but not yet transferred to the CAN network. The value can be used
+   ** to throttle an application which writes frames faster than the
+   ** network is able to receive them.
+   */
+   int64_t  bytesToWrite(void) const;
+
    /*!
    ** \param[in]  teChannelV     CAN channel
    ** \return     \c true if connection is possible
@@ -134,6 +163,26 @@ public:
    bool isConnected(void);
 
 
+   /*!
+   ** \return     \c true if socket is connected to local server
+   ** \see        setLocalConnectionEnabled()
+   **
+   ** The function returns \c true if the socket is connected to the
+   ** local server of the CAN network instead of the TCP server.
+   */
+   bool isLocalConnection(void) const  { return(btLocalActiveP); };
+
+
+   /*!
+   ** \return     \c true if frames are read from shared memory
+   ** \see        setSharedMemoryEnabled()
+   **
+   ** The function returns \c true if the socket reads CAN frames from
+   ** the shared memory ring of the CAN network.
+   */
+   bool isSharedMemoryActive(void) const  { return(btShmActiveP); };
+
+
    /*!
    ** \return     UUID string
    **
@@ -152,6 +201,28 @@ public:
    void  setHostAddress(QHostAddress clHostAddressV);
 
 
+   /*!
+   ** \param[in]  btEnableV      Enable / disable local connection
+   ** \see        isLocalConnection()
+   **
+   ** The function defines if the socket connects to the local server
+   ** of a CAN network on the same host. The setting is evaluated by
+   ** connectNetwork(), the default value is \c true.
+   */
+   void  setLocalConnectionEnabled(bool btEnableV = true);
+
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable shared memory transport
+   ** \see        isSharedMemoryActive()
+   **
+   ** The function defines if the socket accepts the shared memory ring
+   ** offered by a CAN network on the same host. The setting is evaluated
+   ** during the connection handshake, the default value is \c true.
+   */
+   void  setSharedMemoryEnabled(bool btEnableV = true);
+
+
    /*!
    ** Get error state
    **
@@ -201,6 +272,19 @@ public:
    ** This is an overloaded function, using QCanFrameError as parameter.
    */
    bool  writeFrame(const QCanFrameError & clFrameR);
+
+   /*!
+   ** \param[in]  pclFrameV      Pointer to array of CAN frames
+   ** \param[in]  ulCountV       Number of CAN frames
+   ** \return     Number of CAN frames written
+   ** \see  writeFrame()
+   **
+   ** The function writes \a ulCountV CAN frames from the array 
+   ** \a pclFrameV to the CAN socket. The frames are encoded into one
+   ** buffer and transferred by a single write operation, which is
+   ** considerably faster than calling writeFrame() for each frame.
+   */
+   uint32_t writeFrames(const QCanFrame * pclFrameV, uint32_t ulCountV);
    
 
 public slots:
@@ -242,13 +326,56 @@ protected:
 
 private:
 
+   int32_t  nextFrameSize(void) const;
+   void     checkApiFrame(const char * pchDataV, int32_t slSizeV);
+   void     checkSharedMemory(QCanFrameApi & clFrameApiR);
+   int32_t  readShared(char * pchDataV, int32_t slSizeV);
+   void     setFilter(QCanFrameApi & clFrameApiR);
+   void     skipNotify(void);
+   bool     writeData(const char * pchDataV, int32_t slSizeV);
+
+   static bool isNotify(const char * pchDataV, int32_t slSizeV);
+
    QPointer<QTcpSocket> pclTcpSockP;
+   QPointer<QLocalSocket> pclLocalSockP;
+
+   //----------------------------------------------------------------
+   // socket which is used for reading and writing, it points to
+   // the TCP socket or to the local socket
+   //
+   QIODevice *          pclSockP;
+   uint16_t             uwNetPortP;
+   bool                 btLocalActiveP;
+   bool                 btLocalEnabledP;
    QHostAddress         clTcpHostAddrP;
    uint16_t             uwTcpPortP;
    bool                 btIsConnectedP;
    int32_t              slSocketErrorP;
 
+   //----------------------------------------------------------------
+   // wire format options used for writing, negotiated with the
+   // QCanNetwork (refer to QCAN_WIRE_FORMAT_MASK)
+   //
+   uint8_t              ubWireFormatP;
+
+   //----------------------------------------------------------------
+   // shared memory ring of the QCanNetwork, frames of this socket
+   // are marked with the connection ID and skipped
+   //
+   QCanSharedRing       clShmRingP;
+   uint32_t             ulShmClientIdP;
+   bool                 btShmActiveP;
+   bool                 btShmEnabledP;
+
+   //----------------------------------------------------------------
+   // Copy of the acceptance filter sent to the QCanNetwork, it is
+   // applied to frames of the shared memory ring
+   //
+   QCanFilterIndex      clFilterP;
+   uint8_t              ubFilterCntP;
+
 private slots:
+   void  onLocalError(QLocalSocket::LocalSocketError teSocketErrorV);
    void  onSocketConnect(void);
    void  onSocketDisconnect(void);
    void  onSocketError(QAbstractSocket::SocketError teSocketErrorV);
@@ -240,6 +240,7 @@ CpStatus_tv CpCoreBufferAccMask( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    // set acceptance mask
    //
    pclSockT->atsAccMaskM[ubBufferIdxV - 1] = ulAccMaskV;
+   pclSockT->updateFilterIndex(ubBufferIdxV - 1);
 
    return(CpErr_OK);
 }
@@ -384,6 +385,7 @@ CpStatus_tv CpCoreBufferInit( CpPort_ts * ptsPortV, CpCanMsg_ts * ptsCanMsgV,
    // set acceptance mask to default value
    //
    pclSockT->atsAccMaskM[ubBufferIdxV] = 0x1FFFFFFF;
+   pclSockT->updateFilterIndex(ubBufferIdxV);
 
    return (CpErr_OK);
 }
@@ -422,6 +424,8 @@ CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
    pclSockT->atsCanMsgM[ubBufferIdxV - 1].tuMsgId.ulExt = 0;
    pclSockT->atsCanMsgM[ubBufferIdxV - 1].ubMsgDLC      = 0;
    pclSockT->atsCanMsgM[ubBufferIdxV - 1].ubMsgCtrl     = 0;
+   pclSockT->atsCanMsgM[ubBufferIdxV - 1].ulMsgUser     = 0;
+   pclSockT->updateFilterIndex(ubBufferIdxV - 1);
 
    return (CpErr_OK);
 }
@@ -609,6 +613,12 @@ CpStatus_tv CpCoreBufferTransmit(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    pclSockT->atsCanMsgM[ubBufferIdxV].tuMsgData.aulLong[1] = ptsCanMsgV->tuMsgData.aulLong[1];
    pclSockT->atsCanMsgM[ubBufferIdxV].ulMsgUser     = CP_USER_FLAG_TRM;
 
+   //----------------------------------------------------------------
+   // the buffer may have been a receive buffer before, remove it
+   // from the acceptance index
+   //
+   pclSockT->updateFilterIndex(ubBufferIdxV);
+
 
    //----------------------------------------------------------------
    // write CAN frame
@@ -918,30 +928,75 @@ QCanFrame QCanSocketCp2::fromCpMsg(uint8_t ubMsgBufferV)
 }
 
 
+//----------------------------------------------------------------------------//
+// fromPort()                                                                 //
+// get socket of CANpie port                                                  //
+//----------------------------------------------------------------------------//
+QCanSocketCp2 * QCanSocketCp2::fromPort(CpPort_ts * ptsPortV)
+{
+   if(ptsPortV == 0L)
+   {
+      return(0L);
+   }
+   if(ptsPortV->ubPhyIf >= QCAN_NETWORK_MAX)
+   {
+      return(0L);
+   }
+   return(&(aclCanSockListS[ptsPortV->ubPhyIf]));
+}
+
+
 //----------------------------------------------------------------------------//
 // onSocketReceive()                                                          //
 // receive CAN message                                                        //
 //----------------------------------------------------------------------------//
 void QCanSocketCp2::onSocketReceive()
 {
-   QCanFrame   clFrameT;
-   CpCanMsg_ts    tsCanMsgT;
-   CpCanMsg_ts *  ptsCanBufT;
-   uint32_t    ulFrameCntT;
-   uint32_t    ulFrameMaxT;
-   uint32_t       ulAccMaskT;
-   uint8_t        ubBufferIdxT;
+   QCanFrame      clFrameT;
+   uint32_t       ulFrameCntT;
+   uint32_t       ulFrameMaxT;
 
    ulFrameMaxT = framesAvailable();
    for(ulFrameCntT = 0; ulFrameCntT < ulFrameMaxT; ulFrameCntT++)
    {
       readFrame(clFrameT);
-      tsCanMsgT = fromCanFrame(clFrameT);
+      receiveFrame(clFrameT);
+   }
+}
 
-      //----------------------------------------------------------------
-      // run through all possible message buffer
-      //
-      for(ubBufferIdxT = 0; ubBufferIdxT < CP_BUFFER_MAX; ubBufferIdxT++)
+
+//----------------------------------------------------------------------------//
+// receiveFrame()                                                             //
+// copy CAN frame to all receive buffers which accept it                      //
+//----------------------------------------------------------------------------//
+void QCanSocketCp2::receiveFrame(QCanFrame & clFrameR)
+{
+   CpCanMsg_ts    tsCanMsgT;
+   CpCanMsg_ts *  ptsCanBufT;
+   uint64_t       uqBufferMatchT;
+   uint8_t        ubBufferIdxT;
+
+   tsCanMsgT = fromCanFrame(clFrameR);
+
+   //----------------------------------------------------------------
+   // get all receive buffers which accept the identifier, the
+   // index is updated on every buffer configuration
+   //
+   if(CpMsgIsExtended(&tsCanMsgT))
+   {
+      uqBufferMatchT = clFilterIndexM.match(CpMsgGetExtId(&tsCanMsgT), true);
+   }
+   else
+   {
+      uqBufferMatchT = clFilterIndexM.match(CpMsgGetStdId(&tsCanMsgT), false);
+   }
+
+   //----------------------------------------------------------------
+   // run through the matching message buffers
+   //
+   for(ubBufferIdxT = 0; uqBufferMatchT != 0; ubBufferIdxT++)
+   {
+      if((uqBufferMatchT & 1) != 0)
       {
          //--------------------------------------------------------
          // setup pointer to CAN message buffer
@@ -949,65 +1004,25 @@ void QCanSocketCp2::onSocketReceive()
          ptsCanBufT = &(this->atsCanMsgM[ubBufferIdxT]);
 
          //--------------------------------------------------------
-         // get acceptance mask
-         //
-         ulAccMaskT = this->atsAccMaskM[ubBufferIdxT];
-
-         //--------------------------------------------------------
-         // test direction flag
-         //
-         if( ((ptsCanBufT->ulMsgUser) & CP_USER_FLAG_RCV) == 0) continue;
-
-         //--------------------------------------------------------
-         // distinguish frame types
+         // copy to buffer
          //
          if(CpMsgIsExtended(&tsCanMsgT))
          {
-            //------------------------------------------------
-            // check for extended frames
-            //
-            if( (CpMsgGetExtId(ptsCanBufT) & ulAccMaskT) ==
-                (CpMsgGetExtId(&tsCanMsgT) & ulAccMaskT)    )
-            {
-               //----------------------------------------
-               // copy to buffer
-               //
-               ptsCanBufT->tuMsgId.ulExt        = tsCanMsgT.tuMsgId.ulExt;
-               ptsCanBufT->ubMsgDLC             = tsCanMsgT.ubMsgDLC;
-               ptsCanBufT->tuMsgData.aulLong[0] = tsCanMsgT.tuMsgData.aulLong[0];
-               ptsCanBufT->tuMsgData.aulLong[1] = tsCanMsgT.tuMsgData.aulLong[1];
-               if(this->pfnRcvIntHandlerP != 0)
-               {
-                  (* this->pfnRcvIntHandlerP)(ptsCanBufT, ubBufferIdxT + 1);
-               }
-
-            }
+            ptsCanBufT->tuMsgId.ulExt     = tsCanMsgT.tuMsgId.ulExt;
          }
          else
-          {
-             //------------------------------------------------
-             // check for standard frames
-             //
-             if( (CpMsgGetStdId(ptsCanBufT) & ulAccMaskT) ==
-                 (CpMsgGetStdId(&tsCanMsgT) & ulAccMaskT)    )
-             {
-                //----------------------------------------
-                // copy to buffer
-                //
-                ptsCanBufT->tuMsgId.uwStd        = tsCanMsgT.tuMsgId.uwStd;
-                ptsCanBufT->ubMsgDLC             = tsCanMsgT.ubMsgDLC;
-                ptsCanBufT->tuMsgData.aulLong[0] = tsCanMsgT.tuMsgData.aulLong[0];
-                ptsCanBufT->tuMsgData.aulLong[1] = tsCanMsgT.tuMsgData.aulLong[1];
-
-                if(this->pfnRcvIntHandlerP != 0)
-                {
-                   (* this->pfnRcvIntHandlerP)(ptsCanBufT, ubBufferIdxT + 1);
-                }
-
-             }
-          }
+         {
+            ptsCanBufT->tuMsgId.uwStd     = tsCanMsgT.tuMsgId.uwStd;
+         }
+         ptsCanBufT->ubMsgDLC             = tsCanMsgT.ubMsgDLC;
+         ptsCanBufT->tuMsgData.aulLong[0] = tsCanMsgT.tuMsgData.aulLong[0];
+         ptsCanBufT->tuMsgData.aulLong[1] = tsCanMsgT.tuMsgData.aulLong[1];
+         if(this->pfnRcvIntHandlerP != 0)
+         {
+            (* this->pfnRcvIntHandlerP)(ptsCanBufT, ubBufferIdxT + 1);
+         }
       }
-
+      uqBufferMatchT = uqBufferMatchT >> 1;
    }
 }
 
@@ -1042,3 +1057,33 @@ CpCanMsg_ts QCanSocketCp2::fromCanFrame(QCanFrame & clCanFrameR)
 
    return(tsCanMsgT);
 }
+
+
+//----------------------------------------------------------------------------//
+// updateFilterIndex()                                                        //
+// update acceptance index for a message buffer                               //
+//----------------------------------------------------------------------------//
+void QCanSocketCp2::updateFilterIndex(uint8_t ubBufferIdxV)
+{
+   CpCanMsg_ts *  ptsCanBufT;
+
+   ptsCanBufT = &(atsCanMsgM[ubBufferIdxV]);
+
+   //----------------------------------------------------------------
+   // only receive buffers are part of the acceptance index
+   //
+   if( ((ptsCanBufT->ulMsgUser) & CP_USER_FLAG_RCV) == 0)
+   {
+      clFilterIndexM.removeEntry(ubBufferIdxV);
+   }
+   else if(CpMsgIsExtended(ptsCanBufT))
+   {
+      clFilterIndexM.setEntry(ubBufferIdxV, CpMsgGetExtId(ptsCanBufT), 
+                              atsAccMaskM[ubBufferIdxV], true);
+   }
+   else
+   {
+      clFilterIndexM.setEntry(ubBufferIdxV, CpMsgGetStdId(ptsCanBufT), 
+                              atsAccMaskM[ubBufferIdxV], false);
+   }
+}
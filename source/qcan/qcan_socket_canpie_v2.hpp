@@ -35,6 +35,7 @@
 
 
 #include "qcan_socket.hpp"
+#include "qcan_filter_index.hpp"
 #include "../canpie/version2/cp_core.h"
 #include "../canpie/version2/cp_msg.h"
 
@@ -43,6 +44,10 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#if CP_BUFFER_MAX > QCAN_FILTER_INDEX_MAX
+#error CP_BUFFER_MAX exceeds the size of QCanFilterIndex
+#endif
+
 //-----------------------------------------------------------------------------
 /*!
 ** \class QCanSocketCp2
@@ -60,12 +65,30 @@ public:
    QCanFrame   fromCpMsg(uint8_t ubMsgBufferV);
    CpCanMsg_ts fromCanFrame(QCanFrame & clCanFrameR);
 
+   //-------------------------------------------------------------------
+   // socket of a CANpie port, null pointer if the port is invalid
+   //
+   static QCanSocketCp2 * fromPort(CpPort_ts * ptsPortV);
+
+   //-------------------------------------------------------------------
+   // copy a received frame to all receive buffers which accept it
+   //
+   void        receiveFrame(QCanFrame & clFrameR);
+
    //-------------------------------------------------------------------
    // simulation of CAN message buffer
    //
    CpCanMsg_ts atsCanMsgM[CP_BUFFER_MAX];
    uint32_t    atsAccMaskM[CP_BUFFER_MAX];
 
+   //-------------------------------------------------------------------
+   // acceptance index of all receive buffers, it must be updated
+   // by updateFilterIndex() on every change of a buffer
+   //
+   QCanFilterIndex   clFilterIndexM;
+
+   void  updateFilterIndex(uint8_t ubBufferIdxV);
+
 
    //-------------------------------------------------------------------
    // these pointers store the callback handlers
@@ -323,6 +323,7 @@ CpStatus_tv CpCoreBufferConfig( CpPort_ts * ptsPortV,
    // set acceptance mask to default value
    //
    pclSockT->atsAccMaskM[ubBufferIdxV] = ulAcceptMaskV;
+   pclSockT->updateFilterIndex(ubBufferIdxV);
 
    return (eCP_ERR_NONE);
 }
@@ -367,6 +368,8 @@ CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
    pclSockT->atsCanMsgM[ubBufferIdxV - 1].tuMsgId.ulExt = 0;
    pclSockT->atsCanMsgM[ubBufferIdxV - 1].ubMsgDLC      = 0;
    pclSockT->atsCanMsgM[ubBufferIdxV - 1].ubMsgCtrl     = 0;
+   pclSockT->atsCanMsgM[ubBufferIdxV - 1].ulMsgUser     = 0;
+   pclSockT->updateFilterIndex(ubBufferIdxV - 1);
 
    return (eCP_ERR_NONE);
 }
@@ -835,7 +838,7 @@ void QCanSocketCp3::onSocketReceive()
    CpCanMsg_ts *  ptsCanBufT;
    uint32_t       ulFrameCntT;
    uint32_t       ulFrameMaxT;
-   uint32_t       ulAccMaskT;
+   uint64_t       uqBufferMatchT;
    uint8_t        ubBufferIdxT;
 
    ulFrameMaxT = framesAvailable();
@@ -845,79 +848,52 @@ void QCanSocketCp3::onSocketReceive()
       tsCanMsgT = fromCanFrame(clFrameT);
 
       //----------------------------------------------------------------
-      // run through all possible message buffer
+      // get all receive buffers which accept the identifier, the
+      // index is updated on every buffer configuration
       //
-      for(ubBufferIdxT = 0; ubBufferIdxT < CP_BUFFER_MAX; ubBufferIdxT++)
+      if(CpMsgIsExtended(&tsCanMsgT))
       {
-         //--------------------------------------------------------
-         // setup pointer to CAN message buffer
-         //
-         ptsCanBufT = &(this->atsCanMsgM[ubBufferIdxT]);
-
-         //--------------------------------------------------------
-         // get acceptance mask
-         //
-         ulAccMaskT = this->atsAccMaskM[ubBufferIdxT];
-
-         //--------------------------------------------------------
-         // test direction flag
-         //
-         if( ((ptsCanBufT->ulMsgUser) & CP_USER_FLAG_RCV) == 0) continue;
-
-         //--------------------------------------------------------
-         // distinguish frame types
-         //
-         if(CpMsgIsExtended(&tsCanMsgT))
+         uqBufferMatchT = clFilterIndexM.match(CpMsgGetExtId(&tsCanMsgT), true);
+      }
+      else
+      {
+         uqBufferMatchT = clFilterIndexM.match(CpMsgGetStdId(&tsCanMsgT), false);
+      }
+
+      //----------------------------------------------------------------
+      // run through the matching message buffers
+      //
+      for(ubBufferIdxT = 0; uqBufferMatchT != 0; ubBufferIdxT++)
+      {
+         if((uqBufferMatchT & 1) != 0)
          {
-            //------------------------------------------------
-            // check for extended frames
+            //--------------------------------------------------------
+            // setup pointer to CAN message buffer
             //
-            if( (CpMsgGetExtId(ptsCanBufT) & ulAccMaskT) ==
-                (CpMsgGetExtId(&tsCanMsgT) & ulAccMaskT)    )
-            {
-               //----------------------------------------
-               // copy to buffer
-               //
-               ptsCanBufT->tuMsgId.ulExt        = tsCanMsgT.tuMsgId.ulExt;
-               ptsCanBufT->ubMsgDLC             = tsCanMsgT.ubMsgDLC;
-               memcpy(&(ptsCanBufT->tuMsgData.aubByte[0]),
-                      &(tsCanMsgT.tuMsgData.aulLong[0]),
-                      CP_DATA_SIZE );
-               if(this->pfnRcvIntHandlerP != 0)
-               {
-                  (* this->pfnRcvIntHandlerP)(ptsCanBufT, ubBufferIdxT + 1);
-               }
+            ptsCanBufT = &(this->atsCanMsgM[ubBufferIdxT]);
 
+            //--------------------------------------------------------
+            // copy to buffer
+            //
+            if(CpMsgIsExtended(&tsCanMsgT))
+            {
+               ptsCanBufT->tuMsgId.ulExt     = tsCanMsgT.tuMsgId.ulExt;
+            }
+            else
+            {
+               ptsCanBufT->tuMsgId.uwStd     = tsCanMsgT.tuMsgId.uwStd;
+            }
+            ptsCanBufT->ubMsgDLC             = tsCanMsgT.ubMsgDLC;
+            memcpy(&(ptsCanBufT->tuMsgData.aubByte[0]),
+                   &(tsCanMsgT.tuMsgData.aulLong[0]),
+                   CP_DATA_SIZE );
+            if(this->pfnRcvIntHandlerP != 0)
+            {
+               (* this->pfnRcvIntHandlerP)(ptsCanBufT, ubBufferIdxT + 1);
             }
          }
-         else
-          {
-             //------------------------------------------------
-             // check for standard frames
-             //
-             if( (CpMsgGetStdId(ptsCanBufT) & ulAccMaskT) ==
-                 (CpMsgGetStdId(&tsCanMsgT) & ulAccMaskT)    )
-             {
-                //----------------------------------------
-                // copy to buffer
-                //
-                ptsCanBufT->tuMsgId.uwStd        = tsCanMsgT.tuMsgId.uwStd;
-                ptsCanBufT->ubMsgDLC             = tsCanMsgT.ubMsgDLC;
-                memcpy(&(ptsCanBufT->tuMsgData.aubByte[0]),
-                       &(tsCanMsgT.tuMsgData.aulLong[0]),
-                       CP_DATA_SIZE );
-                #if CP_CAN_FD > 0
-
-                #endif
-                if(this->pfnRcvIntHandlerP != 0)
-                {
-                   (* this->pfnRcvIntHandlerP)(ptsCanBufT, ubBufferIdxT + 1);
-                }
-
-             }
-          }
+         uqBufferMatchT = uqBufferMatchT >> 1;
       }
-
    }
 }
 
@@ -963,3 +939,33 @@ CpCanMsg_ts QCanSocketCp3::fromCanFrame(QCanFrame & clCanFrameR)
    }
    return(tsCanMsgT);
 }
+
+
+//----------------------------------------------------------------------------//
+// updateFilterIndex()                                                        //
+// update acceptance index for a message buffer                               //
+//----------------------------------------------------------------------------//
+void QCanSocketCp3::updateFilterIndex(uint8_t ubBufferIdxV)
+{
+   CpCanMsg_ts *  ptsCanBufT;
+
+   ptsCanBufT = &(atsCanMsgM[ubBufferIdxV]);
+
+   //----------------------------------------------------------------
+   // only receive buffers are part of the acceptance index
+   //
+   if( ((ptsCanBufT->ulMsgUser) & CP_USER_FLAG_RCV) == 0)
+   {
+      clFilterIndexM.removeEntry(ubBufferIdxV);
+   }
+   else if(CpMsgIsExtended(ptsCanBufT))
+   {
+      clFilterIndexM.setEntry(ubBufferIdxV, CpMsgGetExtId(ptsCanBufT), 
+                              atsAccMaskM[ubBufferIdxV], true);
+   }
+   else
+   {
+      clFilterIndexM.setEntry(ubBufferIdxV, CpMsgGetStdId(ptsCanBufT), 
+                              atsAccMaskM[ubBufferIdxV], false);
+   }
+}
@@ -36,6 +36,7 @@
 
 #include "../canpie/canpie-fd/cp_core.h"
 #include "../canpie/canpie-fd/cp_msg.h"
+#include "qcan_filter_index.hpp"
 #include "qcan_socket.hpp"
 
 
@@ -44,6 +45,10 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#if CP_BUFFER_MAX > QCAN_FILTER_INDEX_MAX
+#error CP_BUFFER_MAX exceeds the size of QCanFilterIndex
+#endif
+
 //-----------------------------------------------------------------------------
 /*!
 ** \class QCanSocketCp3
@@ -67,6 +72,14 @@ public:
    CpCanMsg_ts atsCanMsgM[CP_BUFFER_MAX];
    uint32_t    atsAccMaskM[CP_BUFFER_MAX];
 
+   //-------------------------------------------------------------------
+   // acceptance index of all receive buffers, it must be updated
+   // by updateFilterIndex() on every change of a buffer
+   //
+   QCanFilterIndex   clFilterIndexM;
+
+   void  updateFilterIndex(uint8_t ubBufferIdxV);
+
 
    //-------------------------------------------------------------------
    // these pointers store the callback handlers
@@ -37,25 +37,13 @@
 
 
 
-//----------------------------------------------------------------------------//
-// QCanTimeStamp()                                                            //
-// time-stamp constructor                                                     //
-//----------------------------------------------------------------------------//
-QCanTimeStamp::QCanTimeStamp(uint32_t ulSecondsV, uint32_t ulNanoSecondsV)
-{
-   this->setSeconds(ulSecondsV);
-   this->setNanoSeconds(ulNanoSecondsV);
-}
-
-
 //----------------------------------------------------------------------------//
 // clear()                                                                    //
 // clear time-stamp value                                                     //
 //----------------------------------------------------------------------------//
 void QCanTimeStamp::clear(void)
 {
-   ulSecondsP     = 0;
-   ulNanoSecondsP = 0;
+   sqNanoSecondsP = 0;
 }
 
 
@@ -63,188 +51,73 @@ void QCanTimeStamp::clear(void)
 // fromMicroSeconds()                                                         //
 // convert micro-seconds value to time-stamp value                            //
 //----------------------------------------------------------------------------//
-void QCanTimeStamp::fromMicroSeconds(uint32_t ulMicroSecondsV)
-{
-   //----------------------------------------------------------------
-   // calculate the seconds
-   //
-   ulSecondsP     = ulMicroSecondsV / 1000000UL;
-   
-   //----------------------------------------------------------------
-   // substract the seconds from parameter
-   //
-   ulMicroSecondsV = ulMicroSecondsV - (ulSecondsP * 1000000UL);
-   
-   //----------------------------------------------------------------
-   // convert the remaining part to nano-seconds
-   //
-   ulNanoSecondsP = ulMicroSecondsV * 1000UL;
-}
-
-
-//----------------------------------------------------------------------------//
-// fromMilliSeconds()                                                         //
-// convert milli-seconds value to time-stamp value                            //
-//----------------------------------------------------------------------------//
-void QCanTimeStamp::fromMilliSeconds(uint32_t ulMilliSecondsV)
+void QCanTimeStamp::fromMicroSeconds(uint64_t uqMicroSecondsV)
 {
    //----------------------------------------------------------------
-   // calculate the seconds
-   //
-   ulSecondsP     = ulMilliSecondsV / 1000UL;
-   
-   //----------------------------------------------------------------
-   // substract the seconds from parameter
-   //
-   ulMilliSecondsV = ulMilliSecondsV - (ulSecondsP * 1000UL);
-   
-   //----------------------------------------------------------------
-   // convert the remaining part to nano-seconds
+   // the value is limited to the range of the time-stamp, the
+   // test avoids an overflow of the multiplication
    //
-   ulNanoSecondsP = ulMilliSecondsV * 1000000UL;
-
-}
-
-
-//----------------------------------------------------------------------------//
-// isValid()                                                                  //
-// test valid value range for data fields                                     //
-//----------------------------------------------------------------------------//
-bool QCanTimeStamp::isValid(void)
-{
-   bool  btResultT = false;
-
-   if( (ulSecondsP <= TIME_STAMP_SECS_LIMIT) &&
-       (ulNanoSecondsP <= TIME_STAMP_NSEC_LIMIT) )
+   if (uqMicroSecondsV / 1000ULL > (uint64_t) TIME_STAMP_TOTAL_LIMIT)
    {
-      btResultT = true;
+      sqNanoSecondsP = TIME_STAMP_TOTAL_LIMIT;
+   }
+   else
+   {
+      this->fromNanoSeconds(uqMicroSecondsV * 1000ULL);
    }
-   
-   return(btResultT);
-}
-
-
-//----------------------------------------------------------------------------//
-// operator -                                                                 //
-// substract two time-stamp values                                            //
-//----------------------------------------------------------------------------//
-QCanTimeStamp QCanTimeStamp::operator-(const QCanTimeStamp & clTimestampR) const
-{
-   QCanTimeStamp clTempT(*this);
-
-   clTempT -= clTimestampR;   // use operator -=
-   return(clTempT);
-}
-
-
-//----------------------------------------------------------------------------//
-// operator !=                                                                //
-// compare two time-stamp values                                              //
-//----------------------------------------------------------------------------//
-bool QCanTimeStamp::operator!=(const QCanTimeStamp & clTimestampR) const
-{
-   return(!(*this == clTimestampR));
-}
-
-
-//----------------------------------------------------------------------------//
-// operator +                                                                 //
-// add two time-stamp values                                                  //
-//----------------------------------------------------------------------------//
-QCanTimeStamp  QCanTimeStamp::operator+(const QCanTimeStamp & clTimestampR) const
-{
-   QCanTimeStamp clTempT(*this);
-
-   clTempT += clTimestampR;   // use operator +=
-   return(clTempT);
 }
 
 
 //----------------------------------------------------------------------------//
-// operator +=                                                                //
-// add two time-stamp values                                                  //
+// fromMilliSeconds()                                                         //
+// convert milli-seconds value to time-stamp value                            //
 //----------------------------------------------------------------------------//
-QCanTimeStamp & QCanTimeStamp::operator+=(const QCanTimeStamp & clTimestampR) 
+void QCanTimeStamp::fromMilliSeconds(uint64_t uqMilliSecondsV)
 {
-   uint32_t    ulNanoSecsT = 0;
-   uint64_t    uqSecondsT = 0;
-
-   //----------------------------------------------------------------
-   // Add nano-second values, this may lead to an overflow, i.e.
-   // more than 999.999.999 nano-seconds
-   //
-   ulNanoSecsT = this->nanoSeconds() + clTimestampR.nanoSeconds();
-   if(ulNanoSecsT > TIME_STAMP_NSEC_LIMIT)
-   {
-      uqSecondsT  = 1;
-      ulNanoSecsT = ulNanoSecsT - 1000000000UL;
-   }
-
-   //----------------------------------------------------------------
-   // calculate seconds value
-   //
-   uqSecondsT = uqSecondsT + this->seconds();
-   uqSecondsT = uqSecondsT + clTimestampR.seconds();
-
    //----------------------------------------------------------------
-   // check for overflow
+   // the value is limited to the range of the time-stamp, the
+   // test avoids an overflow of the multiplication
    //
-   if(uqSecondsT > TIME_STAMP_SECS_LIMIT)
+   if (uqMilliSecondsV / 1000000ULL > (uint64_t) TIME_STAMP_TOTAL_LIMIT)
    {
-      //---------------------------------------------------
-      // set invalid value
-      //
-      this->ulSecondsP     = TIME_STAMP_INVALID_VALUE; 
-      this->ulNanoSecondsP = TIME_STAMP_INVALID_VALUE;
+      sqNanoSecondsP = TIME_STAMP_TOTAL_LIMIT;
    }
    else
    {
-      this->setSeconds((uint32_t) uqSecondsT);
-      this->setNanoSeconds(ulNanoSecsT);
+      this->fromNanoSeconds(uqMilliSecondsV * 1000000ULL);
    }
-   
-   return(*this);
 }
 
 
 //----------------------------------------------------------------------------//
-// operator <                                                                 //
-// compare two time-stamp values                                              //
+// fromNanoSeconds()                                                          //
+// convert nano-seconds value to time-stamp value                             //
 //----------------------------------------------------------------------------//
-bool QCanTimeStamp::operator<(const QCanTimeStamp & clTimestampR) const
+void QCanTimeStamp::fromNanoSeconds(uint64_t uqNanoSecondsV)
 {
-   bool btResultT = false;
-
    //----------------------------------------------------------------
-   // when seconds part is smaller, then result is true
+   // the value is limited to the range of the time-stamp
    //
-   if(this->seconds() < clTimestampR.seconds())
+   if (uqNanoSecondsV > (uint64_t) TIME_STAMP_TOTAL_LIMIT)
    {
-      btResultT = true;
+      sqNanoSecondsP = TIME_STAMP_TOTAL_LIMIT;
    }
-
-   //----------------------------------------------------------------
-   // when seconds part is equal, check the nano-seconds
-   //
-   if(this->seconds() == clTimestampR.seconds())
+   else
    {
-      if(this->nanoSeconds() < clTimestampR.nanoSeconds())
-      {
-         btResultT = true;
-      }
+      sqNanoSecondsP = (int64_t) uqNanoSecondsV;
    }
-      
-   return(btResultT);
 }
 
 
 //----------------------------------------------------------------------------//
-// operator <=                                                                //
-// compare two time-stamp values                                              //
+// operator +=                                                                //
+// add two time-stamp values                                                  //
 //----------------------------------------------------------------------------//
-bool QCanTimeStamp::operator<=(const QCanTimeStamp & clTimestampR) const
+QCanTimeStamp & QCanTimeStamp::operator+=(const QCanTimeStamp & clTimeStampR) 
 {
-   return((*this == clTimestampR) || (*this < clTimestampR));
+   sqNanoSecondsP = add(sqNanoSecondsP, clTimeStampR.sqNanoSecondsP);
+   
+   return(*this);
 }
 
 
@@ -254,82 +127,11 @@ bool QCanTimeStamp::operator<=(const QCanTimeStamp & clTimestampR) const
 //----------------------------------------------------------------------------//
 QCanTimeStamp & QCanTimeStamp::operator-=(const QCanTimeStamp & clTimeStampR)
 {
-   uint32_t    ulNanoSecsT = 0;
-   uint32_t    ulSecondsT  = 0;
-   
-   //----------------------------------------------------------------
-   // test is substraction may cause an underflow
-   //
-   if(*this < clTimeStampR)
-   {
-      //---------------------------------------------------
-      // set invalid value
-      //
-      this->ulSecondsP     = TIME_STAMP_INVALID_VALUE; 
-      this->ulNanoSecondsP = TIME_STAMP_INVALID_VALUE;
-   }
-   else
-   {
-      if(this->ulNanoSecondsP < clTimeStampR.ulNanoSecondsP)
-      {
-         ulNanoSecsT = this->ulNanoSecondsP   + 1000000000UL;
-         ulNanoSecsT = ulNanoSecsT - clTimeStampR.ulNanoSecondsP;
-         ulSecondsT  = (this->ulSecondsP)     - (clTimeStampR.ulSecondsP);
-         ulSecondsT  = ulSecondsT - 1;
-      }
-      else
-      {
-         ulNanoSecsT = (this->ulNanoSecondsP) - (clTimeStampR.ulNanoSecondsP);
-         ulSecondsT  = (this->ulSecondsP)     - (clTimeStampR.ulSecondsP);
-      }
-      
-      //---------------------------------------------------
-      // set value
-      //
-      this->ulSecondsP     = ulSecondsT; 
-      this->ulNanoSecondsP = ulNanoSecsT;
-   }
+   sqNanoSecondsP = sub(sqNanoSecondsP, clTimeStampR.sqNanoSecondsP);
    
    return(*this);
 }
 
-//----------------------------------------------------------------------------//
-// operator ==                                                                //
-// compare two time-stamp values                                              //
-//----------------------------------------------------------------------------//
-bool QCanTimeStamp::operator==(const QCanTimeStamp & clTimeStampR) const
-{
-   bool btResultT = false;
-   if(this->nanoSeconds() == clTimeStampR.nanoSeconds())
-   {
-      if(this->seconds() == clTimeStampR.seconds())
-      {
-         btResultT = true;
-      }
-   }
-   return(btResultT);
-}
-
-
-//----------------------------------------------------------------------------//
-// operator >                                                                 //
-// compare two time-stamp values                                              //
-//----------------------------------------------------------------------------//
-bool QCanTimeStamp::operator>(const QCanTimeStamp & clTimestampR) const
-{
-   return(!(*this < clTimestampR) && !(*this == clTimestampR));
-}
-
-
-//----------------------------------------------------------------------------//
-// operator >=                                                                //
-// compare two time-stamp values                                              //
-//----------------------------------------------------------------------------//
-bool QCanTimeStamp::operator>=(const QCanTimeStamp & clTimestampR) const
-{
-   return((*this == clTimestampR) || !(*this < clTimestampR));
-}
-
 
 //----------------------------------------------------------------------------//
 // setNanoSeconds()                                                           //
@@ -337,14 +139,18 @@ bool QCanTimeStamp::operator>=(const QCanTimeStamp & clTimestampR) const
 //----------------------------------------------------------------------------//
 void QCanTimeStamp::setNanoSeconds(uint32_t ulNanoSecondsV)
 {
-   if(ulNanoSecondsV <= TIME_STAMP_NSEC_LIMIT)
-   {
-      ulNanoSecondsP = ulNanoSecondsV;
-   }
-   else
+   int64_t  sqSecondsT = 0;
+   
+   //----------------------------------------------------------------
+   // keep the seconds part, an invalid time-stamp starts with 0
+   //
+   if (isValid())
    {
-      ulNanoSecondsP = TIME_STAMP_NSEC_LIMIT;
+      sqSecondsT = sqNanoSecondsP / TIME_STAMP_NSEC_PER_SEC;
    }
+   
+   sqNanoSecondsP = (sqSecondsT * TIME_STAMP_NSEC_PER_SEC) + 
+                    limit(ulNanoSecondsV, TIME_STAMP_NSEC_LIMIT);
 }
 
 
@@ -354,12 +160,16 @@ void QCanTimeStamp::setNanoSeconds(uint32_t ulNanoSecondsV)
 //----------------------------------------------------------------------------//
 void QCanTimeStamp::setSeconds(const uint32_t ulSecondsV)
 {
-   if(ulSecondsV <= TIME_STAMP_SECS_LIMIT)
+   int64_t  sqNanoSecsT = 0;
+   
+   //----------------------------------------------------------------
+   // keep the nanoseconds part, an invalid time-stamp starts with 0
+   //
+   if (isValid())
    {
-      ulSecondsP = ulSecondsV;
+      sqNanoSecsT = sqNanoSecondsP % TIME_STAMP_NSEC_PER_SEC;
    }
-   else
-   {
-      ulSecondsP = TIME_STAMP_SECS_LIMIT;
-   }   
+   
+   sqNanoSecondsP = (limit(ulSecondsV, TIME_STAMP_SECS_LIMIT) * 
+                     TIME_STAMP_NSEC_PER_SEC) + sqNanoSecsT;
 }
@@ -74,6 +74,41 @@
 */
 #define  TIME_STAMP_INVALID_VALUE   ((uint32_t) 0xFFFFFFEE)
 
+
+//-------------------------------------------------------------------
+/*!
+** \def  TIME_STAMP_NSEC_PER_SEC
+** 
+** The symbol TIME_STAMP_NSEC_PER_SEC defines the number of nanoseconds
+** within one second.
+*/
+#define  TIME_STAMP_NSEC_PER_SEC    ((int64_t) 1000000000LL)
+
+
+//-------------------------------------------------------------------
+/*!
+** \def  TIME_STAMP_TOTAL_LIMIT
+** 
+** The symbol TIME_STAMP_TOTAL_LIMIT defines the maximum value of the
+** time-stamp in nanoseconds, i.e. #TIME_STAMP_SECS_LIMIT seconds plus
+** #TIME_STAMP_NSEC_LIMIT nanoseconds.
+*/
+#define  TIME_STAMP_TOTAL_LIMIT     (((int64_t) TIME_STAMP_SECS_LIMIT) *   \
+                                     TIME_STAMP_NSEC_PER_SEC +             \
+                                     ((int64_t) TIME_STAMP_NSEC_LIMIT))
+
+
+//-------------------------------------------------------------------
+/*!
+** \def  TIME_STAMP_TOTAL_INVALID
+** 
+** The symbol TIME_STAMP_TOTAL_INVALID defines the internal nanoseconds
+** value of an invalid time-stamp. The value is larger than any valid 
+** time-stamp, so an invalid time-stamp is sorted behind all valid ones.
+*/
+#define  TIME_STAMP_TOTAL_INVALID   ((int64_t) 0x7FFFFFFFFFFFFFFFLL)
+
+
 //-----------------------------------------------------------------------------
 /*!
 ** \class   QCanTimeStamp
@@ -91,6 +126,11 @@
 ** The value of a time-stamp can be set from a counter value by means of
 ** the functions fromMicroSeconds() or fromMilliSeconds(). 
 ** 
+** Internally the value is stored as one 64 bit nanoseconds counter 
+** (refer to toNanoSeconds()), the data fields are derived from this
+** counter. Hence comparison and arithmetic operations are simple 
+** integer operations, which can also be evaluated at compile time.
+** 
 */
 class QCanTimeStamp
 {
@@ -105,7 +145,11 @@ public:
    ** valid value range for the parameters is violated the object will be 
    ** constructed using maximum allowed values. 
    */
-   QCanTimeStamp(uint32_t ulSecondsV=0, uint32_t ulNanoSecondsV=0);
+   constexpr QCanTimeStamp(uint32_t ulSecondsV=0, uint32_t ulNanoSecondsV=0)
+      : sqNanoSecondsP(limit(ulSecondsV, TIME_STAMP_SECS_LIMIT) * 
+                       TIME_STAMP_NSEC_PER_SEC                  +
+                       limit(ulNanoSecondsV, TIME_STAMP_NSEC_LIMIT))
+   { };
 
    
    /*!
@@ -114,18 +158,28 @@ public:
    void  clear(void);
 
    /*!
-   ** \param[in] ulMicroSecondsV - time-value in microseconds [&micro;s]
+   ** \param[in] uqMicroSecondsV - time-value in microseconds [&micro;s]
    ** 
-   ** Set the time-stamp value according to the parameter \a ulMicroSecondsV.
+   ** Set the time-stamp value according to the parameter \a uqMicroSecondsV.
+   ** The 64 bit value does not wrap within the value range of the
+   ** time-stamp, larger values are limited to #TIME_STAMP_SECS_LIMIT.
    */
-   void  fromMicroSeconds(uint32_t ulMicroSecondsV);
+   void  fromMicroSeconds(uint64_t uqMicroSecondsV);
 
    /*!
-   ** \param[in] ulMilliSecondsV - time-value in milliseconds [msec]
+   ** \param[in] uqMilliSecondsV - time-value in milliseconds [msec]
    ** 
-   ** Set the time-stamp value according to the parameter \a ulMilliSecondsV.
+   ** Set the time-stamp value according to the parameter \a uqMilliSecondsV.
    */   
-   void  fromMilliSeconds(uint32_t ulMilliSecondsV);
+   void  fromMilliSeconds(uint64_t uqMilliSecondsV);
+
+   /*!
+   ** \param[in] uqNanoSecondsV - time-value in nanoseconds [nsec]
+   ** 
+   ** Set the time-stamp value according to the parameter \a uqNanoSecondsV,
+   ** e.g. the value of a 64 bit hardware counter.
+   */
+   void  fromNanoSeconds(uint64_t uqNanoSecondsV);
 
    /*!
    ** \return  \c true if time-stamp value is valid
@@ -134,7 +188,8 @@ public:
    ** The limit for the data fields are defined by #TIME_STAMP_SECS_LIMIT
    ** and #TIME_STAMP_NSEC_LIMIT.
    */
-   bool  isValid(void);
+   constexpr bool  isValid(void) const
+   { return(sqNanoSecondsP != TIME_STAMP_TOTAL_INVALID);                   };
    
    
    /*!
@@ -145,7 +200,11 @@ public:
    ** #TIME_STAMP_INVALID_VALUE marks the time-stamp value as invalid.
    ** The validity of a time-stamp can be tested with isValid().
    */
-   inline uint32_t nanoSeconds(void) const   { return(ulNanoSecondsP);  };
+   constexpr uint32_t nanoSeconds(void) const
+   { 
+      return(isValid() ? (uint32_t) (sqNanoSecondsP % TIME_STAMP_NSEC_PER_SEC)
+                       : TIME_STAMP_INVALID_VALUE);
+   };
    
    
    /*!
@@ -156,7 +215,11 @@ public:
    ** #TIME_STAMP_INVALID_VALUE marks the time-stamp value as invalid.
    ** The validity of a time-stamp can be tested with isValid().
    */
-   inline uint32_t seconds(void) const       { return(ulSecondsP);      };
+   constexpr uint32_t seconds(void) const
+   { 
+      return(isValid() ? (uint32_t) (sqNanoSecondsP / TIME_STAMP_NSEC_PER_SEC)
+                       : TIME_STAMP_INVALID_VALUE);
+   };
 
    
    /*!
@@ -181,6 +244,17 @@ public:
    */
    void setSeconds(const uint32_t ulSecondsV);
 
+   /*!
+   ** \return  Time-stamp value in nanoseconds
+   ** 
+   ** Returns the value of this time-stamp in nanoseconds. The function
+   ** returns -1 if the time-stamp is not valid. The return value can 
+   ** be used for fast calculations, e.g. the difference between two 
+   ** time-stamps.
+   */
+   constexpr int64_t toNanoSeconds(void) const
+   { return(isValid() ? sqNanoSecondsP : -1);                              };
+
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
    ** \return  \c true on equal time-stamps
@@ -188,7 +262,8 @@ public:
    ** Returns \c true if this time-stamp is equal to time-stamp \a clTimeStampR,
    ** otherwise returns \c false.
    */
-   bool operator==( const QCanTimeStamp & clTimeStampR) const;
+   constexpr bool operator==( const QCanTimeStamp & clTimeStampR) const
+   { return(sqNanoSecondsP == clTimeStampR.sqNanoSecondsP);                };
 
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -197,7 +272,8 @@ public:
    ** Returns \c true if this time-stamp is not equal to time-stamp 
    ** \a clTimeStampR, otherwise returns \c false.
    */
-   bool operator!=( const QCanTimeStamp & clTimeStampR) const;
+   constexpr bool operator!=( const QCanTimeStamp & clTimeStampR) const
+   { return(sqNanoSecondsP != clTimeStampR.sqNanoSecondsP);                };
    
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -206,7 +282,8 @@ public:
    ** Returns true if this time-stamp is less than time-stamp \a clTimeStampR,
    ** otherwise returns false.
    */
-   bool operator<(const QCanTimeStamp & clTimeStampR) const;
+   constexpr bool operator<(const QCanTimeStamp & clTimeStampR) const
+   { return(sqNanoSecondsP < clTimeStampR.sqNanoSecondsP);                 };
 
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -215,7 +292,8 @@ public:
    ** Returns true if this time-stamp is less than or equal to time-stamp 
    ** \a clTimeStampR, otherwise returns false.
    */   
-   bool operator<=(const QCanTimeStamp & clTimeStampR) const;
+   constexpr bool operator<=(const QCanTimeStamp & clTimeStampR) const
+   { return(sqNanoSecondsP <= clTimeStampR.sqNanoSecondsP);                };
    
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -224,7 +302,8 @@ public:
    ** Returns true if this time-stamp is greater than time-stamp 
    ** \a clTimeStampR, otherwise returns false.
    */
-   bool operator>(const QCanTimeStamp & clTimeStampR) const;
+   constexpr bool operator>(const QCanTimeStamp & clTimeStampR) const
+   { return(sqNanoSecondsP > clTimeStampR.sqNanoSecondsP);                 };
 
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -233,7 +312,8 @@ public:
    ** Returns true if this time-stamp is greater or equal than time-stamp 
    ** \a clTimeStampR, otherwise returns false.
    */
-   bool operator>=(const QCanTimeStamp & clTimeStampR) const;
+   constexpr bool operator>=(const QCanTimeStamp & clTimeStampR) const
+   { return(sqNanoSecondsP >= clTimeStampR.sqNanoSecondsP);                };
    
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -242,7 +322,9 @@ public:
    ** Add the time-stamp \a clTimeStampR to this time-stamp value 
    ** and returns a reference to this time-stamp.
    */
-   QCanTimeStamp   operator+(const QCanTimeStamp & clTimeStampR) const;
+   constexpr QCanTimeStamp operator+(const QCanTimeStamp & clTimeStampR) const
+   { return(QCanTimeStamp(eNANO_SECONDS, add(sqNanoSecondsP, 
+                                             clTimeStampR.sqNanoSecondsP))); };
    
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -260,7 +342,9 @@ public:
    ** Substract the time-stamp \a clTimeStampR from this time-stamp value 
    ** and returns a reference to this time-stamp.
    */
-   QCanTimeStamp operator-(const QCanTimeStamp & clTimeStampR) const;
+   constexpr QCanTimeStamp operator-(const QCanTimeStamp & clTimeStampR) const
+   { return(QCanTimeStamp(eNANO_SECONDS, sub(sqNanoSecondsP, 
+                                             clTimeStampR.sqNanoSecondsP))); };
 
    /*!
    ** \param   clTimeStampR - Refence to other time-stamp
@@ -274,14 +358,55 @@ public:
 private:
 
    /*!
-   ** Seconds, valid value range is 0 to #TIME_STAMP_SECS_LIMIT  
+   ** Tag for the private constructor which takes a nanoseconds value
+   */
+   enum NanoSeconds_e { eNANO_SECONDS };
+
+   /*!
+   ** Construct a time-stamp directly from the nanoseconds value 
+   ** \a sqNanoSecondsV, the value is not checked.
+   */
+   constexpr QCanTimeStamp(NanoSeconds_e, int64_t sqNanoSecondsV)
+      : sqNanoSecondsP(sqNanoSecondsV)
+   { };
+
+   /*!
+   ** Returns \a ulValueV limited to \a ulLimitV.
+   */
+   static constexpr int64_t limit(uint32_t ulValueV, uint32_t ulLimitV)
+   { return((int64_t) ((ulValueV > ulLimitV) ? ulLimitV : ulValueV));      };
+
+   /*!
+   ** Returns the sum of the nanoseconds values \a sqValueAV and 
+   ** \a sqValueBV, or #TIME_STAMP_TOTAL_INVALID on overflow. Two valid
+   ** values can not overflow the 64 bit range.
+   */
+   static constexpr int64_t add(int64_t sqValueAV, int64_t sqValueBV)
+   { 
+      return(((sqValueAV == TIME_STAMP_TOTAL_INVALID) ||
+              (sqValueBV == TIME_STAMP_TOTAL_INVALID) ||
+              (sqValueAV + sqValueBV > TIME_STAMP_TOTAL_LIMIT)) ?
+              TIME_STAMP_TOTAL_INVALID : sqValueAV + sqValueBV);
+   };
+
+   /*!
+   ** Returns the difference of the nanoseconds values \a sqValueAV and 
+   ** \a sqValueBV, or #TIME_STAMP_TOTAL_INVALID on underflow.
    */
-   uint32_t ulSecondsP;
+   static constexpr int64_t sub(int64_t sqValueAV, int64_t sqValueBV)
+   { 
+      return(((sqValueAV == TIME_STAMP_TOTAL_INVALID) ||
+              (sqValueBV == TIME_STAMP_TOTAL_INVALID) ||
+              (sqValueAV < sqValueBV)) ?
+              TIME_STAMP_TOTAL_INVALID : sqValueAV - sqValueBV);
+   };
 
    /*!
-   ** Nanoseconds, valid value range is 0 to TIME_STAMP_NSEC_LIMIT 
+   ** Time-stamp value in nanoseconds, valid value range is 0 to 
+   ** #TIME_STAMP_TOTAL_LIMIT. An invalid time-stamp has the value
+   ** #TIME_STAMP_TOTAL_INVALID.
    */
-   uint32_t ulNanoSecondsP;
+   int64_t  sqNanoSecondsP;
    
 };
 
@@ -0,0 +1,82 @@
+//============================================================================//
+// File:          qcan_trace.cpp                                              //
+// Description:   QCan classes - trace facility                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <QDateTime>
+
+#include "qcan_trace.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Variables                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+Q_LOGGING_CATEGORY(qcanTraceNetwork, "qcan.network")
+Q_LOGGING_CATEGORY(qcanTracePlugin,  "qcan.plugin")
+Q_LOGGING_CATEGORY(qcanTraceReceive, "qcan.plugin.receive", QtWarningMsg)
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// isDue()                                                                    //
+// check time of rate-limited trace point                                     //
+//----------------------------------------------------------------------------//
+bool QCanTrace::isDue(QAtomicInteger<qint64> & sqNextR)
+{
+   qint64   sqNowT;
+   qint64   sqNextT;
+
+   //----------------------------------------------------------------
+   // the time base is shared by all trace points
+   //
+   sqNowT  = QDateTime::currentMSecsSinceEpoch();
+   sqNextT = sqNextR.load();
+   if (sqNowT < sqNextT)
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // only one thread writes the output if a trace point is reached
+   // by several threads at the same time
+   //
+   return(sqNextR.testAndSetRelaxed(sqNextT, sqNowT + QCAN_TRACE_LIMIT_TIME));
+}
+
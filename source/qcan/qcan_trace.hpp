@@ -0,0 +1,173 @@
+//============================================================================//
+// File:          qcan_trace.hpp                                              //
+// Description:   QCan classes - trace facility                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_TRACE_HPP_
+#define QCAN_TRACE_HPP_
+
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QAtomicInteger>
+#include <QLoggingCategory>
+
+//-------------------------------------------------------------------
+/*!
+** \file qcan_trace.hpp
+**
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_TRACE
+** \brief   Enable trace points
+**
+** The symbol enables (value 1) or disables (value 0) all trace
+** points at compile time. A disabled trace point generates no code.
+** The default value is 0 if debug output is disabled by the symbol
+** QT_NO_DEBUG_OUTPUT (release build), otherwise 1.
+*/
+#ifndef  QCAN_TRACE
+#ifdef   QT_NO_DEBUG_OUTPUT
+#define  QCAN_TRACE                 0
+#else
+#define  QCAN_TRACE                 1
+#endif
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_TRACE_LIMIT_TIME
+** \brief   Minimum time between two rate-limited traces
+**
+** This symbol defines the minimum time in milliseconds between two
+** outputs of the same trace point which uses qCanTraceLimited().
+** Outputs within this time are suppressed.
+*/
+#ifndef  QCAN_TRACE_LIMIT_TIME
+#define  QCAN_TRACE_LIMIT_TIME      1000
+#endif
+
+
+//-------------------------------------------------------------------
+// Trace categories, the output of each category is enabled at
+// run-time via the logging rules of Qt, e.g. by the environment
+// variable QT_LOGGING_RULES="qcan.plugin.receive.debug=true"
+//
+//    qcan.network         : QCanNetwork
+//    qcan.plugin          : CAN interface plugins
+//    qcan.plugin.receive  : receive path of plugins, disabled
+//                           by default
+//
+Q_DECLARE_LOGGING_CATEGORY(qcanTraceNetwork)
+Q_DECLARE_LOGGING_CATEGORY(qcanTracePlugin)
+Q_DECLARE_LOGGING_CATEGORY(qcanTraceReceive)
+
+
+#if QCAN_TRACE > 0
+
+//-------------------------------------------------------------------
+/*!
+** \def     qCanTrace
+** \brief   Trace point
+**
+** The macro is used like qDebug(), the first parameter selects the
+** trace category:
+** \code
+** qCanTrace(qcanTraceNetwork) << "open sockets" << slCountT;
+** \endcode
+** The arguments are only evaluated if the category is enabled.
+*/
+#define  qCanTrace(category)        qCDebug(category)
+
+//-------------------------------------------------------------------
+/*!
+** \def     qCanTraceLimited
+** \brief   Rate-limited trace point
+**
+** The macro is used like qCanTrace(). Each trace point writes at
+** most one output within QCAN_TRACE_LIMIT_TIME, so it can be placed
+** on paths which are executed for every frame.
+*/
+#define  qCanTraceLimited(category)                                     \
+   for (bool btTraceT = (category().isDebugEnabled() &&                 \
+                         []() -> bool {                                 \
+                            static QAtomicInteger<qint64> sqTraceNextT; \
+                            return QCanTrace::isDue(sqTraceNextT);      \
+                         }());                                          \
+        btTraceT; btTraceT = false)                                     \
+      QMessageLogger(QT_MESSAGELOG_FILE, QT_MESSAGELOG_LINE,            \
+                     QT_MESSAGELOG_FUNC,                                \
+                     category().categoryName()).debug()
+
+#else
+
+#define  qCanTrace(category)        QT_NO_QDEBUG_MACRO()
+#define  qCanTraceLimited(category) QT_NO_QDEBUG_MACRO()
+
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanTrace
+** \brief   Trace facility
+**
+** The QCanTrace class provides the helper functions for the trace
+** macros qCanTrace() and qCanTraceLimited(). The output is written
+** via the Qt message handler.
+*/
+class QCanTrace
+{
+public:
+
+   /*!
+   ** \param[in]  sqNextR        Time of next allowed output
+   ** \return     \c true if the trace point may write an output
+   **
+   ** The function checks if QCAN_TRACE_LIMIT_TIME has elapsed since
+   ** the last output of a trace point. The function is thread-safe,
+   ** \c sqNextR is provided by the trace point.
+   */
+   static bool isDue(QAtomicInteger<qint64> & sqNextR);
+};
+
+#endif   // QCAN_TRACE_HPP_
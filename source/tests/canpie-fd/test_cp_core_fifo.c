@@ -0,0 +1,313 @@
+//============================================================================//
+// File:          test_cp_core_fifo.c                                         //
+// Description:   Unit tests for CANpie core FIFO functions                   //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include "cp_core.h"
+#include "cp_msg.h"
+#include "unity_fixture.h"
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------//
+/*!
+** \file    test_cp_core_fifo.c
+** \brief   CANpie test cases for CpCoreFifoRead() / CpCoreFifoWrite()
+**
+** The test cases use the simulated CAN controller of the device
+** template, which is in loop-back mode: messages of a transmit buffer
+** are received by the matching receive buffer.
+*/
+//----------------------------------------------------------------------------//
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#define  FIFO_SIZE               16
+#define  MSG_COUNT               24
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+TEST_GROUP(CP_CORE_FIFO);                    // test group name
+static CpPort_ts     tsPortS;                // CAN port
+static CpFifo_ts     tsRcvFifoS;             // receive FIFO
+static CpFifo_ts     tsTrmFifoS;             // transmit FIFO
+static CpCanMsg_ts   atsRcvFifoMsgS[FIFO_SIZE];
+static CpCanMsg_ts   atsTrmFifoMsgS[FIFO_SIZE];
+static CpCanMsg_ts   atsCanMsgS[MSG_COUNT];  // CAN messages
+
+
+/*----------------------------------------------------------------------------*\
+** Function implementations                                                   **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// TEST_SETUP()                                                               //
+// init code for each test case                                               //
+//----------------------------------------------------------------------------//
+TEST_SETUP(CP_CORE_FIFO)
+{
+   uint8_t  ubCntT;
+
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreDriverInit(eCP_CHANNEL_1, &tsPortS, 0));
+
+   //----------------------------------------------------------------
+   // buffer 1 receives all standard frames, buffer 2 transmits
+   //
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreBufferConfig(&tsPortS, eCP_BUFFER_1, 0x000, 0x000,
+                                        CP_MSG_FORMAT_CBFF, 
+                                        eCP_BUFFER_DIR_RCV));
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreBufferConfig(&tsPortS, eCP_BUFFER_2, 0x000, 0x000,
+                                        CP_MSG_FORMAT_CBFF, 
+                                        eCP_BUFFER_DIR_TRM));
+
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE,
+                     CpFifoInit(&tsRcvFifoS, &atsRcvFifoMsgS[0], FIFO_SIZE));
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE,
+                     CpFifoInit(&tsTrmFifoS, &atsTrmFifoMsgS[0], FIFO_SIZE));
+
+   for(ubCntT = 0; ubCntT < MSG_COUNT; ubCntT++)
+   {
+      CpMsgInit(&atsCanMsgS[ubCntT], CP_MSG_FORMAT_CBFF);
+      CpMsgSetIdentifier(&atsCanMsgS[ubCntT], 0x200 + ubCntT);
+      CpMsgSetDlc(&atsCanMsgS[ubCntT], 1);
+      CpMsgSetData(&atsCanMsgS[ubCntT], 0, ubCntT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TEST_TEAR_DOWN()                                                           //
+// release code for each test case                                            //
+//----------------------------------------------------------------------------//
+TEST_TEAR_DOWN(CP_CORE_FIFO)
+{
+   (void) CpCoreDriverRelease(&tsPortS);
+}
+
+
+//----------------------------------------------------------------------------//
+/*!
+** \brief   CP_CORE_FIFO_001
+** This test shall check the parameter tests of CpCoreFifoConfig(),
+** CpCoreFifoRead() and CpCoreFifoWrite().
+*/
+//----------------------------------------------------------------------------//
+TEST(CP_CORE_FIFO, 001)
+{
+   CpFifo_ts      tsFifoT;
+   uint32_t       ulSizeT;
+
+   //----------------------------------------------------------------
+   // @SubTest01
+   // the FIFO size must be a power of two
+   //
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_SIZE,
+                     CpFifoInit(&tsFifoT, &atsRcvFifoMsgS[0], 12));
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_SIZE, 
+                     CpCoreFifoConfig(&tsPortS, eCP_BUFFER_1, &tsFifoT));
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_PARM, 
+                     CpCoreFifoConfig(&tsPortS, eCP_BUFFER_1, 
+                                      (CpFifo_ts *) 0L));
+   TEST_ASSERT_EQUAL(eCP_ERR_BUFFER, 
+                     CpCoreFifoConfig(&tsPortS, CP_BUFFER_MAX + 1, 
+                                      &tsRcvFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest02
+   // no FIFO assigned
+   //
+   ulSizeT = 4;
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_PARM, 
+                     CpCoreFifoRead(&tsPortS, eCP_BUFFER_1, 
+                                    &atsCanMsgS[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(0, ulSizeT);
+   ulSizeT = 4;
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_PARM, 
+                     CpCoreFifoWrite(&tsPortS, eCP_BUFFER_2, 
+                                     &atsCanMsgS[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(0, ulSizeT);
+
+   //----------------------------------------------------------------
+   // @SubTest03
+   // empty receive FIFO
+   //
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoConfig(&tsPortS, eCP_BUFFER_1, &tsRcvFifoS));
+   ulSizeT = 4;
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_EMPTY, 
+                     CpCoreFifoRead(&tsPortS, eCP_BUFFER_1, 
+                                    &atsCanMsgS[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(0, ulSizeT);
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_PARM, 
+                     CpCoreFifoRead(&tsPortS, eCP_BUFFER_1, 
+                                    &atsCanMsgS[0], (uint32_t *) 0L));
+}
+
+
+//----------------------------------------------------------------------------//
+/*!
+** \brief   CP_CORE_FIFO_002
+** This test shall check the transfer of several messages with one call
+** of CpCoreFifoWrite() and CpCoreFifoRead().
+*/
+//----------------------------------------------------------------------------//
+TEST(CP_CORE_FIFO, 002)
+{
+   uint8_t        ubCntT;
+   uint32_t       ulSizeT;
+   CpCanMsg_ts    atsReadMsgT[MSG_COUNT];
+   CpStatistic_ts tsStatsT;
+
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoConfig(&tsPortS, eCP_BUFFER_1, &tsRcvFifoS));
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoConfig(&tsPortS, eCP_BUFFER_2, &tsTrmFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest01
+   // write 10 messages, they are transmitted and received in the
+   // receive FIFO
+   //
+   ulSizeT = 10;
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoWrite(&tsPortS, eCP_BUFFER_2, 
+                                     &atsCanMsgS[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(10, ulSizeT);
+   TEST_ASSERT_EQUAL_UINT32(10, CpFifoCount(&tsRcvFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest02
+   // read the messages in two calls, the second call returns the
+   // number of available messages
+   //
+   ulSizeT = 4;
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoRead(&tsPortS, eCP_BUFFER_1, 
+                                    &atsReadMsgT[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(4, ulSizeT);
+   ulSizeT = MSG_COUNT;
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoRead(&tsPortS, eCP_BUFFER_1, 
+                                    &atsReadMsgT[4], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(6, ulSizeT);
+   for(ubCntT = 0; ubCntT < 10; ubCntT++)
+   {
+      TEST_ASSERT_EQUAL_UINT32(0x200 + ubCntT, 
+                               CpMsgGetIdentifier(&atsReadMsgT[ubCntT]));
+      TEST_ASSERT_EQUAL_UINT8(ubCntT, CpMsgGetData(&atsReadMsgT[ubCntT], 0));
+   }
+
+   //----------------------------------------------------------------
+   // @SubTest03
+   // more messages than the receive FIFO can hold, the messages
+   // are transmitted but only FIFO_SIZE messages are stored
+   //
+   ulSizeT = MSG_COUNT;
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoWrite(&tsPortS, eCP_BUFFER_2, 
+                                     &atsCanMsgS[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(FIFO_SIZE, ulSizeT);
+   TEST_ASSERT_EQUAL_UINT32(FIFO_SIZE, CpFifoCount(&tsRcvFifoS));
+
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, CpCoreStatistic(&tsPortS, &tsStatsT));
+   TEST_ASSERT_EQUAL_UINT32(10 + FIFO_SIZE, tsStatsT.ulTrmMsgCount);
+}
+
+
+//----------------------------------------------------------------------------//
+/*!
+** \brief   CP_CORE_FIFO_003
+** This test shall check that a full transmit FIFO is reported.
+*/
+//----------------------------------------------------------------------------//
+TEST(CP_CORE_FIFO, 003)
+{
+   uint32_t       ulSizeT;
+
+   //----------------------------------------------------------------
+   // @SubTest01
+   // the FIFO is assigned to a receive buffer, hence the messages
+   // are not transmitted and the FIFO gets full
+   //
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoConfig(&tsPortS, eCP_BUFFER_1, &tsTrmFifoS));
+   ulSizeT = MSG_COUNT;
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, 
+                     CpCoreFifoWrite(&tsPortS, eCP_BUFFER_1, 
+                                     &atsCanMsgS[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(FIFO_SIZE, ulSizeT);
+
+   ulSizeT = 1;
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_FULL, 
+                     CpCoreFifoWrite(&tsPortS, eCP_BUFFER_1, 
+                                     &atsCanMsgS[0], &ulSizeT));
+   TEST_ASSERT_EQUAL_UINT32(0, ulSizeT);
+
+   //----------------------------------------------------------------
+   // @SubTest02
+   // after release of the FIFO no messages are transferred
+   //
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE, CpCoreFifoRelease(&tsPortS, eCP_BUFFER_1));
+   ulSizeT = 1;
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_PARM, 
+                     CpCoreFifoRead(&tsPortS, eCP_BUFFER_1, 
+                                    &atsCanMsgS[0], &ulSizeT));
+}
+
+
+//----------------------------------------------------------------------------//
+// TEST_GROUP_RUNNER()                                                        //
+// execute all test cases                                                     //
+//----------------------------------------------------------------------------//
+TEST_GROUP_RUNNER(CP_CORE_FIFO)
+{
+   UnityPrint("*************** RUN  TEST  GROUP  CP_CORE_FIFO: **************");
+   printf("\n");
+   RUN_TEST_CASE(CP_CORE_FIFO, 001);
+   RUN_TEST_CASE(CP_CORE_FIFO, 002);
+   RUN_TEST_CASE(CP_CORE_FIFO, 003);
+   printf("\n");
+}
+
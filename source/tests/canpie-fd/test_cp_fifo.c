@@ -0,0 +1,298 @@
+//============================================================================//
+// File:          test_cp_fifo.c                                              //
+// Description:   Unit tests for CANpie FIFO functions                        //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include "cp_fifo.h"
+#include "cp_msg.h"
+#include "unity_fixture.h"
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------//
+/*!
+** \file    test_cp_fifo.c
+** \brief   CANpie test cases for FIFO functions
+**
+**
+*/
+//----------------------------------------------------------------------------//
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#define  FIFO_SIZE               8
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+TEST_GROUP(CP_FIFO);                         // test group name
+static CpFifo_ts     tsCanFifoS;             // FIFO
+static CpCanMsg_ts   atsFifoMsgS[FIFO_SIZE]; // FIFO entries
+static CpCanMsg_ts   atsCanMsgS[FIFO_SIZE];  // CAN messages
+
+
+/*----------------------------------------------------------------------------*\
+** Function implementations                                                   **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// TEST_SETUP()                                                               //
+// init code for each test case                                               //
+//----------------------------------------------------------------------------//
+TEST_SETUP(CP_FIFO)
+{
+   uint8_t  ubCntT;
+
+   TEST_ASSERT_EQUAL(eCP_ERR_NONE,
+                     CpFifoInit(&tsCanFifoS, &atsFifoMsgS[0], FIFO_SIZE));
+   for(ubCntT = 0; ubCntT < FIFO_SIZE; ubCntT++)
+   {
+      CpMsgInit(&atsCanMsgS[ubCntT], CP_MSG_FORMAT_CBFF);
+      CpMsgSetIdentifier(&atsCanMsgS[ubCntT], 0x100 + ubCntT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TEST_TEAR_DOWN()                                                           //
+// release code for each test case                                            //
+//----------------------------------------------------------------------------//
+TEST_TEAR_DOWN(CP_FIFO)
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+/*!
+** \brief   CP_FIFO_001
+** This test shall check that all entries of the FIFO can be used with
+** the FIFO macros.
+*/
+//----------------------------------------------------------------------------//
+TEST(CP_FIFO, 001)
+{
+   uint8_t        ubCntT;
+   CpCanMsg_ts *  ptsCanMsgT;
+
+   //----------------------------------------------------------------
+   // @SubTest01
+   // new FIFO is empty
+   //
+   TEST_ASSERT_EQUAL(1, CpFifoIsEmpty(&tsCanFifoS));
+   TEST_ASSERT_EQUAL(0, CpFifoIsFull(&tsCanFifoS));
+   TEST_ASSERT_EQUAL_UINT32(0, CpFifoCount(&tsCanFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest02
+   // fill all entries
+   //
+   for(ubCntT = 0; ubCntT < FIFO_SIZE; ubCntT++)
+   {
+      TEST_ASSERT_EQUAL(0, CpFifoIsFull(&tsCanFifoS));
+      ptsCanMsgT = CpFifoDataInPtr(&tsCanFifoS);
+      memcpy(ptsCanMsgT, &atsCanMsgS[ubCntT], sizeof(CpCanMsg_ts));
+      CpFifoIncIn(&tsCanFifoS);
+   }
+   TEST_ASSERT_EQUAL(1, CpFifoIsFull(&tsCanFifoS));
+   TEST_ASSERT_EQUAL_UINT32(FIFO_SIZE, CpFifoCount(&tsCanFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest03
+   // read all entries in the same order
+   //
+   for(ubCntT = 0; ubCntT < FIFO_SIZE; ubCntT++)
+   {
+      TEST_ASSERT_EQUAL(0, CpFifoIsEmpty(&tsCanFifoS));
+      ptsCanMsgT = CpFifoDataOutPtr(&tsCanFifoS);
+      TEST_ASSERT_EQUAL_UINT32(0x100 + ubCntT, CpMsgGetIdentifier(ptsCanMsgT));
+      CpFifoIncOut(&tsCanFifoS);
+   }
+   TEST_ASSERT_EQUAL(1, CpFifoIsEmpty(&tsCanFifoS));
+}
+
+
+//----------------------------------------------------------------------------//
+/*!
+** \brief   CP_FIFO_002
+** This test shall check the bulk functions CpFifoPush() and CpFifoPop(),
+** including a copy which wraps around at the end of the buffer.
+*/
+//----------------------------------------------------------------------------//
+TEST(CP_FIFO, 002)
+{
+   uint8_t        ubCntT;
+   CpCanMsg_ts    atsReadMsgT[FIFO_SIZE];
+
+   //----------------------------------------------------------------
+   // @SubTest01
+   // invalid pointers
+   //
+   TEST_ASSERT_EQUAL_UINT32(0, CpFifoPush((CpFifo_ts *) 0L, 
+                                          &atsCanMsgS[0], 1));
+   TEST_ASSERT_EQUAL_UINT32(0, CpFifoPop(&tsCanFifoS, 
+                                         (CpCanMsg_ts *) 0L, 1));
+
+   //----------------------------------------------------------------
+   // @SubTest02
+   // move the indices to the middle of the buffer
+   //
+   TEST_ASSERT_EQUAL_UINT32(5, CpFifoPush(&tsCanFifoS, &atsCanMsgS[0], 5));
+   TEST_ASSERT_EQUAL_UINT32(5, CpFifoPop(&tsCanFifoS, &atsReadMsgT[0], 8));
+   TEST_ASSERT_EQUAL(1, CpFifoIsEmpty(&tsCanFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest03
+   // write more messages than free entries, the write wraps around
+   //
+   TEST_ASSERT_EQUAL_UINT32(6, CpFifoPush(&tsCanFifoS, &atsCanMsgS[0], 6));
+   TEST_ASSERT_EQUAL_UINT32(2, CpFifoPush(&tsCanFifoS, &atsCanMsgS[6], 5));
+   TEST_ASSERT_EQUAL(1, CpFifoIsFull(&tsCanFifoS));
+   TEST_ASSERT_EQUAL_UINT32(0, CpFifoPush(&tsCanFifoS, &atsCanMsgS[0], 1));
+
+   //----------------------------------------------------------------
+   // @SubTest04
+   // read all messages, the read wraps around
+   //
+   TEST_ASSERT_EQUAL_UINT32(FIFO_SIZE, CpFifoPop(&tsCanFifoS, 
+                                                 &atsReadMsgT[0], FIFO_SIZE));
+   for(ubCntT = 0; ubCntT < FIFO_SIZE; ubCntT++)
+   {
+      TEST_ASSERT_EQUAL_UINT32(0x100 + ubCntT, 
+                               CpMsgGetIdentifier(&atsReadMsgT[ubCntT]));
+   }
+   TEST_ASSERT_EQUAL_UINT32(0, CpFifoPop(&tsCanFifoS, &atsReadMsgT[0], 1));
+}
+
+
+//----------------------------------------------------------------------------//
+/*!
+** \brief   CP_FIFO_003
+** This test shall check the overflow of the free-running indices.
+*/
+//----------------------------------------------------------------------------//
+TEST(CP_FIFO, 003)
+{
+   CpCanMsg_ts    atsReadMsgT[FIFO_SIZE];
+
+   //----------------------------------------------------------------
+   // @SubTest01
+   // start with indices close to the maximum value
+   //
+   CpFifoStoreRelease(&(tsCanFifoS.ulIndexIn),  0xFFFFFFFEUL);
+   CpFifoStoreRelease(&(tsCanFifoS.ulIndexOut), 0xFFFFFFFEUL);
+   TEST_ASSERT_EQUAL(1, CpFifoIsEmpty(&tsCanFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest02
+   // the input index overflows
+   //
+   TEST_ASSERT_EQUAL_UINT32(4, CpFifoPush(&tsCanFifoS, &atsCanMsgS[0], 4));
+   TEST_ASSERT_EQUAL_UINT32(4, CpFifoCount(&tsCanFifoS));
+   TEST_ASSERT_EQUAL_UINT32(2, CpFifoLoadRelaxed(&(tsCanFifoS.ulIndexIn)));
+   TEST_ASSERT_EQUAL_UINT32(4, CpFifoPush(&tsCanFifoS, &atsCanMsgS[4], 8));
+   TEST_ASSERT_EQUAL(1, CpFifoIsFull(&tsCanFifoS));
+
+   //----------------------------------------------------------------
+   // @SubTest03
+   // the output index overflows
+   //
+   TEST_ASSERT_EQUAL_UINT32(3, CpFifoPop(&tsCanFifoS, &atsReadMsgT[0], 3));
+   TEST_ASSERT_EQUAL_UINT32(0x102, CpMsgGetIdentifier(&atsReadMsgT[2]));
+   TEST_ASSERT_EQUAL_UINT32(5, CpFifoCount(&tsCanFifoS));
+   TEST_ASSERT_EQUAL_UINT32(5, CpFifoPop(&tsCanFifoS, &atsReadMsgT[0], 8));
+   TEST_ASSERT_EQUAL_UINT32(0x107, CpMsgGetIdentifier(&atsReadMsgT[4]));
+   TEST_ASSERT_EQUAL(1, CpFifoIsEmpty(&tsCanFifoS));
+}
+
+
+//----------------------------------------------------------------------------//
+/*!
+** \brief   CP_FIFO_004
+** This test shall check a FIFO size which is not a power of two.
+*/
+//----------------------------------------------------------------------------//
+TEST(CP_FIFO, 004)
+{
+   CpCanMsg_ts    atsReadMsgT[FIFO_SIZE];
+
+   //----------------------------------------------------------------
+   // @SubTest01
+   // the size is rejected and the FIFO has no entries, so the
+   // message buffer is never accessed with a masked index beyond
+   // its size
+   //
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_SIZE,
+                     CpFifoInit(&tsCanFifoS, &atsFifoMsgS[0], FIFO_SIZE - 2));
+   TEST_ASSERT_EQUAL_UINT32(0, tsCanFifoS.ulIndexMax);
+   TEST_ASSERT_EQUAL(1, CpFifoIsEmpty(&tsCanFifoS));
+   TEST_ASSERT_EQUAL(1, CpFifoIsFull(&tsCanFifoS));
+   TEST_ASSERT_EQUAL_UINT32(0, CpFifoPush(&tsCanFifoS, &atsCanMsgS[0], 4));
+   TEST_ASSERT_EQUAL_UINT32(0, CpFifoPop(&tsCanFifoS, &atsReadMsgT[0], 4));
+
+   //----------------------------------------------------------------
+   // @SubTest02
+   // invalid parameters
+   //
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_SIZE,
+                     CpFifoInit(&tsCanFifoS, &atsFifoMsgS[0], 0));
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_PARM,
+                     CpFifoInit((CpFifo_ts *) 0L, &atsFifoMsgS[0], FIFO_SIZE));
+   TEST_ASSERT_EQUAL(eCP_ERR_FIFO_PARM,
+                     CpFifoInit(&tsCanFifoS, (CpCanMsg_ts *) 0L, FIFO_SIZE));
+}
+
+
+//----------------------------------------------------------------------------//
+// TEST_GROUP_RUNNER()                                                        //
+// execute all test cases                                                     //
+//----------------------------------------------------------------------------//
+TEST_GROUP_RUNNER(CP_FIFO)
+{
+   UnityPrint("*************** RUN  TEST  GROUP  CP_FIFO: *******************");
+   printf("\n");
+   RUN_TEST_CASE(CP_FIFO, 001);
+   RUN_TEST_CASE(CP_FIFO, 002);
+   RUN_TEST_CASE(CP_FIFO, 003);
+   RUN_TEST_CASE(CP_FIFO, 004);
+   printf("\n");
+}
+
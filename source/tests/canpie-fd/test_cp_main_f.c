@@ -18,6 +18,8 @@
 static void RunAllTests(void)
 {
 
+   RUN_TEST_GROUP(CP_CORE_FIFO);
+   RUN_TEST_GROUP(CP_FIFO);
    RUN_TEST_GROUP(CP_MSG_CCF);
    RUN_TEST_GROUP(CP_MSG_FDF);
 
@@ -9,8 +9,18 @@ using namespace std;
 
 
 #include "test_qcan_timestamp.hpp"
+#include "test_qcan_bus_load.hpp"
+#include "test_qcan_data.hpp"
+#include "test_qcan_filter_index.hpp"
 #include "test_qcan_frame.hpp"
+#include "test_qcan_frame_queue.hpp"
+#include "test_qcan_recorder.hpp"
+#include "test_qcan_scheduler.hpp"
+#include "test_qcan_shared_ring.hpp"
 #include "test_qcan_socket.hpp"
+#ifdef QCAN_TEST_CANPIE_V2
+#include "test_qcan_socket_canpie_v2.hpp"
+#endif
 
 
 int main(int argc, char *argv[])
@@ -31,6 +41,56 @@ int main(int argc, char *argv[])
    TestQCanTimestamp  clTestQCanTimestampT;
    slResultT = QTest::qExec(&clTestQCanTimestampT, argc, &argv[0]);
 
+   //----------------------------------------------------------------
+   // test QCanData
+   //
+   TestQCanData  clTestQCanDataT;
+   slResultT = QTest::qExec(&clTestQCanDataT, argc, &argv[0]) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanBusLoad
+   //
+   TestQCanBusLoad  clTestQCanBusLoadT;
+   slResultT = QTest::qExec(&clTestQCanBusLoadT, argc, &argv[0]) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanFilterIndex
+   //
+   TestQCanFilterIndex  clTestQCanFilterIndexT;
+   slResultT = QTest::qExec(&clTestQCanFilterIndexT, argc, &argv[0]) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanSharedRing
+   //
+   TestQCanSharedRing  clTestQCanSharedRingT;
+   slResultT = QTest::qExec(&clTestQCanSharedRingT, argc, &argv[0]) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanFrameQueue
+   //
+   TestQCanFrameQueue  clTestQCanFrameQueueT;
+   slResultT = QTest::qExec(&clTestQCanFrameQueueT, argc, &argv[0]) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanScheduler
+   //
+   TestQCanScheduler  clTestQCanSchedulerT;
+   slResultT = QTest::qExec(&clTestQCanSchedulerT, argc, &argv[0]) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanRecorder
+   //
+   TestQCanRecorder  clTestQCanRecorderT;
+   slResultT = QTest::qExec(&clTestQCanRecorderT, argc, &argv[0]) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanSocketCp2
+   //
+#ifdef QCAN_TEST_CANPIE_V2
+   TestQCanSocketCp2  clTestQCanSocketCp2T;
+   slResultT = QTest::qExec(&clTestQCanSocketCp2T, argc, &argv[0]) + slResultT;
+#endif
+
    //----------------------------------------------------------------
    // test QCanFrame
    //
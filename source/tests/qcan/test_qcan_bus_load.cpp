@@ -0,0 +1,253 @@
+//============================================================================//
+// File:          test_qcan_bus_load.cpp                                      //
+// Description:   QCAN classes - Test bus load calculation                    //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+
+
+
+#include "test_qcan_bus_load.hpp"
+
+
+TestQCanBusLoad::TestQCanBusLoad()
+{
+
+}
+
+
+TestQCanBusLoad::~TestQCanBusLoad()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::initTestCase()
+{
+   pclBusLoadP = new QCanBusLoad();
+}
+
+
+//----------------------------------------------------------------------------//
+// checkBitrate()                                                             //
+// check conversion of bit-rate values                                        //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkBitrate()
+{
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_NONE) == 0);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_10K)  == 10000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_800K) == 800000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_1M)   == 1000000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_AUTO) == 0);
+   QVERIFY(QCanBusLoad::bitrateValue(2000000)           == 2000000);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkWorstCase()                                                           //
+// check frame length with worst-case bit stuffing                            //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkWorstCase()
+{
+   QCanFrame   clFrameT;
+   uint32_t    ulDataBitsT;
+
+   //----------------------------------------------------------------
+   // standard frame with 8 data bytes: 135 bits
+   //
+   clFrameT = QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   QVERIFY(QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_WORST_CASE,
+                                  ulDataBitsT) == 135);
+   QVERIFY(ulDataBitsT == 0);
+
+   //----------------------------------------------------------------
+   // extended frame with 8 data bytes: 160 bits
+   //
+   clFrameT = QCanFrame(QCanFrame::eFORMAT_CAN_EXT, 0x123, 8);
+   QVERIFY(QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_WORST_CASE,
+                                  ulDataBitsT) == 160);
+
+   //----------------------------------------------------------------
+   // standard frame without data: 55 bits, a remote frame has
+   // no data field
+   //
+   clFrameT = QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x123, 0);
+   QVERIFY(QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_WORST_CASE,
+                                  ulDataBitsT) == 55);
+   clFrameT = QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   clFrameT.setRemote();
+   QVERIFY(QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_WORST_CASE,
+                                  ulDataBitsT) == 55);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkActualStuffing()                                                      //
+// check frame length with stuff bits of the bit stream                       //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkActualStuffing()
+{
+   QCanFrame   clFrameT;
+   uint32_t    ulDataBitsT;
+   uint32_t    ulBitsT;
+   uint8_t     ubCntT;
+
+   //----------------------------------------------------------------
+   // alternating bits need no stuff bits in the data field
+   //
+   clFrameT = QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x555, 8);
+   for(ubCntT = 0; ubCntT < 8; ubCntT++)
+   {
+      clFrameT.setData(ubCntT, 0x55);
+   }
+   ulBitsT = QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_ACTUAL,
+                                    ulDataBitsT);
+   QVERIFY(ulBitsT >= 111);
+   QVERIFY(ulBitsT <  135);
+
+   //----------------------------------------------------------------
+   // zero data bytes need a stuff bit after every 5 bits
+   //
+   for(ubCntT = 0; ubCntT < 8; ubCntT++)
+   {
+      clFrameT.setData(ubCntT, 0x00);
+   }
+   QVERIFY(QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_ACTUAL,
+                                  ulDataBitsT) > ulBitsT + 10);
+
+   //----------------------------------------------------------------
+   // the actual number of bits never exceeds the worst case
+   //
+   qsrand(1);
+   for(ubCntT = 0; ubCntT < 200; ubCntT++)
+   {
+      clFrameT = QCanFrame((QCanFrame::Format_e) (ubCntT & 3), 
+                           (uint32_t) qrand() & 0x1FFFFFFF, 
+                           (uint8_t) (qrand() & 0x0F));
+      clFrameT.setBitrateSwitch((ubCntT & 4) != 0);
+      for(uint8_t ubPosT = 0; ubPosT < clFrameT.dataSize(); ubPosT++)
+      {
+         clFrameT.setData(ubPosT, (uint8_t) qrand());
+      }
+      QVERIFY(QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_ACTUAL,
+                                     ulDataBitsT) <=
+              QCanBusLoad::frameBits(clFrameT, 
+                                     QCanBusLoad::eSTUFFING_WORST_CASE,
+                                     ulDataBitsT));
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// checkFastData()                                                            //
+// check data phase of CAN FD frames                                          //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkFastData()
+{
+   QCanFrame   clFrameT;
+   uint32_t    ulDataBitsT;
+   uint32_t    ulBitsT;
+   uint32_t    ulTimeT;
+
+   //----------------------------------------------------------------
+   // without bit-rate switch there is no data phase
+   //
+   clFrameT = QCanFrame(QCanFrame::eFORMAT_FD_STD, 0x123, 15);
+   ulBitsT  = QCanBusLoad::frameBits(clFrameT, 
+                                     QCanBusLoad::eSTUFFING_WORST_CASE,
+                                     ulDataBitsT);
+   QVERIFY(ulDataBitsT == 0);
+   QVERIFY(ulBitsT > 512 + 21);
+
+   //----------------------------------------------------------------
+   // with bit-rate switch the data phase covers data and CRC field
+   //
+   clFrameT.setBitrateSwitch();
+   QVERIFY(QCanBusLoad::frameBits(clFrameT, QCanBusLoad::eSTUFFING_WORST_CASE,
+                                  ulDataBitsT) == ulBitsT);
+   QVERIFY(ulDataBitsT > 512 + 21);
+   QVERIFY(ulDataBitsT < ulBitsT);
+
+   //----------------------------------------------------------------
+   // the data phase is faster with a higher data bit-rate
+   //
+   pclBusLoadP->setBitrate(eCAN_BITRATE_500K, eCAN_BITRATE_NONE);
+   ulTimeT = pclBusLoadP->frameTime(clFrameT);
+   pclBusLoadP->setBitrate(eCAN_BITRATE_500K, 2000000);
+   QVERIFY(pclBusLoadP->frameTime(clFrameT) < ulTimeT / 2);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkLoad()                                                                //
+// check bus load calculation                                                 //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkLoad()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   uint32_t    ulCntT;
+
+   pclBusLoadP->reset();
+   pclBusLoadP->setBitrate(eCAN_BITRATE_500K, eCAN_BITRATE_NONE);
+   pclBusLoadP->setStuffing(QCanBusLoad::eSTUFFING_WORST_CASE);
+
+   //----------------------------------------------------------------
+   // 135 bits at 500 kBit/s take 270 us
+   //
+   QVERIFY(pclBusLoadP->frameTime(clFrameT) == 270000);
+
+   //----------------------------------------------------------------
+   // 1000 frames in one second are 27 % bus load, 100 frames in
+   // a window of 20 ms saturate the bus
+   //
+   for(ulCntT = 0; ulCntT < 1000; ulCntT++)
+   {
+      pclBusLoadP->addFrame(clFrameT);
+   }
+   QVERIFY(pclBusLoadP->windowLoad(20000000) == 100);
+   QVERIFY(pclBusLoadP->periodLoad(1000000000) == 27);
+
+   //----------------------------------------------------------------
+   // both values are cleared after reading
+   //
+   QVERIFY(pclBusLoadP->windowLoad(20000000) == 0);
+   QVERIFY(pclBusLoadP->periodLoad(1000000000) == 0);
+
+   pclBusLoadP->setStuffing(QCanBusLoad::eSTUFFING_ACTUAL);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::cleanupTestCase()
+{
+   delete(pclBusLoadP);
+}
+
@@ -241,6 +241,329 @@ void TestQCanData::checkByteArray()
 }
 
 
+//----------------------------------------------------------------------------//
+// checkByteArrayCompact()                                                    //
+// check frame data in compact encoding                                       //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkByteArrayCompact()
+{
+   QByteArray  clByteArrayT;
+
+   //----------------------------------------------------------------
+   // convert CAN frame to byte array in compact encoding: header,
+   // time stamp, user, marker, payload and checksum
+   //
+   clByteArrayT = pclCanFrameP->toByteArrayCompact();
+   QVERIFY(QCanData::isCompactArray(clByteArrayT) == true);
+   QCOMPARE(clByteArrayT.size(), QCAN_FRAME_COMPACT_HEADER + 16 +
+                                 DLC_TEST_VALUE + 2);
+   QCOMPARE(QCanData::byteArraySize(clByteArrayT), clByteArrayT.size());
+   QVERIFY(QCanData::isCompactArray(pclCanFrameP->toByteArray()) == false);
+
+   //----------------------------------------------------------------
+   // a compact CAN frame must not be converted to other classes
+   //
+   QCanFrameApi      clCanApiCheckT;
+   QCanFrameError    clCanErrorCheckT;
+   QVERIFY(clCanApiCheckT.fromByteArray(clByteArrayT)   == false);
+   QVERIFY(clCanErrorCheckT.fromByteArray(clByteArrayT) == false);
+
+   //----------------------------------------------------------------
+   // convert back to QCanFrame and check the contents
+   //
+   QCanFrame      clCanFrameCheckT;
+   QVERIFY(clCanFrameCheckT.fromByteArray(clByteArrayT) == true);
+   QVERIFY(clCanFrameCheckT.identifier() == ID_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.dlc()        == DLC_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.marker()     == MARKER_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.user()       == USER_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.timeStamp().seconds()     == TIME_STAMP_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.timeStamp().nanoSeconds() == TIME_STAMP_TEST_VALUE);
+   for (uint8_t ubCntT = 0; ubCntT < DLC_TEST_VALUE; ubCntT++)
+   {
+      QVERIFY(clCanFrameCheckT.data(ubCntT) == DATA_TEST_VALUE + ubCntT);
+   }
+
+   //----------------------------------------------------------------
+   // a wrong checksum must be detected
+   //
+   clByteArrayT[QCAN_FRAME_COMPACT_HEADER] = 0x55;
+   QVERIFY(clCanFrameCheckT.fromByteArray(clByteArrayT) == false);
+
+   //----------------------------------------------------------------
+   // convert API frame and error frame
+   //
+   clByteArrayT = pclCanApiP->toByteArrayCompact();
+   QVERIFY(clCanApiCheckT.fromByteArray(clByteArrayT) == true);
+   QString  clNameT;
+   QVERIFY(clCanApiCheckT.name(clNameT) == true);
+   QCOMPARE(clNameT, QString(API_TEST_VALUE));
+
+   clByteArrayT = pclCanErrorP->toByteArrayCompact();
+   QVERIFY(clCanErrorCheckT.fromByteArray(clByteArrayT) == true);
+   QVERIFY(clCanErrorCheckT.errorState() == eCAN_STATE_BUS_WARN);
+   QVERIFY(clCanErrorCheckT.errorCounterReceive() == 96);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkApiFilter()                                                           //
+// check API frame with acceptance filter entries                             //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkApiFilter()
+{
+   QByteArray     clByteArrayT;
+   QCanFrameApi   clCanApiT;
+   QCanFrameApi   clCanApiCheckT;
+   uint32_t       ulIdentifierT;
+   uint32_t       ulMaskT;
+   bool           btExtendedT;
+   uint8_t        ubEntryT;
+
+   //----------------------------------------------------------------
+   // entries can only be added to a filter frame
+   //
+   QVERIFY(clCanApiT.appendFilter(0x123, 0x7FF, false) == false);
+   clCanApiT.setFilter();
+   QCOMPARE(clCanApiT.filterCount(), (uint8_t) 0);
+   QVERIFY(clCanApiT.filterAppend() == false);
+
+   //----------------------------------------------------------------
+   // fill the frame, the last entry must be rejected
+   //
+   QVERIFY(clCanApiT.appendFilter(0x123, 0x7FF, false) == true);
+   QVERIFY(clCanApiT.appendFilter(0x18FF1234, 0x1FFFFF00, true) == true);
+   for(ubEntryT = 2; ubEntryT < QCAN_FILTER_API_ENTRY_MAX; ubEntryT++)
+   {
+      QVERIFY(clCanApiT.appendFilter(ubEntryT, 0x700, false) == true);
+   }
+   QVERIFY(clCanApiT.appendFilter(0x7FF, 0x7FF, false) == false);
+   QCOMPARE(clCanApiT.filterCount(), (uint8_t) QCAN_FILTER_API_ENTRY_MAX);
+
+   //----------------------------------------------------------------
+   // the entries must pass the fixed and the compact encoding
+   //
+   clByteArrayT = clCanApiT.toByteArray();
+   QVERIFY(clCanApiCheckT.fromByteArray(clByteArrayT) == true);
+   QVERIFY(clCanApiCheckT.function() == QCanFrameApi::eAPI_FUNC_FILTER);
+   QCOMPARE(clCanApiCheckT.filterCount(), (uint8_t) QCAN_FILTER_API_ENTRY_MAX);
+
+   clByteArrayT = clCanApiT.toByteArrayCompact();
+   QVERIFY(clCanApiCheckT.fromByteArray(clByteArrayT) == true);
+   QCOMPARE(clCanApiCheckT.filterCount(), (uint8_t) QCAN_FILTER_API_ENTRY_MAX);
+
+   QVERIFY(clCanApiCheckT.filter(0, ulIdentifierT, ulMaskT, btExtendedT));
+   QCOMPARE(ulIdentifierT, (uint32_t) 0x123);
+   QCOMPARE(ulMaskT,       (uint32_t) 0x7FF);
+   QVERIFY(btExtendedT == false);
+
+   QVERIFY(clCanApiCheckT.filter(1, ulIdentifierT, ulMaskT, btExtendedT));
+   QCOMPARE(ulIdentifierT, (uint32_t) 0x18FF1234);
+   QCOMPARE(ulMaskT,       (uint32_t) 0x1FFFFF00);
+   QVERIFY(btExtendedT == true);
+
+   QVERIFY(clCanApiCheckT.filter(QCAN_FILTER_API_ENTRY_MAX, ulIdentifierT,
+                                 ulMaskT, btExtendedT) == false);
+
+   //----------------------------------------------------------------
+   // append flag
+   //
+   clCanApiT.setFilter(true);
+   QCOMPARE(clCanApiT.filterCount(), (uint8_t) 0);
+   clCanApiCheckT.fromByteArray(clCanApiT.toByteArray());
+   QVERIFY(clCanApiCheckT.filterAppend() == true);
+   QCOMPARE(clCanApiCheckT.filterCount(), (uint8_t) 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkApiQueueStatus()                                                      //
+// check API frame with send queue status                                     //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkApiQueueStatus()
+{
+   QCanFrameApi   clCanApiT;
+   QCanFrameApi   clCanApiCheckT;
+   uint32_t       ulDepthT;
+   uint32_t       ulLimitT;
+   uint32_t       ulDroppedT;
+   uint8_t        ubPolicyT;
+
+   //----------------------------------------------------------------
+   // a request holds no status values
+   //
+   clCanApiT.setQueueStatus();
+   QVERIFY(clCanApiCheckT.fromByteArray(clCanApiT.toByteArray()) == true);
+   QVERIFY(clCanApiCheckT.function() == QCanFrameApi::eAPI_FUNC_QUEUE_STATUS);
+   QVERIFY(clCanApiCheckT.queueStatus(ulDepthT, ulLimitT, 
+                                      ulDroppedT, ubPolicyT) == false);
+
+   //----------------------------------------------------------------
+   // the answer must pass the fixed and the compact encoding
+   //
+   clCanApiT.setQueueStatus(1234, QCAN_NETWORK_QUEUE_SIZE, 0x12345678,
+                            QCAN_SEND_POLICY_DISCONNECT);
+   QVERIFY(clCanApiCheckT.fromByteArray(clCanApiT.toByteArray()) == true);
+   QVERIFY(clCanApiCheckT.queueStatus(ulDepthT, ulLimitT, 
+                                      ulDroppedT, ubPolicyT) == true);
+   QCOMPARE(ulDepthT,   (uint32_t) 1234);
+   QCOMPARE(ulLimitT,   (uint32_t) QCAN_NETWORK_QUEUE_SIZE);
+   QCOMPARE(ulDroppedT, (uint32_t) 0x12345678);
+   QCOMPARE(ubPolicyT,  QCAN_SEND_POLICY_DISCONNECT);
+
+   QVERIFY(clCanApiCheckT.fromByteArray(clCanApiT.toByteArrayCompact()));
+   QVERIFY(clCanApiCheckT.queueStatus(ulDepthT, ulLimitT, 
+                                      ulDroppedT, ubPolicyT) == true);
+   QCOMPARE(ulDroppedT, (uint32_t) 0x12345678);
+
+   //----------------------------------------------------------------
+   // other API functions hold no queue status
+   //
+   clCanApiT.setWireFormat(QCAN_WIRE_FORMAT_COMPACT);
+   QVERIFY(clCanApiT.queueStatus(ulDepthT, ulLimitT, 
+                                 ulDroppedT, ubPolicyT) == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkByteArrayBuffer()                                                     //
+// check conversion with buffer provided by the caller                        //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkByteArrayBuffer()
+{
+   char        achBufferT[QCAN_FRAME_ARRAY_SIZE];
+   int32_t     slSizeT;
+   QCanFrame   clCanFrameCheckT;
+
+   //----------------------------------------------------------------
+   // a buffer which is too small must be rejected
+   //
+   QCOMPARE(pclCanFrameP->toByteArray(&achBufferT[0], 
+                                      QCAN_FRAME_ARRAY_SIZE - 1), 0);
+
+   //----------------------------------------------------------------
+   // the buffer must hold the same data as the byte array
+   //
+   slSizeT = pclCanFrameP->toByteArray(&achBufferT[0], QCAN_FRAME_ARRAY_SIZE);
+   QCOMPARE(slSizeT, QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(QByteArray(&achBufferT[0], slSizeT) == pclCanFrameP->toByteArray());
+   QVERIFY(clCanFrameCheckT.fromByteArray(&achBufferT[0], slSizeT) == true);
+   QVERIFY(clCanFrameCheckT.identifier() == ID_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.marker()     == MARKER_TEST_VALUE);
+
+   slSizeT = pclCanFrameP->toByteArrayCompact(&achBufferT[0], 
+                                              QCAN_FRAME_ARRAY_SIZE);
+   QCOMPARE(QByteArray(&achBufferT[0], slSizeT), 
+            pclCanFrameP->toByteArrayCompact());
+   QCOMPARE(QCanData::byteArraySize(&achBufferT[0], slSizeT), slSizeT);
+   QVERIFY(clCanFrameCheckT.fromByteArray(&achBufferT[0], slSizeT) == true);
+   QVERIFY(clCanFrameCheckT.user()       == USER_TEST_VALUE);
+
+   //----------------------------------------------------------------
+   // an incomplete frame must be rejected
+   //
+   QVERIFY(clCanFrameCheckT.fromByteArray(&achBufferT[0], slSizeT - 1) 
+           == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// benchByteArray()                                                           //
+// frame conversion with QByteArray objects                                   //
+//----------------------------------------------------------------------------//
+void TestQCanData::benchByteArray()
+{
+   QByteArray  clByteArrayT;
+   QCanFrame   clCanFrameCheckT;
+
+   QBENCHMARK
+   {
+      clByteArrayT = pclCanFrameP->toByteArray();
+      clCanFrameCheckT.fromByteArray(clByteArrayT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// benchByteArrayBuffer()                                                     //
+// frame conversion with buffer on the stack                                  //
+//----------------------------------------------------------------------------//
+void TestQCanData::benchByteArrayBuffer()
+{
+   char        achBufferT[QCAN_FRAME_ARRAY_SIZE];
+   QCanFrame   clCanFrameCheckT;
+
+   QBENCHMARK
+   {
+      pclCanFrameP->toByteArray(&achBufferT[0], QCAN_FRAME_ARRAY_SIZE);
+      clCanFrameCheckT.fromByteArray(&achBufferT[0], QCAN_FRAME_ARRAY_SIZE);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// checkChecksum()                                                            //
+// check checksum calculation and frames without checksum                     //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkChecksum()
+{
+   char        achBufferT[QCAN_FRAME_ARRAY_SIZE];
+   int32_t     slSizeT;
+   QCanFrame   clCanFrameCheckT;
+
+   //----------------------------------------------------------------
+   // the table driven checksum must be identical to qChecksum()
+   //
+   pclCanFrameP->toByteArray(&achBufferT[0], QCAN_FRAME_ARRAY_SIZE);
+   for(slSizeT = 0; slSizeT <= QCAN_FRAME_ARRAY_SIZE; slSizeT++)
+   {
+      QCOMPARE(QCanData::checksum(&achBufferT[0], slSizeT), 
+               qChecksum(&achBufferT[0], slSizeT));
+   }
+
+   //----------------------------------------------------------------
+   // fixed encoding without checksum
+   //
+   slSizeT = pclCanFrameP->toByteArray(&achBufferT[0], QCAN_FRAME_ARRAY_SIZE,
+                                       false);
+   QCOMPARE(slSizeT, QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(clCanFrameCheckT.fromByteArray(&achBufferT[0], slSizeT) == true);
+   QVERIFY(clCanFrameCheckT.identifier() == ID_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.marker()     == MARKER_TEST_VALUE);
+
+   //----------------------------------------------------------------
+   // compact encoding without checksum is 2 bytes shorter
+   //
+   slSizeT = pclCanFrameP->toByteArrayCompact(&achBufferT[0], 
+                                              QCAN_FRAME_ARRAY_SIZE, false);
+   QCOMPARE(slSizeT, pclCanFrameP->toByteArrayCompact().size() - 2);
+   QCOMPARE(QCanData::byteArraySize(&achBufferT[0], slSizeT), slSizeT);
+   QVERIFY(clCanFrameCheckT.fromByteArray(&achBufferT[0], slSizeT) == true);
+   QVERIFY(clCanFrameCheckT.user()       == USER_TEST_VALUE);
+   for (uint8_t ubCntT = 0; ubCntT < DLC_TEST_VALUE; ubCntT++)
+   {
+      QVERIFY(clCanFrameCheckT.data(ubCntT) == DATA_TEST_VALUE + ubCntT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// benchByteArrayNoChecksum()                                                 //
+// frame conversion with buffer on the stack, no checksum                     //
+//----------------------------------------------------------------------------//
+void TestQCanData::benchByteArrayNoChecksum()
+{
+   char        achBufferT[QCAN_FRAME_ARRAY_SIZE];
+   QCanFrame   clCanFrameCheckT;
+
+   QBENCHMARK
+   {
+      pclCanFrameP->toByteArray(&achBufferT[0], QCAN_FRAME_ARRAY_SIZE, false);
+      clCanFrameCheckT.fromByteArray(&achBufferT[0], QCAN_FRAME_ARRAY_SIZE);
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // cleanupTestCase()                                                          //
 // cleanup test cases                                                         //
@@ -68,6 +68,14 @@ private slots:
    void checkFrameType();
    void checkConversion();
    void checkByteArray();
+   void checkByteArrayCompact();
+   void checkApiFilter();
+   void checkApiQueueStatus();
+   void checkByteArrayBuffer();
+   void benchByteArray();
+   void benchByteArrayBuffer();
+   void checkChecksum();
+   void benchByteArrayNoChecksum();
    void cleanupTestCase();
 };
 
@@ -0,0 +1,201 @@
+//============================================================================//
+// File:          test_qcan_filter_index.cpp                                  //
+// Description:   QCAN classes - Test acceptance filter index                 //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+
+
+
+#include "test_qcan_filter_index.hpp"
+
+
+TestQCanFilterIndex::TestQCanFilterIndex()
+{
+
+}
+
+
+TestQCanFilterIndex::~TestQCanFilterIndex()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanFilterIndex::initTestCase()
+{
+   pclFilterIndexP = new QCanFilterIndex();
+}
+
+
+//----------------------------------------------------------------------------//
+// checkExactMatch()                                                          //
+// check filters with a full acceptance mask                                  //
+//----------------------------------------------------------------------------//
+void TestQCanFilterIndex::checkExactMatch()
+{
+   pclFilterIndexP->clear();
+   QVERIFY(pclFilterIndexP->isEmpty() == true);
+   QVERIFY(pclFilterIndexP->match(0x100, false) == 0);
+
+   QVERIFY(pclFilterIndexP->setEntry( 0, 0x100, 0x000007FF, false) == true);
+   QVERIFY(pclFilterIndexP->setEntry( 1, 0x100, 0x1FFFFFFF, true)  == true);
+   QVERIFY(pclFilterIndexP->setEntry(63, 0x101, 0xFFFFFFFF, false) == true);
+   QVERIFY(pclFilterIndexP->setEntry(64, 0x101, 0xFFFFFFFF, false) == false);
+   QVERIFY(pclFilterIndexP->isEmpty() == false);
+
+   //----------------------------------------------------------------
+   // the frame format must match
+   //
+   QVERIFY(pclFilterIndexP->match(0x100, false) == 0x01);
+   QVERIFY(pclFilterIndexP->match(0x100, true)  == 0x02);
+   QVERIFY(pclFilterIndexP->match(0x101, false) == ((uint64_t) 1) << 63);
+   QVERIFY(pclFilterIndexP->match(0x101, true)  == 0);
+   QVERIFY(pclFilterIndexP->match(0x102, false) == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkMaskGroup()                                                           //
+// check filters with a partial acceptance mask                               //
+//----------------------------------------------------------------------------//
+void TestQCanFilterIndex::checkMaskGroup()
+{
+   pclFilterIndexP->clear();
+
+   //----------------------------------------------------------------
+   // two entries share the mask 0x780, one entry accepts all 
+   // standard frames
+   //
+   pclFilterIndexP->setEntry(0, 0x180, 0x780, false);
+   pclFilterIndexP->setEntry(1, 0x200, 0x780, false);
+   pclFilterIndexP->setEntry(2, 0x000, 0x000, false);
+   pclFilterIndexP->setEntry(3, 0x185, 0x7FF, false);
+
+   QVERIFY(pclFilterIndexP->match(0x185, false) == 0x0D);
+   QVERIFY(pclFilterIndexP->match(0x1FF, false) == 0x05);
+   QVERIFY(pclFilterIndexP->match(0x27F, false) == 0x06);
+   QVERIFY(pclFilterIndexP->match(0x300, false) == 0x04);
+   QVERIFY(pclFilterIndexP->match(0x185, true)  == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkRemove()                                                              //
+// check removal and replacement of filters                                   //
+//----------------------------------------------------------------------------//
+void TestQCanFilterIndex::checkRemove()
+{
+   pclFilterIndexP->clear();
+   pclFilterIndexP->setEntry(4, 0x123, 0x7FF, false);
+   pclFilterIndexP->setEntry(5, 0x100, 0x700, false);
+   QVERIFY(pclFilterIndexP->match(0x123, false) == 0x30);
+
+   pclFilterIndexP->removeEntry(5);
+   QVERIFY(pclFilterIndexP->match(0x123, false) == 0x10);
+
+   pclFilterIndexP->setEntry(4, 0x124, 0x7FF, false);
+   QVERIFY(pclFilterIndexP->match(0x123, false) == 0);
+   QVERIFY(pclFilterIndexP->match(0x124, false) == 0x10);
+
+   pclFilterIndexP->removeEntry(4);
+   QVERIFY(pclFilterIndexP->isEmpty() == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkLinearScan()                                                          //
+// compare the index with a linear scan over all filters                      //
+//----------------------------------------------------------------------------//
+void TestQCanFilterIndex::checkLinearScan()
+{
+   uint32_t    aulIdentifierT[QCAN_FILTER_INDEX_MAX];
+   uint32_t    aulAcceptMaskT[QCAN_FILTER_INDEX_MAX];
+   bool        abtExtendedT[QCAN_FILTER_INDEX_MAX];
+   uint32_t    ulIdentifierT;
+   uint32_t    ulFormatMaskT;
+   uint64_t    uqResultT;
+   uint32_t    ulCntT;
+   uint8_t     ubEntryT;
+   bool        btExtendedT;
+
+   qsrand(1);
+   pclFilterIndexP->clear();
+   for(ubEntryT = 0; ubEntryT < QCAN_FILTER_INDEX_MAX; ubEntryT++)
+   {
+      aulIdentifierT[ubEntryT] = (uint32_t) qrand();
+      switch(qrand() % 3)
+      {
+         case 0:  aulAcceptMaskT[ubEntryT] = 0x1FFFFFFF; break;
+         case 1:  aulAcceptMaskT[ubEntryT] = 0x000007F0; break;
+         default: aulAcceptMaskT[ubEntryT] = 0x1FFFFF00; break;
+      }
+      abtExtendedT[ubEntryT] = ((qrand() & 1) != 0);
+      pclFilterIndexP->setEntry(ubEntryT, aulIdentifierT[ubEntryT],
+                                aulAcceptMaskT[ubEntryT], 
+                                abtExtendedT[ubEntryT]);
+   }
+
+   for(ulCntT = 0; ulCntT < 10000; ulCntT++)
+   {
+      btExtendedT   = ((qrand() & 1) != 0);
+      ulFormatMaskT = btExtendedT ? 0x1FFFFFFF : 0x000007FF;
+      if((qrand() & 1) != 0)
+      {
+         ulIdentifierT = (uint32_t) qrand();
+      }
+      else
+      {
+         ulIdentifierT = aulIdentifierT[qrand() % QCAN_FILTER_INDEX_MAX];
+      }
+
+      uqResultT = 0;
+      for(ubEntryT = 0; ubEntryT < QCAN_FILTER_INDEX_MAX; ubEntryT++)
+      {
+         if(abtExtendedT[ubEntryT] != btExtendedT) continue;
+         if( (aulIdentifierT[ubEntryT] & aulAcceptMaskT[ubEntryT] & 
+              ulFormatMaskT) == 
+             (ulIdentifierT & aulAcceptMaskT[ubEntryT] & ulFormatMaskT) )
+         {
+            uqResultT |= ((uint64_t) 1) << ubEntryT;
+         }
+      }
+      QCOMPARE(pclFilterIndexP->match(ulIdentifierT, btExtendedT), uqResultT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanFilterIndex::cleanupTestCase()
+{
+   delete(pclFilterIndexP);
+}
+
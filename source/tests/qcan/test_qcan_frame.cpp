@@ -305,6 +305,228 @@ void TestQCanFrame::checkByteArray()
    }
 }
 
+//----------------------------------------------------------------------------//
+// referenceString()                                                          //
+// text of CAN frame built by QString::arg(), as used before the formatter    //
+//----------------------------------------------------------------------------//
+QString TestQCanFrame::referenceString(const QCanFrame & clFrameR, 
+                                       bool btShowTimeV)
+{
+   QString clStringT;
+
+   if(btShowTimeV == true)
+   {
+      clStringT = QString("%1.%2 ")
+                  .arg(clFrameR.timeStamp().seconds(), 5, 10)
+                  .arg(clFrameR.timeStamp().nanoSeconds() / 10000, 
+                       5, 10, QChar('0'));
+   }
+
+   clStringT += QString("%1  ").arg(clFrameR.identifier(), 8, 16).toUpper();
+
+   switch(clFrameR.frameFormat())
+   {
+      case QCanFrame::eFORMAT_CAN_STD:
+         clStringT += "CBFF ";
+         break;
+
+      case QCanFrame::eFORMAT_CAN_EXT:
+         clStringT += "CEFF ";
+         break;
+
+      case QCanFrame::eFORMAT_FD_STD:
+         clStringT += "FBFF ";
+         break;
+
+      case QCanFrame::eFORMAT_FD_EXT:
+         clStringT += "FEFF ";
+         break;
+
+      default:
+
+         break;
+   }
+
+   clStringT += QString("%1  ").arg(clFrameR.dlc(), 2, 10);
+
+   for(uint8_t ubCntT = 0; ubCntT < clFrameR.dataSize(); ubCntT++)
+   {
+      if((ubCntT > 0) && ((ubCntT % 32) == 0))
+      {
+         if(btShowTimeV == true)
+         {
+            clStringT +="\n                               ";
+         }
+         else
+         {
+            clStringT +="\n                   ";
+         }
+      }
+      clStringT += QString("%1 ").arg(clFrameR.data(ubCntT), 2, 16, 
+                                      QLatin1Char('0')).toUpper();
+   }
+
+   return(clStringT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setupFdFrame()                                                             //
+// CAN FD frame with 64 bytes and time-stamp                                  //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::setupFdFrame(QCanFrame & clFrameR)
+{
+   QCanTimeStamp  clTimeT(12345, 678900000);
+
+   clFrameR.setFrameFormat(QCanFrame::eFORMAT_FD_EXT);
+   clFrameR.setIdentifier(0x1ABCDEF);
+   clFrameR.setDlc(15);
+   for(uint8_t ubCntT = 0; ubCntT < clFrameR.dataSize(); ubCntT++)
+   {
+      clFrameR.setData(ubCntT, (uint8_t) (ubCntT * 7));
+   }
+   clFrameR.setTimeStamp(clTimeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkFormat()                                                              //
+// check conversion of numbers                                                //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::checkFormat()
+{
+   char     achBufferT[16];
+   char *   pchEndT;
+   uint32_t ulValueT;
+
+   static const uint32_t aulValueT[] = { 0, 9, 10, 99, 100, 255, 256, 999,
+                                         1000, 65535, 123456789, 
+                                         0x1FFFFFFF, 0xFFFFFFFF };
+
+   for(uint8_t ubCntT = 0; ubCntT < sizeof(aulValueT) / sizeof(uint32_t); 
+       ubCntT++)
+   {
+      ulValueT = aulValueT[ubCntT];
+
+      pchEndT = QCanData::formatDecimal(&achBufferT[0], ulValueT);
+      QVERIFY(QString::fromLatin1(&achBufferT[0], pchEndT - &achBufferT[0]) ==
+              QString::number(ulValueT));
+
+      pchEndT = QCanData::formatHex(&achBufferT[0], ulValueT);
+      QVERIFY(QString::fromLatin1(&achBufferT[0], pchEndT - &achBufferT[0]) ==
+              QString::number(ulValueT, 16).toUpper());
+   }
+
+   //----------------------------------------------------------------
+   // fill characters
+   //
+   pchEndT = QCanData::formatDecimal(&achBufferT[0], 42, 5, '0');
+   QVERIFY(QString::fromLatin1(&achBufferT[0], pchEndT - &achBufferT[0]) ==
+           "00042");
+
+   pchEndT = QCanData::formatHex(&achBufferT[0], 0x7FF, 8);
+   QVERIFY(QString::fromLatin1(&achBufferT[0], pchEndT - &achBufferT[0]) ==
+           "     7FF");
+
+   pchEndT = QCanData::formatHexByte(&achBufferT[0], 0xA5);
+   QVERIFY(QString::fromLatin1(&achBufferT[0], pchEndT - &achBufferT[0]) ==
+           "A5");
+}
+
+
+//----------------------------------------------------------------------------//
+// checkToString()                                                            //
+// compare text of CAN frame with reference                                   //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::checkToString()
+{
+   QCanFrame   clFrameT;
+   char        achBufferT[QCAN_FRAME_STRING_SIZE];
+
+   //----------------------------------------------------------------
+   // classical CAN frames with all DLC values
+   //
+   for(uint8_t ubCntT = 0; ubCntT < 9; ubCntT++)
+   {
+      clFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_STD);
+      clFrameT.setIdentifier(0x100 + ubCntT);
+      clFrameT.setDlc(ubCntT);
+      clFrameT.setData(0, 0xF0 + ubCntT);
+      QVERIFY(clFrameT.toString(false) == referenceString(clFrameT, false));
+      QVERIFY(clFrameT.toString(true)  == referenceString(clFrameT, true));
+   }
+
+   //----------------------------------------------------------------
+   // CAN FD frame with line break
+   //
+   setupFdFrame(clFrameT);
+   QVERIFY(clFrameT.toString(false) == referenceString(clFrameT, false));
+   QVERIFY(clFrameT.toString(true)  == referenceString(clFrameT, true));
+
+   //----------------------------------------------------------------
+   // buffer too small
+   //
+   QVERIFY(clFrameT.toString(&achBufferT[0], 
+                             QCAN_FRAME_STRING_SIZE - 1) == 0);
+   QVERIFY(clFrameT.toString(&achBufferT[0], 
+                             QCAN_FRAME_STRING_SIZE) > 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// benchToStringReference()                                                   //
+// text of CAN FD frame by QString::arg()                                     //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::benchToStringReference()
+{
+   QCanFrame   clFrameT;
+   QString     clStringT;
+
+   setupFdFrame(clFrameT);
+   QBENCHMARK
+   {
+      clStringT = referenceString(clFrameT, true);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// benchToString()                                                            //
+// text of CAN FD frame as QString                                            //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::benchToString()
+{
+   QCanFrame   clFrameT;
+   QString     clStringT;
+
+   setupFdFrame(clFrameT);
+   QBENCHMARK
+   {
+      clStringT = clFrameT.toString(true);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// benchToStringBuffer()                                                      //
+// text of CAN FD frame written to buffer                                     //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::benchToStringBuffer()
+{
+   QCanFrame   clFrameT;
+   char        achBufferT[QCAN_FRAME_STRING_SIZE];
+   int32_t     slSizeT = 0;
+
+   setupFdFrame(clFrameT);
+   QBENCHMARK
+   {
+      slSizeT = clFrameT.toString(&achBufferT[0], QCAN_FRAME_STRING_SIZE, 
+                                  true);
+   }
+   QVERIFY(slSizeT > 0);
+}
+
+
 //----------------------------------------------------------------------------//
 // cleanupTestCase()                                                          //
 // cleanup test cases                                                         //
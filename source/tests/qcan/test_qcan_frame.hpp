@@ -59,6 +59,10 @@ private:
    QCanFrame *    pclFdExtP;
    QCanFrame *    pclFrameP;
 
+   QString        referenceString(const QCanFrame & clFrameR, 
+                                  bool btShowTimeV);
+   void           setupFdFrame(QCanFrame & clFrameR);
+
 private slots:
 
    void initTestCase();
@@ -71,6 +75,11 @@ private slots:
    void checkFrameData();
    void checkFrameRemote();
    void checkByteArray();
+   void checkFormat();
+   void checkToString();
+   void benchToStringReference();
+   void benchToString();
+   void benchToStringBuffer();
    void cleanupTestCase();
 };
 
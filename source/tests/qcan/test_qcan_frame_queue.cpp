@@ -0,0 +1,231 @@
+//============================================================================//
+// File:          test_qcan_frame_queue.cpp                                   //
+// Description:   QCAN classes - Test lock-free frame queue                   //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+
+#include <QThread>
+
+#include "test_qcan_frame_queue.hpp"
+
+
+//-------------------------------------------------------------------
+// small queue, so the overrun can be tested quickly
+//
+#define  QUEUE_TEST_SLOTS     8
+#define  QUEUE_TEST_FRAMES    100000
+
+
+//-------------------------------------------------------------------
+// writer thread for checkThread(), the frame number is stored in
+// the first 4 bytes of each frame
+//
+class TestQueueWriter : public QThread
+{
+public:
+   TestQueueWriter(QCanFrameQueue * pclQueueV) : pclQueueP(pclQueueV) { };
+
+protected:
+   void run() Q_DECL_OVERRIDE
+   {
+      uint32_t ulCntT = 0;
+
+      while(ulCntT < QUEUE_TEST_FRAMES)
+      {
+         if(pclQueueP->push((const char *) &ulCntT, sizeof(ulCntT)) == true)
+         {
+            ulCntT++;
+         }
+      }
+   };
+
+private:
+   QCanFrameQueue *  pclQueueP;
+};
+
+
+TestQCanFrameQueue::TestQCanFrameQueue()
+{
+
+}
+
+
+TestQCanFrameQueue::~TestQCanFrameQueue()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanFrameQueue::initTestCase()
+{
+   pclQueueP = new QCanFrameQueue(QUEUE_TEST_SLOTS - 1);
+   QVERIFY(pclQueueP->isEmpty() == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkPushPop()                                                             //
+// frames are read in the order they are written                              //
+//----------------------------------------------------------------------------//
+void TestQCanFrameQueue::checkPushPop()
+{
+   char        achDataT[QCAN_FRAME_ARRAY_SIZE];
+   QByteArray  clDataT;
+   uint8_t     ubCntT;
+   uint32_t    ulTagT = 0;
+
+   memset(&achDataT[0], 0, QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(pclQueueP->push(&achDataT[0], 0) == false);
+   QVERIFY(pclQueueP->push(&achDataT[0], QCAN_FRAME_ARRAY_SIZE + 1) == false);
+   QVERIFY(pclQueueP->pop(clDataT) == false);
+
+   for(ubCntT = 0; ubCntT < 4; ubCntT++)
+   {
+      memset(&achDataT[0], ubCntT, QCAN_FRAME_ARRAY_SIZE);
+      QVERIFY(pclQueueP->push(&achDataT[0], 10 + ubCntT) == true);
+   }
+   QCOMPARE(pclQueueP->count(), (uint32_t) 4);
+
+   for(ubCntT = 0; ubCntT < 4; ubCntT++)
+   {
+      QVERIFY(pclQueueP->pop(clDataT) == true);
+      QCOMPARE(clDataT.size(), 10 + ubCntT);
+      QCOMPARE(clDataT.at(9), (char) ubCntT);
+   }
+   QVERIFY(pclQueueP->isEmpty() == true);
+
+   //----------------------------------------------------------------
+   // the tag is passed with the frame
+   //
+   QVERIFY(pclQueueP->push(&achDataT[0], 10, 0x12345678) == true);
+   QVERIFY(pclQueueP->pop(clDataT, &ulTagT) == true);
+   QCOMPARE(ulTagT, (uint32_t) 0x12345678);
+   QCOMPARE(pclQueueP->overruns(), (uint32_t) 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkOverrun()                                                             //
+// frames are dropped if the queue is full                                    //
+//----------------------------------------------------------------------------//
+void TestQCanFrameQueue::checkOverrun()
+{
+   QByteArray  clDataT;
+   uint32_t    ulCntT;
+
+   //----------------------------------------------------------------
+   // the number of slots has been rounded up to QUEUE_TEST_SLOTS
+   //
+   for(ulCntT = 0; ulCntT < (QUEUE_TEST_SLOTS + 3); ulCntT++)
+   {
+      clDataT = QByteArray((const char *) &ulCntT, sizeof(ulCntT));
+      QCOMPARE(pclQueueP->push(clDataT), (ulCntT < QUEUE_TEST_SLOTS));
+   }
+   QCOMPARE(pclQueueP->count(), (uint32_t) QUEUE_TEST_SLOTS);
+   QCOMPARE(pclQueueP->overruns(), (uint32_t) 3);
+
+   //----------------------------------------------------------------
+   // the oldest frames are kept
+   //
+   QVERIFY(pclQueueP->pop(clDataT) == true);
+   QCOMPARE(*((const uint32_t *) clDataT.constData()), (uint32_t) 0);
+
+   pclQueueP->clear();
+   QVERIFY(pclQueueP->isEmpty() == true);
+   QCOMPARE(pclQueueP->overruns(), (uint32_t) 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkPopBatch()                                                            //
+// several frames are read with one call                                      //
+//----------------------------------------------------------------------------//
+void TestQCanFrameQueue::checkPopBatch()
+{
+   char        aachBatchT[QUEUE_TEST_SLOTS][QCAN_FRAME_ARRAY_SIZE];
+   uint32_t    ulCntT;
+
+   QCOMPARE(pclQueueP->popBatch(&aachBatchT[0][0], QUEUE_TEST_SLOTS), (uint32_t) 0);
+
+   //----------------------------------------------------------------
+   // write more frames than read by one call, the ring index
+   // wraps around
+   //
+   for(ulCntT = 0; ulCntT < 6; ulCntT++)
+   {
+      QVERIFY(pclQueueP->push((const char *) &ulCntT, sizeof(ulCntT)) == true);
+   }
+   QCOMPARE(pclQueueP->popBatch(&aachBatchT[0][0], 4), (uint32_t) 4);
+   for(ulCntT = 6; ulCntT < 12; ulCntT++)
+   {
+      QVERIFY(pclQueueP->push((const char *) &ulCntT, sizeof(ulCntT)) == true);
+   }
+   QCOMPARE(pclQueueP->popBatch(&aachBatchT[0][0], QUEUE_TEST_SLOTS), (uint32_t) 8);
+
+   for(ulCntT = 0; ulCntT < 8; ulCntT++)
+   {
+      QCOMPARE(*((const uint32_t *) &aachBatchT[ulCntT][0]), ulCntT + 4);
+   }
+   QVERIFY(pclQueueP->isEmpty() == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkThread()                                                              //
+// writer and reader run in different threads                                 //
+//----------------------------------------------------------------------------//
+void TestQCanFrameQueue::checkThread()
+{
+   TestQueueWriter   clWriterT(pclQueueP);
+   QByteArray        clDataT;
+   uint32_t          ulCntT = 0;
+
+   clWriterT.start();
+   while(ulCntT < QUEUE_TEST_FRAMES)
+   {
+      if(pclQueueP->pop(clDataT) == true)
+      {
+         QCOMPARE(*((const uint32_t *) clDataT.constData()), ulCntT);
+         ulCntT++;
+      }
+   }
+   QVERIFY(clWriterT.wait(1000) == true);
+   QVERIFY(pclQueueP->isEmpty() == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// release the queue                                                          //
+//----------------------------------------------------------------------------//
+void TestQCanFrameQueue::cleanupTestCase()
+{
+   delete(pclQueueP);
+}
+
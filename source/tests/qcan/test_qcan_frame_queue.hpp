@@ -0,0 +1,71 @@
+//============================================================================//
+// File:          test_qcan_frame_queue.hpp                                   //
+// Description:   QCAN classes - Test lock-free frame queue                   //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef TEST_QCAN_FRAME_QUEUE_HPP_
+#define TEST_QCAN_FRAME_QUEUE_HPP_
+
+
+#include <QTest>
+#include <QCanFrameQueue>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanFrameQueue
+** \brief   Test lock-free frame queue
+** 
+*/
+class TestQCanFrameQueue : public QObject
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanFrameQueue();
+   
+   
+   ~TestQCanFrameQueue();
+
+private:
+   
+   QCanFrameQueue *     pclQueueP;
+   
+private slots:
+
+   void initTestCase();
+   
+   void checkPushPop();
+   void checkOverrun();
+   void checkPopBatch();
+   void checkThread();
+   void cleanupTestCase();
+};
+
+
+
+
+#endif   // TEST_QCAN_FRAME_QUEUE_HPP_
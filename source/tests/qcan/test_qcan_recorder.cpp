@@ -0,0 +1,337 @@
+//============================================================================//
+// File:          test_qcan_recorder.cpp                                      //
+// Description:   QCAN classes - Test binary trace recorder                   //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+#include <QDir>
+#include <QFile>
+#include <QThread>
+
+#include <QCanFrameApi>
+#include <QCanFrameError>
+
+#include "test_qcan_recorder.hpp"
+
+
+//-------------------------------------------------------------------
+// number of frames and frames per write for checkSegments(), the
+// frames of one write fit into the queue of the recorder
+//
+#define  RECORDER_TEST_FRAMES    50000
+#define  RECORDER_TEST_CHUNK     5000
+#define  RECORDER_TEST_SEGMENTS  2
+
+//-------------------------------------------------------------------
+// highest segment number which is searched and removed
+//
+#define  RECORDER_TEST_SEARCH    16
+
+
+TestQCanRecorder::TestQCanRecorder()
+{
+
+}
+
+
+TestQCanRecorder::~TestQCanRecorder()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// readSegment()                                                              //
+// read all records of a segment                                              //
+//----------------------------------------------------------------------------//
+bool TestQCanRecorder::readSegment(uint32_t ulSegmentV, 
+                                   QVector<QByteArray> & clFrameListR,
+                                   QVector<uint64_t> & clTimeListR)
+{
+   QFile          clFileT(pclRecorderP->segmentName(ulSegmentV));
+   QByteArray     clDataT;
+   const char *   pchDataT;
+   int32_t        slPosT;
+   int32_t        slSizeT;
+   uint64_t       uqTimeT;
+   uint8_t        ubByteT;
+
+   clFrameListR.clear();
+   clTimeListR.clear();
+
+   if(clFileT.open(QIODevice::ReadOnly) == false)
+   {
+      return(false);
+   }
+   clDataT = clFileT.readAll();
+   clFileT.close();
+
+   //----------------------------------------------------------------
+   // test header: magic and segment number
+   //
+   if(clDataT.size() < QCAN_RECORDER_HEADER_SIZE)
+   {
+      return(false);
+   }
+   if(clDataT.left(8) != QByteArray(QCAN_RECORDER_MAGIC))
+   {
+      return(false);
+   }
+   pchDataT = clDataT.constData();
+   if(((uint8_t) pchDataT[18] != (uint8_t) (ulSegmentV >> 8)) ||
+      ((uint8_t) pchDataT[19] != (uint8_t) (ulSegmentV)))
+   {
+      return(false);
+   }
+
+   //----------------------------------------------------------------
+   // each record holds the time of reception and one frame
+   //
+   slPosT = QCAN_RECORDER_HEADER_SIZE;
+   while((slPosT + 8) < clDataT.size())
+   {
+      uqTimeT = 0;
+      for(ubByteT = 0; ubByteT < 8; ubByteT++)
+      {
+         uqTimeT = (uqTimeT << 8) | (uint8_t) pchDataT[slPosT + ubByteT];
+      }
+      slPosT = slPosT + 8;
+
+      slSizeT = QCanData::byteArraySize(&pchDataT[slPosT], 
+                                        clDataT.size() - slPosT);
+      if((slSizeT == 0) || ((slPosT + slSizeT) > clDataT.size()))
+      {
+         return(false);
+      }
+
+      clTimeListR.append(uqTimeT);
+      clFrameListR.append(clDataT.mid(slPosT, slSizeT));
+      slPosT = slPosT + slSizeT;
+   }
+
+   return(slPosT == clDataT.size());
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanRecorder::initTestCase()
+{
+   pclRecorderP = new QCanRecorder();
+   clFileNameP  = QDir::tempPath() + "/test_qcan_recorder.qcr";
+
+   QVERIFY(pclRecorderP->isRecording() == false);
+   QVERIFY(pclRecorderP->segmentSize() == QCAN_RECORDER_SEGMENT_SIZE);
+   QVERIFY(pclRecorderP->segmentCount() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkInactive()                                                            //
+// frames are not accepted without recording                                  //
+//----------------------------------------------------------------------------//
+void TestQCanRecorder::checkInactive()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 2);
+
+   QVERIFY(pclRecorderP->record(clFrameT.toByteArray()) == false);
+   QVERIFY(pclRecorderP->frameCount() == 0);
+   QVERIFY(pclRecorderP->overruns() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkRecord()                                                              //
+// record all frame types in both encodings                                   //
+//----------------------------------------------------------------------------//
+void TestQCanRecorder::checkRecord()
+{
+   QCanFrame            clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   QCanFrame            clCheckT;
+   QCanFrameApi         clApiFrameT;
+   QCanFrameError       clErrFrameT;
+   QCanData             clDataT(QCanData::eTYPE_CAN);
+   QVector<QByteArray>  clFrameListT;
+   QVector<uint64_t>    clTimeListT;
+   uint8_t              ubPosT;
+
+   for(ubPosT = 0; ubPosT < 8; ubPosT++)
+   {
+      clFrameT.setData(ubPosT, 0x10 + ubPosT);
+   }
+   clApiFrameT.setBitrate(eCAN_BITRATE_500K, eCAN_BITRATE_NONE);
+   clErrFrameT.setErrorState(eCAN_STATE_BUS_WARN);
+
+   QVERIFY(pclRecorderP->startRecording(clFileNameP) == true);
+   QVERIFY(pclRecorderP->isRecording() == true);
+
+   //----------------------------------------------------------------
+   // the frames are passed in fixed and compact encoding, frames
+   // of invalid size are not accepted
+   //
+   QVERIFY(pclRecorderP->record(clFrameT.toByteArray()) == true);
+   clFrameT.setIdentifier(0x124);
+   QVERIFY(pclRecorderP->record(clFrameT.toByteArrayCompact()) == true);
+   QVERIFY(pclRecorderP->record(clApiFrameT.toByteArray()) == true);
+   QVERIFY(pclRecorderP->record(clErrFrameT.toByteArray()) == true);
+   QVERIFY(pclRecorderP->record(QByteArray()) == false);
+
+   pclRecorderP->stopRecording();
+   QVERIFY(pclRecorderP->isRecording() == false);
+   QVERIFY(pclRecorderP->frameCount() == 4);
+   QVERIFY(pclRecorderP->overruns() == 0);
+
+   //----------------------------------------------------------------
+   // read back the trace, all frames use the compact encoding
+   //
+   QVERIFY(readSegment(1, clFrameListT, clTimeListT) == true);
+   QVERIFY(clFrameListT.size() == 4);
+
+   QVERIFY(clDataT.fromByteArray(clFrameListT.at(2)) == true);
+   QVERIFY(clDataT.frameType() == QCanData::eTYPE_API);
+   QVERIFY(clDataT.fromByteArray(clFrameListT.at(3)) == true);
+   QVERIFY(clDataT.frameType() == QCanData::eTYPE_ERROR);
+
+   QVERIFY(clCheckT.fromByteArray(clFrameListT.at(0)) == true);
+   QVERIFY(clCheckT.identifier() == 0x123);
+   QVERIFY(clCheckT.dlc() == 8);
+   QVERIFY(clCheckT.data(7) == 0x17);
+   QVERIFY(clCheckT.fromByteArray(clFrameListT.at(1)) == true);
+   QVERIFY(clCheckT.identifier() == 0x124);
+
+   //----------------------------------------------------------------
+   // the time of reception is monotonic
+   //
+   QVERIFY(clTimeListT.at(0) <= clTimeListT.at(1));
+   QVERIFY(clTimeListT.at(1) <= clTimeListT.at(2));
+   QVERIFY(clTimeListT.at(2) <= clTimeListT.at(3));
+}
+
+
+//----------------------------------------------------------------------------//
+// checkSegments()                                                            //
+// segment rotation with limited number of segments                           //
+//----------------------------------------------------------------------------//
+void TestQCanRecorder::checkSegments()
+{
+   QCanFrame            clFrameT(QCanFrame::eFORMAT_CAN_EXT, 0, 4);
+   QVector<QByteArray>  clFrameListT;
+   QVector<uint64_t>    clTimeListT;
+   uint32_t             ulFrameCntT;
+   uint32_t             ulSegmentT;
+   uint32_t             ulLastSegmentT;
+   uint32_t             ulNextIdT;
+   int32_t              slIdxT;
+
+   //----------------------------------------------------------------
+   // the smallest segment size results in several segments
+   //
+   pclRecorderP->setSegmentSize(0);
+   QVERIFY(pclRecorderP->segmentSize() == QCAN_RECORDER_BUFFER_SIZE);
+   pclRecorderP->setSegmentCount(RECORDER_TEST_SEGMENTS);
+
+   clFrameT.setData(0, 0x11);
+   clFrameT.setData(1, 0x22);
+   clFrameT.setData(2, 0x33);
+   clFrameT.setData(3, 0x44);
+
+   QVERIFY(pclRecorderP->startRecording(clFileNameP) == true);
+   for(ulFrameCntT = 0; ulFrameCntT < RECORDER_TEST_FRAMES; ulFrameCntT++)
+   {
+      clFrameT.setIdentifier(ulFrameCntT);
+      QVERIFY(pclRecorderP->record(clFrameT.toByteArrayCompact()) == true);
+
+      //--------------------------------------------------------
+      // give the thread time to empty the queue
+      //
+      if((ulFrameCntT % RECORDER_TEST_CHUNK) == (RECORDER_TEST_CHUNK - 1))
+      {
+         QThread::msleep(3 * QCAN_RECORDER_POLL_TIME);
+      }
+   }
+   pclRecorderP->stopRecording();
+
+   QVERIFY(pclRecorderP->frameCount() == RECORDER_TEST_FRAMES);
+   QVERIFY(pclRecorderP->overruns() == 0);
+
+   //----------------------------------------------------------------
+   // find the last segment, only the most recent segments are
+   // kept on disk
+   //
+   ulLastSegmentT = 1;
+   while((QFile::exists(pclRecorderP->segmentName(ulLastSegmentT)) == false) &&
+         (ulLastSegmentT < RECORDER_TEST_SEARCH))
+   {
+      ulLastSegmentT++;
+   }
+   while(QFile::exists(pclRecorderP->segmentName(ulLastSegmentT + 1)))
+   {
+      ulLastSegmentT++;
+   }
+   QVERIFY(ulLastSegmentT > RECORDER_TEST_SEGMENTS);
+   QVERIFY(QFile::exists(pclRecorderP->segmentName(1)) == false);
+   QVERIFY(QFile::exists(pclRecorderP->segmentName(ulLastSegmentT -
+                                          RECORDER_TEST_SEGMENTS)) == false);
+
+   //----------------------------------------------------------------
+   // the remaining segments hold consecutive frames up to the
+   // last one
+   //
+   ulNextIdT = 0;
+   for(ulSegmentT = ulLastSegmentT - RECORDER_TEST_SEGMENTS + 1; 
+       ulSegmentT <= ulLastSegmentT; ulSegmentT++)
+   {
+      QVERIFY(readSegment(ulSegmentT, clFrameListT, clTimeListT) == true);
+      QVERIFY(clFrameListT.size() > 0);
+      for(slIdxT = 0; slIdxT < clFrameListT.size(); slIdxT++)
+      {
+         QVERIFY(clFrameT.fromByteArray(clFrameListT.at(slIdxT)) == true);
+         if(ulNextIdT != 0)
+         {
+            QVERIFY(clFrameT.identifier() == ulNextIdT);
+         }
+         ulNextIdT = clFrameT.identifier() + 1;
+      }
+   }
+   QVERIFY(ulNextIdT == RECORDER_TEST_FRAMES);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// remove trace files                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanRecorder::cleanupTestCase()
+{
+   uint32_t ulSegmentT;
+
+   for(ulSegmentT = 1; ulSegmentT <= RECORDER_TEST_SEARCH; ulSegmentT++)
+   {
+      QFile::remove(pclRecorderP->segmentName(ulSegmentT));
+   }
+
+   delete(pclRecorderP);
+}
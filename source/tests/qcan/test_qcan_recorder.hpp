@@ -0,0 +1,74 @@
+//============================================================================//
+// File:          test_qcan_recorder.hpp                                      //
+// Description:   QCAN classes - Test binary trace recorder                   //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef TEST_QCAN_RECORDER_HPP_
+#define TEST_QCAN_RECORDER_HPP_
+
+
+#include <QTest>
+#include <QCanRecorder>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanRecorder
+** \brief   Test binary trace recorder
+** 
+*/
+class TestQCanRecorder : public QObject
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanRecorder();
+   
+   
+   ~TestQCanRecorder();
+
+private:
+   
+   bool  readSegment(uint32_t ulSegmentV, QVector<QByteArray> & clFrameListR,
+                     QVector<uint64_t> & clTimeListR);
+
+   QCanRecorder *       pclRecorderP;
+   QString              clFileNameP;
+   
+private slots:
+
+   void initTestCase();
+   
+   void checkInactive();
+   void checkRecord();
+   void checkSegments();
+   void cleanupTestCase();
+};
+
+
+
+
+#endif   // TEST_QCAN_RECORDER_HPP_
@@ -0,0 +1,343 @@
+//============================================================================//
+// File:          test_qcan_scheduler.cpp                                     //
+// Description:   QCAN classes - Test cyclic transmit scheduler               //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+
+#include <QCanFrameApi>
+
+#include "test_qcan_scheduler.hpp"
+
+
+//-------------------------------------------------------------------
+// the period of the test jobs in ticks
+//
+#define  SCHEDULER_TEST_PERIOD   10
+#define  SCHEDULER_TEST_LONG     ((2 * QCAN_SCHEDULER_SLOTS) + 3)
+
+
+TestQCanScheduler::TestQCanScheduler()
+{
+
+}
+
+
+TestQCanScheduler::~TestQCanScheduler()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::initTestCase()
+{
+   //----------------------------------------------------------------
+   // the scheduler is tested without CAN interface, so the thread
+   // is not running and the ticks are processed by the test
+   //
+   pclSchedulerP = new QCanScheduler();
+   QVERIFY(pclSchedulerP->jobCount() == 0);
+
+   clFrameP.setIdentifier(0x123);
+   clFrameP.setDlc(2);
+   clFrameP.setData(0, 0x00);
+   clFrameP.setData(1, 0x55);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkAddRemove()                                                           //
+// add and remove jobs                                                        //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::checkAddRemove()
+{
+   //----------------------------------------------------------------
+   // a job with the same owner and number is replaced
+   //
+   QVERIFY(pclSchedulerP->addJob(1, 0, clFrameP, 1000) == true);
+   QVERIFY(pclSchedulerP->jobCount() == 1);
+   QVERIFY(pclSchedulerP->addJob(1, 0, clFrameP, 2000) == true);
+   QVERIFY(pclSchedulerP->jobCount() == 1);
+
+   //----------------------------------------------------------------
+   // a period of 0 is not accepted
+   //
+   QVERIFY(pclSchedulerP->addJob(1, 1, clFrameP, 0) == false);
+   QVERIFY(pclSchedulerP->jobCount() == 1);
+
+   QVERIFY(pclSchedulerP->addJob(1, 1, clFrameP, 1000) == true);
+   QVERIFY(pclSchedulerP->addJob(2, 0, clFrameP, 1000) == true);
+   QVERIFY(pclSchedulerP->jobCount() == 3);
+
+   pclSchedulerP->removeJob(1, 0);
+   QVERIFY(pclSchedulerP->jobCount() == 2);
+
+   pclSchedulerP->removeJobs(1);
+   QVERIFY(pclSchedulerP->jobCount() == 1);
+
+   pclSchedulerP->removeJobs(2);
+   QVERIFY(pclSchedulerP->jobCount() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkPeriod()                                                              //
+// transmit frame with fixed period                                           //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::checkPeriod()
+{
+   QVector<QCanFrame>   clFrameListT;
+   uint32_t             ulTickT;
+   uint32_t             ulFrameCntT;
+
+   QVERIFY(pclSchedulerP->addJob(1, 0, clFrameP, 
+                     SCHEDULER_TEST_PERIOD * QCAN_SCHEDULER_TICK) == true);
+
+   //----------------------------------------------------------------
+   // the first frame is transmitted with the next tick
+   //
+   for(ulTickT = 0; ulTickT < (SCHEDULER_TEST_PERIOD * 10); ulTickT++)
+   {
+      ulFrameCntT = pclSchedulerP->processTick(clFrameListT);
+      if((ulTickT % SCHEDULER_TEST_PERIOD) == 0)
+      {
+         QVERIFY(ulFrameCntT == 1);
+      }
+      else
+      {
+         QVERIFY(ulFrameCntT == 0);
+      }
+   }
+   QVERIFY(clFrameListT.size() == 10);
+   QVERIFY(clFrameListT.at(9).identifier() == 0x123);
+   QVERIFY(clFrameListT.at(9).data(1) == 0x55);
+
+   //----------------------------------------------------------------
+   // no frame after the job has been removed
+   //
+   pclSchedulerP->removeJob(1, 0);
+   clFrameListT.clear();
+   for(ulTickT = 0; ulTickT < (SCHEDULER_TEST_PERIOD * 2); ulTickT++)
+   {
+      pclSchedulerP->processTick(clFrameListT);
+   }
+   QVERIFY(clFrameListT.size() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkCount()                                                               //
+// limited number of transmissions with payload increment                     //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::checkCount()
+{
+   QVector<QCanFrame>   clFrameListT;
+   uint32_t             ulTickT;
+   int32_t              slFrameIdxT;
+
+   QVERIFY(pclSchedulerP->addJob(3, 7, clFrameP, QCAN_SCHEDULER_TICK, 
+                                 5, 0) == true);
+
+   for(ulTickT = 0; ulTickT < 20; ulTickT++)
+   {
+      pclSchedulerP->processTick(clFrameListT);
+   }
+
+   //----------------------------------------------------------------
+   // the job ends after 5 frames, byte 0 is incremented
+   //
+   QVERIFY(clFrameListT.size() == 5);
+   for(slFrameIdxT = 0; slFrameIdxT < clFrameListT.size(); slFrameIdxT++)
+   {
+      QVERIFY(clFrameListT.at(slFrameIdxT).data(0) == slFrameIdxT);
+      QVERIFY(clFrameListT.at(slFrameIdxT).data(1) == 0x55);
+   }
+   QVERIFY(pclSchedulerP->jobCount() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkWheel()                                                               //
+// period longer than one revolution of the timer wheel                       //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::checkWheel()
+{
+   QVector<QCanFrame>   clFrameListT;
+   uint32_t             ulTickT;
+   uint32_t             ulFrameCntT;
+
+   QVERIFY(pclSchedulerP->addJob(1, 0, clFrameP, 
+                     SCHEDULER_TEST_LONG * QCAN_SCHEDULER_TICK) == true);
+   QVERIFY(pclSchedulerP->addJob(1, 1, clFrameP, 
+                     SCHEDULER_TEST_PERIOD * QCAN_SCHEDULER_TICK) == true);
+
+   //----------------------------------------------------------------
+   // count the frames of the long period, the short period is
+   // a divider of the tick number
+   //
+   for(ulTickT = 0; ulTickT <= (SCHEDULER_TEST_LONG * 3); ulTickT++)
+   {
+      clFrameListT.clear();
+      ulFrameCntT = pclSchedulerP->processTick(clFrameListT);
+      if((ulTickT % SCHEDULER_TEST_PERIOD) == 0)
+      {
+         ulFrameCntT--;
+      }
+
+      if((ulTickT % SCHEDULER_TEST_LONG) == 0)
+      {
+         QVERIFY(ulFrameCntT == 1);
+      }
+      else
+      {
+         QVERIFY(ulFrameCntT == 0);
+      }
+   }
+
+   pclSchedulerP->removeJobs(1);
+   QVERIFY(pclSchedulerP->jobCount() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkJobMax()                                                              //
+// limit of jobs                                                              //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::checkJobMax()
+{
+   uint32_t ulJobT;
+
+   for(ulJobT = 0; ulJobT < QCAN_SCHEDULER_JOB_MAX; ulJobT++)
+   {
+      QVERIFY(pclSchedulerP->addJob(ulJobT >> 8, (uint8_t) ulJobT,
+                                    clFrameP, 1000) == true);
+   }
+   QVERIFY(pclSchedulerP->jobCount() == QCAN_SCHEDULER_JOB_MAX);
+   QVERIFY(pclSchedulerP->addJob(0x100, 0, clFrameP, 1000) == false);
+
+   //----------------------------------------------------------------
+   // the entries are available again after all jobs are removed
+   //
+   for(ulJobT = 0; ulJobT <= (QCAN_SCHEDULER_JOB_MAX >> 8); ulJobT++)
+   {
+      pclSchedulerP->removeJobs(ulJobT);
+   }
+   QVERIFY(pclSchedulerP->jobCount() == 0);
+   QVERIFY(pclSchedulerP->addJob(0x100, 0, clFrameP, 1000) == true);
+   pclSchedulerP->removeJobs(0x100);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkApiFrame()                                                            //
+// transfer of job by API frame                                               //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::checkApiFrame()
+{
+   QCanFrameApi   clApiFrameT;
+   QCanFrameApi   clApiCheckT;
+   QCanFrame      clFrameT(QCanFrame::eFORMAT_FD_EXT, 0x1ABCDEF0);
+   QCanFrame      clCheckT;
+   uint8_t        ubJobT;
+   uint8_t        ubIncPosT;
+   uint32_t       ulPeriodT;
+   uint32_t       ulCountT;
+
+   clFrameT.setDlc(14);
+   clFrameT.setBitrateSwitch();
+   clFrameT.setData(47, 0xA5);
+
+   QVERIFY(clApiFrameT.setCyclic(9, clFrameT, 2500, 100, 47) == true);
+   QVERIFY(clApiCheckT.fromByteArray(clApiFrameT.toByteArray()) == true);
+   QVERIFY(clApiCheckT.function() == QCanFrameApi::eAPI_FUNC_CYCLIC);
+   QVERIFY(clApiCheckT.cyclic(ubJobT, clCheckT, ulPeriodT, 
+                              ulCountT, ubIncPosT) == true);
+   QVERIFY(ubJobT     == 9);
+   QVERIFY(ulPeriodT  == 2500);
+   QVERIFY(ulCountT   == 100);
+   QVERIFY(ubIncPosT  == 47);
+   QVERIFY(clCheckT.frameFormat()   == QCanFrame::eFORMAT_FD_EXT);
+   QVERIFY(clCheckT.identifier()    == 0x1ABCDEF0);
+   QVERIFY(clCheckT.dlc()           == 14);
+   QVERIFY(clCheckT.bitrateSwitch() == true);
+   QVERIFY(clCheckT.data(47)        == 0xA5);
+
+   //----------------------------------------------------------------
+   // a payload of 64 bytes does not fit into the API frame
+   //
+   clFrameT.setDlc(15);
+   QVERIFY(clApiFrameT.setCyclic(9, clFrameT, 2500) == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkVirtual()                                                             //
+// transmit jobs without CAN interface                                        //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::checkVirtual()
+{
+   QByteArray  clDataT;
+   QCanFrame   clCheckT;
+   uint32_t    ulOwnerT = 0;
+   uint32_t    ulFrameCntT = 0;
+   int32_t     slWaitT;
+
+   //----------------------------------------------------------------
+   // the frames are passed to the network together with the owner
+   // of the job
+   //
+   pclSchedulerP->setEnabled(true);
+   QVERIFY(pclSchedulerP->addJob(5, 2, clFrameP, QCAN_SCHEDULER_TICK, 
+                                 3) == true);
+
+   for(slWaitT = 0; (slWaitT < 100) && (ulFrameCntT < 3); slWaitT++)
+   {
+      QTest::qWait(10);
+      while(pclSchedulerP->readFrame(clDataT, ulOwnerT) == true)
+      {
+         QVERIFY(ulOwnerT == 5);
+         QVERIFY(clCheckT.fromByteArray(clDataT) == true);
+         QVERIFY(clCheckT.identifier() == 0x123);
+         ulFrameCntT++;
+      }
+   }
+   pclSchedulerP->setEnabled(false);
+
+   QVERIFY(ulFrameCntT == 3);
+   QVERIFY(pclSchedulerP->jobCount() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanScheduler::cleanupTestCase()
+{
+   delete(pclSchedulerP);
+}
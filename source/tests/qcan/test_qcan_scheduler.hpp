@@ -0,0 +1,75 @@
+//============================================================================//
+// File:          test_qcan_scheduler.hpp                                     //
+// Description:   QCAN classes - Test cyclic transmit scheduler               //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef TEST_QCAN_SCHEDULER_HPP_
+#define TEST_QCAN_SCHEDULER_HPP_
+
+
+#include <QTest>
+#include <QCanScheduler>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanScheduler
+** \brief   Test cyclic transmit scheduler
+** 
+*/
+class TestQCanScheduler : public QObject
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanScheduler();
+   
+   
+   ~TestQCanScheduler();
+
+private:
+   
+   QCanScheduler *      pclSchedulerP;
+   QCanFrame            clFrameP;
+   
+private slots:
+
+   void initTestCase();
+   
+   void checkAddRemove();
+   void checkPeriod();
+   void checkCount();
+   void checkWheel();
+   void checkJobMax();
+   void checkApiFrame();
+   void checkVirtual();
+   void cleanupTestCase();
+};
+
+
+
+
+#endif   // TEST_QCAN_SCHEDULER_HPP_
@@ -0,0 +1,226 @@
+//============================================================================//
+// File:          test_qcan_shared_ring.cpp                                   //
+// Description:   QCAN classes - Test shared memory frame ring                //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+
+
+
+#include "test_qcan_shared_ring.hpp"
+
+
+//-------------------------------------------------------------------
+// small ring, so the overrun can be tested quickly
+//
+#define  RING_TEST_KEY        "TestQCanSharedRing"
+#define  RING_TEST_SLOTS      8
+
+
+TestQCanSharedRing::TestQCanSharedRing()
+{
+
+}
+
+
+TestQCanSharedRing::~TestQCanSharedRing()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::initTestCase()
+{
+   pclWriterP = new QCanSharedRing();
+   pclReaderP = new QCanSharedRing();
+}
+
+
+//----------------------------------------------------------------------------//
+// checkAttach()                                                              //
+// create and attach the ring                                                 //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkAttach()
+{
+   QVERIFY(pclReaderP->attach(RING_TEST_KEY, 1) == false);
+   QVERIFY(pclWriterP->create(RING_TEST_KEY, 6) == false);
+   QVERIFY(pclWriterP->create(RING_TEST_KEY, RING_TEST_SLOTS) == true);
+   QVERIFY(pclWriterP->isAttached() == true);
+   QVERIFY(pclReaderP->attach(RING_TEST_KEY, 0) == false);
+   QVERIFY(pclReaderP->attach(RING_TEST_KEY, 1) == true);
+   QCOMPARE(pclWriterP->readerIndex(1), (int32_t) 0);
+   QCOMPARE(pclWriterP->readerIndex(2), (int32_t) -1);
+   QVERIFY(pclReaderP->key() == QString(RING_TEST_KEY));
+   QCOMPARE(pclReaderP->framesPending(), (uint32_t) 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkReadWrite()                                                           //
+// frames are read in the order they are written                              //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkReadWrite()
+{
+   char        achDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint32_t    ulSourceT;
+   uint8_t     ubCntT;
+
+   memset(&achDataT[0], 0, QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(pclWriterP->write(1, &achDataT[0], 0) == false);
+   QVERIFY(pclWriterP->write(1, &achDataT[0], 
+                             QCAN_FRAME_ARRAY_SIZE + 1) == false);
+
+   for(ubCntT = 0; ubCntT < 4; ubCntT++)
+   {
+      memset(&achDataT[0], ubCntT, QCAN_FRAME_ARRAY_SIZE);
+      QVERIFY(pclWriterP->write(ubCntT, &achDataT[0], 10 + ubCntT) == true);
+   }
+   QCOMPARE(pclReaderP->framesPending(), (uint32_t) 4);
+
+   for(ubCntT = 0; ubCntT < 4; ubCntT++)
+   {
+      QCOMPARE(pclReaderP->read(ulSourceT, &achDataT[0], 
+                                QCAN_FRAME_ARRAY_SIZE), 10 + ubCntT);
+      QCOMPARE(ulSourceT, (uint32_t) ubCntT);
+      QCOMPARE(achDataT[9], (char) ubCntT);
+   }
+   QCOMPARE(pclReaderP->read(ulSourceT, &achDataT[0], 
+                             QCAN_FRAME_ARRAY_SIZE), 0);
+   QCOMPARE(pclReaderP->lostFrames(), (uint32_t) 0);
+
+   //----------------------------------------------------------------
+   // a second reader starts at the current write position
+   //
+   QCanSharedRing clReaderT;
+   QVERIFY(clReaderT.attach(RING_TEST_KEY, 2) == true);
+   QCOMPARE(clReaderT.framesPending(), (uint32_t) 0);
+   QCOMPARE(clReaderT.writeIndex(), pclWriterP->writeIndex());
+}
+
+
+//----------------------------------------------------------------------------//
+// checkOverrun()                                                             //
+// a slow reader loses the oldest frames                                      //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkOverrun()
+{
+   char        achDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint32_t    ulSourceT;
+   uint32_t    ulCntT;
+
+   for(ulCntT = 0; ulCntT < (RING_TEST_SLOTS * 2); ulCntT++)
+   {
+      memset(&achDataT[0], 0, QCAN_FRAME_ARRAY_SIZE);
+      QVERIFY(pclWriterP->write(ulCntT, &achDataT[0], 16) == true);
+   }
+   QCOMPARE(pclReaderP->framesPending(), (uint32_t) RING_TEST_SLOTS);
+
+   //----------------------------------------------------------------
+   // the slot which is written next can not be read, hence one
+   // frame less than the number of slots is available
+   //
+   for(ulCntT = RING_TEST_SLOTS + 1; ulCntT < (RING_TEST_SLOTS * 2); ulCntT++)
+   {
+      QCOMPARE(pclReaderP->read(ulSourceT, &achDataT[0], 
+                                QCAN_FRAME_ARRAY_SIZE), 16);
+      QCOMPARE(ulSourceT, ulCntT);
+   }
+   QCOMPARE(pclReaderP->lostFrames(), (uint32_t) RING_TEST_SLOTS + 1);
+   QCOMPARE(pclReaderP->framesPending(), (uint32_t) 0);
+
+   //----------------------------------------------------------------
+   // the read position can be set to a value of the writer
+   //
+   pclReaderP->setReadIndex(pclWriterP->writeIndex() - 2);
+   QCOMPARE(pclReaderP->framesPending(), (uint32_t) 2);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkReaderLag()                                                           //
+// the writer removes or skips frames of a single reader                      //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkReaderLag()
+{
+   char        achDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint32_t    ulSourceT;
+   uint32_t    ulCntT;
+   int32_t     slReaderT;
+
+   slReaderT = pclWriterP->readerIndex(1);
+   QVERIFY(slReaderT >= 0);
+   pclReaderP->setReadIndex(pclWriterP->writeIndex());
+   QCOMPARE(pclWriterP->readerLag(slReaderT), (uint32_t) 0);
+
+   //----------------------------------------------------------------
+   // the second frame is skipped by the reader
+   //
+   memset(&achDataT[0], 0, QCAN_FRAME_ARRAY_SIZE);
+   for(ulCntT = 0; ulCntT < 4; ulCntT++)
+   {
+      QVERIFY(pclWriterP->write(ulCntT, &achDataT[0], 16, 
+                                (ulCntT == 1) ? (1 << slReaderT) : 0) == true);
+   }
+   QCOMPARE(pclWriterP->readerLag(slReaderT), (uint32_t) 4);
+   QCOMPARE(pclReaderP->read(ulSourceT, &achDataT[0], 
+                             QCAN_FRAME_ARRAY_SIZE), 16);
+   QCOMPARE(ulSourceT, (uint32_t) 0);
+   QCOMPARE(pclReaderP->read(ulSourceT, &achDataT[0], 
+                             QCAN_FRAME_ARRAY_SIZE), 16);
+   QCOMPARE(ulSourceT, (uint32_t) 2);
+   QCOMPARE(pclWriterP->readerLag(slReaderT), (uint32_t) 1);
+
+   //----------------------------------------------------------------
+   // the writer removes the oldest frames of the reader
+   //
+   QCOMPARE(pclWriterP->dropFrames(slReaderT, 4), (uint32_t) 1);
+   QCOMPARE(pclWriterP->readerLag(slReaderT), (uint32_t) 0);
+   QCOMPARE(pclReaderP->read(ulSourceT, &achDataT[0], 
+                             QCAN_FRAME_ARRAY_SIZE), 0);
+
+   //----------------------------------------------------------------
+   // a released entry is not found any more
+   //
+   pclWriterP->releaseReader(1);
+   QCOMPARE(pclWriterP->readerIndex(1), (int32_t) -1);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// release the ring                                                           //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::cleanupTestCase()
+{
+   pclReaderP->detach();
+   pclWriterP->detach();
+   QVERIFY(pclReaderP->isAttached() == false);
+
+   delete(pclReaderP);
+   delete(pclWriterP);
+}
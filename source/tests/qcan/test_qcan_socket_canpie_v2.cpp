@@ -0,0 +1,144 @@
+//============================================================================//
+// File:          test_qcan_socket_canpie_v2.cpp                              //
+// Description:   QCAN classes - Test CANpie version 2 socket                 //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+#include <string.h>
+
+#include "test_qcan_socket_canpie_v2.hpp"
+
+
+TestQCanSocketCp2::TestQCanSocketCp2()
+{
+
+}
+
+
+TestQCanSocketCp2::~TestQCanSocketCp2()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanSocketCp2::initTestCase()
+{
+   //----------------------------------------------------------------
+   // the message buffers are used without a connection to a
+   // network, frames are passed to receiveFrame() directly
+   //
+   memset(&tsPortP, 0, sizeof(CpPort_ts));
+   tsPortP.ubPhyIf = 0;
+
+   pclSockP = QCanSocketCp2::fromPort(&tsPortP);
+   QVERIFY(pclSockP != 0L);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkReceive()                                                             //
+// check frame reception of a receive buffer                                  //
+//----------------------------------------------------------------------------//
+void TestQCanSocketCp2::checkReceive()
+{
+   CpCanMsg_ts    tsCanMsgT;
+   uint8_t        aubDataT[8];
+   QCanFrame      clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 2);
+
+   CpMsgClear(&tsCanMsgT);
+   CpMsgSetStdId(&tsCanMsgT, 0x123);
+   CpMsgSetDlc(&tsCanMsgT, 2);
+   QVERIFY(CpCoreBufferInit(&tsPortP, &tsCanMsgT, CP_BUFFER_1,
+                            CP_BUFFER_DIR_RX) == CpErr_OK);
+   QVERIFY(pclSockP->clFilterIndexM.match(0x123, false) == 0x01);
+
+   clFrameT.setData(0, 0xAA);
+   clFrameT.setData(1, 0x55);
+   pclSockP->receiveFrame(clFrameT);
+
+   QVERIFY(CpCoreBufferGetData(&tsPortP, CP_BUFFER_1, &aubDataT[0]) == 
+           CpErr_OK);
+   QVERIFY(aubDataT[0] == 0xAA);
+   QVERIFY(aubDataT[1] == 0x55);
+
+   QVERIFY(CpCoreBufferRelease(&tsPortP, CP_BUFFER_1) == CpErr_OK);
+   QVERIFY(pclSockP->clFilterIndexM.isEmpty() == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkReceiveToTransmit()                                                   //
+// a receive buffer which is used for transmission accepts no frames          //
+//----------------------------------------------------------------------------//
+void TestQCanSocketCp2::checkReceiveToTransmit()
+{
+   CpCanMsg_ts    tsCanMsgT;
+   uint8_t        aubDataT[8];
+   QCanFrame      clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 2);
+
+   CpMsgClear(&tsCanMsgT);
+   CpMsgSetStdId(&tsCanMsgT, 0x123);
+   CpMsgSetDlc(&tsCanMsgT, 2);
+   QVERIFY(CpCoreBufferInit(&tsPortP, &tsCanMsgT, CP_BUFFER_2,
+                            CP_BUFFER_DIR_RX) == CpErr_OK);
+   QVERIFY(pclSockP->clFilterIndexM.match(0x123, false) == 0x02);
+
+   //----------------------------------------------------------------
+   // transmit with the same buffer, the socket is not connected, 
+   // so the frame is only copied to the buffer
+   //
+   CpMsgSetData(&tsCanMsgT, 0, 0x11);
+   CpMsgSetData(&tsCanMsgT, 1, 0x22);
+   QVERIFY(CpCoreBufferTransmit(&tsPortP, CP_BUFFER_2, &tsCanMsgT) == 
+           CpErr_OK);
+   QVERIFY(pclSockP->clFilterIndexM.match(0x123, false) == 0);
+
+   //----------------------------------------------------------------
+   // a matching frame must not overwrite the transmit data
+   //
+   clFrameT.setData(0, 0xAA);
+   clFrameT.setData(1, 0x55);
+   pclSockP->receiveFrame(clFrameT);
+
+   QVERIFY(CpCoreBufferGetData(&tsPortP, CP_BUFFER_2, &aubDataT[0]) == 
+           CpErr_OK);
+   QVERIFY(aubDataT[0] == 0x11);
+   QVERIFY(aubDataT[1] == 0x22);
+
+   QVERIFY(CpCoreBufferRelease(&tsPortP, CP_BUFFER_2) == CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanSocketCp2::cleanupTestCase()
+{
+
+}
@@ -0,0 +1,70 @@
+//============================================================================//
+// File:          test_qcan_socket_canpie_v2.hpp                              //
+// Description:   QCAN classes - Test CANpie version 2 socket                 //
+// Author:        Uwe Koppe                                                   //
+// e-mail:        koppe@microcontrol.net                                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// Junkersring 23                                                             //
+// 53844 Troisdorf                                                            //
+// Germany                                                                    //
+// Tel: +49-2241-25659-0                                                      //
+// Fax: +49-2241-25659-11                                                     //
+//                                                                            //
+// The copyright to the computer program(s) herein is the property of         //
+// MicroControl GmbH & Co. KG, Germany. The program(s) may be used            //
+// and/or copied only with the written permission of MicroControl GmbH &      //
+// Co. KG or in accordance with the terms and conditions stipulated in        //
+// the agreement/contract under which the program(s) have been supplied.      //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 20.05.2015  Initial version                                                //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef TEST_QCAN_SOCKET_CANPIE_V2_HPP_
+#define TEST_QCAN_SOCKET_CANPIE_V2_HPP_
+
+
+#include <QTest>
+#include "qcan_socket_canpie_v2.hpp"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanSocketCp2
+** \brief   Test message buffers of the CANpie version 2 socket
+** 
+*/
+class TestQCanSocketCp2 : public QObject
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanSocketCp2();
+   
+   
+   ~TestQCanSocketCp2();
+
+private:
+   
+   CpPort_ts         tsPortP;
+   QCanSocketCp2 *   pclSockP;
+   
+private slots:
+
+   void initTestCase();
+   
+   void checkReceive();
+   void checkReceiveToTransmit();
+   void cleanupTestCase();
+};
+
+
+
+
+#endif   // TEST_QCAN_SOCKET_CANPIE_V2_HPP_
@@ -187,6 +187,50 @@ void TestQCanTimestamp::checkConversion()
    
 }
 
+//----------------------------------------------------------------------------//
+// checkConversion64()                                                        //
+// check conversions from 64 bit values                                       //
+//----------------------------------------------------------------------------//
+void TestQCanTimestamp::checkConversion64()
+{
+   //----------------------------------------------------------------
+   // set 4294967296 micro-seconds, which is beyond the range of
+   // a 32 bit value
+   //
+   pclTimestampA->fromMicroSeconds(4294967296ULL);
+   QVERIFY(pclTimestampA->seconds()     == 4294);
+   QVERIFY(pclTimestampA->nanoSeconds() == 967296000);
+
+   //----------------------------------------------------------------
+   // set 7 days + 5 micro-seconds
+   //
+   pclTimestampA->fromMicroSeconds(604800000005ULL);
+   QVERIFY(pclTimestampA->seconds()     == 604800);
+   QVERIFY(pclTimestampA->nanoSeconds() == 5000);
+
+   //----------------------------------------------------------------
+   // set 7 days + 5 milli-seconds
+   //
+   pclTimestampA->fromMilliSeconds(604800005ULL);
+   QVERIFY(pclTimestampA->seconds()     == 604800);
+   QVERIFY(pclTimestampA->nanoSeconds() == 5000000);
+
+   //----------------------------------------------------------------
+   // set 7 days + 5 nano-seconds
+   //
+   pclTimestampA->fromNanoSeconds(604800000000005ULL);
+   QVERIFY(pclTimestampA->seconds()     == 604800);
+   QVERIFY(pclTimestampA->nanoSeconds() == 5);
+
+   //----------------------------------------------------------------
+   // the seconds are limited to TIME_STAMP_SECS_LIMIT
+   //
+   pclTimestampA->fromMicroSeconds(0xFFFFFFFFFFFFFFFFULL);
+   QVERIFY(pclTimestampA->seconds()     == TIME_STAMP_SECS_LIMIT);
+   QVERIFY(pclTimestampA->isValid()     == true);
+}
+
+
 //----------------------------------------------------------------------------//
 // checkOperatorCompare()                                                     //
 // check comparision between time-stamp values                                //
@@ -426,6 +470,58 @@ void TestQCanTimestamp::checkOperatorMinus()
 }
 
 
+//----------------------------------------------------------------------------//
+// checkNanoSeconds()                                                         //
+// check nanoseconds representation                                           //
+//----------------------------------------------------------------------------//
+void TestQCanTimestamp::checkNanoSeconds()
+{
+   //----------------------------------------------------------------
+   // comparison and arithmetic can be evaluated at compile time
+   //
+   static_assert(QCanTimeStamp(1, 5) < QCanTimeStamp(2, 0), 
+                 "QCanTimeStamp: constexpr compare");
+   static_assert((QCanTimeStamp(1, 999999999) + QCanTimeStamp(0, 1)) == 
+                 QCanTimeStamp(2, 0), "QCanTimeStamp: constexpr add");
+   static_assert((QCanTimeStamp(0, 1) - QCanTimeStamp(0, 2)).isValid() == 
+                 false, "QCanTimeStamp: constexpr sub");
+
+   //----------------------------------------------------------------
+   // the nanoseconds value combines both data fields
+   //
+   QCanTimeStamp clResultT(3, 250);
+   QVERIFY(clResultT.toNanoSeconds() == 3000000250LL);
+
+   clResultT.setSeconds(TIME_STAMP_SECS_LIMIT);
+   clResultT.setNanoSeconds(TIME_STAMP_NSEC_LIMIT);
+   QVERIFY(clResultT.toNanoSeconds() == TIME_STAMP_TOTAL_LIMIT);
+
+   //----------------------------------------------------------------
+   // an invalid time-stamp returns -1 and is sorted behind
+   // all valid time-stamps
+   //
+   clResultT += QCanTimeStamp(0, 1);
+   QVERIFY(clResultT.isValid()       == false);
+   QVERIFY(clResultT.toNanoSeconds() == -1);
+   QVERIFY(clResultT > QCanTimeStamp(TIME_STAMP_SECS_LIMIT, 
+                                     TIME_STAMP_NSEC_LIMIT));
+
+   //----------------------------------------------------------------
+   // an invalid time-stamp stays invalid on arithmetic operations
+   //
+   clResultT -= QCanTimeStamp(1, 0);
+   QVERIFY(clResultT.isValid()       == false);
+
+   //----------------------------------------------------------------
+   // setting a data field makes the time-stamp valid again
+   //
+   clResultT.setSeconds(7);
+   QVERIFY(clResultT.seconds()       == 7);
+   QVERIFY(clResultT.nanoSeconds()   == 0);
+   QVERIFY(clResultT.isValid()       == true);
+}
+
+
 //----------------------------------------------------------------------------//
 // cleanupTestCase()                                                          //
 // cleanup test cases                                                         //
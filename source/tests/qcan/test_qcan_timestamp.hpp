@@ -64,9 +64,11 @@ private slots:
    
    void checkValueRange();
    void checkConversion();
+   void checkConversion64();
    void checkOperatorCompare();
    void checkOperatorPlus();
    void checkOperatorMinus();
+   void checkNanoSeconds();
    void cleanupTestCase();
 };
 
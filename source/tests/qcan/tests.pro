@@ -84,27 +84,67 @@ VPATH += ./../../qcan
 #---------------------------------------------------------------
 # header files of project 
 #
-HEADERS +=  qcan_frame.hpp             \
+HEADERS +=  qcan_bus_load.hpp          \
+            qcan_frame.hpp             \
+            qcan_frame_queue.hpp       \
+            qcan_filter_index.hpp      \
             qcan_interface.hpp         \
+            qcan_recorder.hpp          \
+            qcan_scheduler.hpp         \
             qcan_socket.hpp            \
+            qcan_trace.hpp             \
+            test_qcan_bus_load.hpp     \
+            test_qcan_data.hpp         \
+            test_qcan_filter_index.hpp \
             test_qcan_frame.hpp        \
+            test_qcan_frame_queue.hpp  \
+            test_qcan_recorder.hpp     \
+            test_qcan_scheduler.hpp    \
+            test_qcan_shared_ring.hpp  \
             test_qcan_socket.hpp       \
             test_qcan_timestamp.hpp
 
 #---------------------------------------------------------------
 # source files of project 
 #
-SOURCES +=  qcan_data.cpp              \
+SOURCES +=  qcan_bus_load.cpp          \
+            qcan_data.cpp              \
             qcan_frame.cpp             \
             qcan_frame_api.cpp         \
             qcan_frame_error.cpp       \
+            qcan_frame_queue.cpp       \
+            qcan_filter_index.cpp      \
+            qcan_recorder.cpp          \
+            qcan_scheduler.cpp         \
+            qcan_shared_ring.cpp       \
             qcan_timestamp.cpp         \
+            qcan_trace.cpp             \
             qcan_socket.cpp            \
+            test_qcan_bus_load.cpp     \
+            test_qcan_data.cpp         \
+            test_qcan_filter_index.cpp \
             test_qcan_frame.cpp        \
+            test_qcan_frame_queue.cpp  \
+            test_qcan_recorder.cpp     \
+            test_qcan_scheduler.cpp    \
+            test_qcan_shared_ring.cpp  \
             test_qcan_socket.cpp       \
             test_qcan_timestamp.cpp    \
             test_main.cpp
 
+#---------------------------------------------------------------
+# the CANpie version 2 socket requires the CANpie version 2
+# header files
+#
+exists(./../../canpie/version2/cp_core.h) {
+   QT      += widgets
+   DEFINES += QCAN_TEST_CANPIE_V2
+   HEADERS += qcan_socket_canpie_v2.hpp          \
+              test_qcan_socket_canpie_v2.hpp
+   SOURCES += qcan_socket_canpie_v2.cpp          \
+              test_qcan_socket_canpie_v2.cpp
+}
+
 
 
 